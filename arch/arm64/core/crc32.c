@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief CRC-32 and CRC-32C using the ARMv8 CRC32 instructions
+ */
+
+#include <kernel.h>
+#include <sys/util.h>
+
+/* The CRC32 instructions are an extension of ARMv8.0, let the assembler
+ * accept them whatever -mcpu/-march the rest of the kernel is built with.
+ */
+#define CRC32_INSN(insn, dst, src) \
+	__asm__ (".arch_extension crc\n\t" insn : "+r" (dst) : "r" (src))
+
+#define CRC32_UPDATE(name, b, w)					\
+uint32_t name(uint32_t crc, const uint8_t *data, size_t len)		\
+{									\
+	while (len > 0 && ((uintptr_t)data & 7) != 0) {			\
+		CRC32_INSN(b " %w0, %w0, %w1", crc, *data);		\
+		data++;							\
+		len--;							\
+	}								\
+									\
+	while (len >= 8) {						\
+		CRC32_INSN(w " %w0, %w0, %x1", crc,			\
+			   *(const uint64_t *)data);			\
+		data += 8;						\
+		len -= 8;						\
+	}								\
+									\
+	while (len > 0) {						\
+		CRC32_INSN(b " %w0, %w0, %w1", crc, *data);		\
+		data++;							\
+		len--;							\
+	}								\
+									\
+	return crc;							\
+}
+
+CRC32_UPDATE(arch_crc32_update, "crc32b", "crc32x")
+CRC32_UPDATE(arch_crc32c_update, "crc32cb", "crc32cx")
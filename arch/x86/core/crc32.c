@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief CRC-32C using the SSE4.2 crc32 instruction
+ *
+ * The instruction only implements the Castagnoli polynomial, CRC-32 with
+ * the IEEE 802.3 polynomial stays with the software implementation.
+ */
+
+#include <kernel.h>
+#include <sys/util.h>
+
+#ifdef CONFIG_X86_64
+#define CRC32_WORD "crc32q"
+#else
+#define CRC32_WORD "crc32l"
+#endif
+
+uint32_t arch_crc32c_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+	unsigned long acc = crc;
+
+	while (len > 0 && ((uintptr_t)data & (sizeof(unsigned long) - 1)) != 0) {
+		__asm__ ("crc32b %1, %k0" : "+r" (acc) : "rm" (*data));
+		data++;
+		len--;
+	}
+
+	while (len >= sizeof(unsigned long)) {
+		__asm__ (CRC32_WORD " %1, %0"
+			 : "+r" (acc)
+			 : "rm" (*(const unsigned long *)data));
+		data += sizeof(unsigned long);
+		len -= sizeof(unsigned long);
+	}
+
+	while (len > 0) {
+		__asm__ ("crc32b %1, %k0" : "+r" (acc) : "rm" (*data));
+		data++;
+		len--;
+	}
+
+	return (uint32_t)acc;
+}
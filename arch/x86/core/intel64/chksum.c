@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Internet checksum for Intel64
+ *
+ * The data is summed as 32-bit words split into the 64-bit lanes of SSE2
+ * registers, so no carries have to be propagated until the final fold.
+ * The SSE registers are part of the context saved for every thread and
+ * interrupt on Intel64, so the kernel can use them freely.
+ */
+
+#include <kernel.h>
+#include <string.h>
+
+typedef uint64_t v2du __attribute__((vector_size(16)));
+
+uint16_t arch_net_chksum(const uint8_t *data, size_t len)
+{
+	const v2du mask = { 0xffffffffU, 0xffffffffU };
+	v2du lo = { 0U, 0U };
+	v2du hi = { 0U, 0U };
+	uint64_t sum, word;
+	v2du v0, v1;
+
+	while (len >= 32) {
+		memcpy(&v0, data, sizeof(v0));
+		memcpy(&v1, data + 16, sizeof(v1));
+		lo += (v0 & mask) + (v1 & mask);
+		hi += (v0 >> 32) + (v1 >> 32);
+		data += 32;
+		len -= 32;
+	}
+
+	lo += hi;
+	sum = lo[0] + lo[1];
+
+	while (len >= 4) {
+		uint32_t w;
+
+		memcpy(&w, data, sizeof(w));
+		sum += w;
+		data += 4;
+		len -= 4;
+	}
+
+	if (len > 0) {
+		/* Little endian, the trailing bytes land in the low lanes
+		 * and an odd last byte gets the zero pad above it.
+		 */
+		word = 0U;
+		memcpy(&word, data, len);
+		sum += word;
+	}
+
+	sum = (sum & 0xffffffffU) + (sum >> 32);
+	sum = (sum & 0xffffffffU) + (sum >> 32);
+	sum = (sum & 0xffffU) + (sum >> 16);
+	sum = (sum & 0xffffU) + (sum >> 16);
+
+	return (uint16_t)sum;
+}
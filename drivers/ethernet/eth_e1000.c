@@ -118,6 +118,7 @@ static int e1000_tx(struct e1000_dev *dev, void *buf, size_t len)
 	dev->tx.addr = POINTER_TO_INT(buf);
 	dev->tx.len = len;
 	dev->tx.cmd = TDESC_EOP | TDESC_RS;
+	dev->tx.sta = 0;
 
 	iow32(dev, TDT, 1);
 
@@ -134,12 +135,22 @@ static int e1000_send(const struct device *ddev, struct net_pkt *pkt)
 {
 	struct e1000_dev *dev = ddev->data;
 	size_t len = net_pkt_get_len(pkt);
+	int ret;
+
+	/* With several TX queues the driver is called from several threads,
+	 * they share the single descriptor and bounce buffer.
+	 */
+	k_mutex_lock(&dev->tx_lock, K_FOREVER);
 
 	if (net_pkt_read(pkt, dev->txb, len)) {
-		return -EIO;
+		ret = -EIO;
+	} else {
+		ret = e1000_tx(dev, dev->txb, len);
 	}
 
-	return e1000_tx(dev, dev->txb, len);
+	k_mutex_unlock(&dev->tx_lock);
+
+	return ret;
 }
 
 static struct net_pkt *e1000_rx(struct e1000_dev *dev)
@@ -251,6 +262,8 @@ int e1000_probe(const struct device *ddev)
 	device_map(&dev->address, mbar.phys_addr, mbar.size,
 		   K_MEM_CACHE_NONE);
 
+	k_mutex_init(&dev->tx_lock);
+
 	/* Setup TX descriptor */
 
 	iow32(dev, TDBAL, (uint32_t) &dev->tx);
@@ -84,6 +84,8 @@ struct e1000_dev {
 	 */
 	struct net_if *iface;
 	uint8_t mac[ETH_ALEN];
+	/* Serializes the TX descriptor between the TX queue threads */
+	struct k_mutex tx_lock;
 	uint8_t txb[NET_ETH_MTU];
 	uint8_t rxb[NET_ETH_MTU];
 #if defined(CONFIG_ETH_E1000_PTP_CLOCK)
@@ -31,6 +31,17 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief Non-volatile Storage lookup cache statistics
+ *
+ * @param lookups Number of ID lookups
+ * @param hits Lookups resolved without walking the allocation table
+ */
+struct nvs_lookup_cache_stats {
+	uint32_t lookups;
+	uint32_t hits;
+};
+
 /**
  * @brief Non-volatile Storage File system structure
  *
@@ -44,6 +55,8 @@ extern "C" {
  * @param nvs_lock Mutex
  * @param flash_device Flash Device runtime structure
  * @param flash_parameters Flash memory parameters structure
+ * @param lookup_cache Address of the latest ATE for each ID hash
+ * @param lookup_stats Lookup cache statistics
  */
 struct nvs_fs {
 	off_t offset;
@@ -55,6 +68,10 @@ struct nvs_fs {
 	struct k_mutex nvs_lock;
 	const struct device *flash_device;
 	const struct flash_parameters *flash_parameters;
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+	struct nvs_lookup_cache_stats lookup_stats;
+#endif
 };
 
 /**
@@ -165,6 +182,24 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len, ui
  */
 ssize_t nvs_calc_free_space(struct nvs_fs *fs);
 
+#if defined(CONFIG_NVS_LOOKUP_CACHE) || defined(__DOXYGEN__)
+/**
+ * @brief nvs_lookup_cache_stats_get
+ *
+ * Get the lookup cache statistics of the file system. A lookup is a hit when
+ * the cache points directly at the latest entry of the ID, or tells that the
+ * ID is not stored at all. The statistics are reset when the file system is
+ * mounted.
+ *
+ * @param fs Pointer to file system
+ * @param stats Pointer to where the statistics are copied
+ * @retval 0 Success
+ * @retval -ERRNO errno code if error
+ */
+int nvs_lookup_cache_stats_get(struct nvs_fs *fs,
+			       struct nvs_lookup_cache_stats *stats);
+#endif
+
 /**
  * @brief nvs_init
  *
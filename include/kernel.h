@@ -4276,6 +4276,8 @@ extern int k_work_poll_cancel(struct k_work_poll *work);
 struct k_msgq {
 	/** Message queue wait queue */
 	_wait_q_t wait_q;
+	/** Writers waiting for a reserved slot to be committed */
+	_wait_q_t commit_wait_q;
 	/** Lock */
 	struct k_spinlock lock;
 	/** Message size */
@@ -4308,6 +4310,7 @@ struct k_msgq {
 #define Z_MSGQ_INITIALIZER(obj, q_buffer, q_msg_size, q_max_msgs) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.commit_wait_q = Z_WAIT_Q_INIT(&obj.commit_wait_q), \
 	.msg_size = q_msg_size, \
 	.max_msgs = q_max_msgs, \
 	.buffer_start = q_buffer, \
@@ -4324,6 +4327,7 @@ struct k_msgq {
 
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
+#define K_MSGQ_FLAG_RESERVED	BIT(1)
 
 /**
  * @brief Message Queue Attributes
@@ -4438,9 +4442,85 @@ int k_msgq_cleanup(struct k_msgq *msgq);
  * @retval 0 Message sent.
  * @retval -ENOMSG Returned without waiting or queue purged.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Returned without waiting while a slot reserved with
+ *                k_msgq_reserve() isn't committed yet.
  */
 __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends up to @a num messages, stored one after the other at
+ * @a data, to message queue @a msgq. The messages are given to waiting
+ * threads or copied into the ring buffer under a single lock, and the
+ * scheduler runs once for all threads woken up.
+ *
+ * As many messages as fit are sent without waiting. Only if the queue is
+ * full does the caller wait, for the first message to be sent.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Pointer to the messages.
+ * @param num Number of messages.
+ * @param timeout Waiting period to send the first message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages sent, which may be less than @a num.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Returned without waiting while a slot reserved with
+ *                k_msgq_reserve() isn't committed yet.
+ */
+__syscall int k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			      uint32_t num, k_timeout_t timeout);
+
+/**
+ * @brief Reserve a slot for a message in a message queue.
+ *
+ * This routine returns the ring buffer slot the next message of @a msgq
+ * goes to, so the message can be written in place instead of being copied
+ * by k_msgq_put(). The message is sent with k_msgq_commit().
+ *
+ * Only one slot can be reserved at a time, and until it is committed no
+ * other message can be put into the queue: k_msgq_put() and
+ * k_msgq_put_many() wait for the commit within their waiting period.
+ * Receiving messages is not affected.
+ *
+ * A user mode thread needs write access to the whole ring buffer of the
+ * queue, e.g. a buffer in its memory domain given to k_msgq_init().
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param slot Set to the address of the reserved slot, which is
+ *             msg_size bytes long.
+ *
+ * @retval 0 Slot reserved.
+ * @retval -ENOMSG The queue is full.
+ * @retval -EBUSY Another slot is already reserved.
+ */
+__syscall int k_msgq_reserve(struct k_msgq *msgq, void **slot);
+
+/**
+ * @brief Send or drop the message in a reserved slot.
+ *
+ * This routine finishes a k_msgq_reserve(). With @a send the message
+ * written into the slot is sent as k_msgq_put() would, otherwise the slot
+ * is released and nothing is sent. The slot must not be accessed any more
+ * afterwards.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param send True to send the message, false to drop it.
+ *
+ * @retval 0 Slot committed.
+ * @retval -EINVAL No slot is reserved.
+ */
+__syscall int k_msgq_commit(struct k_msgq *msgq, bool send);
+
 /**
  * @brief Receive a message from a message queue.
  *
@@ -4463,6 +4543,35 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a num messages from message queue @a msgq
+ * in a "first in, first out" manner, and stores them one after the other
+ * at @a data. All of them are taken under a single lock, threads waiting
+ * to send are then let in and the scheduler runs once for all of them.
+ *
+ * The messages already queued are received without waiting. Only if the
+ * queue is empty does the caller wait, for one message.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of area to hold @a num messages.
+ * @param num Maximum number of messages to receive.
+ * @param timeout Waiting period to receive a message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages received, which may be less than @a num.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_get_many(struct k_msgq *msgq, void *data, uint32_t num,
+			      k_timeout_t timeout);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -4516,7 +4625,9 @@ __syscall void  k_msgq_get_attrs(struct k_msgq *msgq,
 
 static inline uint32_t z_impl_k_msgq_num_free_get(struct k_msgq *msgq)
 {
-	return msgq->max_msgs - msgq->used_msgs;
+	uint32_t reserved = (msgq->flags & K_MSGQ_FLAG_RESERVED) ? 1U : 0U;
+
+	return msgq->max_msgs - msgq->used_msgs - reserved;
 }
 
 /**
@@ -4902,6 +5013,14 @@ __syscall void k_pipe_buffer_flush(struct k_pipe *pipe);
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+struct z_mem_slab_magazine {
+	struct k_spinlock lock;
+	char *free_list;
+	uint32_t count;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
@@ -4913,6 +5032,13 @@ struct k_mem_slab {
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	/* Set while the slab ran out of blocks, frees then skip the
+	 * magazines so they can wake pending threads
+	 */
+	atomic_t bypass;
+	struct z_mem_slab_magazine magazines[CONFIG_MP_NUM_CPUS];
+#endif
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 };
@@ -5063,9 +5189,17 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  *
  * @return Number of allocated memory blocks.
  */
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+extern uint32_t z_mem_slab_num_used_get(struct k_mem_slab *slab);
+#endif
+
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	return z_mem_slab_num_used_get(slab);
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -5100,7 +5234,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /** @} */
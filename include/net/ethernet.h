@@ -168,6 +168,12 @@ enum ethernet_hw_caps {
 
 	/** TXTIME supported */
 	ETHERNET_TXTIME			= BIT(19),
+
+	/** TCP segmentation offload supported, the segment size of a large
+	 * packet is given by net_pkt_gso_size(). Implies TX checksum
+	 * offloading.
+	 */
+	ETHERNET_HW_TX_TSO		= BIT(20),
 };
 
 /** @cond INTERNAL_HIDDEN */
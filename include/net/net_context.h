@@ -281,6 +281,11 @@ __net_socket struct net_context {
 		/** Mutex used by condition variable */
 		struct k_mutex *lock;
 	} cond;
+
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	/** Epoll instances watching this socket */
+	sys_slist_t epoll_items;
+#endif
 #endif /* CONFIG_NET_SOCKETS */
 
 #if defined(CONFIG_NET_OFFLOAD)
@@ -312,9 +317,48 @@ __net_socket struct net_context {
 #endif
 #if defined(CONFIG_NET_CONTEXT_SNDTIMEO)
 		k_timeout_t sndtimeo;
+#endif
+#if defined(CONFIG_NET_CONTEXT_RCVBUF)
+		/** Receive buffer limit in bytes, 0 if unlimited */
+		uint32_t rcvbuf;
+#endif
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+		/** Send buffer limit in bytes, 0 if unlimited */
+		uint32_t sndbuf;
+#endif
+#if defined(CONFIG_NET_CONTEXT_REUSEPORT)
+		/** Share the local address and port with other contexts */
+		bool reuseport;
 #endif
 	} options;
 
+#if defined(CONFIG_NET_CONTEXT_RCVBUF)
+	/** Payload bytes of the datagrams waiting to be read */
+	atomic_t rcvbuf_used;
+#endif
+
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+	/** Bytes of the datagrams queued for sending */
+	atomic_t sndbuf_used;
+#endif
+
+#if defined(CONFIG_NET_IPV6_NBR_DST_CACHE)
+	/** Neighbor the packets of a connected context were last sent to */
+	struct {
+		/** IPv6 destination the neighbor was found for */
+		struct in6_addr dst;
+
+		/** Neighbor cache entry */
+		void *nbr;
+
+		/** Network interface of the neighbor */
+		struct net_if *iface;
+
+		/** Neighbor cache generation the entry is valid for */
+		uint32_t gen;
+	} ipv6_nbr_cache;
+#endif
+
 	/** Protocol (UDP, TCP or IEEE 802.3 protocol value) */
 	uint16_t proto;
 
@@ -350,6 +394,24 @@ static inline bool net_context_is_bound_to_iface(struct net_context *context)
 	return context->flags & NET_CONTEXT_BOUND_TO_IFACE;
 }
 
+/**
+ * @brief Can this context share its local address and port.
+ *
+ * @param context Network context.
+ *
+ * @return True if SO_REUSEPORT is set on the context, False otherwise.
+ */
+static inline bool net_context_is_reuseport(struct net_context *context)
+{
+	NET_ASSERT(context);
+
+#if defined(CONFIG_NET_CONTEXT_REUSEPORT)
+	return context->options.reuseport;
+#else
+	return false;
+#endif
+}
+
 /**
  * @brief Is this context is accepting data now.
  *
@@ -990,6 +1052,34 @@ int net_context_sendmsg(struct net_context *context,
 			k_timeout_t timeout,
 			void *user_data);
 
+/**
+ * @brief Send a network buffer chain without copying it.
+ *
+ * @details The chain is linked into the outgoing packet behind the
+ * protocol headers instead of being copied. The stack takes its own
+ * reference to @a frags and the caller keeps the one it had, so the caller
+ * must always release its reference with net_buf_unref(). After a
+ * successful call the data must not be modified anymore, TCP keeps the
+ * buffers queued until they are acknowledged.
+ *
+ * @param context The network context to use.
+ * @param frags The buffer chain to send
+ * @param dst_addr Destination address, NULL to use the connected peer.
+ * @param addrlen Length of the address.
+ * @param cb Caller-supplied callback function.
+ * @param timeout Currently this value is not used.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return numbers of bytes sent on success, a negative errno otherwise
+ */
+int net_context_sendto_frags(struct net_context *context,
+			     struct net_buf *frags,
+			     const struct sockaddr *dst_addr,
+			     socklen_t addrlen,
+			     net_context_send_cb_t cb,
+			     k_timeout_t timeout,
+			     void *user_data);
+
 /**
  * @brief Receive network data from a peer specified by context.
  *
@@ -1060,6 +1150,10 @@ enum net_context_option {
 	NET_OPT_SOCKS5		= 3,
 	NET_OPT_RCVTIMEO        = 4,
 	NET_OPT_SNDTIMEO        = 5,
+	NET_OPT_TCP_CONGESTION  = 6,
+	NET_OPT_RCVBUF          = 7,
+	NET_OPT_SNDBUF          = 8,
+	NET_OPT_REUSEPORT       = 9,
 };
 
 /**
@@ -121,6 +121,21 @@ struct net_pkt {
 	/** Reference counter */
 	atomic_t atomic_ref;
 
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+	/** Bytes charged to the send buffer of the context */
+	uint32_t sndbuf_len;
+#endif
+
+#if NET_TC_FLOW_QUEUES > 1
+	/** Flow hash used to select the traffic class queue, 0 if unset */
+	uint32_t flow_hash;
+#endif
+
+#if defined(CONFIG_NET_TCP_GSO)
+	/** Segment size if the packet is split at the L2, 0 otherwise */
+	uint16_t gso_size;
+#endif
+
 	/* Filled by layer 2 when network packet is received. */
 	struct net_linkaddr lladdr_src;
 	struct net_linkaddr lladdr_dst;
@@ -189,6 +204,12 @@ struct net_pkt {
 				 * defined(CONFIG_NET_ETHERNET_BRIDGE).
 				 */
 
+	uint8_t chksum_done : 1; /* Transport layer checksum is already
+				  * valid, e.g. updated incrementally,
+				  * and is left as is when the packet is
+				  * finalized.
+				  */
+
 	union {
 		/* IPv6 hop limit or IPv4 ttl for this network packet.
 		 * The value is shared between IPv6 and IPv4.
@@ -359,6 +380,17 @@ static inline void net_pkt_set_l2_bridged(struct net_pkt *pkt, bool is_l2_bridge
 	}
 }
 
+static inline bool net_pkt_is_chksum_done(struct net_pkt *pkt)
+{
+	return !!(pkt->chksum_done);
+}
+
+static inline void net_pkt_set_chksum_done(struct net_pkt *pkt,
+					   bool is_chksum_done)
+{
+	pkt->chksum_done = is_chksum_done;
+}
+
 static inline uint8_t net_pkt_ip_hdr_len(struct net_pkt *pkt)
 {
 	return pkt->ip_hdr_len;
@@ -887,6 +919,84 @@ static inline void net_pkt_set_txtime(struct net_pkt *pkt, uint64_t txtime)
 }
 #endif /* CONFIG_NET_PKT_TXTIME */
 
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+static inline uint32_t net_pkt_sndbuf_len(struct net_pkt *pkt)
+{
+	return pkt->sndbuf_len;
+}
+
+static inline void net_pkt_set_sndbuf_len(struct net_pkt *pkt, uint32_t len)
+{
+	pkt->sndbuf_len = len;
+}
+#else
+static inline uint32_t net_pkt_sndbuf_len(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_sndbuf_len(struct net_pkt *pkt, uint32_t len)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(len);
+}
+#endif /* CONFIG_NET_CONTEXT_SNDBUF */
+
+#if NET_TC_FLOW_QUEUES > 1
+static inline uint32_t net_pkt_flow_hash(struct net_pkt *pkt)
+{
+	return pkt->flow_hash;
+}
+
+/* Drivers of NICs doing receive side scaling can pass the hardware hash
+ * here so that the stack does not need to compute it.
+ */
+static inline void net_pkt_set_flow_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	pkt->flow_hash = hash;
+}
+#else
+static inline uint32_t net_pkt_flow_hash(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_flow_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hash);
+}
+#endif /* NET_TC_FLOW_QUEUES > 1 */
+
+#if defined(CONFIG_NET_TCP_GSO)
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	pkt->gso_size = size;
+}
+#else
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(size);
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 #if defined(CONFIG_NET_PKT_TXTIME_STATS_DETAIL) || \
 	defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
 static inline uint32_t *net_pkt_stats_tick(struct net_pkt *pkt)
@@ -1496,6 +1606,34 @@ void net_pkt_frag_insert(struct net_pkt *pkt, struct net_buf *frag);
  */
 bool net_pkt_compact(struct net_pkt *pkt);
 
+/** RX memory pressure levels, see net_pkt_mem_pressure() */
+enum net_pkt_mem_pressure {
+	/** Enough packets and buffers are free */
+	NET_PKT_MEM_PRESSURE_NONE,
+	/** Free share below CONFIG_NET_PKT_PRESSURE_LOW_PERCENT */
+	NET_PKT_MEM_PRESSURE_LOW,
+	/** Free share below CONFIG_NET_PKT_PRESSURE_CRITICAL_PERCENT */
+	NET_PKT_MEM_PRESSURE_CRITICAL,
+};
+
+/**
+ * @brief Get the memory pressure of the predefined RX pools.
+ *
+ * @details The level is computed from the free share of the RX packet
+ * slab and, if CONFIG_NET_BUF_POOL_USAGE is enabled, of the RX data
+ * pool, whichever is lower.
+ *
+ * @return Current memory pressure level.
+ */
+#if defined(CONFIG_NET_CONTEXT_RCVBUF)
+enum net_pkt_mem_pressure net_pkt_mem_pressure(void);
+#else
+static inline enum net_pkt_mem_pressure net_pkt_mem_pressure(void)
+{
+	return NET_PKT_MEM_PRESSURE_NONE;
+}
+#endif
+
 /**
  * @brief Get information about predefined RX, TX and DATA pools.
  *
@@ -182,6 +182,20 @@ struct net_stats_udp {
 	net_stats_t chkerr;
 };
 
+/**
+ * @brief Socket buffer statistics
+ */
+struct net_stats_sock_buf {
+	/** Number of datagrams dropped because the receive buffer was full. */
+	net_stats_t rcvbuf_drop;
+
+	/** Number of datagrams dropped because of RX memory pressure. */
+	net_stats_t pressure_drop;
+
+	/** Number of sends deferred because the send buffer was full. */
+	net_stats_t sndbuf_full;
+};
+
 /**
  * @brief IPv6 neighbor discovery statistics
  */
@@ -189,6 +203,18 @@ struct net_stats_ipv6_nd {
 	net_stats_t drop;
 	net_stats_t recv;
 	net_stats_t sent;
+
+	/** Number of sent packets whose neighbor was found in the cache */
+	net_stats_t nbr_hit;
+
+	/** Number of sent packets whose neighbor was not in the cache */
+	net_stats_t nbr_miss;
+
+	/** Number of sent packets whose neighbor was cached in the context */
+	net_stats_t nbr_ctx_hit;
+
+	/** Number of neighbors removed to make room for a new one */
+	net_stats_t nbr_evicted;
 };
 
 /**
@@ -327,6 +353,11 @@ struct net_stats {
 	struct net_stats_udp udp;
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_SOCKET_BUF)
+	/** Socket buffer statistics */
+	struct net_stats_sock_buf sock_buf;
+#endif
+
 #if defined(CONFIG_NET_STATISTICS_IPV6_ND)
 	/** IPv6 neighbor discovery statistics */
 	struct net_stats_ipv6_nd ipv6_nd;
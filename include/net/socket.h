@@ -27,6 +27,7 @@
 #include <net/net_ip.h>
 #include <net/dns_resolve.h>
 #include <net/socket_select.h>
+#include <net/socket_epoll.h>
 #include <stdlib.h>
 
 #ifdef __cplusplus
@@ -39,6 +40,25 @@ struct zsock_pollfd {
 	short revents;
 };
 
+/** Message used by zsock_recvmmsg() and zsock_sendmmsg() */
+struct zsock_mmsghdr {
+	struct msghdr msg_hdr; /* message header */
+	unsigned int msg_len;  /* bytes transferred, set by the call */
+};
+
+/** Ancillary data of IP_PKTINFO */
+struct in_pktinfo {
+	unsigned int   ipi_ifindex;  /* interface index */
+	struct in_addr ipi_spec_dst; /* local address */
+	struct in_addr ipi_addr;     /* destination address of the header */
+};
+
+/** Ancillary data of IPV6_PKTINFO */
+struct in6_pktinfo {
+	struct in6_addr ipi6_addr;    /* destination address */
+	unsigned int    ipi6_ifindex; /* interface index */
+};
+
 /* ZSOCK_POLL* values are compatible with Linux */
 /** zsock_poll: Poll for readability */
 #define ZSOCK_POLLIN 1
@@ -55,6 +75,10 @@ struct zsock_pollfd {
 
 /** zsock_recv: Read data without removing it from socket input queue */
 #define ZSOCK_MSG_PEEK 0x02
+/** zsock_recvmsg: Ancillary data was discarded for lack of space in the
+ *  control buffer (output value only)
+ */
+#define ZSOCK_MSG_CTRUNC 0x08
 /** zsock_recv: return the real length of the datagram, even when it was longer
  *  than the passed buffer
  */
@@ -63,6 +87,8 @@ struct zsock_pollfd {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: block for the first datagram only */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 
 /* Well-known values, e.g. from Linux man 2 shutdown:
  * "The constants SHUT_RD, SHUT_WR, SHUT_RDWR have the value 0, 1, 2,
@@ -396,6 +422,102 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
 				 int flags, struct sockaddr *src_addr,
 				 socklen_t *addrlen);
 
+/**
+ * @brief Receive a message from a socket
+ *
+ * @details
+ * @rst
+ * See `POSIX.1-2017 article
+ * <http://pubs.opengroup.org/onlinepubs/9699919799/functions/recvmsg.html>`__
+ * for normative description. For datagram sockets, ancillary data enabled
+ * with the ``IP_PKTINFO``, ``IP_RECVTOS``, ``IPV6_RECVPKTINFO``,
+ * ``IPV6_RECVTCLASS`` and ``SO_TIMESTAMPNS`` socket options is returned in
+ * ``msg_control``.
+ * This function is also exposed as ``recvmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+__syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
+
+/**
+ * @brief Receive multiple messages from a socket
+ *
+ * @details
+ * @rst
+ * See `Linux man page <https://man7.org/linux/man-pages/man2/recvmmsg.2.html>`__
+ * for a description. The socket is looked up and locked only once for
+ * the whole batch. Unlike Linux, there is no timeout argument: with
+ * ``ZSOCK_MSG_WAITFORONE`` only the first message waits for data, the
+ * following ones are collected if they are already queued.
+ * This function is also exposed as ``recvmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of messages received or -1 with errno set if none was
+ */
+__syscall int zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Send multiple messages on a socket
+ *
+ * @details
+ * @rst
+ * See `Linux man page <https://man7.org/linux/man-pages/man2/sendmmsg.2.html>`__
+ * for a description. The socket is looked up and locked only once for
+ * the whole batch.
+ * This function is also exposed as ``sendmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of messages sent or -1 with errno set if none was
+ */
+__syscall int zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+struct net_buf;
+
+/**
+ * @brief Receive data from a socket without copying it
+ *
+ * @details
+ * @rst
+ * Like zsock_recvfrom(), but the network buffers holding the payload are
+ * handed to the caller in ``*buf`` instead of being copied. A datagram
+ * socket returns one whole datagram, a stream socket the data of the next
+ * received segment. The caller owns the chain and must release it with
+ * ``net_buf_unref()``, the buffers are taken from the receive pool until
+ * then. Only ``ZSOCK_MSG_DONTWAIT`` is supported in ``flags``. Not
+ * available from user mode.
+ * @endrst
+ *
+ * @return Length of the chain, 0 at the end of a stream (``*buf`` is then
+ *         NULL), or -1 with errno set
+ */
+ssize_t zsock_recvfrom_zc(int sock, struct net_buf **buf, int flags,
+			  struct sockaddr *src_addr, socklen_t *addrlen);
+
+/**
+ * @brief Send a buffer chain on a socket without copying it
+ *
+ * @details
+ * @rst
+ * Like zsock_sendto(), but the data of ``buf`` is linked into the outgoing
+ * packet instead of being copied. The stack takes its own reference to the
+ * chain, the caller releases its reference with ``net_buf_unref()``
+ * whether the call succeeded or not. After a successful call the data must
+ * not be modified anymore. A NULL ``dest_addr`` sends to the connected
+ * peer. The whole chain is sent, datagrams are not truncated. Not
+ * available from user mode.
+ * @endrst
+ *
+ * @return Number of bytes sent or -1 with errno set
+ */
+ssize_t zsock_sendto_zc(int sock, struct net_buf *buf, int flags,
+			const struct sockaddr *dest_addr, socklen_t addrlen);
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -734,6 +856,28 @@ static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg(sock, msg, flags);
+}
+
+#define mmsghdr zsock_mmsghdr
+
+/* The timeout is not supported, use MSG_WAITFORONE or SO_RCVTIMEO */
+static inline int recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags, void *timeout)
+{
+	ARG_UNUSED(timeout);
+
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
+static inline int sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
 	return zsock_poll(fds, nfds, timeout);
@@ -807,9 +951,11 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define POLLNVAL ZSOCK_POLLNVAL
 
 #define MSG_PEEK ZSOCK_MSG_PEEK
+#define MSG_CTRUNC ZSOCK_MSG_CTRUNC
 #define MSG_TRUNC ZSOCK_MSG_TRUNC
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
 
 #define SHUT_RD ZSOCK_SHUT_RD
 #define SHUT_WR ZSOCK_SHUT_WR
@@ -852,14 +998,16 @@ struct ifreq {
 /** sockopt: Transmission of broadcast messages is supported (ignored, for compatibility) */
 #define SO_BROADCAST 6
 
-/** sockopt: Size of socket socket send buffer (ignored, for compatibility) */
+/** sockopt: Size of socket send buffer in bytes */
 #define SO_SNDBUF 7
+/** sockopt: Size of socket receive buffer in bytes */
+#define SO_RCVBUF 8
 
 /** sockopt: Enable sending keep-alive messages on connections (ignored, for compatibility) */
 #define SO_KEEPALIVE 9
 /** sockopt: Place out-of-band data into receive stream (ignored, for compatibility) */
 #define SO_OOBINLINE 10
-/** sockopt: Allow multiple sockets to reuse a single port (ignored, for compatibility) */
+/** sockopt: Allow multiple sockets to reuse a single port */
 #define SO_REUSEPORT 15
 
 /**
@@ -876,6 +1024,13 @@ struct ifreq {
 /** sockopt: Socket accepts incoming connections (ignored, for compatibility) */
 #define SO_ACCEPTCONN 30
 
+/**
+ * sockopt: Receive the RX timestamp of datagrams with recvmsg(), the
+ * ancillary data is a struct net_ptp_time
+ */
+#define SO_TIMESTAMPNS 35
+#define SCM_TIMESTAMPNS SO_TIMESTAMPNS
+
 /** sockopt: Timestamp TX packets */
 #define SO_TIMESTAMPING 37
 /** sockopt: Protocol used with the socket */
@@ -889,10 +1044,28 @@ struct ifreq {
 /* Socket options for IPPROTO_TCP level */
 /** sockopt: Disable TCP buffering (ignored, for compatibility) */
 #define TCP_NODELAY 1
+/** sockopt: Name of the TCP congestion control algorithm */
+#define TCP_CONGESTION 13
+
+/* Socket options for IPPROTO_IP level */
+/** Ancillary data: type of service of a received datagram (uint8_t) */
+#define IP_TOS 1
+/** sockopt: Receive struct in_pktinfo ancillary data with recvmsg() */
+#define IP_PKTINFO 8
+/** sockopt: Receive IP_TOS ancillary data with recvmsg() */
+#define IP_RECVTOS 13
 
 /* Socket options for IPPROTO_IPV6 level */
 /** sockopt: Don't support IPv4 access (ignored, for compatibility) */
 #define IPV6_V6ONLY 26
+/** sockopt: Receive IPV6_PKTINFO ancillary data with recvmsg() */
+#define IPV6_RECVPKTINFO 49
+/** Ancillary data: struct in6_pktinfo of a received datagram */
+#define IPV6_PKTINFO 50
+/** sockopt: Receive IPV6_TCLASS ancillary data with recvmsg() */
+#define IPV6_RECVTCLASS 66
+/** Ancillary data: traffic class of a received datagram (int) */
+#define IPV6_TCLASS 67
 
 /** sockopt: Socket priority */
 #define SO_PRIORITY 12
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#include <toolchain.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Event bits, values match the ZSOCK_POLL* ones */
+#define ZSOCK_EPOLLIN      0x001
+#define ZSOCK_EPOLLOUT     0x004
+#define ZSOCK_EPOLLERR     0x008
+#define ZSOCK_EPOLLHUP     0x010
+
+/** Report the event once, when the socket becomes ready */
+#define ZSOCK_EPOLLONESHOT (1U << 30)
+/** Report only transitions to the ready state (edge triggered) */
+#define ZSOCK_EPOLLET      (1U << 31)
+
+/* Operations for zsock_epoll_ctl() */
+#define ZSOCK_EPOLL_CTL_ADD 1
+#define ZSOCK_EPOLL_CTL_DEL 2
+#define ZSOCK_EPOLL_CTL_MOD 3
+
+union zsock_epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+};
+
+struct zsock_epoll_event {
+	uint32_t events;
+	union zsock_epoll_data data;
+};
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @details
+ * @rst
+ * An epoll instance keeps a persistent set of sockets together with
+ * the list of the ones which are ready, so that waiting costs in
+ * proportion to the number of ready sockets and not to the number of
+ * watched ones, as is the case with :c:func:`zsock_poll()`. Only native
+ * (non-TLS, non-offloaded) sockets can be added to the set.
+ * The returned descriptor is itself pollable and must be closed with
+ * :c:func:`zsock_close()`.
+ * This function is also exposed as ``epoll_create1()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @param flags Must be 0
+ *
+ * @return Epoll file descriptor or -1 with errno set
+ */
+__syscall int zsock_epoll_create(int flags);
+
+/**
+ * @brief Add, modify or remove a socket of an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux man page <https://man7.org/linux/man-pages/man2/epoll_ctl.2.html>`__
+ * for a description of the semantics. ``ZSOCK_EPOLLHUP`` is always
+ * reported. Native sockets have no error state, so ``ZSOCK_EPOLLERR`` is
+ * accepted but never reported, as with :c:func:`zsock_poll()`. A socket
+ * is removed from all the instances it belongs to when it is closed.
+ * This function is also exposed as ``epoll_ctl()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @param epfd Epoll file descriptor
+ * @param op One of ZSOCK_EPOLL_CTL_ADD, ZSOCK_EPOLL_CTL_MOD or
+ *        ZSOCK_EPOLL_CTL_DEL
+ * @param fd Socket
+ * @param event Requested events and user data, ignored for
+ *        ZSOCK_EPOLL_CTL_DEL
+ *
+ * @return 0 on success or -1 with errno set
+ */
+__syscall int zsock_epoll_ctl(int epfd, int op, int fd,
+			      struct zsock_epoll_event *event);
+
+/**
+ * @brief Wait for events on an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux man page <https://man7.org/linux/man-pages/man2/epoll_wait.2.html>`__
+ * for a description of the semantics. Closing the epoll descriptor
+ * wakes up the threads waiting on it, which then fail with ``EBADF``.
+ * This function is also exposed as ``epoll_wait()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @param epfd Epoll file descriptor
+ * @param events Array where the ready events are stored
+ * @param maxevents Size of the array, must be greater than 0
+ * @param timeout Timeout in milliseconds, -1 waits forever
+ *
+ * @return Number of ready sockets, 0 on timeout or -1 with errno set
+ */
+__syscall int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			       int maxevents, int timeout);
+
+#ifdef CONFIG_NET_SOCKETS_POSIX_NAMES
+
+#define EPOLLIN ZSOCK_EPOLLIN
+#define EPOLLOUT ZSOCK_EPOLLOUT
+#define EPOLLERR ZSOCK_EPOLLERR
+#define EPOLLHUP ZSOCK_EPOLLHUP
+#define EPOLLONESHOT ZSOCK_EPOLLONESHOT
+#define EPOLLET ZSOCK_EPOLLET
+
+#define EPOLL_CTL_ADD ZSOCK_EPOLL_CTL_ADD
+#define EPOLL_CTL_DEL ZSOCK_EPOLL_CTL_DEL
+#define EPOLL_CTL_MOD ZSOCK_EPOLL_CTL_MOD
+
+#define epoll_data_t union zsock_epoll_data
+#define epoll_event zsock_epoll_event
+
+static inline int epoll_create1(int flags)
+{
+	return zsock_epoll_create(flags);
+}
+
+static inline int epoll_ctl(int epfd, int op, int fd,
+			    struct zsock_epoll_event *event)
+{
+	return zsock_epoll_ctl(epfd, op, fd, event);
+}
+
+static inline int epoll_wait(int epfd, struct zsock_epoll_event *events,
+			     int maxevents, int timeout)
+{
+	return zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+
+#endif /* CONFIG_NET_SOCKETS_POSIX_NAMES */
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <syscalls/socket_epoll.h>
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_ */
@@ -32,6 +32,17 @@ struct z_spinlock_key {
 	int key;
 };
 
+#ifdef CONFIG_SPINLOCK_MCS
+/* Queue node of a CPU waiting for or holding an MCS spinlock */
+struct z_spin_mcs_node {
+	/* Next CPU in the queue */
+	atomic_ptr_t next;
+
+	/* Cleared by the previous holder when the lock is handed over */
+	atomic_t wait;
+};
+#endif
+
 /**
  * @brief Kernel Spin Lock
  *
@@ -40,7 +51,15 @@ struct z_spinlock_key {
  * application code.
  */
 struct k_spinlock {
-#ifdef CONFIG_SMP
+#if defined(CONFIG_SPINLOCK_TICKET)
+	/* Ticket of the next CPU to take the lock, and ticket served */
+	atomic_t next;
+	atomic_t owner;
+#elif defined(CONFIG_SPINLOCK_MCS)
+	/* Last CPU in the queue, and queue node of the holder */
+	atomic_ptr_t tail;
+	struct z_spin_mcs_node *holder;
+#elif defined(CONFIG_SMP)
 	atomic_t locked;
 #endif
 
@@ -86,6 +105,48 @@ bool z_spin_lock_mem_coherent(struct k_spinlock *l);
 
 #endif /* CONFIG_SPIN_VALIDATE */
 
+#ifdef CONFIG_SPINLOCK_MCS
+void z_spin_mcs_lock(struct k_spinlock *l);
+void z_spin_mcs_unlock(struct k_spinlock *l);
+#endif
+
+#ifdef CONFIG_SMP
+/* Internal function: waits until the lock is free and takes it */
+static ALWAYS_INLINE void z_spin_acquire(struct k_spinlock *l)
+{
+#if defined(CONFIG_SPINLOCK_TICKET)
+	atomic_val_t ticket = atomic_inc(&l->next);
+
+	while (atomic_get(&l->owner) != ticket) {
+	}
+#elif defined(CONFIG_SPINLOCK_MCS)
+	z_spin_mcs_lock(l);
+#else
+	while (!atomic_cas(&l->locked, 0, 1)) {
+	}
+#endif
+}
+
+/* Internal function: frees the lock for the next CPU */
+static ALWAYS_INLINE void z_spin_drop(struct k_spinlock *l)
+{
+#if defined(CONFIG_SPINLOCK_TICKET)
+	atomic_inc(&l->owner);
+#elif defined(CONFIG_SPINLOCK_MCS)
+	z_spin_mcs_unlock(l);
+#else
+	/* Strictly we don't need atomic_clear() here (which is an
+	 * exchange operation that returns the old value).  We are always
+	 * setting a zero and (because we hold the lock) know the existing
+	 * state won't change due to a race.  But some architectures need
+	 * a memory barrier when used like this, and we don't have a
+	 * Zephyr framework for that.
+	 */
+	atomic_clear(&l->locked);
+#endif
+}
+#endif /* CONFIG_SMP */
+
 /**
  * @brief Spinlock key type
  *
@@ -146,8 +207,7 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 #endif
 
 #ifdef CONFIG_SMP
-	while (!atomic_cas(&l->locked, 0, 1)) {
-	}
+	z_spin_acquire(l);
 #endif
 
 #ifdef CONFIG_SPIN_VALIDATE
@@ -186,14 +246,7 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 #endif
 
 #ifdef CONFIG_SMP
-	/* Strictly we don't need atomic_clear() here (which is an
-	 * exchange operation that returns the old value).  We are always
-	 * setting a zero and (because we hold the lock) know the existing
-	 * state won't change due to a race.  But some architectures need
-	 * a memory barrier when used like this, and we don't have a
-	 * Zephyr framework for that.
-	 */
-	atomic_clear(&l->locked);
+	z_spin_drop(l);
 #endif
 	arch_irq_unlock(key.key);
 }
@@ -208,7 +261,7 @@ static ALWAYS_INLINE void k_spin_release(struct k_spinlock *l)
 	__ASSERT(z_spin_unlock_valid(l), "Not my spinlock %p", l);
 #endif
 #ifdef CONFIG_SMP
-	atomic_clear(&l->locked);
+	z_spin_drop(l);
 #endif
 }
 
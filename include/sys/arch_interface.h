@@ -437,6 +437,18 @@ static inline struct _cpu *arch_curr_cpu(void);
  * This will invoke z_sched_ipi() on other CPUs in the system.
  */
 void arch_sched_ipi(void);
+
+#ifdef CONFIG_SCHED_IPI_DIRECTED
+/**
+ * Send an interrupt to a subset of CPUs
+ *
+ * Like arch_sched_ipi(), but only the CPUs whose bits are set in
+ * @a cpu_bitmap will invoke z_sched_ipi().
+ *
+ * @param cpu_bitmap Bitmap of CPU indices to interrupt
+ */
+void arch_sched_directed_ipi(uint32_t cpu_bitmap);
+#endif
 #endif /* CONFIG_SMP */
 
 /** @} */
@@ -1180,6 +1192,58 @@ uint32_t arch_timing_freq_get_mhz(void);
 
 #endif /* CONFIG_TIMING_FUNCTIONS */
 
+#ifdef CONFIG_ARCH_HAS_CRC32
+/**
+ * @brief Update a CRC-32 with the IEEE 802.3 polynomial
+ *
+ * Runs the reflected polynomial 0xedb88320 over the data using the CRC
+ * instructions of the CPU. No inversion is applied to the input or the
+ * result, callers take care of the initial value and final XOR.
+ *
+ * @param crc Current CRC register value
+ * @param data Input bytes, no alignment required
+ * @param len Length of the input in bytes
+ *
+ * @return Updated CRC register value
+ *
+ * @see crc32_ieee_update()
+ */
+uint32_t arch_crc32_update(uint32_t crc, const uint8_t *data, size_t len);
+#endif /* CONFIG_ARCH_HAS_CRC32 */
+
+#ifdef CONFIG_ARCH_HAS_CRC32C
+/**
+ * @brief Update a CRC-32C with the Castagnoli polynomial
+ *
+ * Same as arch_crc32_update() for the reflected polynomial 0x82f63b78.
+ *
+ * @param crc Current CRC register value
+ * @param data Input bytes, no alignment required
+ * @param len Length of the input in bytes
+ *
+ * @return Updated CRC register value
+ *
+ * @see crc32_c()
+ */
+uint32_t arch_crc32c_update(uint32_t crc, const uint8_t *data, size_t len);
+#endif /* CONFIG_ARCH_HAS_CRC32C */
+
+#ifdef CONFIG_ARCH_HAS_NET_CHKSUM
+/**
+ * @brief Compute the Internet checksum of a buffer
+ *
+ * Returns the one's complement sum (RFC 1071) of the data taken as
+ * 16-bit words in native byte order, folded to 16 bits and not
+ * complemented. An odd trailing byte is padded with a zero byte.
+ *
+ * @param data Input bytes, no alignment required
+ * @param len Length of the input in bytes
+ *
+ * @return One's complement sum of the data
+ */
+uint16_t arch_net_chksum(const uint8_t *data, size_t len);
+#endif /* CONFIG_ARCH_HAS_NET_CHKSUM */
+
 #ifdef CONFIG_PCIE_MSI_MULTI_VECTOR
 
 struct msi_vector;
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file */
+
+#ifndef ZEPHYR_INCLUDE_SYS_MPMC_RING_H_
+#define ZEPHYR_INCLUDE_SYS_MPMC_RING_H_
+
+#include <kernel.h>
+#include <sys/atomic.h>
+#include <sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup mpmc_ring_apis Multi producer, multi consumer ring APIs
+ * @ingroup datastructure_apis
+ * @{
+ */
+
+/**
+ * @brief Lock-free bounded ring of fixed size elements for any number of
+ * producers and consumers.
+ *
+ * Producers and consumers claim an element by advancing the head or tail
+ * index with a compare and swap, every element carries a sequence number
+ * telling whether it is free or holds data for the current lap around
+ * the ring. Nothing ever waits for a lock, a put or get only retries when
+ * another one claimed the same element first.
+ */
+struct sys_mpmc_ring {
+	/** Next element to put */
+	atomic_t head __aligned(CONFIG_LOCKFREE_RING_ALIGN);
+
+	/** Next element to get */
+	atomic_t tail __aligned(CONFIG_LOCKFREE_RING_ALIGN);
+
+	/** Element storage, see SYS_MPMC_RING_BUF_SIZE() */
+	atomic_t *buffer __aligned(CONFIG_LOCKFREE_RING_ALIGN);
+
+	/** Element size in bytes */
+	size_t elem_size;
+
+	/** Number of elements minus one */
+	uint32_t mask;
+
+	/** Number of consumers waiting for an element */
+	atomic_t waiters;
+
+	/** Given by the producers while consumers wait */
+	struct k_sem sem;
+};
+
+/**
+ * @brief Storage needed for a ring, in atomic_t units.
+ *
+ * Every element is preceded by its sequence number.
+ *
+ * @param elem_size Element size in bytes.
+ * @param num_elems Number of elements.
+ */
+#define SYS_MPMC_RING_BUF_SIZE(elem_size, num_elems) \
+	((1 + DIV_ROUND_UP((elem_size), sizeof(atomic_t))) * (num_elems))
+
+/**
+ * @brief Statically define and initialize a ring.
+ *
+ * @param name Name of the ring.
+ * @param _elem_size Element size in bytes.
+ * @param num_elems Number of elements, must be a power of two and at
+ *                  least 2.
+ */
+#define SYS_MPMC_RING_DEFINE(name, _elem_size, num_elems)		\
+	BUILD_ASSERT((num_elems) >= 2 &&				\
+		     ((num_elems) & ((num_elems) - 1)) == 0,		\
+		     "Number of elements must be a power of two >= 2");	\
+	static atomic_t _mpmc_ring_buf_##name[				\
+		SYS_MPMC_RING_BUF_SIZE(_elem_size, num_elems)];		\
+	struct sys_mpmc_ring name = {					\
+		.buffer = _mpmc_ring_buf_##name,			\
+		.elem_size = (_elem_size),				\
+		.mask = (num_elems) - 1,				\
+		.sem = Z_SEM_INITIALIZER(name.sem, 0, (num_elems)),	\
+	}
+
+/**
+ * @brief Initialize a ring.
+ *
+ * @param ring Ring to initialize.
+ * @param buffer Storage of SYS_MPMC_RING_BUF_SIZE() atomic_t.
+ * @param elem_size Element size in bytes.
+ * @param num_elems Number of elements, must be a power of two and at
+ *                  least 2.
+ */
+void sys_mpmc_ring_init(struct sys_mpmc_ring *ring, atomic_t *buffer,
+			size_t elem_size, uint32_t num_elems);
+
+/**
+ * @brief Put an element into the ring.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param ring Ring.
+ * @param data Element to copy into the ring.
+ *
+ * @retval 0 Element put.
+ * @retval -EAGAIN The ring is full.
+ */
+int sys_mpmc_ring_put(struct sys_mpmc_ring *ring, const void *data);
+
+/**
+ * @brief Get the oldest element from the ring.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param ring Ring.
+ * @param data Where to copy the element.
+ *
+ * @retval 0 Element copied.
+ * @retval -EAGAIN The ring is empty.
+ */
+int sys_mpmc_ring_get(struct sys_mpmc_ring *ring, void *data);
+
+/**
+ * @brief Get the oldest element, waiting for one if the ring is empty.
+ *
+ * Not from an ISR unless @a timeout is K_NO_WAIT. Producers only wake
+ * consumers up while some wait, a put into a ring nobody waits for stays
+ * lock-free.
+ *
+ * @param ring Ring.
+ * @param data Where to copy the element.
+ * @param timeout Waiting period, or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @retval 0 Element copied.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int sys_mpmc_ring_get_wait(struct sys_mpmc_ring *ring, void *data,
+			   k_timeout_t timeout);
+
+#if defined(CONFIG_POLL) || defined(__DOXYGEN__)
+/**
+ * @brief Prepare a poll event that is ready when the ring has elements.
+ *
+ * Lets a consumer wait for the ring together with other objects in
+ * k_poll(). The event is ready right away if the ring already has
+ * elements. sys_mpmc_ring_poll_finish() must be called once k_poll()
+ * returns, after which elements can be taken with sys_mpmc_ring_get().
+ * Another consumer may have taken them first.
+ *
+ * @param ring Ring.
+ * @param event Event to initialize.
+ */
+void sys_mpmc_ring_poll_prepare(struct sys_mpmc_ring *ring,
+				struct k_poll_event *event);
+
+/**
+ * @brief Finish waiting for a ring with k_poll().
+ *
+ * @param ring Ring.
+ */
+void sys_mpmc_ring_poll_finish(struct sys_mpmc_ring *ring);
+#endif /* CONFIG_POLL */
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_MPMC_RING_H_ */
@@ -11,7 +11,7 @@
  * sys_mutex behaves almost exactly like k_mutex, with the added advantage
  * that a sys_mutex instance can reside in user memory.
  *
- * Further enhancements will support locking/unlocking uncontended sys_mutexes
+ * With CONFIG_SYS_MUTEX_FAST, uncontended sys_mutexes are locked/unlocked
  * with simple atomic ops instead of syscalls, similar to Linux's
  * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI
  */
@@ -25,10 +25,13 @@ extern "C" {
 #include <zephyr/types.h>
 #include <sys_clock.h>
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+#include <kernel.h>
+#endif
+
 struct sys_mutex {
-	/* Currently unused, but will be used to store state for fast mutexes
-	 * that can be locked/unlocked with atomic ops if there is no
-	 * contention
+	/* 0 if unlocked, the owner thread if locked with atomic ops, odd if
+	 * the kernel side k_mutex is in use, see lib/os/mutex.c
 	 */
 	atomic_t val;
 };
@@ -101,7 +104,11 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  */
 static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST
+	if (atomic_cas(&mutex->val, 0, (atomic_val_t)k_current_get())) {
+		return 0;
+	}
+#endif
 	return z_sys_mutex_kernel_lock(mutex, timeout);
 }
 
@@ -124,7 +131,11 @@ static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
  */
 static inline int sys_mutex_unlock(struct sys_mutex *mutex)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST
+	if (atomic_cas(&mutex->val, (atomic_val_t)k_current_get(), 0)) {
+		return 0;
+	}
+#endif
 	return z_sys_mutex_kernel_unlock(mutex);
 }
 
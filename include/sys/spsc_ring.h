@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file */
+
+#ifndef ZEPHYR_INCLUDE_SYS_SPSC_RING_H_
+#define ZEPHYR_INCLUDE_SYS_SPSC_RING_H_
+
+#include <kernel.h>
+#include <sys/atomic.h>
+#include <sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup spsc_ring_apis Single producer, single consumer ring APIs
+ * @ingroup datastructure_apis
+ * @{
+ */
+
+/**
+ * @brief Lock-free ring of fixed size elements for one producer and one
+ * consumer.
+ *
+ * The producer only writes the head index and the consumer only writes
+ * the tail index, so neither side takes a lock and the two can run on
+ * different CPUs, or in an ISR and a thread, at the same time. Each side
+ * caches the index of the other and only reads it again when the cached
+ * value says the ring is full or empty.
+ *
+ * There must never be more than one producer or more than one consumer
+ * at a time, see @ref mpmc_ring_apis otherwise.
+ */
+struct sys_spsc_ring {
+	/** Next element to put, only written by the producer */
+	atomic_t head __aligned(CONFIG_LOCKFREE_RING_ALIGN);
+
+	/** Tail last seen by the producer */
+	uint32_t tail_cache;
+
+	/** Next element to get, only written by the consumer */
+	atomic_t tail __aligned(CONFIG_LOCKFREE_RING_ALIGN);
+
+	/** Head last seen by the consumer */
+	uint32_t head_cache;
+
+	/** Element storage */
+	uint8_t *buffer __aligned(CONFIG_LOCKFREE_RING_ALIGN);
+
+	/** Element size in bytes */
+	size_t elem_size;
+
+	/** Number of elements minus one */
+	uint32_t mask;
+
+	/** Number of consumers waiting for an element */
+	atomic_t waiters;
+
+	/** Given by the producer while a consumer waits */
+	struct k_sem sem;
+};
+
+/**
+ * @brief Statically define and initialize a ring.
+ *
+ * @param name Name of the ring.
+ * @param _elem_size Element size in bytes.
+ * @param num_elems Number of elements, must be a power of two.
+ */
+#define SYS_SPSC_RING_DEFINE(name, _elem_size, num_elems)		\
+	BUILD_ASSERT((num_elems) != 0 &&				\
+		     ((num_elems) & ((num_elems) - 1)) == 0,		\
+		     "Number of elements must be a power of two");	\
+	static uint8_t __aligned(sizeof(void *))			\
+		_spsc_ring_buf_##name[(_elem_size) * (num_elems)];	\
+	struct sys_spsc_ring name = {					\
+		.buffer = _spsc_ring_buf_##name,			\
+		.elem_size = (_elem_size),				\
+		.mask = (num_elems) - 1,				\
+		.sem = Z_SEM_INITIALIZER(name.sem, 0, (num_elems)),	\
+	}
+
+/**
+ * @brief Initialize a ring.
+ *
+ * @param ring Ring to initialize.
+ * @param buffer Storage for @a num_elems elements.
+ * @param elem_size Element size in bytes.
+ * @param num_elems Number of elements, must be a power of two.
+ */
+void sys_spsc_ring_init(struct sys_spsc_ring *ring, void *buffer,
+			size_t elem_size, uint32_t num_elems);
+
+/**
+ * @brief Claim the next free element, to be filled in place.
+ *
+ * Only for the producer. The element is put with
+ * sys_spsc_ring_put_finish().
+ *
+ * @param ring Ring.
+ *
+ * @return Address of the element, NULL if the ring is full.
+ */
+void *sys_spsc_ring_put_claim(struct sys_spsc_ring *ring);
+
+/**
+ * @brief Put the element returned by sys_spsc_ring_put_claim().
+ *
+ * @funcprops \isr_ok
+ *
+ * @param ring Ring.
+ */
+void sys_spsc_ring_put_finish(struct sys_spsc_ring *ring);
+
+/**
+ * @brief Put an element into the ring.
+ *
+ * Only for the producer.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param ring Ring.
+ * @param data Element to copy into the ring.
+ *
+ * @retval 0 Element put.
+ * @retval -EAGAIN The ring is full.
+ */
+int sys_spsc_ring_put(struct sys_spsc_ring *ring, const void *data);
+
+/**
+ * @brief Claim the oldest element, to be read in place.
+ *
+ * Only for the consumer. The element is released with
+ * sys_spsc_ring_get_finish().
+ *
+ * @param ring Ring.
+ *
+ * @return Address of the element, NULL if the ring is empty.
+ */
+void *sys_spsc_ring_get_claim(struct sys_spsc_ring *ring);
+
+/**
+ * @brief Release the element returned by sys_spsc_ring_get_claim().
+ *
+ * @param ring Ring.
+ */
+void sys_spsc_ring_get_finish(struct sys_spsc_ring *ring);
+
+/**
+ * @brief Get the oldest element from the ring.
+ *
+ * Only for the consumer.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param ring Ring.
+ * @param data Where to copy the element.
+ *
+ * @retval 0 Element copied.
+ * @retval -EAGAIN The ring is empty.
+ */
+int sys_spsc_ring_get(struct sys_spsc_ring *ring, void *data);
+
+/**
+ * @brief Get the oldest element, waiting for one if the ring is empty.
+ *
+ * Only for the consumer, and not from an ISR unless @a timeout is
+ * K_NO_WAIT. The producer only wakes the consumer up while it waits, a
+ * put into a ring nobody waits for stays lock-free.
+ *
+ * @param ring Ring.
+ * @param data Where to copy the element.
+ * @param timeout Waiting period, or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @retval 0 Element copied.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int sys_spsc_ring_get_wait(struct sys_spsc_ring *ring, void *data,
+			   k_timeout_t timeout);
+
+#if defined(CONFIG_POLL) || defined(__DOXYGEN__)
+/**
+ * @brief Prepare a poll event that is ready when the ring has elements.
+ *
+ * Lets the consumer wait for the ring together with other objects in
+ * k_poll(). The event is ready right away if the ring already has
+ * elements. sys_spsc_ring_poll_finish() must be called once k_poll()
+ * returns, after which the elements can be taken with
+ * sys_spsc_ring_get().
+ *
+ * @param ring Ring.
+ * @param event Event to initialize.
+ */
+void sys_spsc_ring_poll_prepare(struct sys_spsc_ring *ring,
+				struct k_poll_event *event);
+
+/**
+ * @brief Finish waiting for a ring with k_poll().
+ *
+ * @param ring Ring.
+ */
+void sys_spsc_ring_poll_finish(struct sys_spsc_ring *ring);
+#endif /* CONFIG_POLL */
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_SPSC_RING_H_ */
@@ -143,6 +143,61 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes);
  */
 void sys_heap_free(struct sys_heap *heap, void *mem);
 
+#if defined(CONFIG_SYS_HEAP_SLAB) || defined(__DOXYGEN__)
+/** @brief Allocate memory from the calling CPU's size class cache
+ *
+ * Returns a chunk of the right size previously freed with
+ * sys_heap_slab_free() on this CPU, or NULL if there is none or the
+ * request is too big or needs more than chunk header alignment.  The
+ * cache has its own spinlock, so unlike the other sys_heap functions
+ * this needs no heap lock and may run concurrently with operations
+ * holding it.  Supervisor mode only.
+ *
+ * @param heap Heap from which to allocate
+ * @param align Alignment in bytes, a power of two or zero, with the
+ *              optional rewind bit of sys_heap_aligned_alloc()
+ * @param bytes Number of bytes requested
+ * @return Pointer to memory the caller can now use, or NULL
+ */
+void *sys_heap_slab_alloc(struct sys_heap *heap, size_t align, size_t bytes);
+
+/** @brief Free memory into the calling CPU's size class cache
+ *
+ * Counterpart of sys_heap_slab_alloc() with the same locking rules.
+ * The memory is kept in the cache if its size class is cached, the
+ * class is not full and the caches are not bypassed, otherwise false
+ * is returned and the memory must be freed with sys_heap_free() under
+ * the heap lock.  sys_heap_free() itself never caches memory.
+ *
+ * @param heap Heap to which to return the memory
+ * @param mem A pointer previously returned from this heap
+ * @return true if the memory was cached, false otherwise
+ */
+bool sys_heap_slab_free(struct sys_heap *heap, void *mem);
+
+/** @brief Return the memory cached by all CPUs to the heap
+ *
+ * To be called with the heap lock held, e.g. when an allocation
+ * failed and should be retried.
+ *
+ * @param heap Heap whose caches to flush
+ * @return true if any memory was returned to the heap
+ */
+bool sys_heap_slab_flush(struct sys_heap *heap);
+
+/** @brief Make sys_heap_slab_free() skip the caches
+ *
+ * To be called with the heap lock held.  While set, freed memory has
+ * to go through sys_heap_free(), e.g. so that threads waiting for
+ * memory are woken.  Memory freed into a cache before bypassing it
+ * is only returned by a following sys_heap_slab_flush().
+ *
+ * @param heap Heap whose caches to bypass
+ * @param bypass true to bypass the caches, false to use them again
+ */
+void sys_heap_slab_bypass(struct sys_heap *heap, bool bypass);
+#endif
+
 /** @brief Expand the size of an existing allocation
  *
  * Returns a pointer to a new memory region with the same contents,
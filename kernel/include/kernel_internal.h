@@ -186,6 +186,12 @@ void z_mem_domain_exit_thread(struct k_thread *thread);
  * not recommended.
  */
 extern struct k_spinlock z_mem_domain_lock;
+
+/* Make an unlocked mutex owned by another thread, which then has to unlock
+ * it with k_mutex_unlock(). Used by sys_mutex when a mutex locked in user
+ * memory gets contended.
+ */
+void z_mutex_owner_set(struct k_mutex *mutex, struct k_thread *owner);
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_GDBSTUB
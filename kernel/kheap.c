@@ -66,7 +66,18 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 {
 	int64_t now, end = sys_clock_timeout_end_calc(timeout);
 	void *ret = NULL;
-	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	k_spinlock_key_t key;
+
+#ifdef CONFIG_SYS_HEAP_SLAB
+	ret = sys_heap_slab_alloc(&h->heap, align, bytes);
+	if (ret != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
+		return ret;
+	}
+#endif
+
+	key = k_spin_lock(&h->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
 
@@ -77,12 +88,30 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 	while (ret == NULL) {
 		ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
 
+#ifdef CONFIG_SYS_HEAP_SLAB
+		/* The memory may be held in the caches of the CPUs */
+		if (ret == NULL && sys_heap_slab_flush(&h->heap)) {
+			ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
+		}
+#endif
+
 		now = sys_clock_tick_get();
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || ((end - now) <= 0)) {
 			break;
 		}
 
+#ifdef CONFIG_SYS_HEAP_SLAB
+		/* Frees must reach the heap to wake us up.  Memory cached
+		 * before the bypass took effect is flushed, try again
+		 * with it.
+		 */
+		sys_heap_slab_bypass(&h->heap, true);
+		if (sys_heap_slab_flush(&h->heap)) {
+			continue;
+		}
+#endif
+
 		if (!blocked_alloc) {
 			blocked_alloc = true;
 
@@ -117,7 +146,21 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 
 void k_heap_free(struct k_heap *h, void *mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	k_spinlock_key_t key;
+
+#ifdef CONFIG_SYS_HEAP_SLAB
+	if (sys_heap_slab_free(&h->heap, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
+		return;
+	}
+#endif
+
+	key = k_spin_lock(&h->lock);
+
+#ifdef CONFIG_SYS_HEAP_SLAB
+	/* Waiting threads only get memory freed to the heap */
+	sys_heap_slab_bypass(&h->heap, z_waitq_head(&h->wait_q) != NULL);
+#endif
 
 	sys_heap_free(&h->heap, mem);
 
@@ -14,6 +14,7 @@
 #include <ksched.h>
 #include <init.h>
 #include <sys/check.h>
+#include <string.h>
 
 /**
  * @brief Initialize kernel memory slab subsystem.
@@ -73,6 +74,160 @@ out:
 SYS_INIT(init_mem_slab_module, PRE_KERNEL_1,
 	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+/* Every CPU caches up to CONFIG_MEM_SLAB_MAGAZINE_SIZE free blocks of the
+ * slab in its magazine, so most allocs and frees only take the lock of the
+ * local magazine, which no other CPU normally touches.  Blocks move between
+ * the slab and a magazine in batches of MAGAZINE_BATCH while holding both
+ * locks, the slab lock first.  Blocks in magazines are counted in num_used
+ * of the slab, z_mem_slab_num_used_get() subtracts them.
+ *
+ * A slab out of free blocks takes back the blocks of all magazines before
+ * failing or pending.  It sets bypass before doing so, and frees then go to
+ * the slab where they wake pending threads, until the slab has free blocks
+ * again.
+ */
+#define MAGAZINE_BATCH (CONFIG_MEM_SLAB_MAGAZINE_SIZE / 2)
+
+static inline struct z_mem_slab_magazine *local_magazine(struct k_mem_slab *slab)
+{
+	/* Moving to another CPU right after reading the id is harmless, the
+	 * magazine is still protected by its lock
+	 */
+	return &slab->magazines[arch_curr_cpu()->id];
+}
+
+static inline void block_push(char **list, char *block)
+{
+	*(char **)block = *list;
+	*list = block;
+}
+
+static inline char *block_pop(char **list)
+{
+	char *block = *list;
+
+	*list = *(char **)block;
+	return block;
+}
+
+static bool magazine_alloc(struct k_mem_slab *slab, void **mem)
+{
+	struct z_mem_slab_magazine *mag = local_magazine(slab);
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+	bool ret = false;
+
+	if (mag->free_list != NULL) {
+		*mem = block_pop(&mag->free_list);
+		mag->count--;
+		ret = true;
+	}
+
+	k_spin_unlock(&mag->lock, key);
+
+	return ret;
+}
+
+static bool magazine_free(struct k_mem_slab *slab, void **mem)
+{
+	struct z_mem_slab_magazine *mag = local_magazine(slab);
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+	bool ret = false;
+
+	if (mag->count < CONFIG_MEM_SLAB_MAGAZINE_SIZE &&
+	    !atomic_get(&slab->bypass)) {
+		block_push(&mag->free_list, *mem);
+		mag->count++;
+		ret = true;
+	}
+
+	k_spin_unlock(&mag->lock, key);
+
+	return ret;
+}
+
+/* Called with the slab locked, moves a batch of free blocks of the slab
+ * to the local magazine
+ */
+static void magazine_refill(struct k_mem_slab *slab)
+{
+	struct z_mem_slab_magazine *mag = local_magazine(slab);
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+
+	while (slab->free_list != NULL && mag->count < MAGAZINE_BATCH) {
+		block_push(&mag->free_list, block_pop(&slab->free_list));
+		mag->count++;
+		slab->num_used++;
+	}
+
+	k_spin_unlock(&mag->lock, key);
+}
+
+/* Called with the slab locked, moves a batch of blocks of a full local
+ * magazine back to the slab
+ */
+static void magazine_drain(struct k_mem_slab *slab)
+{
+	struct z_mem_slab_magazine *mag = local_magazine(slab);
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+
+	while (mag->count > CONFIG_MEM_SLAB_MAGAZINE_SIZE - MAGAZINE_BATCH) {
+		block_push(&slab->free_list, block_pop(&mag->free_list));
+		mag->count--;
+		slab->num_used--;
+	}
+
+	k_spin_unlock(&mag->lock, key);
+}
+
+/* Called with the slab locked when it has no free blocks left, takes back
+ * the blocks of all magazines
+ */
+static void magazines_flush(struct k_mem_slab *slab)
+{
+	struct z_mem_slab_magazine *mag;
+	k_spinlock_key_t key;
+
+	atomic_set(&slab->bypass, 1);
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		mag = &slab->magazines[i];
+		key = k_spin_lock(&mag->lock);
+
+		while (mag->free_list != NULL) {
+			block_push(&slab->free_list,
+				   block_pop(&mag->free_list));
+			slab->num_used--;
+		}
+		mag->count = 0U;
+
+		k_spin_unlock(&mag->lock, key);
+	}
+
+	if (slab->free_list != NULL) {
+		atomic_clear(&slab->bypass);
+	}
+}
+
+uint32_t z_mem_slab_num_used_get(struct k_mem_slab *slab)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	uint32_t num_used = slab->num_used;
+
+	/* Blocks only move between the slab and the magazines with the slab
+	 * locked, allocs and frees running right now are counted or not as
+	 * without magazines
+	 */
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		num_used -= slab->magazines[i].count;
+	}
+
+	k_spin_unlock(&slab->lock, key);
+
+	return num_used;
+}
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
+
 int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 		    size_t block_size, uint32_t num_blocks)
 {
@@ -87,6 +242,10 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	slab->max_used = 0U;
 #endif
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	atomic_clear(&slab->bypass);
+	(void)memset(slab->magazines, 0, sizeof(slab->magazines));
+#endif
 
 	rc = create_free_list(slab);
 	if (rc < 0) {
@@ -103,17 +262,37 @@ out:
 
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 	int result;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	if (magazine_alloc(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+
+		return 0;
+	}
+#endif
+
+	key = k_spin_lock(&slab->lock);
+
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	if (slab->free_list == NULL) {
+		magazines_flush(slab);
+	}
+#endif
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
 		slab->free_list = *(char **)(slab->free_list);
 		slab->num_used++;
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+		magazine_refill(slab);
+#endif
+
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 		slab->max_used = MAX(slab->num_used, slab->max_used);
 #endif
@@ -147,9 +326,20 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	if (magazine_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+		return;
+	}
+#endif
+
+	key = k_spin_lock(&slab->lock);
+
 	if (slab->free_list == NULL && IS_ENABLED(CONFIG_MULTITHREADING)) {
 		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
@@ -166,6 +356,11 @@ void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 	slab->free_list = *(char **) mem;
 	slab->num_used--;
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	magazine_drain(slab);
+	atomic_clear(&slab->bypass);
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
 	k_spin_unlock(&slab->lock, key);
@@ -32,6 +32,80 @@ static inline void handle_poll_events(struct k_msgq *msgq, uint32_t state)
 }
 #endif /* CONFIG_POLL */
 
+/* Wait until no slot is reserved, before putting messages.  Writers
+ * can't wait for the commit on wait_q, where readers may be waiting at
+ * the same time while the queue is empty.  On success the lock is held
+ * again and the time spent waiting is taken off timeout, otherwise the
+ * lock has been released.
+ */
+static int reserve_wait(struct k_msgq *msgq, k_spinlock_key_t *key,
+			k_timeout_t *timeout)
+{
+	int64_t remaining, end = sys_clock_timeout_end_calc(*timeout);
+	bool waited = false;
+	int ret;
+
+	while ((msgq->flags & K_MSGQ_FLAG_RESERVED) != 0U) {
+		if (K_TIMEOUT_EQ(*timeout, K_NO_WAIT)) {
+			k_spin_unlock(&msgq->lock, *key);
+			return waited ? -EAGAIN : -EBUSY;
+		}
+
+		ret = z_pend_curr(&msgq->lock, *key, &msgq->commit_wait_q,
+				  *timeout);
+		if (ret != 0) {
+			return ret;
+		}
+
+		*key = k_spin_lock(&msgq->lock);
+		waited = true;
+
+		if (!K_TIMEOUT_EQ(*timeout, K_FOREVER)) {
+			remaining = end - sys_clock_tick_get();
+			*timeout = remaining > 0 ? Z_TIMEOUT_TICKS(remaining) :
+				   K_NO_WAIT;
+		}
+	}
+
+	return 0;
+}
+
+/* Copy num messages into the ring buffer at the write pointer */
+static void ring_write(struct k_msgq *msgq, const char *data, uint32_t num)
+{
+	size_t len = num * msgq->msg_size;
+	size_t first = MIN(len, (size_t)(msgq->buffer_end - msgq->write_ptr));
+
+	(void)memcpy(msgq->write_ptr, data, first);
+	msgq->write_ptr += first;
+	if (msgq->write_ptr == msgq->buffer_end) {
+		msgq->write_ptr = msgq->buffer_start;
+	}
+
+	if (first < len) {
+		(void)memcpy(msgq->buffer_start, data + first, len - first);
+		msgq->write_ptr = msgq->buffer_start + (len - first);
+	}
+}
+
+/* Copy num messages out of the ring buffer at the read pointer */
+static void ring_read(struct k_msgq *msgq, char *data, uint32_t num)
+{
+	size_t len = num * msgq->msg_size;
+	size_t first = MIN(len, (size_t)(msgq->buffer_end - msgq->read_ptr));
+
+	(void)memcpy(data, msgq->read_ptr, first);
+	msgq->read_ptr += first;
+	if (msgq->read_ptr == msgq->buffer_end) {
+		msgq->read_ptr = msgq->buffer_start;
+	}
+
+	if (first < len) {
+		(void)memcpy(data + first, msgq->buffer_start, len - first);
+		msgq->read_ptr = msgq->buffer_start + (len - first);
+	}
+}
+
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs)
 {
@@ -44,6 +118,7 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	msgq->used_msgs = 0;
 	msgq->flags = 0;
 	z_waitq_init(&msgq->wait_q);
+	z_waitq_init(&msgq->commit_wait_q);
 	msgq->lock = (struct k_spinlock) {};
 #ifdef CONFIG_POLL
 	sys_dlist_init(&msgq->poll_events);
@@ -96,7 +171,8 @@ int k_msgq_cleanup(struct k_msgq *msgq)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, cleanup, msgq);
 
-	CHECKIF(z_waitq_head(&msgq->wait_q) != NULL) {
+	CHECKIF(z_waitq_head(&msgq->wait_q) != NULL ||
+		z_waitq_head(&msgq->commit_wait_q) != NULL) {
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, cleanup, msgq, -EBUSY);
 
 		return -EBUSY;
@@ -125,6 +201,13 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
 
+	/* the reserved slot has to be committed first */
+	result = reserve_wait(msgq, &key, &timeout);
+	if (result != 0) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+		return result;
+	}
+
 	if (msgq->used_msgs < msgq->max_msgs) {
 		/* message queue isn't full */
 		pending_thread = z_unpend_first_thread(&msgq->wait_q);
@@ -185,6 +268,213 @@ static inline int z_vrfy_k_msgq_put(struct k_msgq *msgq, const void *data,
 #include <syscalls/k_msgq_put_mrsh.c>
 #endif
 
+int z_impl_k_msgq_put_many(struct k_msgq *msgq, const void *data, uint32_t num,
+			   k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	const char *src = data;
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	bool resched = false;
+	uint32_t count = 0U;
+	uint32_t space;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put_many, msgq, timeout);
+
+	result = reserve_wait(msgq, &key, &timeout);
+	if (result != 0) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_many, msgq, timeout,
+					       result);
+		return result;
+	}
+
+	/* give messages to waiting threads, these only exist while the
+	 * queue is empty
+	 */
+	while (count < num && msgq->used_msgs == 0U) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+
+		(void)memcpy(pending_thread->base.swap_data, src,
+			     msgq->msg_size);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		src += msgq->msg_size;
+		count++;
+		resched = true;
+	}
+
+	/* put the rest in the queue, as far as it fits */
+	space = MIN(num - count, msgq->max_msgs - msgq->used_msgs);
+	if (space > 0U) {
+		ring_write(msgq, src, space);
+		msgq->used_msgs += space;
+		count += space;
+#ifdef CONFIG_POLL
+		handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+	}
+
+	if (count > 0U || num == 0U) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_many, msgq, timeout,
+					       count);
+
+		if (resched) {
+			z_reschedule(&msgq->lock, key);
+		} else {
+			k_spin_unlock(&msgq->lock, key);
+		}
+		return count;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_many, msgq, timeout,
+					       -ENOMSG);
+
+		k_spin_unlock(&msgq->lock, key);
+		return -ENOMSG;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put_many, msgq, timeout);
+
+	/* queue is full, wait until the first message can be put */
+	_current->base.swap_data = (void *)data;
+
+	result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+	result = result == 0 ? 1 : result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_many, msgq, timeout, result);
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+					 uint32_t num, k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_READ(data, num, msgq->msg_size));
+
+	return z_impl_k_msgq_put_many(msgq, data, num, timeout);
+}
+#include <syscalls/k_msgq_put_many_mrsh.c>
+#endif
+
+int z_impl_k_msgq_reserve(struct k_msgq *msgq, void **slot)
+{
+	k_spinlock_key_t key;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_RESERVED) != 0U) {
+		result = -EBUSY;
+	} else if (msgq->used_msgs == msgq->max_msgs) {
+		result = -ENOMSG;
+	} else {
+		/* the slot stays at the write pointer, nothing else can be
+		 * put until it is committed
+		 */
+		msgq->flags |= K_MSGQ_FLAG_RESERVED;
+		*slot = msgq->write_ptr;
+		result = 0;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, reserve, msgq, result);
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_reserve(struct k_msgq *msgq, void **slot)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(slot, sizeof(*slot)));
+	/* the caller writes the message directly into the ring buffer */
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(msgq->buffer_start,
+				      msgq->buffer_end - msgq->buffer_start));
+
+	return z_impl_k_msgq_reserve(msgq, slot);
+}
+#include <syscalls/k_msgq_reserve_mrsh.c>
+#endif
+
+int z_impl_k_msgq_commit(struct k_msgq *msgq, bool send)
+{
+	struct k_thread *pending_thread = NULL;
+	k_spinlock_key_t key;
+	bool resched = false;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_RESERVED) == 0U) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_msgq, commit, msgq, -EINVAL);
+
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+
+	msgq->flags &= ~K_MSGQ_FLAG_RESERVED;
+
+	/* let in the writers waiting for the slot to be committed */
+	while ((pending_thread =
+		z_unpend_first_thread(&msgq->commit_wait_q)) != NULL) {
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		resched = true;
+	}
+
+	if (send && msgq->used_msgs == 0U) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	}
+
+	if (pending_thread != NULL) {
+		/* give message to waiting thread */
+		(void)memcpy(pending_thread->base.swap_data, msgq->write_ptr,
+			     msgq->msg_size);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		resched = true;
+	} else if (send) {
+		msgq->write_ptr += msgq->msg_size;
+		if (msgq->write_ptr == msgq->buffer_end) {
+			msgq->write_ptr = msgq->buffer_start;
+		}
+		msgq->used_msgs++;
+#ifdef CONFIG_POLL
+		handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, commit, msgq, 0);
+
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_commit(struct k_msgq *msgq, bool send)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+
+	return z_impl_k_msgq_commit(msgq, send);
+}
+#include <syscalls/k_msgq_commit_mrsh.c>
+#endif
+
 void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
@@ -281,6 +571,86 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
 #include <syscalls/k_msgq_get_mrsh.c>
 #endif
 
+int z_impl_k_msgq_get_many(struct k_msgq *msgq, void *data, uint32_t num,
+			   k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	bool resched = false;
+	uint32_t count;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get_many, msgq, timeout);
+
+	count = MIN(num, msgq->used_msgs);
+	if (count > 0U) {
+		ring_read(msgq, data, count);
+		msgq->used_msgs -= count;
+
+		/* refill the queue from threads waiting to write */
+		while (msgq->used_msgs < msgq->max_msgs) {
+			pending_thread = z_unpend_first_thread(&msgq->wait_q);
+			if (pending_thread == NULL) {
+				break;
+			}
+
+			ring_write(msgq, pending_thread->base.swap_data, 1U);
+			msgq->used_msgs++;
+			arch_thread_return_value_set(pending_thread, 0);
+			z_ready_thread(pending_thread);
+			resched = true;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_many, msgq, timeout,
+					       count);
+
+		if (resched) {
+			z_reschedule(&msgq->lock, key);
+		} else {
+			k_spin_unlock(&msgq->lock, key);
+		}
+		return count;
+	}
+
+	if (num == 0U || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		result = num == 0U ? 0 : -ENOMSG;
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_many, msgq, timeout,
+					       result);
+
+		k_spin_unlock(&msgq->lock, key);
+		return result;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get_many, msgq, timeout);
+
+	/* queue is empty, wait for one message */
+	_current->base.swap_data = data;
+
+	result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+	result = result == 0 ? 1 : result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_many, msgq, timeout, result);
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_many(struct k_msgq *msgq, void *data,
+					 uint32_t num, k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(data, num, msgq->msg_size));
+
+	return z_impl_k_msgq_get_many(msgq, data, num, timeout);
+}
+#include <syscalls/k_msgq_get_many_mrsh.c>
+#endif
+
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
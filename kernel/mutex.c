@@ -279,3 +279,19 @@ static inline int z_vrfy_k_mutex_unlock(struct k_mutex *mutex)
 }
 #include <syscalls/k_mutex_unlock_mrsh.c>
 #endif
+
+#ifdef CONFIG_SYS_MUTEX_FAST
+void z_mutex_owner_set(struct k_mutex *mutex, struct k_thread *owner)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* The caller only does this while nobody else uses the mutex */
+	if (mutex->lock_count == 0U) {
+		mutex->owner_orig_prio = owner->base.prio;
+		mutex->lock_count = 1U;
+		mutex->owner = owner;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+#endif
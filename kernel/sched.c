@@ -196,6 +196,219 @@ static ALWAYS_INLINE void z_priq_dumb_add(sys_dlist_t *pq,
 	sys_dlist_append(pq, &thread->base.qnode_dlist);
 }
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+/* Peek at the head of a run queue without regard to CPU masks */
+#if defined(CONFIG_SCHED_DUMB)
+#define _priq_run_peek		z_priq_dumb_best
+#elif defined(CONFIG_SCHED_SCALABLE)
+#define _priq_run_peek		z_priq_rb_best
+#elif defined(CONFIG_SCHED_MULTIQ)
+#define _priq_run_peek		z_priq_mq_best
+#endif
+
+static ALWAYS_INLINE bool cpu_allowed(struct k_thread *thread, int cpu)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	return (thread->base.cpu_mask & BIT(cpu)) != 0;
+#else
+	ARG_UNUSED(thread);
+	ARG_UNUSED(cpu);
+	return true;
+#endif
+}
+
+static ALWAYS_INLINE bool cpu_is_idle(int cpu)
+{
+	struct _cpu *c = &_kernel.cpus[cpu];
+
+	return (c->current == c->idle_thread) &&
+		(_priq_run_peek(&c->ready_q.runq) == NULL);
+}
+
+/* True if the thread would preempt what the CPU is running now, so
+ * that queueing it there and kicking that CPU gets it run right away
+ */
+static ALWAYS_INLINE bool runq_preempts(struct k_thread *thread, int cpu)
+{
+	struct k_thread *owner = _kernel.cpus[cpu].current;
+
+	if (owner == NULL) {
+		/* A CPU that hasn't been started yet */
+		return false;
+	}
+
+	if (z_is_idle_thread_object(owner)) {
+		return true;
+	}
+
+	return (is_preempt(owner) || is_metairq(thread)) &&
+		(z_sched_prio_cmp(thread, owner) > 0);
+}
+
+/* Picks the run queue for a thread being made runnable.  The CPU
+ * it last ran on is preferred as its cache is likely still warm,
+ * unless that CPU is busy and another permitted CPU is sitting idle.
+ * With no permitted CPU idle, the thread goes to one whose current
+ * thread it preempts (the lowest priority one if its old CPU isn't
+ * among them), so it never waits behind higher priority work while
+ * another CPU runs lower priority work.
+ */
+static int runq_select_cpu(struct k_thread *thread)
+{
+	int cpu = thread->base.runq_cpu;
+	int target = -1;
+
+	if (cpu_allowed(thread, cpu) && cpu_is_idle(cpu)) {
+		return cpu;
+	}
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (cpu_allowed(thread, i) && cpu_is_idle(i)) {
+			return i;
+		}
+	}
+
+	if (cpu_allowed(thread, cpu) && runq_preempts(thread, cpu)) {
+		return cpu;
+	}
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (!cpu_allowed(thread, i) || !runq_preempts(thread, i)) {
+			continue;
+		}
+
+		if ((target < 0) ||
+		    (z_sched_prio_cmp(_kernel.cpus[target].current,
+				      _kernel.cpus[i].current) > 0)) {
+			target = i;
+		}
+	}
+
+	if (target >= 0) {
+		return target;
+	}
+
+	if (!cpu_allowed(thread, cpu)) {
+		/* Masked off its old CPU: any permitted one will do.
+		 * A thread with an empty mask can't run anywhere, so
+		 * where it is queued doesn't matter.
+		 */
+		for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			if (cpu_allowed(thread, i)) {
+				return i;
+			}
+		}
+	}
+
+	return cpu;
+}
+
+/* Given the best thread on the local queue (or NULL), look for a
+ * better one queued on another CPU that won't otherwise be run soon,
+ * i.e. one waiting behind a thread its own CPU won't preempt for it.
+ * Threads whose own CPU was kicked to run them are left alone even
+ * when we have nothing to do; moving them would only cost cache.  A
+ * thread found this way is migrated to the local queue.
+ */
+static struct k_thread *runq_steal(struct k_thread *best)
+{
+	int me = _current_cpu->id;
+	struct k_thread *victim = NULL;
+	int victim_cpu = me;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (i == me) {
+			continue;
+		}
+
+		/* Mask-aware on SCHED_CPU_MASK: only returns threads
+		 * permitted to run on this CPU
+		 */
+		struct k_thread *t = _priq_run_best(&_kernel.cpus[i].ready_q.runq);
+
+		if (t == NULL) {
+			continue;
+		}
+
+		if ((best != NULL) && (z_sched_prio_cmp(t, best) <= 0)) {
+			continue;
+		}
+
+		if (runq_preempts(t, i)) {
+			/* Its own CPU has been kicked and will run it */
+			continue;
+		}
+
+		if (victim == NULL || z_sched_prio_cmp(t, victim) > 0) {
+			victim = t;
+			victim_cpu = i;
+		}
+	}
+
+	if (victim == NULL) {
+		return best;
+	}
+
+	_priq_run_remove(&_kernel.cpus[victim_cpu].ready_q.runq, victim);
+	victim->base.runq_cpu = me;
+	_priq_run_add(&_current_cpu->ready_q.runq, victim);
+
+	return victim;
+}
+
+static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
+{
+	return &_kernel.cpus[thread->base.runq_cpu].ready_q.runq;
+}
+
+static ALWAYS_INLINE void *curr_cpu_runq(void)
+{
+	return &arch_curr_cpu()->ready_q.runq;
+}
+
+static ALWAYS_INLINE void runq_add(struct k_thread *thread)
+{
+	thread->base.runq_cpu = runq_select_cpu(thread);
+	_priq_run_add(thread_runq(thread), thread);
+}
+
+static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
+{
+	_priq_run_remove(thread_runq(thread), thread);
+}
+
+static ALWAYS_INLINE struct k_thread *runq_best(void)
+{
+	return runq_steal(_priq_run_best(curr_cpu_runq()));
+}
+
+/* Interrupt the CPU a thread was just queued on, if it needs to
+ * reschedule to pick it up.  The local CPU reschedules on its own.
+ */
+static void runq_kick(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_IPI_SUPPORTED
+	int cpu = thread->base.runq_cpu;
+
+	if (cpu == _current_cpu->id) {
+		return;
+	}
+
+	if (!runq_preempts(thread, cpu)) {
+		/* Won't preempt; left for a CPU looking to steal */
+		return;
+	}
+
+# ifdef CONFIG_SCHED_IPI_DIRECTED
+	arch_sched_directed_ipi(BIT(cpu));
+# else
+	arch_sched_ipi();
+# endif
+#else
+	ARG_UNUSED(thread);
+#endif
+}
+#else
 static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 {
 #ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
@@ -238,6 +451,7 @@ static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
 	return _priq_run_best(curr_cpu_runq());
 }
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 
 /* _current is never in the run queue until context switch on
  * SMP configurations, see z_requeue_current()
@@ -280,6 +494,9 @@ void z_requeue_current(struct k_thread *curr)
 {
 	if (z_is_thread_queued(curr)) {
 		runq_add(curr);
+#ifdef CONFIG_SCHED_CPU_RUNQ
+		runq_kick(curr);
+#endif
 	}
 }
 
@@ -597,7 +814,9 @@ static void ready_thread(struct k_thread *thread)
 
 		queue_thread(thread);
 		update_cache(0);
-#if defined(CONFIG_SMP) &&  defined(CONFIG_SCHED_IPI_SUPPORTED)
+#if defined(CONFIG_SCHED_CPU_RUNQ)
+		runq_kick(thread);
+#elif defined(CONFIG_SMP) &&  defined(CONFIG_SCHED_IPI_SUPPORTED)
 		arch_sched_ipi();
 #endif
 	}
@@ -1030,6 +1249,9 @@ void *z_get_next_switch_handle(void *interrupted)
 			 */
 			if (z_is_thread_queued(old_thread)) {
 				runq_add(old_thread);
+#ifdef CONFIG_SCHED_CPU_RUNQ
+				runq_kick(old_thread);
+#endif
 			}
 		}
 		old_thread->switch_handle = interrupted;
@@ -1197,7 +1419,7 @@ void init_ready_q(struct _ready_q *rq)
 		}
 	};
 #elif defined(CONFIG_SCHED_MULTIQ)
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
 		sys_dlist_init(&rq->runq.queues[i]);
 	}
 #else
@@ -1207,7 +1429,7 @@ void init_ready_q(struct _ready_q *rq)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_CPU_RUNQ)
 	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
@@ -1444,7 +1666,8 @@ void z_impl_k_wakeup(k_tid_t thread)
 	z_mark_thread_as_not_suspended(thread);
 	z_ready_thread(thread);
 
-#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED) && \
+	!defined(CONFIG_SCHED_CPU_RUNQ)
 	arch_sched_ipi();
 #endif
 
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2021 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* MCS queue spinlocks.  Every CPU waiting for a lock appends its own
+ * node to the queue of the lock and spins on a flag in that node, so
+ * contended CPUs don't write a shared cache line.  Unlock clears the
+ * flag of the next node, which hands the lock over in queue order.
+ *
+ * The nodes can't live on the stack (stacks may not be coherent
+ * between CPUs), each CPU has a small pool instead.  Interrupts are
+ * masked while a spinlock is waited for or held, so the pool of a CPU
+ * is only ever touched by that CPU.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <spinlock.h>
+#include <sys/util.h>
+
+BUILD_ASSERT(CONFIG_SPINLOCK_MCS_NESTING <= 32, "Too many nodes for mask");
+
+static struct z_spin_mcs_node nodes[CONFIG_MP_NUM_CPUS]
+				   [CONFIG_SPINLOCK_MCS_NESTING];
+
+/* Nodes in use, per CPU */
+static uint32_t nodes_used[CONFIG_MP_NUM_CPUS];
+
+static struct z_spin_mcs_node *node_alloc(void)
+{
+	int cpu = _current_cpu->id;
+	int idx = find_lsb_set(~nodes_used[cpu]) - 1;
+
+	__ASSERT(idx >= 0 && idx < CONFIG_SPINLOCK_MCS_NESTING,
+		 "Too many nested spinlocks, increase "
+		 "CONFIG_SPINLOCK_MCS_NESTING");
+
+	nodes_used[cpu] |= BIT(idx);
+
+	return &nodes[cpu][idx];
+}
+
+static void node_free(struct z_spin_mcs_node *node)
+{
+	int cpu = _current_cpu->id;
+
+	nodes_used[cpu] &= ~BIT(node - nodes[cpu]);
+}
+
+void z_spin_mcs_lock(struct k_spinlock *l)
+{
+	struct z_spin_mcs_node *node = node_alloc();
+	struct z_spin_mcs_node *prev;
+
+	atomic_ptr_set(&node->next, NULL);
+	atomic_set(&node->wait, 1);
+
+	prev = atomic_ptr_set(&l->tail, node);
+	if (prev != NULL) {
+		/* Let the previous CPU know who to hand the lock to */
+		atomic_ptr_set(&prev->next, node);
+
+		while (atomic_get(&node->wait) != 0) {
+		}
+	}
+
+	l->holder = node;
+}
+
+void z_spin_mcs_unlock(struct k_spinlock *l)
+{
+	struct z_spin_mcs_node *node = l->holder;
+	struct z_spin_mcs_node *next = atomic_ptr_get(&node->next);
+
+	if (next == NULL) {
+		if (atomic_ptr_cas(&l->tail, node, NULL)) {
+			node_free(node);
+			return;
+		}
+
+		/* Another CPU queued itself but hasn't linked its node to
+		 * ours yet.
+		 */
+		do {
+			next = atomic_ptr_get(&node->next);
+		} while (next == NULL);
+	}
+
+	atomic_clear(&next->wait);
+	node_free(node);
+}
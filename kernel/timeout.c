@@ -11,10 +11,13 @@
 #include <syscall_handler.h>
 #include <drivers/timer/system_timer.h>
 #include <sys_clock.h>
+#include <sys/math_extras.h>
 
 static uint64_t curr_tick;
 
+#ifndef CONFIG_TIMEOUT_QUEUE_WHEEL
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif
 
 static struct k_spinlock timeout_lock;
 
@@ -36,6 +39,211 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+
+/* Hierarchical timing wheel.  Each level has WHEEL_SLOTS buckets
+ * covering WHEEL_BITS bits of the tick count, level 0 holding the
+ * timeouts that expire within the current WHEEL_SLOTS tick window.
+ * A timeout in a higher level is "cascaded" down when the tick count
+ * reaches the start of its bucket.  Anything beyond the top level
+ * waits on an overflow list that is rehashed at each wraparound of
+ * the top level.
+ *
+ * Here dticks holds the absolute expiry tick (truncated to its
+ * width) rather than a delta from the previous entry, so insertion
+ * and removal are O(1).  Occupancy bitmaps make finding the next
+ * expiry O(levels).  Bits are cleared lazily, so a bit may be set
+ * for an empty bucket after z_abort_timeout().
+ */
+#define WHEEL_BITS	6
+#define WHEEL_SLOTS	BIT(WHEEL_BITS)
+#define WHEEL_MASK	(WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS	CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_SPAN_BITS	(WHEEL_LEVELS * WHEEL_BITS)
+
+BUILD_ASSERT(WHEEL_SPAN_BITS < 64, "Too many timing wheel levels");
+
+static sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+static uint64_t wheel_occupied[WHEEL_LEVELS];
+static sys_dlist_t wheel_overflow = SYS_DLIST_STATIC_INIT(&wheel_overflow);
+static bool wheel_ready;
+
+static uint64_t expiry(const struct _timeout *t)
+{
+#ifdef CONFIG_TIMEOUT_64BIT
+	return (uint64_t)t->dticks;
+#else
+	return curr_tick + (int32_t)((uint32_t)t->dticks - (uint32_t)curr_tick);
+#endif
+}
+
+static void wheel_insert(struct _timeout *t)
+{
+	uint64_t exp = expiry(t);
+
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		int shift = (l + 1) * WHEEL_BITS;
+
+		if ((exp >> shift) == (curr_tick >> shift)) {
+			int slot = (exp >> (l * WHEEL_BITS)) & WHEEL_MASK;
+
+			sys_dlist_append(&wheel[l][slot], &t->node);
+			wheel_occupied[l] |= BIT64(slot);
+			return;
+		}
+	}
+
+	sys_dlist_append(&wheel_overflow, &t->node);
+}
+
+/* Tick of the next expiry or cascade, UINT64_MAX if nothing pending */
+static uint64_t wheel_next_event(void)
+{
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		int shift = l * WHEEL_BITS;
+
+		while (wheel_occupied[l] != 0U) {
+			int slot = u64_count_trailing_zeros(wheel_occupied[l]);
+			uint64_t base;
+
+			if (sys_dlist_is_empty(&wheel[l][slot])) {
+				wheel_occupied[l] &= ~BIT64(slot);
+				continue;
+			}
+
+			base = curr_tick & ~(BIT64(shift + WHEEL_BITS) - 1U);
+			return base | ((uint64_t)slot << shift);
+		}
+	}
+
+	if (!sys_dlist_is_empty(&wheel_overflow)) {
+		return ((curr_tick >> WHEEL_SPAN_BITS) + 1U) << WHEEL_SPAN_BITS;
+	}
+
+	return UINT64_MAX;
+}
+
+static void wheel_rehash(sys_dlist_t *list)
+{
+	sys_dlist_t tmp;
+	sys_dnode_t *n;
+
+	sys_dlist_init(&tmp);
+	while ((n = sys_dlist_get(list)) != NULL) {
+		sys_dlist_append(&tmp, n);
+	}
+	while ((n = sys_dlist_get(&tmp)) != NULL) {
+		wheel_insert(CONTAINER_OF(n, struct _timeout, node));
+	}
+}
+
+/* Called with curr_tick at a wheel event: move the buckets that
+ * start here down to the lower levels, highest level first.
+ */
+static void wheel_cascade(void)
+{
+	if ((curr_tick & (BIT64(WHEEL_SPAN_BITS) - 1U)) == 0U) {
+		wheel_rehash(&wheel_overflow);
+	}
+
+	for (int l = WHEEL_LEVELS - 1; l > 0; l--) {
+		int shift = l * WHEEL_BITS;
+		int slot = (curr_tick >> shift) & WHEEL_MASK;
+
+		if ((curr_tick & (BIT64(shift) - 1U)) != 0U ||
+		    (wheel_occupied[l] & BIT64(slot)) == 0U) {
+			continue;
+		}
+
+		wheel_occupied[l] &= ~BIT64(slot);
+		wheel_rehash(&wheel[l][slot]);
+	}
+}
+
+static bool tq_add(struct _timeout *to, int64_t ticks)
+{
+	uint64_t prev;
+
+	if (!wheel_ready) {
+		for (int l = 0; l < WHEEL_LEVELS; l++) {
+			for (int i = 0; i < WHEEL_SLOTS; i++) {
+				sys_dlist_init(&wheel[l][i]);
+			}
+		}
+		wheel_ready = true;
+	}
+
+	prev = wheel_next_event();
+	to->dticks = curr_tick + ticks;
+	wheel_insert(to);
+
+	return wheel_next_event() < prev;
+}
+
+static void tq_remove(struct _timeout *to)
+{
+	sys_dlist_remove(&to->node);
+}
+
+static int64_t tq_first_ticks(void)
+{
+	uint64_t ev = wheel_next_event();
+
+	return ev == UINT64_MAX ? -1 : (int64_t)(ev - curr_tick);
+}
+
+static int64_t tq_remaining(const struct _timeout *to)
+{
+	return expiry(to) - curr_tick;
+}
+
+/* Returns the next timeout due within announce_remaining ticks,
+ * already removed from the wheel, advancing curr_tick to its expiry.
+ */
+static struct _timeout *tq_expire_next(void)
+{
+	if (!wheel_ready) {
+		return NULL;
+	}
+
+	for (;;) {
+		int slot = curr_tick & WHEEL_MASK;
+		sys_dnode_t *n = NULL;
+		uint64_t ev;
+
+		if ((wheel_occupied[0] & BIT64(slot)) != 0U) {
+			n = sys_dlist_get(&wheel[0][slot]);
+			if (n == NULL) {
+				wheel_occupied[0] &= ~BIT64(slot);
+			}
+		}
+
+		if (n != NULL) {
+			struct _timeout *t = CONTAINER_OF(n, struct _timeout, node);
+
+			t->dticks = 0;
+			return t;
+		}
+
+		ev = wheel_next_event();
+		if (ev == UINT64_MAX ||
+		    ev - curr_tick > (uint64_t)announce_remaining) {
+			return NULL;
+		}
+
+		announce_remaining -= ev - curr_tick;
+		curr_tick = ev;
+		wheel_cascade();
+	}
+}
+
+static void tq_announce_done(void)
+{
+	/* Nothing is due before curr_tick + announce_remaining */
+}
+
+#else /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -59,6 +267,79 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+static bool tq_add(struct _timeout *to, int64_t ticks)
+{
+	struct _timeout *t;
+
+	to->dticks = ticks;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+
+	return to == first();
+}
+
+static void tq_remove(struct _timeout *to)
+{
+	remove_timeout(to);
+}
+
+static int64_t tq_first_ticks(void)
+{
+	struct _timeout *to = first();
+
+	return to == NULL ? -1 : to->dticks;
+}
+
+static int64_t tq_remaining(const struct _timeout *timeout)
+{
+	int64_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+static struct _timeout *tq_expire_next(void)
+{
+	struct _timeout *t = first();
+
+	if (t == NULL || t->dticks > announce_remaining) {
+		return NULL;
+	}
+
+	curr_tick += t->dticks;
+	announce_remaining -= t->dticks;
+	t->dticks = 0;
+	remove_timeout(t);
+
+	return t;
+}
+
+static void tq_announce_done(void)
+{
+	if (first() != NULL) {
+		first()->dticks -= announce_remaining;
+	}
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 static int32_t elapsed(void)
 {
 	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
@@ -66,15 +347,15 @@ static int32_t elapsed(void)
 
 static int32_t next_timeout(void)
 {
-	struct _timeout *to = first();
+	int64_t first_ticks = tq_first_ticks();
 	int32_t ticks_elapsed = elapsed();
 	int32_t ret;
 
-	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	if ((first_ticks < 0) ||
+	    ((int64_t)(first_ticks - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, first_ticks - ticks_elapsed);
 	}
 
 #ifdef CONFIG_TIMESLICING
@@ -100,31 +381,17 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	to->fn = fn;
 
 	LOCKED(&timeout_lock) {
-		struct _timeout *t;
+		int64_t ticks;
 
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    Z_TICK_ABS(timeout.ticks) >= 0) {
-			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
-
-			to->dticks = MAX(1, ticks);
+			ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
+			ticks = MAX(1, ticks);
 		} else {
-			to->dticks = timeout.ticks + 1 + elapsed();
+			ticks = timeout.ticks + 1 + elapsed();
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
-
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
-
-		if (to == first()) {
+		if (tq_add(to, ticks)) {
 #if CONFIG_TIMESLICING
 			/*
 			 * This is not ideal, since it does not
@@ -153,7 +420,7 @@ int z_abort_timeout(struct _timeout *to)
 
 	LOCKED(&timeout_lock) {
 		if (sys_dnode_is_linked(&to->node)) {
-			remove_timeout(to);
+			tq_remove(to);
 			ret = 0;
 		}
 	}
@@ -164,20 +431,11 @@ int z_abort_timeout(struct _timeout *to)
 /* must be locked */
 static k_ticks_t timeout_rem(const struct _timeout *timeout)
 {
-	k_ticks_t ticks = 0;
-
 	if (z_is_inactive_timeout(timeout)) {
 		return 0;
 	}
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
-
-	return ticks - elapsed();
+	return tq_remaining(timeout) - elapsed();
 }
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
@@ -243,26 +501,17 @@ void sys_clock_announce(int32_t ticks)
 #endif
 
 	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
+	struct _timeout *t;
 
 	announce_remaining = ticks;
 
-	while (first() != NULL && first()->dticks <= announce_remaining) {
-		struct _timeout *t = first();
-		int dt = t->dticks;
-
-		curr_tick += dt;
-		announce_remaining -= dt;
-		t->dticks = 0;
-		remove_timeout(t);
-
+	while ((t = tq_expire_next()) != NULL) {
 		k_spin_unlock(&timeout_lock, key);
 		t->fn(t);
 		key = k_spin_lock(&timeout_lock);
 	}
 
-	if (first() != NULL) {
-		first()->dticks -= announce_remaining;
-	}
+	tq_announce_done();
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
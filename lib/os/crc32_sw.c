@@ -6,11 +6,64 @@
 
 #include <sys/crc.h>
 
+#if defined(CONFIG_CRC32_ARCH) && defined(CONFIG_ARCH_HAS_CRC32)
+#include <sys/arch_interface.h>
+#elif defined(CONFIG_CRC32_SLICE_BY_4) || defined(CONFIG_CRC32_SLICE_BY_8)
+#include "crc32_ieee_tables.h"
+#endif
+
 uint32_t crc32_ieee(const uint8_t *data, size_t len)
 {
 	return crc32_ieee_update(0x0, data, len);
 }
 
+#if defined(CONFIG_CRC32_ARCH) && defined(CONFIG_ARCH_HAS_CRC32)
+
+uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+	return ~arch_crc32_update(~crc, data, len);
+}
+
+#elif defined(CONFIG_CRC32_SLICE_BY_4) || defined(CONFIG_CRC32_SLICE_BY_8)
+
+uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+	const uint32_t (*t)[256] = crc32_ieee_slice;
+
+	crc = ~crc;
+
+	/* Byte-wise until the data is word aligned */
+	while (len > 0 && ((uintptr_t)data & 3) != 0) {
+		crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xff];
+		len--;
+	}
+
+	while (len >= CRC32_SLICE_TABLES) {
+		crc ^= (uint32_t)data[0] | ((uint32_t)data[1] << 8) |
+		       ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+#if CRC32_SLICE_TABLES > 4
+		crc = t[7][crc & 0xff] ^ t[6][(crc >> 8) & 0xff] ^
+		      t[5][(crc >> 16) & 0xff] ^ t[4][crc >> 24] ^
+		      t[3][data[4]] ^ t[2][data[5]] ^
+		      t[1][data[6]] ^ t[0][data[7]];
+#else
+		crc = t[3][crc & 0xff] ^ t[2][(crc >> 8) & 0xff] ^
+		      t[1][(crc >> 16) & 0xff] ^ t[0][crc >> 24];
+#endif
+		data += CRC32_SLICE_TABLES;
+		len -= CRC32_SLICE_TABLES;
+	}
+
+	while (len > 0) {
+		crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xff];
+		len--;
+	}
+
+	return (~crc);
+}
+
+#else
+
 uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 {
 	/* crc table generated from polynomial 0xedb88320 */
@@ -32,3 +85,5 @@ uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 
 	return (~crc);
 }
+
+#endif
@@ -6,6 +6,11 @@
 
 #include <sys/crc.h>
 
+#if defined(CONFIG_CRC32_ARCH) && defined(CONFIG_ARCH_HAS_CRC32C)
+#include <sys/arch_interface.h>
+#elif defined(CONFIG_CRC32_SLICE_BY_4) || defined(CONFIG_CRC32_SLICE_BY_8)
+#include "crc32c_tables.h"
+#else
 /* crc table generated from polynomial 0x1EDC6F41UL (Castagnoli) */
 static const uint32_t crc32c_table[16] = {
 	0x00000000UL, 0x105EC76FUL, 0x20BD8EDEUL, 0x30E349B1UL,
@@ -13,6 +18,7 @@ static const uint32_t crc32c_table[16] = {
 	0x82F63B78UL, 0x92A8FC17UL, 0xA24BB5A6UL, 0xB21572C9UL,
 	0xC38D26C4UL, 0xD3D3E1ABUL, 0xE330A81AUL, 0xF36E6F75UL
 };
+#endif
 
 /* This value needs to be XORed with the final crc value once crc for
  * the entire stream is calculated. This is a requirement of crc32c algo.
@@ -24,17 +30,71 @@ static const uint32_t crc32c_table[16] = {
  */
 #define CRC32C_INIT	0xFFFFFFFFUL
 
-uint32_t crc32_c(uint32_t crc, const uint8_t *data,
-		 size_t len, bool first_pkt, bool last_pkt)
+#if defined(CONFIG_CRC32_ARCH) && defined(CONFIG_ARCH_HAS_CRC32C)
+
+static uint32_t crc32c_update(uint32_t crc, const uint8_t *data, size_t len)
 {
-	if (first_pkt) {
-		crc = CRC32C_INIT;
+	return arch_crc32c_update(crc, data, len);
+}
+
+#elif defined(CONFIG_CRC32_SLICE_BY_4) || defined(CONFIG_CRC32_SLICE_BY_8)
+
+static uint32_t crc32c_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+	const uint32_t (*t)[256] = crc32c_slice;
+
+	/* Byte-wise until the data is word aligned */
+	while (len > 0 && ((uintptr_t)data & 3) != 0) {
+		crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xff];
+		len--;
+	}
+
+	while (len >= CRC32_SLICE_TABLES) {
+		crc ^= (uint32_t)data[0] | ((uint32_t)data[1] << 8) |
+		       ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+#if CRC32_SLICE_TABLES > 4
+		crc = t[7][crc & 0xff] ^ t[6][(crc >> 8) & 0xff] ^
+		      t[5][(crc >> 16) & 0xff] ^ t[4][crc >> 24] ^
+		      t[3][data[4]] ^ t[2][data[5]] ^
+		      t[1][data[6]] ^ t[0][data[7]];
+#else
+		crc = t[3][crc & 0xff] ^ t[2][(crc >> 8) & 0xff] ^
+		      t[1][(crc >> 16) & 0xff] ^ t[0][crc >> 24];
+#endif
+		data += CRC32_SLICE_TABLES;
+		len -= CRC32_SLICE_TABLES;
 	}
 
+	while (len > 0) {
+		crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xff];
+		len--;
+	}
+
+	return crc;
+}
+
+#else
+
+static uint32_t crc32c_update(uint32_t crc, const uint8_t *data, size_t len)
+{
 	for (size_t i = 0; i < len; i++) {
 		crc = crc32c_table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
 		crc = crc32c_table[(crc ^ ((uint32_t)data[i] >> 4)) & 0x0F] ^ (crc >> 4);
 	}
 
+	return crc;
+}
+
+#endif
+
+uint32_t crc32_c(uint32_t crc, const uint8_t *data,
+		 size_t len, bool first_pkt, bool last_pkt)
+{
+	if (first_pkt) {
+		crc = CRC32C_INIT;
+	}
+
+	crc = crc32c_update(crc, data, len);
+
 	return last_pkt ? (crc ^ CRC32C_XOR_OUT) : crc;
 }
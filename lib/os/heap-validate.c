@@ -68,6 +68,56 @@ static inline void check_nexts(struct z_heap *h, int bidx)
 	}
 }
 
+#ifdef CONFIG_SYS_HEAP_SLAB
+/* Every cached chunk must be a valid used chunk of its class size and
+ * each list must hold exactly as many chunks as counted.  Cached chunks
+ * are marked unused while walking the lists so a chunk linked twice is
+ * caught, then marked used again.
+ */
+static bool valid_slab_caches(struct z_heap *h)
+{
+	bool valid = true;
+	int cpu, i;
+	chunkid_t c;
+
+	for (cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		struct z_heap_slab *s = &h->slab[cpu];
+
+		for (i = 0; i < CONFIG_SYS_HEAP_SLAB_CLASSES; i++) {
+			uint32_t n = 0;
+
+			for (c = s->head[i]; c != 0U && valid;
+			     c = next_free_chunk(h, c), n++) {
+				valid = n < s->count[i] &&
+					in_bounds(h, c) &&
+					valid_chunk(h, c) &&
+					chunk_used(h, c) &&
+					slab_class(h, chunk_size(h, c)) == i;
+				if (valid) {
+					set_chunk_used(h, c, false);
+				}
+			}
+
+			valid = valid && n == s->count[i];
+		}
+	}
+
+	/* Restore the used bits, stopping where the walk above did */
+	for (cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		struct z_heap_slab *s = &h->slab[cpu];
+
+		for (i = 0; i < CONFIG_SYS_HEAP_SLAB_CLASSES; i++) {
+			for (c = s->head[i]; c != 0U && !chunk_used(h, c);
+			     c = next_free_chunk(h, c)) {
+				set_chunk_used(h, c, true);
+			}
+		}
+	}
+
+	return valid;
+}
+#endif
+
 static void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
 			   size_t *free_bytes)
 {
@@ -102,6 +152,12 @@ bool sys_heap_validate(struct sys_heap *heap)
 		return false;  /* Should have exactly consumed the buffer */
 	}
 
+#ifdef CONFIG_SYS_HEAP_SLAB
+	if (!valid_slab_caches(h)) {
+		return false;
+	}
+#endif
+
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	/*
 	 * Validate sys_heap_runtime_stats_get API.
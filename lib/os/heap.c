@@ -149,6 +149,161 @@ static chunkid_t mem_to_chunkid(struct z_heap *h, void *p)
 	return (mem - chunk_header_bytes(h) - base) / CHUNK_UNIT;
 }
 
+#ifdef CONFIG_SYS_HEAP_SLAB
+/* Lock the size class cache of the calling CPU.  Moving to another CPU
+ * right after picking the cache is harmless, its lock protects it there
+ * as well.
+ */
+static struct z_heap_slab *slab_lock(struct z_heap *h, k_spinlock_key_t *key)
+{
+	struct z_heap_slab *s = slab_cache(h);
+
+	*key = k_spin_lock(&s->lock);
+
+	return s;
+}
+
+static chunkid_t slab_get(struct z_heap *h, struct z_heap_slab *s,
+			  chunksz_t sz)
+{
+	chunksz_t cls = slab_class(h, sz);
+	chunkid_t c;
+
+	if (cls >= CONFIG_SYS_HEAP_SLAB_CLASSES || s->head[cls] == 0U) {
+		return 0;
+	}
+
+	c = s->head[cls];
+	s->head[cls] = next_free_chunk(h, c);
+	s->count[cls]--;
+
+	CHECK(chunk_used(h, c));
+	CHECK(chunk_size(h, c) == sz);
+
+	return c;
+}
+
+static bool slab_put(struct z_heap *h, struct z_heap_slab *s, chunkid_t c)
+{
+	chunksz_t cls = slab_class(h, chunk_size(h, c));
+
+	if (h->slab_bypass || cls >= CONFIG_SYS_HEAP_SLAB_CLASSES ||
+	    s->count[cls] >= CONFIG_SYS_HEAP_SLAB_DEPTH) {
+		return false;
+	}
+
+	set_next_free_chunk(h, c, s->head[cls]);
+	s->head[cls] = c;
+	s->count[cls]++;
+
+	return true;
+}
+
+void *sys_heap_slab_alloc(struct sys_heap *heap, size_t align, size_t bytes)
+{
+	struct z_heap *h = heap->heap;
+	struct z_heap_slab *s;
+	k_spinlock_key_t key;
+	chunkid_t c;
+	void *mem;
+
+	/* Cached chunks are only aligned to the chunk header size */
+	if ((align & (align - 1)) != 0U || align > chunk_header_bytes(h)) {
+		return NULL;
+	}
+
+	if (bytes == 0U || size_too_big(h, bytes)) {
+		return NULL;
+	}
+
+	s = slab_lock(h, &key);
+	c = slab_get(h, s, bytes_to_chunksz(h, bytes));
+	k_spin_unlock(&s->lock, key);
+
+	if (c == 0U) {
+		return NULL;
+	}
+
+	mem = chunk_mem(h, c);
+
+#ifdef CONFIG_SYS_HEAP_LISTENER
+	heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(heap), mem,
+				   chunksz_to_bytes(h, chunk_size(h, c)));
+#endif
+
+	return mem;
+}
+
+bool sys_heap_slab_free(struct sys_heap *heap, void *mem)
+{
+	if (mem == NULL) {
+		return true;
+	}
+	struct z_heap *h = heap->heap;
+	chunkid_t c = mem_to_chunkid(h, mem);
+	struct z_heap_slab *s;
+	k_spinlock_key_t key;
+	bool cached;
+
+	__ASSERT(chunk_used(h, c),
+		 "unexpected heap state (double-free?) for memory at %p", mem);
+	__ASSERT(left_chunk(h, right_chunk(h, c)) == c,
+		 "corrupted heap bounds (buffer overflow?) for memory at %p",
+		 mem);
+
+	s = slab_lock(h, &key);
+	cached = slab_put(h, s, c);
+	k_spin_unlock(&s->lock, key);
+
+#ifdef CONFIG_SYS_HEAP_LISTENER
+	if (cached) {
+		heap_listener_notify_free(HEAP_ID_FROM_POINTER(heap), mem,
+					  chunksz_to_bytes(h, chunk_size(h, c)));
+	}
+#endif
+
+	return cached;
+}
+
+bool sys_heap_slab_flush(struct sys_heap *heap)
+{
+	struct z_heap *h = heap->heap;
+	bool flushed = false;
+	k_spinlock_key_t key;
+
+	for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		struct z_heap_slab *s = &h->slab[cpu];
+
+		key = k_spin_lock(&s->lock);
+
+		for (int i = 0; i < CONFIG_SYS_HEAP_SLAB_CLASSES; i++) {
+			while (s->head[i] != 0U) {
+				chunkid_t c = s->head[i];
+
+				s->head[i] = next_free_chunk(h, c);
+				set_chunk_used(h, c, false);
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+				h->allocated_bytes -=
+					chunksz_to_bytes(h, chunk_size(h, c));
+#endif
+				free_chunk(h, c);
+				flushed = true;
+			}
+			s->count[i] = 0;
+		}
+
+		k_spin_unlock(&s->lock, key);
+	}
+
+	return flushed;
+}
+
+void sys_heap_slab_bypass(struct sys_heap *heap, bool bypass)
+{
+	heap->heap->slab_bypass = bypass;
+}
+#endif /* CONFIG_SYS_HEAP_SLAB */
+
 void sys_heap_free(struct sys_heap *heap, void *mem)
 {
 	if (mem == NULL) {
@@ -260,6 +415,7 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 
 	chunksz_t chunk_sz = bytes_to_chunksz(h, bytes);
 	chunkid_t c = alloc_chunk(h, chunk_sz);
+
 	if (c == 0U) {
 		return NULL;
 	}
@@ -510,6 +666,11 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 		h->buckets[i].next = 0;
 	}
 
+#ifdef CONFIG_SYS_HEAP_SLAB
+	h->slab_bypass = false;
+	(void)memset(h->slab, 0, sizeof(h->slab));
+#endif
+
 	/* chunk containing our struct z_heap */
 	set_chunk_size(h, 0, chunk0_size);
 	set_left_chunk_size(h, 0, 0);
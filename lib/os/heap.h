@@ -65,6 +65,21 @@ struct z_heap_bucket {
 	chunkid_t next;
 };
 
+/* Per-CPU size class caches (CONFIG_SYS_HEAP_SLAB).  Class N holds
+ * chunks of min_chunk_size() + N units in a LIFO list linked through
+ * their FREE_NEXT field.  Cached chunks stay marked used, so they are
+ * never merged and look allocated to everything else in the heap.
+ * Each cache has its own lock, so a CPU can use its cache without the
+ * heap lock while another CPU holding the heap lock flushes it.
+ */
+#ifdef CONFIG_SYS_HEAP_SLAB
+struct z_heap_slab {
+	struct k_spinlock lock;
+	chunkid_t head[CONFIG_SYS_HEAP_SLAB_CLASSES];
+	uint8_t count[CONFIG_SYS_HEAP_SLAB_CLASSES];
+};
+#endif
+
 struct z_heap {
 	chunkid_t chunk0_hdr[2];
 	chunkid_t end_chunk;
@@ -72,6 +87,10 @@ struct z_heap {
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	size_t free_bytes;
 	size_t allocated_bytes;
+#endif
+#ifdef CONFIG_SYS_HEAP_SLAB
+	bool slab_bypass;
+	struct z_heap_slab slab[CONFIG_MP_NUM_CPUS];
 #endif
 	struct z_heap_bucket buckets[0];
 };
@@ -252,6 +271,23 @@ static inline int bucket_idx(struct z_heap *h, chunksz_t sz)
 	return 31 - __builtin_clz(usable_sz);
 }
 
+#ifdef CONFIG_SYS_HEAP_SLAB
+/* Size class cache of the calling CPU */
+static inline struct z_heap_slab *slab_cache(struct z_heap *h)
+{
+#ifdef CONFIG_SMP
+	return &h->slab[arch_curr_cpu()->id];
+#else
+	return &h->slab[0];
+#endif
+}
+
+static inline chunksz_t slab_class(struct z_heap *h, chunksz_t sz)
+{
+	return sz - min_chunk_size(h);
+}
+#endif
+
 static inline bool size_too_big(struct z_heap *h, size_t bytes)
 {
 	/*
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/mpmc_ring.h>
+#include <string.h>
+
+/* Bounded MPMC queue after Dmitry Vyukov.  head and tail run freely and
+ * wrap at 2^32.  The sequence number of the element for index idx says
+ * what the element waits for: idx if it is free for the put of idx,
+ * idx + 1 if it holds the data for the get of idx.  The get then makes
+ * it idx + size, free for the put one lap later.
+ *
+ * The sequence numbers are stored relative to the position of their
+ * element in the ring, so a zeroed buffer is a valid empty ring and
+ * SYS_MPMC_RING_DEFINE() needs no run time initialization.  Stored
+ * values are therefore the lap base (idx & ~mask) for a free element and
+ * the lap base + 1 for a full one.  With a single element the lap base
+ * is idx itself, so a full element would look free to the next put:
+ * rings have at least two elements.
+ */
+
+static inline size_t slot_words(struct sys_mpmc_ring *ring)
+{
+	return 1 + DIV_ROUND_UP(ring->elem_size, sizeof(atomic_t));
+}
+
+static inline atomic_t *slot(struct sys_mpmc_ring *ring, uint32_t idx)
+{
+	return &ring->buffer[(idx & ring->mask) * slot_words(ring)];
+}
+
+static inline int32_t seq_diff(atomic_t *seq, uint32_t expected)
+{
+	return (int32_t)((uint32_t)atomic_get(seq) - expected);
+}
+
+void sys_mpmc_ring_init(struct sys_mpmc_ring *ring, atomic_t *buffer,
+			size_t elem_size, uint32_t num_elems)
+{
+	__ASSERT(num_elems >= 2U && is_power_of_two(num_elems),
+		 "Number of elements must be a power of two >= 2");
+
+	ring->buffer = buffer;
+	ring->elem_size = elem_size;
+	ring->mask = num_elems - 1U;
+	memset(buffer, 0, SYS_MPMC_RING_BUF_SIZE(elem_size, num_elems) *
+	       sizeof(atomic_t));
+	atomic_set(&ring->head, 0);
+	atomic_set(&ring->tail, 0);
+	atomic_set(&ring->waiters, 0);
+	k_sem_init(&ring->sem, 0, num_elems);
+}
+
+int sys_mpmc_ring_put(struct sys_mpmc_ring *ring, const void *data)
+{
+	uint32_t head = (uint32_t)atomic_get(&ring->head);
+	atomic_t *seq;
+	int32_t diff;
+
+	for (;;) {
+		seq = slot(ring, head);
+		diff = seq_diff(seq, head & ~ring->mask);
+
+		if (diff == 0) {
+			/* free, claim it unless another producer did */
+			if (atomic_cas(&ring->head, (atomic_val_t)head,
+				       (atomic_val_t)(head + 1U))) {
+				break;
+			}
+		} else if (diff < 0) {
+			/* still holds the data of the previous lap */
+			return -EAGAIN;
+		} else {
+			;
+		}
+
+		head = (uint32_t)atomic_get(&ring->head);
+	}
+
+	memcpy(seq + 1, data, ring->elem_size);
+	atomic_set(seq, (head & ~ring->mask) + 1U);
+
+	/* Consumers count themselves before checking the ring again, so
+	 * either they see the element or we see them waiting
+	 */
+	if (atomic_get(&ring->waiters) != 0) {
+		k_sem_give(&ring->sem);
+	}
+
+	return 0;
+}
+
+int sys_mpmc_ring_get(struct sys_mpmc_ring *ring, void *data)
+{
+	uint32_t tail = (uint32_t)atomic_get(&ring->tail);
+	atomic_t *seq;
+	int32_t diff;
+
+	for (;;) {
+		seq = slot(ring, tail);
+		diff = seq_diff(seq, (tail & ~ring->mask) + 1U);
+
+		if (diff == 0) {
+			/* full, claim it unless another consumer did */
+			if (atomic_cas(&ring->tail, (atomic_val_t)tail,
+				       (atomic_val_t)(tail + 1U))) {
+				break;
+			}
+		} else if (diff < 0) {
+			/* not put yet */
+			return -EAGAIN;
+		} else {
+			;
+		}
+
+		tail = (uint32_t)atomic_get(&ring->tail);
+	}
+
+	memcpy(data, seq + 1, ring->elem_size);
+	atomic_set(seq, (tail & ~ring->mask) + ring->mask + 1U);
+
+	return 0;
+}
+
+int sys_mpmc_ring_get_wait(struct sys_mpmc_ring *ring, void *data,
+			   k_timeout_t timeout)
+{
+	int ret;
+
+	while (sys_mpmc_ring_get(ring, data) != 0) {
+		atomic_inc(&ring->waiters);
+
+		/* An element put before we were counted didn't give the
+		 * semaphore
+		 */
+		if (sys_mpmc_ring_get(ring, data) == 0) {
+			atomic_dec(&ring->waiters);
+			return 0;
+		}
+
+		/* The semaphore may also have been given for an element
+		 * another consumer took, then the loop just checks again
+		 */
+		ret = k_sem_take(&ring->sem, timeout);
+		atomic_dec(&ring->waiters);
+		if (ret != 0) {
+			return -EAGAIN;
+		}
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_POLL
+void sys_mpmc_ring_poll_prepare(struct sys_mpmc_ring *ring,
+				struct k_poll_event *event)
+{
+	uint32_t tail;
+
+	atomic_inc(&ring->waiters);
+
+	tail = (uint32_t)atomic_get(&ring->tail);
+	if (seq_diff(slot(ring, tail), (tail & ~ring->mask) + 1U) >= 0) {
+		k_sem_give(&ring->sem);
+	}
+
+	k_poll_event_init(event, K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &ring->sem);
+}
+
+void sys_mpmc_ring_poll_finish(struct sys_mpmc_ring *ring)
+{
+	(void)k_sem_take(&ring->sem, K_NO_WAIT);
+	atomic_dec(&ring->waiters);
+}
+#endif /* CONFIG_POLL */
@@ -8,6 +8,7 @@
 #include <sys/mutex.h>
 #include <syscall_handler.h>
 #include <kernel_structs.h>
+#include <kernel_internal.h>
 
 static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 {
@@ -23,22 +24,153 @@ static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 
 static bool check_sys_mutex_addr(struct sys_mutex *addr)
 {
-	/* sys_mutex memory is never touched, just used to lookup the
-	 * underlying k_mutex, but we don't want threads using mutexes
-	 * that are outside their memory domain
+	/* sys_mutex memory is used to lookup the underlying k_mutex, and
+	 * with CONFIG_SYS_MUTEX_FAST holds the lock state, we don't want
+	 * threads using mutexes that are outside their memory domain
 	 */
 	return Z_SYSCALL_MEMORY_WRITE(addr, sizeof(struct sys_mutex));
 }
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+/* With the fast path, mutex->val is 0 while the mutex is unlocked and the
+ * owner thread while it is locked by sys_mutex_lock() without a syscall.
+ * Once a thread has to wait, or the owner locks recursively, the kernel
+ * takes over: the k_mutex is given to the owner, and val becomes odd and
+ * counts the kernel side lock calls not unlocked yet, waiters included.
+ * When that count drops to zero val is 0 again.
+ *
+ * User threads only ever change val from 0 to themselves and back, so the
+ * kernel only has to use atomic_cas() when val is even. All kernel side
+ * changes are serialized by this lock.
+ */
+#define KERNEL_MODE	BIT(0)
+#define KERNEL_LOCK	2
+
+static struct k_spinlock lock;
+
+static struct k_thread *get_owner(atomic_val_t val)
+{
+	struct z_object *obj = z_object_find((void *)val);
+
+	/* val sits in user memory, trust it only if it is a live thread.
+	 * The owner gets the k_mutex and may be boosted by priority
+	 * inheritance, so a user thread must also have permission on it,
+	 * or it could forge val to act on threads outside its domain.
+	 */
+	if (obj == NULL || obj->type != K_OBJ_THREAD ||
+	    (obj->flags & K_OBJ_FLAG_INITIALIZED) == 0U) {
+		return NULL;
+	}
+
+	if ((_current->base.user_options & K_USER) != 0U &&
+	    z_object_validate(obj, K_OBJ_THREAD, _OBJ_INIT_TRUE) != 0) {
+		return NULL;
+	}
+
+	return (struct k_thread *)val;
+}
+
+static int kernel_lock_get(struct sys_mutex *mutex,
+			   struct k_mutex *kernel_mutex)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_thread *owner;
+	atomic_val_t val, new_val;
+
+	do {
+		owner = NULL;
+		val = atomic_get(&mutex->val);
+
+		if ((val & KERNEL_MODE) != 0) {
+			new_val = val + KERNEL_LOCK;
+		} else if (val == 0) {
+			new_val = KERNEL_MODE | KERNEL_LOCK;
+		} else {
+			owner = get_owner(val);
+			if (owner == NULL) {
+				k_spin_unlock(&lock, key);
+				return -EINVAL;
+			}
+
+			/* One for the lock of the owner, one for ours */
+			new_val = KERNEL_MODE | (2 * KERNEL_LOCK);
+		}
+	} while (!atomic_cas(&mutex->val, val, new_val));
+
+	/* The owner now has to unlock through the kernel, which waits for
+	 * this lock, so the k_mutex is handed over before anyone sees it.
+	 */
+	if (owner != NULL) {
+		z_mutex_owner_set(kernel_mutex, owner);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static void kernel_lock_put(struct sys_mutex *mutex)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (atomic_sub(&mutex->val, KERNEL_LOCK) == (KERNEL_MODE | KERNEL_LOCK)) {
+		atomic_set(&mutex->val, 0);
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+static int kernel_unlock_check(struct sys_mutex *mutex)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	atomic_val_t val = atomic_get(&mutex->val);
+
+	k_spin_unlock(&lock, key);
+
+	if ((val & KERNEL_MODE) != 0) {
+		return 0;
+	}
+
+	/* Unlocked, or locked by another thread without the kernel */
+	return val == 0 ? -EINVAL : -EPERM;
+}
+#else
+static inline int kernel_lock_get(struct sys_mutex *mutex,
+				  struct k_mutex *kernel_mutex)
+{
+	return 0;
+}
+
+static inline void kernel_lock_put(struct sys_mutex *mutex)
+{
+}
+
+static inline int kernel_unlock_check(struct sys_mutex *mutex)
+{
+	return 0;
+}
+#endif /* CONFIG_SYS_MUTEX_FAST */
+
 int z_impl_z_sys_mutex_kernel_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
 	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
+	int ret;
 
 	if (kernel_mutex == NULL) {
 		return -EINVAL;
 	}
 
-	return k_mutex_lock(kernel_mutex, timeout);
+	ret = kernel_lock_get(mutex, kernel_mutex);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = k_mutex_lock(kernel_mutex, timeout);
+	if (ret != 0) {
+		kernel_lock_put(mutex);
+	}
+
+	return ret;
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
@@ -55,12 +187,27 @@ static inline int z_vrfy_z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
 int z_impl_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
 {
 	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
+	int ret;
+
+	if (kernel_mutex == NULL) {
+		return -EINVAL;
+	}
 
-	if (kernel_mutex == NULL || kernel_mutex->lock_count == 0) {
+	ret = kernel_unlock_check(mutex);
+	if (ret != 0) {
+		return ret;
+	}
+
+	if (kernel_mutex->lock_count == 0) {
 		return -EINVAL;
 	}
 
-	return k_mutex_unlock(kernel_mutex);
+	ret = k_mutex_unlock(kernel_mutex);
+	if (ret == 0) {
+		kernel_lock_put(mutex);
+	}
+
+	return ret;
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
@@ -85,6 +85,15 @@ int sys_sem_take(struct sys_sem *sem, k_timeout_t timeout)
 	int ret = 0;
 	atomic_t old_value;
 
+	/* Don't mark the semaphore contended if we won't wait, the next
+	 * give would make a useless wake syscall
+	 */
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		old_value = bounded_dec(&sem->futex.val, SYS_SEM_MINIMUM + 1);
+
+		return old_value > 0 ? 0 : -ETIMEDOUT;
+	}
+
 	do {
 		old_value = bounded_dec(&sem->futex.val,
 					SYS_SEM_MINIMUM);
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/spsc_ring.h>
+#include <string.h>
+
+/* head and tail run freely and wrap at 2^32, head - tail is the number
+ * of elements in the ring.  Storing an index is the release of the
+ * element memory to the other side, atomic_set() and atomic_get() are
+ * sequentially consistent so no extra barriers are needed.
+ */
+
+static inline uint8_t *elem(struct sys_spsc_ring *ring, uint32_t idx)
+{
+	return ring->buffer + (idx & ring->mask) * ring->elem_size;
+}
+
+void sys_spsc_ring_init(struct sys_spsc_ring *ring, void *buffer,
+			size_t elem_size, uint32_t num_elems)
+{
+	__ASSERT(is_power_of_two(num_elems),
+		 "Number of elements must be a power of two");
+
+	atomic_set(&ring->head, 0);
+	atomic_set(&ring->tail, 0);
+	ring->tail_cache = 0U;
+	ring->head_cache = 0U;
+	ring->buffer = buffer;
+	ring->elem_size = elem_size;
+	ring->mask = num_elems - 1U;
+	atomic_set(&ring->waiters, 0);
+	k_sem_init(&ring->sem, 0, num_elems);
+}
+
+void *sys_spsc_ring_put_claim(struct sys_spsc_ring *ring)
+{
+	uint32_t head = (uint32_t)atomic_get(&ring->head);
+
+	if (head - ring->tail_cache > ring->mask) {
+		ring->tail_cache = (uint32_t)atomic_get(&ring->tail);
+		if (head - ring->tail_cache > ring->mask) {
+			return NULL;
+		}
+	}
+
+	return elem(ring, head);
+}
+
+void sys_spsc_ring_put_finish(struct sys_spsc_ring *ring)
+{
+	atomic_set(&ring->head, (uint32_t)atomic_get(&ring->head) + 1U);
+
+	/* The consumer counts itself before checking the ring again, so
+	 * either it sees the element or we see it waiting
+	 */
+	if (atomic_get(&ring->waiters) != 0) {
+		k_sem_give(&ring->sem);
+	}
+}
+
+int sys_spsc_ring_put(struct sys_spsc_ring *ring, const void *data)
+{
+	void *dst = sys_spsc_ring_put_claim(ring);
+
+	if (dst == NULL) {
+		return -EAGAIN;
+	}
+
+	memcpy(dst, data, ring->elem_size);
+	sys_spsc_ring_put_finish(ring);
+
+	return 0;
+}
+
+void *sys_spsc_ring_get_claim(struct sys_spsc_ring *ring)
+{
+	uint32_t tail = (uint32_t)atomic_get(&ring->tail);
+
+	if (tail == ring->head_cache) {
+		ring->head_cache = (uint32_t)atomic_get(&ring->head);
+		if (tail == ring->head_cache) {
+			return NULL;
+		}
+	}
+
+	return elem(ring, tail);
+}
+
+void sys_spsc_ring_get_finish(struct sys_spsc_ring *ring)
+{
+	atomic_set(&ring->tail, (uint32_t)atomic_get(&ring->tail) + 1U);
+}
+
+int sys_spsc_ring_get(struct sys_spsc_ring *ring, void *data)
+{
+	void *src = sys_spsc_ring_get_claim(ring);
+
+	if (src == NULL) {
+		return -EAGAIN;
+	}
+
+	memcpy(data, src, ring->elem_size);
+	sys_spsc_ring_get_finish(ring);
+
+	return 0;
+}
+
+int sys_spsc_ring_get_wait(struct sys_spsc_ring *ring, void *data,
+			   k_timeout_t timeout)
+{
+	int ret;
+
+	while (sys_spsc_ring_get(ring, data) != 0) {
+		atomic_inc(&ring->waiters);
+
+		/* An element put before we were counted didn't give the
+		 * semaphore
+		 */
+		if (sys_spsc_ring_get(ring, data) == 0) {
+			atomic_dec(&ring->waiters);
+			return 0;
+		}
+
+		/* The semaphore may also have been given for an element
+		 * we already took, then the loop just checks again
+		 */
+		ret = k_sem_take(&ring->sem, timeout);
+		atomic_dec(&ring->waiters);
+		if (ret != 0) {
+			return -EAGAIN;
+		}
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_POLL
+void sys_spsc_ring_poll_prepare(struct sys_spsc_ring *ring,
+				struct k_poll_event *event)
+{
+	atomic_inc(&ring->waiters);
+
+	if (sys_spsc_ring_get_claim(ring) != NULL) {
+		k_sem_give(&ring->sem);
+	}
+
+	k_poll_event_init(event, K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &ring->sem);
+}
+
+void sys_spsc_ring_poll_finish(struct sys_spsc_ring *ring)
+{
+	(void)k_sem_take(&ring->sem, K_NO_WAIT);
+	atomic_dec(&ring->waiters);
+}
+#endif /* CONFIG_POLL */
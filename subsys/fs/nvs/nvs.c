@@ -29,6 +29,98 @@ static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
 }
 /* end basic routines */
 
+/* lookup cache routines */
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+static inline size_t nvs_lookup_cache_pos(uint16_t id)
+{
+	uint16_t hash;
+
+	/* CRC8-CCITT is already used for the ATE checksums and makes a good
+	 * enough hash, larger caches need more bits.
+	 */
+#if CONFIG_NVS_LOOKUP_CACHE_SIZE <= 256
+	hash = crc8_ccitt(0xff, &id, sizeof(id));
+#else
+	hash = crc16_ccitt(0xffff, (const uint8_t *)&id, sizeof(id));
+#endif
+
+	return hash % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+}
+
+static inline void nvs_lookup_cache_update(struct nvs_fs *fs, uint16_t id,
+					   uint32_t addr)
+{
+	/* 0xFFFF is used by the special ATEs, keep it out of the cache */
+	if (id != 0xFFFF) {
+		fs->lookup_cache[nvs_lookup_cache_pos(id)] = addr;
+	}
+}
+
+/* drop the cache entries pointing into a sector that is about to be erased */
+static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t addr)
+{
+	uint32_t *cache_entry = fs->lookup_cache;
+	uint32_t *const cache_end =
+		&fs->lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+
+	addr &= ADDR_SECT_MASK;
+
+	for (; cache_entry < cache_end; ++cache_entry) {
+		if ((*cache_entry & ADDR_SECT_MASK) == addr) {
+			*cache_entry = NVS_LOOKUP_CACHE_NO_ADDR;
+		}
+	}
+}
+
+/* nvs_lookup_start returns the address to start walking backwards from when
+ * looking for the latest ATE of id, or false when id is known to be absent.
+ */
+static bool nvs_lookup_start(struct nvs_fs *fs, uint16_t id, uint32_t *addr)
+{
+	*addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
+	fs->lookup_stats.lookups++;
+
+	if (*addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		fs->lookup_stats.hits++;
+		return false;
+	}
+
+	return true;
+}
+
+/* the lookup is a hit if the cached ATE was the one looked for */
+static inline void nvs_lookup_done(struct nvs_fs *fs, uint32_t start_addr,
+				   uint32_t found_addr)
+{
+	if (start_addr == found_addr) {
+		fs->lookup_stats.hits++;
+	}
+}
+#else
+static inline void nvs_lookup_cache_update(struct nvs_fs *fs, uint16_t id,
+					   uint32_t addr)
+{
+}
+
+static inline void nvs_lookup_cache_invalidate(struct nvs_fs *fs,
+					       uint32_t addr)
+{
+}
+
+static inline bool nvs_lookup_start(struct nvs_fs *fs, uint16_t id,
+				    uint32_t *addr)
+{
+	*addr = fs->ate_wra;
+	return true;
+}
+
+static inline void nvs_lookup_done(struct nvs_fs *fs, uint32_t start_addr,
+				   uint32_t found_addr)
+{
+}
+#endif
+/* end lookup cache routines */
+
 /* flash routines */
 /* basic aligned flash write to nvs address */
 static int nvs_flash_al_wrt(struct nvs_fs *fs, uint32_t addr, const void *data,
@@ -96,6 +188,10 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 
 	rc = nvs_flash_al_wrt(fs, fs->ate_wra, entry,
 			       sizeof(struct nvs_ate));
+	if (!rc) {
+		/* Only an ate which made it to flash can be looked up */
+		nvs_lookup_cache_update(fs, entry->id, fs->ate_wra);
+	}
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
 
 	return rc;
@@ -610,6 +706,7 @@ gc_done:
 	}
 
 	/* Erase the gc'ed sector */
+	nvs_lookup_cache_invalidate(fs, sec_addr);
 	rc = nvs_flash_erase_sector(fs, sec_addr);
 	if (rc) {
 		return rc;
@@ -617,6 +714,46 @@ gc_done:
 	return 0;
 }
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+/* walk the allocation table from the newest to the oldest entry, the first
+ * valid ATE found for a cache position is the latest one.
+ */
+static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t addr, ate_addr;
+	uint32_t *cache_entry;
+	struct nvs_ate ate;
+
+	(void)memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+	(void)memset(&fs->lookup_stats, 0, sizeof(fs->lookup_stats));
+	addr = fs->ate_wra;
+
+	while (true) {
+		/* nvs_prev_ate() moves addr to the previous ATE */
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+		if (rc) {
+			return rc;
+		}
+
+		cache_entry = &fs->lookup_cache[nvs_lookup_cache_pos(ate.id)];
+
+		if ((ate.id != 0xFFFF) &&
+		    (*cache_entry == NVS_LOOKUP_CACHE_NO_ADDR) &&
+		    nvs_ate_valid(fs, &ate)) {
+			*cache_entry = ate_addr;
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	return 0;
+}
+#endif
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -819,6 +956,12 @@ end:
 
 		rc = nvs_add_gc_done_ate(fs);
 	}
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	if (!rc) {
+		rc = nvs_lookup_cache_rebuild(fs);
+	}
+#endif
 	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
 }
@@ -911,7 +1054,7 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 	int rc, gc_count;
 	size_t ate_size, data_size;
 	struct nvs_ate wlk_ate;
-	uint32_t wlk_addr, rd_addr;
+	uint32_t wlk_addr, rd_addr, start_addr;
 	uint16_t required_space = 0U; /* no space, appropriate for delete ate */
 	bool prev_found = false;
 
@@ -933,21 +1076,26 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 	}
 
 	/* find latest entry with same id */
-	wlk_addr = fs->ate_wra;
-	rd_addr = wlk_addr;
+	rd_addr = 0U;
 
-	while (1) {
-		rd_addr = wlk_addr;
-		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
-		if (rc) {
-			return rc;
-		}
-		if ((wlk_ate.id == id) && (nvs_ate_valid(fs, &wlk_ate))) {
-			prev_found = true;
-			break;
-		}
-		if (wlk_addr == fs->ate_wra) {
-			break;
+	if (nvs_lookup_start(fs, id, &wlk_addr)) {
+		start_addr = wlk_addr;
+
+		while (1) {
+			rd_addr = wlk_addr;
+			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+			if (rc) {
+				return rc;
+			}
+			if ((wlk_ate.id == id) &&
+			    (nvs_ate_valid(fs, &wlk_ate))) {
+				prev_found = true;
+				nvs_lookup_done(fs, start_addr, rd_addr);
+				break;
+			}
+			if (wlk_addr == fs->ate_wra) {
+				break;
+			}
 		}
 	}
 
@@ -1033,7 +1181,7 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 		      uint16_t cnt)
 {
 	int rc;
-	uint32_t wlk_addr, rd_addr;
+	uint32_t wlk_addr, rd_addr, start_addr;
 	uint16_t cnt_his;
 	struct nvs_ate wlk_ate;
 	size_t ate_size;
@@ -1051,7 +1199,11 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 
 	cnt_his = 0U;
 
-	wlk_addr = fs->ate_wra;
+	if (!nvs_lookup_start(fs, id, &wlk_addr)) {
+		return -ENOENT;
+	}
+
+	start_addr = wlk_addr;
 	rd_addr = wlk_addr;
 
 	while (cnt_his <= cnt) {
@@ -1061,6 +1213,9 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 			goto err;
 		}
 		if ((wlk_ate.id == id) &&  (nvs_ate_valid(fs, &wlk_ate))) {
+			if (cnt_his == 0U) {
+				nvs_lookup_done(fs, start_addr, rd_addr);
+			}
 			cnt_his++;
 		}
 		if (wlk_addr == fs->ate_wra) {
@@ -1149,3 +1304,20 @@ ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 	}
 	return free_space;
 }
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+int nvs_lookup_cache_stats_get(struct nvs_fs *fs,
+			       struct nvs_lookup_cache_stats *stats)
+{
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	*stats = fs->lookup_stats;
+	k_mutex_unlock(&fs->nvs_lock);
+
+	return 0;
+}
+#endif
@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #include <errno.h>
 #include <sys/util.h>
+#include <random/rand32.h>
 
 #include <net/net_core.h>
 #include <net/net_pkt.h>
@@ -52,6 +53,9 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 /** Remote address specified */
 #define NET_CONN_LOCAL_ADDR_SPEC	BIT(6)
 
+/** Member of a SO_REUSEPORT group */
+#define NET_CONN_REUSEPORT		BIT(7)
+
 #define NET_CONN_RANK(_flags)		(_flags & 0x78)
 
 static struct net_conn conns[CONFIG_NET_MAX_CONN];
@@ -59,6 +63,32 @@ static struct net_conn conns[CONFIG_NET_MAX_CONN];
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+#if defined(CONFIG_NET_CONN_HASH)
+#define CONN_HASH_SIZE BIT(CONFIG_NET_CONN_HASH_BITS)
+#define CONN_HASH_MASK (CONN_HASH_SIZE - 1)
+
+/* Handlers with a fully specified remote end point, hashed by the remote
+ * address, remote port and local port.
+ */
+static sys_slist_t conn_hash[CONN_HASH_SIZE];
+static struct k_spinlock conn_hash_lock[CONN_HASH_SIZE];
+
+/* Handlers that only specify the local port (listening sockets), hashed
+ * by the local port.
+ */
+static sys_slist_t conn_listen_hash[CONN_HASH_SIZE];
+static struct k_spinlock conn_listen_hash_lock[CONN_HASH_SIZE];
+
+/* Number of UDP/TCP handlers without a local port. These cannot be
+ * hashed so the linear search is used while there are any.
+ */
+static atomic_t conn_unhashed;
+#endif /* CONFIG_NET_CONN_HASH */
+
+#if defined(CONFIG_NET_CONN_HASH) || defined(CONFIG_NET_CONTEXT_REUSEPORT)
+static uint32_t conn_hash_seed;
+#endif
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -141,101 +171,294 @@ static void conn_set_unused(struct net_conn *conn)
 	sys_slist_prepend(&conn_unused, &conn->node);
 }
 
-/* Check if we already have identical connection handler installed. */
-static struct net_conn *conn_find_handler(uint16_t proto, uint8_t family,
-					  const struct sockaddr *remote_addr,
-					  const struct sockaddr *local_addr,
-					  uint16_t remote_port,
-					  uint16_t local_port)
+#if defined(CONFIG_NET_CONN_HASH) || defined(CONFIG_NET_CONTEXT_REUSEPORT)
+static inline uint32_t conn_hash_mix(uint32_t hash, uint32_t val)
 {
-	struct net_conn *conn;
-	struct net_conn *tmp;
+	hash ^= val;
+	hash *= 0x9e3779b1U;
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&conn_used, conn, tmp, node) {
-		if (conn->proto != proto) {
-			continue;
+	return hash ^ (hash >> 15);
+}
+
+uint32_t net_conn_hash(uint16_t proto, sa_family_t family,
+		       const void *remote_addr, uint16_t remote_port,
+		       uint16_t local_port)
+{
+	const uint8_t *addr = remote_addr;
+	uint32_t hash = conn_hash_seed ^ proto;
+	size_t len = 0;
+	size_t i;
+
+	if (addr) {
+		len = family == AF_INET6 ? sizeof(struct in6_addr) :
+					   sizeof(struct in_addr);
+	}
+
+	for (i = 0; i < len; i += sizeof(uint32_t)) {
+		hash = conn_hash_mix(hash, UNALIGNED_GET((uint32_t *)&addr[i]));
+	}
+
+	hash = conn_hash_mix(hash, ((uint32_t)remote_port << 16) | local_port);
+
+	return hash ^ (hash >> 16);
+}
+#endif /* CONFIG_NET_CONN_HASH || CONFIG_NET_CONTEXT_REUSEPORT */
+
+#if defined(CONFIG_NET_CONN_HASH)
+
+static const void *conn_sockaddr_ip(const struct sockaddr *addr)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV6) && addr->sa_family == AF_INET6) {
+		if (net_ipv6_is_addr_unspecified(&net_sin6(addr)->sin6_addr)) {
+			return NULL;
 		}
 
-		if (conn->family != family) {
-			continue;
+		return &net_sin6(addr)->sin6_addr;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && addr->sa_family == AF_INET) {
+		if (!net_sin(addr)->sin_addr.s_addr) {
+			return NULL;
 		}
 
-		if (remote_addr) {
-			if (!(conn->flags & NET_CONN_REMOTE_ADDR_SET)) {
-				continue;
-			}
+		return &net_sin(addr)->sin_addr;
+	}
 
-			if (IS_ENABLED(CONFIG_NET_IPV6) &&
-			    remote_addr->sa_family == AF_INET6 &&
-			    remote_addr->sa_family ==
-			    conn->remote_addr.sa_family) {
-				if (!net_ipv6_addr_cmp(
-					    &net_sin6(remote_addr)->sin6_addr,
-					    &net_sin6(&conn->remote_addr)->
-								sin6_addr)) {
-					continue;
-				}
-			} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
-				   remote_addr->sa_family == AF_INET &&
-				   remote_addr->sa_family ==
-				   conn->remote_addr.sa_family) {
-				if (!net_ipv4_addr_cmp(
-					    &net_sin(remote_addr)->sin_addr,
-					    &net_sin(&conn->remote_addr)->
-								sin_addr)) {
-					continue;
-				}
-			} else {
-				continue;
-			}
-		} else if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
-			continue;
+	return NULL;
+}
+
+/* Return the hash bucket of a handler, or NULL if the handler cannot be
+ * hashed. Ports are in host byte order as given to net_conn_register().
+ */
+static sys_slist_t *conn_hash_bucket(uint16_t proto, uint8_t family,
+				     const struct sockaddr *remote_addr,
+				     uint16_t remote_port,
+				     uint16_t local_port,
+				     struct k_spinlock **lock)
+{
+	const void *addr = NULL;
+	uint32_t idx;
+
+	if ((proto != IPPROTO_UDP && proto != IPPROTO_TCP) ||
+	    (family != AF_INET && family != AF_INET6) || !local_port) {
+		return NULL;
+	}
+
+	if (remote_addr && remote_port) {
+		addr = conn_sockaddr_ip(remote_addr);
+	}
+
+	if (addr) {
+		idx = net_conn_hash(proto, family, addr, htons(remote_port),
+				    htons(local_port)) & CONN_HASH_MASK;
+		*lock = &conn_hash_lock[idx];
+
+		return &conn_hash[idx];
+	}
+
+	idx = net_conn_hash(proto, family, NULL, 0,
+			    htons(local_port)) & CONN_HASH_MASK;
+	*lock = &conn_listen_hash_lock[idx];
+
+	return &conn_listen_hash[idx];
+}
+
+static sys_slist_t *conn_hash_bucket_of(struct net_conn *conn,
+					struct k_spinlock **lock)
+{
+	return conn_hash_bucket(conn->proto, conn->family,
+				(conn->flags & NET_CONN_REMOTE_ADDR_SET) ?
+				&conn->remote_addr : NULL,
+				ntohs(net_sin(&conn->remote_addr)->sin_port),
+				ntohs(net_sin(&conn->local_addr)->sin_port),
+				lock);
+}
+
+/* Can the handler receive UDP or TCP packets over IPv4 or IPv6 */
+static bool conn_is_ip(struct net_conn *conn)
+{
+	return (conn->proto == IPPROTO_UDP || conn->proto == IPPROTO_TCP) &&
+		(conn->family == AF_INET || conn->family == AF_INET6 ||
+		 conn->family == AF_UNSPEC);
+}
+
+static void conn_hash_add(struct net_conn *conn)
+{
+	struct k_spinlock *lock;
+	k_spinlock_key_t key;
+	sys_slist_t *bucket;
+
+	bucket = conn_hash_bucket_of(conn, &lock);
+	if (!bucket) {
+		if (conn_is_ip(conn)) {
+			atomic_inc(&conn_unhashed);
 		}
 
-		if (local_addr) {
-			if (!(conn->flags & NET_CONN_LOCAL_ADDR_SET)) {
-				continue;
-			}
+		return;
+	}
 
-			if (IS_ENABLED(CONFIG_NET_IPV6) &&
-			    local_addr->sa_family == AF_INET6 &&
-			    local_addr->sa_family ==
-			    conn->local_addr.sa_family) {
-				if (!net_ipv6_addr_cmp(
-					    &net_sin6(local_addr)->sin6_addr,
-					    &net_sin6(&conn->local_addr)->
-								sin6_addr)) {
-					continue;
-				}
-			} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
-				   local_addr->sa_family == AF_INET &&
-				   local_addr->sa_family ==
-				   conn->local_addr.sa_family) {
-				if (!net_ipv4_addr_cmp(
-					    &net_sin(local_addr)->sin_addr,
-					    &net_sin(&conn->local_addr)->
-								sin_addr)) {
-					continue;
-				}
-			} else {
-				continue;
+	key = k_spin_lock(lock);
+	sys_slist_prepend(bucket, &conn->hash_node);
+	k_spin_unlock(lock, key);
+}
+
+static void conn_hash_remove(struct net_conn *conn)
+{
+	struct k_spinlock *lock;
+	k_spinlock_key_t key;
+	sys_slist_t *bucket;
+
+	bucket = conn_hash_bucket_of(conn, &lock);
+	if (!bucket) {
+		if (conn_is_ip(conn)) {
+			atomic_dec(&conn_unhashed);
+		}
+
+		return;
+	}
+
+	key = k_spin_lock(lock);
+	sys_slist_find_and_remove(bucket, &conn->hash_node);
+	k_spin_unlock(lock, key);
+}
+#else
+#define conn_hash_add(...)
+#define conn_hash_remove(...)
+#endif /* CONFIG_NET_CONN_HASH */
+
+static bool conn_is_identical(struct net_conn *conn,
+			      uint16_t proto, uint8_t family,
+			      const struct sockaddr *remote_addr,
+			      const struct sockaddr *local_addr,
+			      uint16_t remote_port,
+			      uint16_t local_port)
+{
+	if (conn->proto != proto) {
+		return false;
+	}
+
+	if (conn->family != family) {
+		return false;
+	}
+
+	if (remote_addr) {
+		if (!(conn->flags & NET_CONN_REMOTE_ADDR_SET)) {
+			return false;
+		}
+
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    remote_addr->sa_family == AF_INET6 &&
+		    remote_addr->sa_family ==
+		    conn->remote_addr.sa_family) {
+			if (!net_ipv6_addr_cmp(
+				    &net_sin6(remote_addr)->sin6_addr,
+				    &net_sin6(&conn->remote_addr)->
+							sin6_addr)) {
+				return false;
 			}
-		} else if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
-			continue;
+		} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+			   remote_addr->sa_family == AF_INET &&
+			   remote_addr->sa_family ==
+			   conn->remote_addr.sa_family) {
+			if (!net_ipv4_addr_cmp(
+				    &net_sin(remote_addr)->sin_addr,
+				    &net_sin(&conn->remote_addr)->
+							sin_addr)) {
+				return false;
+			}
+		} else {
+			return false;
 		}
+	} else if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
+		return false;
+	}
 
-		if (net_sin(&conn->remote_addr)->sin_port !=
-		    htons(remote_port)) {
-			continue;
+	if (local_addr) {
+		if (!(conn->flags & NET_CONN_LOCAL_ADDR_SET)) {
+			return false;
 		}
 
-		if (net_sin(&conn->local_addr)->sin_port !=
-		    htons(local_port)) {
-			continue;
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    local_addr->sa_family == AF_INET6 &&
+		    local_addr->sa_family ==
+		    conn->local_addr.sa_family) {
+			if (!net_ipv6_addr_cmp(
+				    &net_sin6(local_addr)->sin6_addr,
+				    &net_sin6(&conn->local_addr)->
+							sin6_addr)) {
+				return false;
+			}
+		} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+			   local_addr->sa_family == AF_INET &&
+			   local_addr->sa_family ==
+			   conn->local_addr.sa_family) {
+			if (!net_ipv4_addr_cmp(
+				    &net_sin(local_addr)->sin_addr,
+				    &net_sin(&conn->local_addr)->
+							sin_addr)) {
+				return false;
+			}
+		} else {
+			return false;
 		}
+	} else if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
+		return false;
+	}
+
+	if (net_sin(&conn->remote_addr)->sin_port !=
+	    htons(remote_port)) {
+		return false;
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port !=
+	    htons(local_port)) {
+		return false;
+	}
+
+	return true;
+}
+
+/* Check if we already have identical connection handler installed. */
+static struct net_conn *conn_find_handler(uint16_t proto, uint8_t family,
+					  const struct sockaddr *remote_addr,
+					  const struct sockaddr *local_addr,
+					  uint16_t remote_port,
+					  uint16_t local_port)
+{
+	struct net_conn *conn;
+	struct net_conn *tmp;
+
+#if defined(CONFIG_NET_CONN_HASH)
+	struct k_spinlock *lock;
+	k_spinlock_key_t key;
+	sys_slist_t *bucket;
+
+	/* An identical handler always lives in the same bucket */
+	bucket = conn_hash_bucket(proto, family, remote_addr, remote_port,
+				  local_port, &lock);
+	if (bucket) {
+		key = k_spin_lock(lock);
+
+		SYS_SLIST_FOR_EACH_CONTAINER(bucket, conn, hash_node) {
+			if (conn_is_identical(conn, proto, family,
+					      remote_addr, local_addr,
+					      remote_port, local_port)) {
+				break;
+			}
+		}
+
+		k_spin_unlock(lock, key);
 
 		return conn;
 	}
+#endif
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&conn_used, conn, tmp, node) {
+		if (conn_is_identical(conn, proto, family, remote_addr,
+				      local_addr, remote_port, local_port)) {
+			return conn;
+		}
+	}
 
 	return NULL;
 }
@@ -255,7 +478,8 @@ int net_conn_register(uint16_t proto, uint8_t family,
 
 	conn = conn_find_handler(proto, family, remote_addr, local_addr,
 				 remote_port, local_port);
-	if (conn) {
+	if (conn && !((conn->flags & NET_CONN_REUSEPORT) && context &&
+		      net_context_is_reuseport(context))) {
 		NET_ERR("Identical connection handler %p already found.", conn);
 		return -EALREADY;
 	}
@@ -344,6 +568,11 @@ int net_conn_register(uint16_t proto, uint8_t family,
 		net_sin(&conn->local_addr)->sin_port = htons(local_port);
 	}
 
+	if ((proto == IPPROTO_UDP || proto == IPPROTO_TCP) && local_port &&
+	    context && net_context_is_reuseport(context)) {
+		flags |= NET_CONN_REUSEPORT;
+	}
+
 	conn->cb = cb;
 	conn->user_data = user_data;
 	conn->flags = flags;
@@ -356,6 +585,7 @@ int net_conn_register(uint16_t proto, uint8_t family,
 	}
 
 	conn_set_used(conn);
+	conn_hash_add(conn);
 
 	conn_register_debug(conn, remote_port, local_port);
 
@@ -379,6 +609,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	NET_DBG("Connection handler %p removed", conn);
 
+	conn_hash_remove(conn);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
 
 	conn_set_unused(conn);
@@ -511,6 +742,211 @@ static bool conn_are_end_points_valid(struct net_pkt *pkt,
 	return !(my_src_addr && (src_port == dst_port));
 }
 
+/* Check the ports and addresses of a UDP/TCP handler against the packet */
+static bool conn_end_points_match(struct net_conn *conn,
+				  struct net_pkt *pkt,
+				  union net_ip_header *ip_hdr,
+				  uint16_t src_port,
+				  uint16_t dst_port)
+{
+	if (net_sin(&conn->remote_addr)->sin_port) {
+		if (net_sin(&conn->remote_addr)->sin_port != src_port) {
+			return false;
+		}
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port) {
+		if (net_sin(&conn->local_addr)->sin_port != dst_port) {
+			return false;
+		}
+	}
+
+	if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
+		if (!conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+			return false;
+		}
+	}
+
+	if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
+		if (!conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+#if defined(CONFIG_NET_CONN_HASH)
+static struct net_conn *conn_hash_lookup(sys_slist_t *bucket,
+					 struct k_spinlock *lock,
+					 struct net_pkt *pkt,
+					 union net_ip_header *ip_hdr,
+					 uint8_t proto,
+					 uint16_t src_port,
+					 uint16_t dst_port)
+{
+	struct net_conn *best_match = NULL;
+	int16_t best_rank = -1;
+	struct net_conn *conn;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(bucket, conn, hash_node) {
+		if (conn->proto != proto ||
+		    conn->family != net_pkt_family(pkt)) {
+			continue;
+		}
+
+		if (conn->context != NULL &&
+		    net_context_is_bound_to_iface(conn->context) &&
+		    net_pkt_iface(pkt) != net_context_get_iface(conn->context)) {
+			continue;
+		}
+
+		if (!conn_end_points_match(conn, pkt, ip_hdr, src_port,
+					   dst_port)) {
+			continue;
+		}
+
+		if (best_rank < NET_CONN_RANK(conn->flags)) {
+			best_rank = NET_CONN_RANK(conn->flags);
+			best_match = conn;
+		}
+	}
+
+	k_spin_unlock(lock, key);
+
+	return best_match;
+}
+
+/* Find the handler of a unicast UDP/TCP packet. A handler for the exact
+ * remote end point is preferred over a listening one.
+ */
+static struct net_conn *conn_find_hashed(struct net_pkt *pkt,
+					 union net_ip_header *ip_hdr,
+					 uint8_t proto,
+					 uint16_t src_port,
+					 uint16_t dst_port)
+{
+	sa_family_t family = net_pkt_family(pkt);
+	struct net_conn *conn;
+	const void *addr;
+	uint32_t idx;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		addr = ip_hdr->ipv6->src;
+	} else {
+		addr = ip_hdr->ipv4->src;
+	}
+
+	idx = net_conn_hash(proto, family, addr, src_port, dst_port) &
+		CONN_HASH_MASK;
+
+	conn = conn_hash_lookup(&conn_hash[idx], &conn_hash_lock[idx],
+				pkt, ip_hdr, proto, src_port, dst_port);
+	if (conn) {
+		return conn;
+	}
+
+	idx = net_conn_hash(proto, family, NULL, 0, dst_port) &
+		CONN_HASH_MASK;
+
+	return conn_hash_lookup(&conn_listen_hash[idx],
+				&conn_listen_hash_lock[idx],
+				pkt, ip_hdr, proto, src_port, dst_port);
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
+#if defined(CONFIG_NET_CONTEXT_REUSEPORT)
+static bool conn_reuseport_member(struct net_conn *conn,
+				  struct net_conn *member,
+				  struct net_pkt *pkt)
+{
+	if (!(member->flags & NET_CONN_REUSEPORT)) {
+		return false;
+	}
+
+	if (member->context != NULL &&
+	    net_context_is_bound_to_iface(member->context) &&
+	    net_pkt_iface(pkt) != net_context_get_iface(member->context)) {
+		return false;
+	}
+
+	return conn_is_identical(member, conn->proto, conn->family,
+				 (conn->flags & NET_CONN_REMOTE_ADDR_SET) ?
+				 &conn->remote_addr : NULL,
+				 (conn->flags & NET_CONN_LOCAL_ADDR_SET) ?
+				 &conn->local_addr : NULL,
+				 ntohs(net_sin(&conn->remote_addr)->sin_port),
+				 ntohs(net_sin(&conn->local_addr)->sin_port));
+}
+
+/* Pick the member of the SO_REUSEPORT group of conn which serves the flow
+ * of the packet. Each member is scored by mixing the flow hash with its
+ * slot and the highest score wins, so a flow stays on the same member and
+ * only the flows of a member which leaves the group move elsewhere.
+ */
+static struct net_conn *conn_reuseport_select(struct net_conn *conn,
+					      struct net_pkt *pkt,
+					      union net_ip_header *ip_hdr,
+					      uint8_t proto,
+					      uint16_t src_port,
+					      uint16_t dst_port)
+{
+	sa_family_t family = net_pkt_family(pkt);
+	struct net_conn *selected = conn;
+	struct net_conn *member;
+	uint32_t best_score = 0U;
+	uint32_t score;
+	const void *addr;
+	uint32_t hash;
+#if defined(CONFIG_NET_CONN_HASH)
+	struct k_spinlock *lock;
+	k_spinlock_key_t key;
+	sys_slist_t *bucket;
+#endif
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		addr = ip_hdr->ipv6->src;
+	} else {
+		addr = ip_hdr->ipv4->src;
+	}
+
+	hash = net_conn_hash(proto, family, addr, src_port, dst_port);
+
+#if defined(CONFIG_NET_CONN_HASH)
+	/* All the members of a group live in the same bucket */
+	bucket = conn_hash_bucket_of(conn, &lock);
+	if (!bucket) {
+		return conn;
+	}
+
+	key = k_spin_lock(lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(bucket, member, hash_node) {
+#else
+	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, member, node) {
+#endif
+		if (!conn_reuseport_member(conn, member, pkt)) {
+			continue;
+		}
+
+		score = conn_hash_mix(hash, (uint32_t)(member - conns));
+		if (score >= best_score) {
+			best_score = score;
+			selected = member;
+		}
+	}
+
+#if defined(CONFIG_NET_CONN_HASH)
+	k_spin_unlock(lock, key);
+#endif
+
+	return selected;
+}
+#endif /* CONFIG_NET_CONTEXT_REUSEPORT */
+
 static enum net_verdict conn_raw_socket(struct net_pkt *pkt,
 					struct net_conn *conn, uint8_t proto)
 {
@@ -627,6 +1063,18 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
+#if defined(CONFIG_NET_CONN_HASH)
+	if ((proto == IPPROTO_UDP || proto == IPPROTO_TCP) &&
+	    (net_pkt_family(pkt) == AF_INET ||
+	     net_pkt_family(pkt) == AF_INET6) &&
+	    !is_mcast_pkt && !is_bcast_pkt &&
+	    atomic_get(&conn_unhashed) == 0) {
+		best_match = conn_find_hashed(pkt, ip_hdr, proto, src_port,
+					      dst_port);
+		goto deliver;
+	}
+#endif
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
 		if (conn->context != NULL &&
 		    net_context_is_bound_to_iface(conn->context) &&
@@ -697,34 +1145,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 		if (IS_ENABLED(CONFIG_NET_UDP) ||
 		    IS_ENABLED(CONFIG_NET_TCP)) {
-			if (net_sin(&conn->remote_addr)->sin_port) {
-				if (net_sin(&conn->remote_addr)->sin_port !=
-				    src_port) {
-					continue;
-				}
-			}
-
-			if (net_sin(&conn->local_addr)->sin_port) {
-				if (net_sin(&conn->local_addr)->sin_port !=
-				    dst_port) {
-					continue;
-				}
-			}
-
-			if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
-				if (!conn_addr_cmp(pkt, ip_hdr,
-						   &conn->remote_addr,
-						   true)) {
-					continue;
-				}
-			}
-
-			if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
-				if (!conn_addr_cmp(pkt, ip_hdr,
-						   &conn->local_addr,
-						   false)) {
-					continue;
-				}
+			if (!conn_end_points_match(conn, pkt, ip_hdr,
+						   src_port, dst_port)) {
+				continue;
 			}
 
 			/* If we have an existing best_match, and that one
@@ -800,7 +1223,19 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
+#if defined(CONFIG_NET_CONN_HASH)
+deliver:
+#endif
 	conn = best_match;
+
+#if defined(CONFIG_NET_CONTEXT_REUSEPORT)
+	if (conn && (conn->flags & NET_CONN_REUSEPORT) &&
+	    !is_mcast_pkt && !is_bcast_pkt) {
+		conn = conn_reuseport_select(conn, pkt, ip_hdr, proto,
+					     src_port, dst_port);
+	}
+#endif
+
 	if (conn) {
 		NET_DBG("[%p] match found cb %p ud %p rank 0x%02x",
 			conn, conn->cb, conn->user_data, conn->flags);
@@ -860,6 +1295,17 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	for (i = 0; i < CONN_HASH_SIZE; i++) {
+		sys_slist_init(&conn_hash[i]);
+		sys_slist_init(&conn_listen_hash[i]);
+	}
+#endif
+
+#if defined(CONFIG_NET_CONN_HASH) || defined(CONFIG_NET_CONTEXT_REUSEPORT)
+	conn_hash_seed = sys_rand32_get();
+#endif
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
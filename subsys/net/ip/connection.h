@@ -51,6 +51,11 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+#if defined(CONFIG_NET_CONN_HASH)
+	/** Internal slist node for the hash bucket */
+	sys_snode_t hash_node;
+#endif
+
 	/** Remote IP address */
 	struct sockaddr remote_addr;
 
@@ -208,6 +213,26 @@ typedef void (*net_conn_foreach_cb_t)(struct net_conn *conn, void *user_data);
  */
 void net_conn_foreach(net_conn_foreach_cb_t cb, void *user_data);
 
+/**
+ * @brief Calculate the hash of a connection end point tuple.
+ *
+ * The same hash is used by the connection handler lookup and by the TCP
+ * connection lookup. Ports are given in network byte order.
+ *
+ * @param proto Protocol of the connection (IPPROTO_UDP or IPPROTO_TCP)
+ * @param family Protocol family of the remote address
+ * @param remote_addr Remote IPv4 or IPv6 address, NULL if not specified.
+ * @param remote_port Remote port, 0 if not specified.
+ * @param local_port Local port.
+ *
+ * @return Hash value, caller selects the bucket from the low bits.
+ */
+#if defined(CONFIG_NET_CONN_HASH) || defined(CONFIG_NET_CONTEXT_REUSEPORT)
+uint32_t net_conn_hash(uint16_t proto, sa_family_t family,
+		       const void *remote_addr, uint16_t remote_port,
+		       uint16_t local_port);
+#endif
+
 #if defined(CONFIG_NET_NATIVE)
 void net_conn_init(void);
 #else
@@ -48,6 +48,35 @@ static int icmpv4_create(struct net_pkt *pkt, uint8_t icmp_type, uint8_t icmp_co
 	return net_pkt_set_data(pkt, &icmpv4_access);
 }
 
+/* The echo reply carries the payload of the request unchanged, so its
+ * checksum is the one of the request updated for the new type (RFC 1624)
+ * and the payload does not need to be summed again.
+ */
+static int icmpv4_create_echo_reply(struct net_pkt *reply,
+				    struct net_icmp_hdr *req_hdr)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(icmpv4_access,
+					      struct net_icmp_hdr);
+	struct net_icmp_hdr *icmp_hdr;
+
+	icmp_hdr = (struct net_icmp_hdr *)net_pkt_get_data(reply,
+							    &icmpv4_access);
+	if (!icmp_hdr) {
+		return -ENOBUFS;
+	}
+
+	icmp_hdr->type   = NET_ICMPV4_ECHO_REPLY;
+	icmp_hdr->code   = 0U;
+	icmp_hdr->chksum = net_chksum_update16(
+		req_hdr->chksum,
+		htons((uint16_t)(req_hdr->type << 8) | req_hdr->code),
+		htons(NET_ICMPV4_ECHO_REPLY << 8));
+
+	net_pkt_set_chksum_done(reply, true);
+
+	return net_pkt_set_data(reply, &icmpv4_access);
+}
+
 int net_icmpv4_finalize(struct net_pkt *pkt)
 {
 	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(icmpv4_access,
@@ -65,7 +94,9 @@ int net_icmpv4_finalize(struct net_pkt *pkt)
 		return -ENOBUFS;
 	}
 
-	icmp_hdr->chksum = net_calc_chksum_icmpv4(pkt);
+	if (!net_pkt_is_chksum_done(pkt)) {
+		icmp_hdr->chksum = net_calc_chksum_icmpv4(pkt);
+	}
 
 	return net_pkt_set_data(pkt, &icmpv4_access);
 }
@@ -465,7 +496,7 @@ static enum net_verdict icmpv4_handle_echo_request(struct net_pkt *pkt,
 		}
 	}
 
-	if (icmpv4_create(reply, NET_ICMPV4_ECHO_REPLY, 0) ||
+	if (icmpv4_create_echo_reply(reply, icmp_hdr) ||
 	    net_pkt_copy(reply, pkt, payload_len)) {
 		goto drop;
 	}
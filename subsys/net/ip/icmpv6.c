@@ -79,7 +79,9 @@ int net_icmpv6_finalize(struct net_pkt *pkt)
 		return -ENOBUFS;
 	}
 
-	icmp_hdr->chksum = net_calc_chksum_icmpv6(pkt);
+	if (!net_pkt_is_chksum_done(pkt)) {
+		icmp_hdr->chksum = net_calc_chksum_icmpv6(pkt);
+	}
 
 	return net_pkt_set_data(pkt, &icmp_access);
 }
@@ -102,6 +104,45 @@ int net_icmpv6_create(struct net_pkt *pkt, uint8_t icmp_type, uint8_t icmp_code)
 	return net_pkt_set_data(pkt, &icmp_access);
 }
 
+/* The echo reply carries the payload of the request unchanged, so its
+ * checksum is the one of the request updated for the new type and, when
+ * the request was sent to a multicast group, for the new source address
+ * in the pseudo header (RFC 1624).
+ */
+static int icmpv6_create_echo_reply(struct net_pkt *reply,
+				    struct net_ipv6_hdr *req_ip_hdr,
+				    struct net_icmp_hdr *req_hdr,
+				    const struct in6_addr *src)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(icmp_access,
+					      struct net_icmp_hdr);
+	struct net_icmp_hdr *icmp_hdr;
+	uint16_t chksum;
+
+	icmp_hdr = (struct net_icmp_hdr *)net_pkt_get_data(reply, &icmp_access);
+	if (!icmp_hdr) {
+		return -ENOBUFS;
+	}
+
+	chksum = net_chksum_update16(
+		req_hdr->chksum,
+		htons((uint16_t)(req_hdr->type << 8) | req_hdr->code),
+		htons(NET_ICMPV6_ECHO_REPLY << 8));
+
+	if (memcmp(req_ip_hdr->dst, src, sizeof(*src)) != 0) {
+		chksum = net_chksum_update(chksum, req_ip_hdr->dst,
+					   (const uint8_t *)src, sizeof(*src));
+	}
+
+	icmp_hdr->type   = NET_ICMPV6_ECHO_REPLY;
+	icmp_hdr->code   = 0U;
+	icmp_hdr->chksum = chksum;
+
+	net_pkt_set_chksum_done(reply, true);
+
+	return net_pkt_set_data(reply, &icmp_access);
+}
+
 static
 enum net_verdict icmpv6_handle_echo_request(struct net_pkt *pkt,
 					    struct net_ipv6_hdr *ip_hdr,
@@ -111,8 +152,6 @@ enum net_verdict icmpv6_handle_echo_request(struct net_pkt *pkt,
 	const struct in6_addr *src;
 	int16_t payload_len;
 
-	ARG_UNUSED(icmp_hdr);
-
 	NET_DBG("Received Echo Request from %s to %s",
 		log_strdup(net_sprint_ipv6_addr(&ip_hdr->src)),
 		log_strdup(net_sprint_ipv6_addr(&ip_hdr->dst)));
@@ -151,7 +190,7 @@ enum net_verdict icmpv6_handle_echo_request(struct net_pkt *pkt,
 		goto drop;
 	}
 
-	if (net_icmpv6_create(reply, NET_ICMPV6_ECHO_REPLY, 0) ||
+	if (icmpv6_create_echo_reply(reply, ip_hdr, icmp_hdr, src) ||
 	    net_pkt_copy(reply, pkt, payload_len)) {
 		NET_DBG("DROP: wrong buffer");
 		goto drop;
@@ -107,11 +107,15 @@ struct net_ipv6_nbr_data {
 	/** Is the neighbor a router */
 	bool is_router;
 
-#if defined(CONFIG_NET_IPV6_NBR_CACHE) || defined(CONFIG_NET_IPV6_ND)
-	/** Stale counter used to removed oldest nbr in STALE state,
-	 *  when table is full.
+#if defined(CONFIG_NET_IPV6_NBR_CACHE)
+	/** Node in the neighbor address hash */
+	sys_snode_t hash_node;
+
+	/** Uptime in ms when a packet was last sent to the neighbor, used
+	 *  to remove the least recently used neighbor when the table is
+	 *  full.
 	 */
-	uint32_t stale_counter;
+	uint32_t last_used;
 #endif
 };
 
@@ -384,6 +388,21 @@ static inline void net_ipv6_nbr_set_reachable_timer(struct net_if *iface,
 }
 #endif
 
+/**
+ * @brief Forget the neighbors cached in the network contexts.
+ *
+ * @details Must be called when the next hop of a destination may have
+ * changed, i.e. when routes, routers or on-link prefixes are added or
+ * removed.
+ */
+#if defined(CONFIG_NET_IPV6_NBR_DST_CACHE) && defined(CONFIG_NET_NATIVE_IPV6)
+void net_ipv6_nbr_dst_cache_flush(void);
+#else
+static inline void net_ipv6_nbr_dst_cache_flush(void)
+{
+}
+#endif
+
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 /** Store pending IPv6 fragment information that is needed for reassembly. */
 struct net_ipv6_reassembly {
@@ -54,15 +54,6 @@ LOG_MODULE_DECLARE(net_ipv6, CONFIG_NET_IPV6_LOG_LEVEL);
 #define MAX_IPV6_MTU 0xffff
 
 #if defined(CONFIG_NET_IPV6_NBR_CACHE) || defined(CONFIG_NET_IPV6_ND)
-/* Global stale counter, whenever ipv6 neighbor enters into
- * stale state, stale counter is incremented by one.
- * When network stack tries to add new neighbor and if table
- * is full, oldest (oldest stale counter) neighbor in stale
- * state will be removed from the table and new entry will be
- * added.
- */
-static uint32_t stale_counter;
-
 static struct k_sem nbr_lock;
 #endif
 
@@ -97,6 +88,17 @@ NET_NBR_TABLE_INIT(NET_NBR_GLOBAL,
 		   net_neighbor_pool,
 		   net_neighbor_table_clear);
 
+/* The neighbors in use, indexed by a hash of their IPv6 address */
+static sys_slist_t nbr_hash[CONFIG_NET_IPV6_NBR_HASH_SIZE];
+static struct k_spinlock nbr_hash_lock;
+
+#if defined(CONFIG_NET_IPV6_NBR_DST_CACHE)
+/* Changed whenever a neighbor cached in a net_context may have become
+ * invalid.
+ */
+static atomic_t nbr_dst_cache_gen;
+#endif
+
 const char *net_ipv6_nbr_state2str(enum net_ipv6_nbr_state state)
 {
 	switch (state) {
@@ -124,17 +126,22 @@ static inline struct net_nbr *get_nbr(int idx)
 
 static inline struct net_nbr *get_nbr_from_data(struct net_ipv6_nbr_data *data)
 {
-	int i;
+	/* The data is always stored right after the generic part */
+	return CONTAINER_OF((uint8_t *)data, struct net_nbr, __nbr);
+}
 
-	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
-		struct net_nbr *nbr = get_nbr(i);
+static inline sys_slist_t *nbr_hash_bucket(const struct in6_addr *addr)
+{
+	/* The interface identifier is the part which differs between the
+	 * neighbors of a link.
+	 */
+	uint32_t hash = sys_get_be32(&addr->s6_addr[8]) ^
+			sys_get_be32(&addr->s6_addr[12]);
 
-		if (nbr->data == (uint8_t *)data) {
-			return nbr;
-		}
-	}
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
 
-	return NULL;
+	return &nbr_hash[hash % CONFIG_NET_IPV6_NBR_HASH_SIZE];
 }
 
 static void ipv6_nbr_set_state(struct net_nbr *nbr,
@@ -150,43 +157,6 @@ static void ipv6_nbr_set_state(struct net_nbr *nbr,
 		net_ipv6_nbr_state2str(new_state));
 
 	net_ipv6_nbr_data(nbr)->state = new_state;
-
-	if (net_ipv6_nbr_data(nbr)->state == NET_IPV6_NBR_STATE_STALE) {
-		if (stale_counter + 1 != UINT32_MAX) {
-			net_ipv6_nbr_data(nbr)->stale_counter = stale_counter++;
-		} else {
-			/* Global stale counter reached UINT32_MAX, reset it and
-			 * respective neighbors stale counter too.
-			 */
-			struct net_nbr *n = NULL;
-			struct net_ipv6_nbr_data *data = NULL;
-			int i;
-
-			k_sem_take(&nbr_lock, K_FOREVER);
-
-			stale_counter = 0U;
-
-			for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
-				n = get_nbr(i);
-				if (!n || !n->ref) {
-					continue;
-				}
-
-				data = net_ipv6_nbr_data(nbr);
-				if (!data) {
-					continue;
-				}
-
-				if (data->state != NET_IPV6_NBR_STATE_STALE) {
-					continue;
-				}
-
-				data->stale_counter = stale_counter++;
-			}
-
-			k_sem_give(&nbr_lock);
-		}
-	}
 }
 
 struct iface_cb_data {
@@ -259,27 +229,110 @@ static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
 				  struct net_if *iface,
 				  const struct in6_addr *addr)
 {
-	int i;
+	struct net_ipv6_nbr_data *data;
+	struct net_nbr *found = NULL;
+	k_spinlock_key_t key;
 
-	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
-		struct net_nbr *nbr = get_nbr(i);
+	ARG_UNUSED(table);
 
-		if (!nbr->ref) {
-			continue;
-		}
+	key = k_spin_lock(&nbr_hash_lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(nbr_hash_bucket(addr), data, hash_node) {
+		struct net_nbr *nbr = get_nbr_from_data(data);
 
 		if (iface && nbr->iface != iface) {
 			continue;
 		}
 
-		if (net_ipv6_addr_cmp(&net_ipv6_nbr_data(nbr)->addr, addr)) {
-			return nbr;
+		if (net_ipv6_addr_cmp(&data->addr, addr)) {
+			found = nbr;
+			break;
 		}
 	}
 
-	return NULL;
+	k_spin_unlock(&nbr_hash_lock, key);
+
+	return found;
+}
+
+static void nbr_hash_add(struct net_nbr *nbr)
+{
+	struct net_ipv6_nbr_data *data = net_ipv6_nbr_data(nbr);
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&nbr_hash_lock);
+	sys_slist_prepend(nbr_hash_bucket(&data->addr), &data->hash_node);
+	k_spin_unlock(&nbr_hash_lock, key);
+}
+
+static void nbr_hash_remove(struct net_nbr *nbr)
+{
+	struct net_ipv6_nbr_data *data = net_ipv6_nbr_data(nbr);
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&nbr_hash_lock);
+	sys_slist_find_and_remove(nbr_hash_bucket(&data->addr),
+				  &data->hash_node);
+	k_spin_unlock(&nbr_hash_lock, key);
+}
+
+#if defined(CONFIG_NET_IPV6_NBR_DST_CACHE)
+void net_ipv6_nbr_dst_cache_flush(void)
+{
+	atomic_inc(&nbr_dst_cache_gen);
+}
+
+/* Use the neighbor the context sent its previous packet to, if nothing
+ * which could change the next hop happened since then.
+ */
+static bool nbr_dst_cache_get(struct net_pkt *pkt, const struct in6_addr *dst)
+{
+	struct net_context *ctx = net_pkt_context(pkt);
+	struct net_linkaddr_storage *lladdr;
+	struct net_nbr *nbr;
+
+	if (!ctx || !(ctx->flags & NET_CONTEXT_REMOTE_ADDR_SET) ||
+	    ctx->ipv6_nbr_cache.gen != (uint32_t)atomic_get(&nbr_dst_cache_gen)) {
+		return false;
+	}
+
+	nbr = ctx->ipv6_nbr_cache.nbr;
+	if (!nbr || !nbr->ref || nbr->idx == NET_NBR_LLADDR_UNKNOWN ||
+	    net_ipv6_nbr_data(nbr)->state != NET_IPV6_NBR_STATE_REACHABLE ||
+	    !net_ipv6_addr_cmp(&ctx->ipv6_nbr_cache.dst, dst)) {
+		return false;
+	}
+
+	lladdr = net_nbr_get_lladdr(nbr->idx);
+
+	net_pkt_set_iface(pkt, ctx->ipv6_nbr_cache.iface);
+	net_pkt_lladdr_dst(pkt)->addr = lladdr->addr;
+	net_pkt_lladdr_dst(pkt)->len = lladdr->len;
+
+	net_ipv6_nbr_data(nbr)->last_used = k_uptime_get_32();
+
+	net_stats_update_ipv6_nd_nbr_ctx_hit(net_pkt_iface(pkt));
+
+	return true;
 }
 
+static void nbr_dst_cache_set(struct net_pkt *pkt, const struct in6_addr *dst,
+			      struct net_nbr *nbr, uint32_t gen)
+{
+	struct net_context *ctx = net_pkt_context(pkt);
+
+	if (!ctx || !(ctx->flags & NET_CONTEXT_REMOTE_ADDR_SET) ||
+	    net_ipv6_nbr_data(nbr)->state != NET_IPV6_NBR_STATE_REACHABLE) {
+		return;
+	}
+
+	net_ipaddr_copy(&ctx->ipv6_nbr_cache.dst, dst);
+	ctx->ipv6_nbr_cache.nbr = nbr;
+	ctx->ipv6_nbr_cache.iface = net_pkt_iface(pkt);
+	ctx->ipv6_nbr_cache.gen = gen;
+}
+#endif /* CONFIG_NET_IPV6_NBR_DST_CACHE */
+
 static inline void nbr_clear_ns_pending(struct net_ipv6_nbr_data *data)
 {
 	data->send_ns = 0;
@@ -412,11 +465,14 @@ static void nbr_init(struct net_nbr *nbr, struct net_if *iface,
 	net_ipv6_nbr_data(nbr)->is_router = is_router;
 	net_ipv6_nbr_data(nbr)->pending = NULL;
 	net_ipv6_nbr_data(nbr)->send_ns = 0;
+	net_ipv6_nbr_data(nbr)->last_used = k_uptime_get_32();
 
 #if defined(CONFIG_NET_IPV6_ND)
 	net_ipv6_nbr_data(nbr)->reachable = 0;
 	net_ipv6_nbr_data(nbr)->reachable_timeout = 0;
 #endif
+
+	nbr_hash_add(nbr);
 }
 
 static struct net_nbr *nbr_new(struct net_if *iface,
@@ -500,50 +556,58 @@ static void dbg_update_neighbor_lladdr_raw(uint8_t *new_lladdr,
 #define dbg_addr_sent_tgt(pkt_str, src, dst, tgt, pkt)		\
 	dbg_addr_with_tgt("Sent", pkt_str, src, dst, tgt, pkt)
 
-static void ipv6_nd_remove_old_stale_nbr(void)
+/* Remove the least recently used neighbor to make room for a new one.
+ * Stale neighbors go first as they are not known to be reachable anyway.
+ * Routers, static entries and neighbors which are still being resolved
+ * are kept.
+ */
+static void ipv6_nbr_evict(void)
 {
-	struct net_nbr *nbr = NULL;
-	struct net_ipv6_nbr_data *data = NULL;
-	int nbr_idx = -1;
-	uint32_t oldest = UINT32_MAX;
+	struct net_ipv6_nbr_data *data, *oldest = NULL;
+	struct net_nbr *nbr, *victim = NULL;
+	bool stale, victim_stale = false;
 	int i;
 
 	k_sem_take(&nbr_lock, K_FOREVER);
 
 	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
 		nbr = get_nbr(i);
-		if (!nbr || !nbr->ref) {
+		if (!nbr->ref) {
 			continue;
 		}
 
 		data = net_ipv6_nbr_data(nbr);
-		if (!data || data->is_router ||
-		    data->state != NET_IPV6_NBR_STATE_STALE) {
+		if (data->is_router ||
+		    data->state == NET_IPV6_NBR_STATE_STATIC ||
+		    data->state == NET_IPV6_NBR_STATE_INCOMPLETE) {
 			continue;
 		}
 
-		if (nbr_idx == -1) {
-			nbr_idx = i;
-			oldest = data->stale_counter;
-			continue;
-		}
+		stale = data->state == NET_IPV6_NBR_STATE_STALE;
 
-		if (oldest == MIN(oldest, data->stale_counter)) {
-			continue;
+		if (victim) {
+			if (victim_stale && !stale) {
+				continue;
+			}
+
+			if (stale == victim_stale &&
+			    (int32_t)(data->last_used - oldest->last_used) >= 0) {
+				continue;
+			}
 		}
 
-		nbr_idx = i;
-		oldest = data->stale_counter;
+		victim = nbr;
+		victim_stale = stale;
+		oldest = data;
 	}
 
-	if (nbr_idx != -1) {
-		nbr = get_nbr(nbr_idx);
-		if (!nbr) {
-			return;
-		}
+	if (victim) {
+		NET_DBG("nbr %p evicting %s", victim,
+			log_strdup(net_sprint_ipv6_addr(&oldest->addr)));
+
+		net_stats_update_ipv6_nd_nbr_evicted(victim->iface);
 
-		net_ipv6_nbr_rm(nbr->iface,
-				&net_ipv6_nbr_data(nbr)->addr);
+		net_ipv6_nbr_rm(victim->iface, &oldest->addr);
 	}
 
 	k_sem_give(&nbr_lock);
@@ -566,10 +630,10 @@ static struct net_nbr *add_nbr(struct net_if *iface,
 		return nbr;
 	}
 
-	/* Check if there are any stale neighbors, delete the oldest
-	 * one and try to add new neighbor.
+	/* The table is full, delete the least recently used neighbor
+	 * and try to add new neighbor.
 	 */
-	ipv6_nd_remove_old_stale_nbr();
+	ipv6_nbr_evict();
 
 	nbr = nbr_new(iface, addr, is_router, state);
 	if (!nbr) {
@@ -653,7 +717,8 @@ void net_neighbor_data_remove(struct net_nbr *nbr)
 {
 	NET_DBG("Neighbor %p removed", nbr);
 
-	return;
+	nbr_hash_remove(nbr);
+	net_ipv6_nbr_dst_cache_flush();
 }
 
 void net_neighbor_table_clear(struct net_nbr_table *table)
@@ -776,6 +841,9 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 	struct net_if *iface = NULL;
 	struct net_ipv6_hdr *ip_hdr;
 	struct net_nbr *nbr;
+#if defined(CONFIG_NET_IPV6_NBR_DST_CACHE)
+	uint32_t gen;
+#endif
 	int ret;
 
 	NET_ASSERT(pkt && pkt->buffer);
@@ -787,9 +855,11 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 	/* If we have already fragmented the packet, the fragment id will
-	 * contain a proper value and we can skip other checks.
+	 * contain a proper value and we can skip other checks. TCP
+	 * segmentation offload packets are split into segments that fit
+	 * the MTU before they are sent.
 	 */
-	if (net_pkt_ipv6_fragment_id(pkt) == 0U) {
+	if (net_pkt_ipv6_fragment_id(pkt) == 0U && !net_pkt_gso_size(pkt)) {
 		uint16_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
 		size_t pkt_len = net_pkt_get_len(pkt);
 
@@ -854,6 +924,17 @@ ignore_frag_error:
 		return NET_OK;
 	}
 
+#if defined(CONFIG_NET_IPV6_NBR_DST_CACHE)
+	if (nbr_dst_cache_get(pkt, (struct in6_addr *)ip_hdr->dst)) {
+		return NET_OK;
+	}
+
+	/* Read before the lookups, a change during them makes the result
+	 * stale.
+	 */
+	gen = (uint32_t)atomic_get(&nbr_dst_cache_gen);
+#endif
+
 	if (net_if_ipv6_addr_onlink(&iface, (struct in6_addr *)ip_hdr->dst)) {
 		nexthop = (struct in6_addr *)ip_hdr->dst;
 		net_pkt_set_iface(pkt, iface);
@@ -920,6 +1001,14 @@ try_send:
 			log_strdup(net_sprint_ll_addr(lladdr->addr,
 						      lladdr->len)));
 
+		net_ipv6_nbr_data(nbr)->last_used = k_uptime_get_32();
+		net_stats_update_ipv6_nd_nbr_hit(net_pkt_iface(pkt));
+
+#if defined(CONFIG_NET_IPV6_NBR_DST_CACHE)
+		nbr_dst_cache_set(pkt, (struct in6_addr *)ip_hdr->dst, nbr,
+				  gen);
+#endif
+
 		/* Start the NUD if we are in STALE state.
 		 * See RFC 4861 ch 7.3.3 for details.
 		 */
@@ -934,6 +1023,8 @@ try_send:
 		return NET_OK;
 	}
 
+	net_stats_update_ipv6_nd_nbr_miss(net_pkt_iface(pkt));
+
 #if defined(CONFIG_NET_IPV6_ND)
 	/* We need to send NS and wait for NA before sending the packet. */
 	ret = net_ipv6_send_ns(net_pkt_iface(pkt), pkt,
@@ -1416,9 +1507,12 @@ static void ipv6_nd_restart_reachable_timer(struct net_nbr *nbr, int64_t time)
 		net_ipv6_nbr_data(nbr)->reachable_timeout = time;
 	}
 
+	/* A timer which fires a little after the requested time is kept,
+	 * so that close timeouts are handled in the same run.
+	 */
 	remaining = k_ticks_to_ms_ceil32(
 		k_work_delayable_remaining_get(&ipv6_nd_reachable_timer));
-	if (!remaining || remaining > time) {
+	if (!remaining || remaining > time + CONFIG_NET_IPV6_NBR_TIMER_SLACK) {
 		k_work_reschedule(&ipv6_nd_reachable_timer, K_MSEC(time));
 	}
 }
@@ -1448,8 +1542,11 @@ static void ipv6_nd_reachable_timeout(struct k_work *work)
 			continue;
 		}
 
+		/* Handle the neighbors which would time out soon now too
+		 * instead of waking up again for them.
+		 */
 		remaining = data->reachable + data->reachable_timeout - current;
-		if (remaining > 0) {
+		if (remaining > CONFIG_NET_IPV6_NBR_TIMER_SLACK) {
 			ipv6_nd_restart_reachable_timer(NULL, remaining);
 			continue;
 		}
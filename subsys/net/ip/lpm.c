@@ -0,0 +1,259 @@
+/** @file
+ * @brief Longest prefix match table
+ *
+ * Path compressed binary trie (Patricia trie). Every node stores its full
+ * prefix, the child to follow is selected by the first bit after it.
+ */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/util.h>
+
+#include "lpm.h"
+
+static inline int get_bit(const uint8_t *key, int bit)
+{
+	return (key[bit / 8] >> (7 - bit % 8)) & 1;
+}
+
+/* Number of leading bits which are the same in a and b, at most max */
+static int common_len(const uint8_t *a, const uint8_t *b, int max)
+{
+	int len = 0;
+
+	while (len < max) {
+		uint8_t diff = a[len / 8] ^ b[len / 8];
+
+		if (diff) {
+			len += __builtin_clz(diff) - 24;
+			break;
+		}
+
+		len += 8;
+	}
+
+	return MIN(len, max);
+}
+
+static inline bool node_matches(struct net_lpm_node *node, const uint8_t *key)
+{
+	return common_len(key, node->prefix, node->prefix_len) ==
+		node->prefix_len;
+}
+
+static struct net_lpm_node *node_alloc(struct net_lpm *lpm,
+				       const uint8_t *prefix,
+				       uint8_t prefix_len)
+{
+	struct net_lpm_node *node;
+	int i;
+
+	for (i = 0; i < lpm->node_count; i++) {
+		node = &lpm->nodes[i];
+
+		if (node->in_use) {
+			continue;
+		}
+
+		memset(node, 0, sizeof(*node));
+		node->in_use = true;
+		node->prefix_len = prefix_len;
+
+		memcpy(node->prefix, prefix, prefix_len / 8);
+		if (prefix_len % 8) {
+			node->prefix[prefix_len / 8] = prefix[prefix_len / 8] &
+				(0xff << (8 - prefix_len % 8));
+		}
+
+		return node;
+	}
+
+	return NULL;
+}
+
+/* Wait until the lookups which started before now are finished */
+static void lpm_synchronize(struct net_lpm *lpm)
+{
+	int idx = atomic_inc(&lpm->epoch) & 1;
+
+	while (atomic_get(&lpm->readers[idx]) != 0) {
+		k_msleep(1);
+	}
+}
+
+struct net_lpm_entry *net_lpm_lookup(struct net_lpm *lpm, const uint8_t *key,
+				     net_lpm_match_cb_t cb, void *user_data)
+{
+	struct net_lpm_node *node = atomic_ptr_get(&lpm->root);
+	struct net_lpm_entry *found = NULL;
+	struct net_lpm_entry *entry;
+
+	while (node && node_matches(node, key)) {
+		for (entry = atomic_ptr_get(&node->entries); entry;
+		     entry = atomic_ptr_get(&entry->next)) {
+			if (!cb || cb(entry, user_data)) {
+				found = entry;
+				break;
+			}
+		}
+
+		if (node->prefix_len >= lpm->bits) {
+			break;
+		}
+
+		node = atomic_ptr_get(&node->child[get_bit(key,
+							   node->prefix_len)]);
+	}
+
+	return found;
+}
+
+int net_lpm_insert(struct net_lpm *lpm, const uint8_t *prefix,
+		   uint8_t prefix_len, struct net_lpm_entry *entry)
+{
+	atomic_ptr_t *link = &lpm->root;
+	struct net_lpm_node *node, *new, *branch;
+	int common = 0;
+
+	if (prefix_len > lpm->bits) {
+		return -EINVAL;
+	}
+
+	while ((node = atomic_ptr_get(link)) != NULL) {
+		common = common_len(prefix, node->prefix,
+				    MIN(prefix_len, node->prefix_len));
+		if (common < node->prefix_len) {
+			break;
+		}
+
+		if (node->prefix_len == prefix_len) {
+			atomic_ptr_set(&entry->next,
+				       atomic_ptr_get(&node->entries));
+			atomic_ptr_set(&node->entries, entry);
+			return 0;
+		}
+
+		link = &node->child[get_bit(prefix, node->prefix_len)];
+	}
+
+	new = node_alloc(lpm, prefix, prefix_len);
+	if (!new) {
+		return -ENOMEM;
+	}
+
+	atomic_ptr_set(&entry->next, NULL);
+	atomic_ptr_set(&new->entries, entry);
+
+	/* The new nodes are complete before they are linked to the trie,
+	 * so a concurrent lookup sees either the old or the new trie.
+	 */
+	if (!node) {
+		atomic_ptr_set(link, new);
+		return 0;
+	}
+
+	if (common == prefix_len) {
+		/* The new prefix contains the prefix of the node */
+		atomic_ptr_set(&new->child[get_bit(node->prefix, prefix_len)],
+			       node);
+		atomic_ptr_set(link, new);
+		return 0;
+	}
+
+	branch = node_alloc(lpm, prefix, common);
+	if (!branch) {
+		new->in_use = false;
+		return -ENOMEM;
+	}
+
+	atomic_ptr_set(&branch->child[get_bit(prefix, common)], new);
+	atomic_ptr_set(&branch->child[get_bit(node->prefix, common)], node);
+	atomic_ptr_set(link, branch);
+
+	return 0;
+}
+
+int net_lpm_remove(struct net_lpm *lpm, const uint8_t *prefix,
+		   uint8_t prefix_len, struct net_lpm_entry *entry)
+{
+	struct net_lpm_node *retired[2] = { NULL, NULL };
+	atomic_ptr_t *link = &lpm->root;
+	atomic_ptr_t *parent_link = NULL;
+	struct net_lpm_node *parent = NULL;
+	struct net_lpm_node *node, *child[2];
+	struct net_lpm_entry *cur;
+	atomic_ptr_t *entry_link;
+	int i;
+
+	while ((node = atomic_ptr_get(link)) != NULL) {
+		if (node->prefix_len > prefix_len ||
+		    !node_matches(node, prefix)) {
+			return -ENOENT;
+		}
+
+		if (node->prefix_len == prefix_len) {
+			break;
+		}
+
+		parent_link = link;
+		parent = node;
+		link = &node->child[get_bit(prefix, node->prefix_len)];
+	}
+
+	if (!node) {
+		return -ENOENT;
+	}
+
+	for (entry_link = &node->entries;
+	     (cur = atomic_ptr_get(entry_link)) != NULL;
+	     entry_link = &cur->next) {
+		if (cur == entry) {
+			break;
+		}
+	}
+
+	if (!cur) {
+		return -ENOENT;
+	}
+
+	/* The next pointer of the entry is kept, lookups standing on it
+	 * can still continue.
+	 */
+	atomic_ptr_set(entry_link, atomic_ptr_get(&entry->next));
+
+	child[0] = atomic_ptr_get(&node->child[0]);
+	child[1] = atomic_ptr_get(&node->child[1]);
+
+	/* A node without values is only needed as a branch point */
+	if (!atomic_ptr_get(&node->entries) && !(child[0] && child[1])) {
+		atomic_ptr_set(link, child[0] ? child[0] : child[1]);
+		retired[0] = node;
+
+		/* The parent may have been a branch point to this node */
+		if (!child[0] && !child[1] && parent &&
+		    !atomic_ptr_get(&parent->entries)) {
+			i = (link == &parent->child[0]) ? 1 : 0;
+
+			atomic_ptr_set(parent_link,
+				       atomic_ptr_get(&parent->child[i]));
+			retired[1] = parent;
+		}
+	}
+
+	lpm_synchronize(lpm);
+
+	for (i = 0; i < ARRAY_SIZE(retired); i++) {
+		if (retired[i]) {
+			retired[i]->in_use = false;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,207 @@
+/** @file
+ * @brief Longest prefix match table
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __LPM_H
+#define __LPM_H
+
+#include <kernel.h>
+#include <sys/atomic.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Longest key, in bits, that can be stored in the table */
+#define NET_LPM_MAX_BITS 128
+
+/**
+ * @brief Value stored in the table. Embedded in the user's structure,
+ * several values can share the same prefix.
+ */
+struct net_lpm_entry {
+	/** Next value with the same prefix */
+	atomic_ptr_t next;
+};
+
+/**
+ * @brief Node of the path compressed binary trie. A node either holds
+ * values for its prefix or is a branch point with two children.
+ */
+struct net_lpm_node {
+	/** Children selected by the bit following the prefix */
+	atomic_ptr_t child[2];
+
+	/** Values with exactly this prefix */
+	atomic_ptr_t entries;
+
+	/** Prefix bits, the bits after prefix_len are zero */
+	uint8_t prefix[NET_LPM_MAX_BITS / 8];
+
+	/** Prefix length in bits */
+	uint8_t prefix_len;
+
+	/** Is the node allocated */
+	bool in_use;
+};
+
+/**
+ * @brief Longest prefix match table.
+ *
+ * Lookups do not take any lock, they only mark themselves as readers of the
+ * current epoch, see net_lpm_read_lock(). Updates must be serialized by the
+ * caller. An update publishes new nodes with a single pointer store and
+ * waits for the readers of the previous epoch to finish before a removed
+ * node or value can be reused.
+ */
+struct net_lpm {
+	/** Root of the trie */
+	atomic_ptr_t root;
+
+	/** Node pool */
+	struct net_lpm_node *nodes;
+
+	/** Number of nodes in the pool */
+	uint16_t node_count;
+
+	/** Length of the keys in bits */
+	uint8_t bits;
+
+	/** Current read epoch, only the lowest bit is used as an index */
+	atomic_t epoch;
+
+	/** Number of lookups running in each epoch */
+	atomic_t readers[2];
+};
+
+/**
+ * @brief Statically define a longest prefix match table.
+ *
+ * @details A trie with n prefixes never needs more than 2 * n - 1 nodes.
+ *
+ * @param _name Name of the table
+ * @param _max_prefixes Maximum number of different prefixes in the table
+ * @param _bits Key length in bits, 32 for IPv4 and 128 for IPv6
+ */
+#define NET_LPM_DEFINE(_name, _max_prefixes, _bits)			\
+	static struct net_lpm_node _name##_nodes[2 * (_max_prefixes)];	\
+	static struct net_lpm _name = {					\
+		.nodes = _name##_nodes,					\
+		.node_count = 2 * (_max_prefixes),			\
+		.bits = (_bits),					\
+	}
+
+/**
+ * @brief Start a lookup section.
+ *
+ * @details Values found in the section stay valid until
+ * net_lpm_read_unlock() is called, even if they are removed at the same
+ * time. The section must not block.
+ *
+ * @param lpm Table
+ *
+ * @return Epoch index to give to net_lpm_read_unlock()
+ */
+static inline int net_lpm_read_lock(struct net_lpm *lpm)
+{
+	int idx;
+
+	do {
+		idx = atomic_get(&lpm->epoch) & 1;
+		atomic_inc(&lpm->readers[idx]);
+
+		/* An update may have switched the epoch and checked our
+		 * counter before we incremented it, use the new epoch then.
+		 */
+		if ((atomic_get(&lpm->epoch) & 1) == idx) {
+			break;
+		}
+
+		atomic_dec(&lpm->readers[idx]);
+	} while (true);
+
+	return idx;
+}
+
+/**
+ * @brief End a lookup section.
+ *
+ * @param lpm Table
+ * @param idx Value returned by net_lpm_read_lock()
+ */
+static inline void net_lpm_read_unlock(struct net_lpm *lpm, int idx)
+{
+	atomic_dec(&lpm->readers[idx]);
+}
+
+/**
+ * @brief Callback used to select a value during a lookup.
+ *
+ * @param entry Value with a prefix matching the key
+ * @param user_data User supplied data
+ *
+ * @return True if the value can be returned, false to keep looking.
+ */
+typedef bool (*net_lpm_match_cb_t)(struct net_lpm_entry *entry,
+				   void *user_data);
+
+/**
+ * @brief Find the value with the longest prefix matching a key.
+ *
+ * @details Must be called in a section started by net_lpm_read_lock().
+ *
+ * @param lpm Table
+ * @param key Key, lpm->bits long
+ * @param cb Callback selecting the values, NULL to accept any value
+ * @param user_data User data given to the callback
+ *
+ * @return The value with the longest matching prefix, NULL if none.
+ */
+struct net_lpm_entry *net_lpm_lookup(struct net_lpm *lpm, const uint8_t *key,
+				     net_lpm_match_cb_t cb, void *user_data);
+
+/**
+ * @brief Add a value to the table.
+ *
+ * @param lpm Table
+ * @param prefix Prefix, the bits after prefix_len are ignored
+ * @param prefix_len Prefix length in bits
+ * @param entry Value to add
+ *
+ * @return 0 on success, -EINVAL if the prefix is too long, -ENOMEM if
+ *         there are no free nodes.
+ */
+int net_lpm_insert(struct net_lpm *lpm, const uint8_t *prefix,
+		   uint8_t prefix_len, struct net_lpm_entry *entry);
+
+/**
+ * @brief Remove a value from the table.
+ *
+ * @details Waits until the lookups which may still see the value are
+ * finished, so the value can be reused when the function returns. Must
+ * not be called from a lookup section.
+ *
+ * @param lpm Table
+ * @param prefix Prefix the value was added with
+ * @param prefix_len Prefix length in bits
+ * @param entry Value to remove
+ *
+ * @return 0 on success, -ENOENT if the value was not in the table.
+ */
+int net_lpm_remove(struct net_lpm *lpm, const uint8_t *prefix,
+		   uint8_t prefix_len, struct net_lpm_entry *entry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LPM_H */
@@ -1245,15 +1245,86 @@ static int get_context_sndtimeo(struct net_context *context,
 #endif
 }
 
+static int get_context_rcvbuf(struct net_context *context,
+			      void *value, size_t *len)
+{
+#if defined(CONFIG_NET_CONTEXT_RCVBUF)
+	*((uint32_t *)value) = context->options.rcvbuf;
+
+	if (len) {
+		*len = sizeof(uint32_t);
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+static int get_context_sndbuf(struct net_context *context,
+			      void *value, size_t *len)
+{
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+	*((uint32_t *)value) = context->options.sndbuf;
+
+	if (len) {
+		*len = sizeof(uint32_t);
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+static int get_context_reuseport(struct net_context *context,
+				 void *value, size_t *len)
+{
+#if defined(CONFIG_NET_CONTEXT_REUSEPORT)
+	*((bool *)value) = context->options.reuseport;
+
+	if (len) {
+		*len = sizeof(bool);
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+static int get_context_tcp_congestion(struct net_context *context,
+				      void *value, size_t *len)
+{
+	if (net_context_get_ip_proto(context) != IPPROTO_TCP || !len) {
+		return -EINVAL;
+	}
+
+	return net_tcp_get_congestion(context, value, len);
+}
+
 /* If buf is not NULL, then use it. Otherwise read the data to be written
  * to net_pkt from msghdr.
  */
 static int context_write_data(struct net_pkt *pkt, const void *buf,
-			      int buf_len, const struct msghdr *msghdr)
+			      int buf_len, const struct msghdr *msghdr,
+			      struct net_buf *frags)
 {
 	int ret = 0;
 
-	if (msghdr) {
+	if (frags) {
+		/* Only the headers were allocated, drop the buffer if it
+		 * is not going to hold any so that TCP does not queue it.
+		 */
+		if (pkt->buffer && pkt->buffer->len == 0U &&
+		    pkt->buffer->frags == NULL) {
+			net_pkt_frag_unref(pkt->buffer);
+			pkt->buffer = NULL;
+		}
+
+		/* The caller keeps its own reference to the chain */
+		net_pkt_append_buffer(pkt, net_buf_ref(frags));
+	} else if (msghdr) {
 		int i;
 
 		for (i = 0; i < msghdr->msg_iovlen; i++) {
@@ -1282,6 +1353,7 @@ static int context_setup_udp_packet(struct net_context *context,
 				    const void *buf,
 				    size_t len,
 				    const struct msghdr *msg,
+				    struct net_buf *frags,
 				    const struct sockaddr *dst_addr,
 				    socklen_t addrlen)
 {
@@ -1323,7 +1395,7 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = context_write_data(pkt, buf, len, msg);
+	ret = context_write_data(pkt, buf, len, msg, frags);
 	if (ret) {
 		return ret;
 	}
@@ -1411,7 +1483,8 @@ static int context_sendto(struct net_context *context,
 			  net_context_send_cb_t cb,
 			  k_timeout_t timeout,
 			  void *user_data,
-			  bool sendto)
+			  bool sendto,
+			  struct net_buf *frags)
 {
 	const struct msghdr *msghdr = NULL;
 	struct net_if *iface;
@@ -1608,7 +1681,9 @@ static int context_sendto(struct net_context *context,
 		return -EINVAL;
 	}
 
-	if (msghdr && len == 0) {
+	if (frags) {
+		len = net_buf_frags_len(frags);
+	} else if (msghdr && len == 0) {
 		int i;
 
 		for (i = 0; i < msghdr->msg_iovlen; i++) {
@@ -1621,15 +1696,42 @@ static int context_sendto(struct net_context *context,
 		return -ENETDOWN;
 	}
 
-	pkt = context_alloc_pkt(context, len, PKT_WAIT_TIME);
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+	/* TCP applies the limit to its own send queue */
+	if (context->options.sndbuf &&
+	    net_context_get_ip_proto(context) != IPPROTO_TCP) {
+		atomic_val_t used = atomic_get(&context->sndbuf_used);
+
+		if (used > 0 && used + len > context->options.sndbuf) {
+			if (iface) {
+				net_stats_update_sock_sndbuf_full(iface);
+			}
+
+			return -EAGAIN;
+		}
+	}
+#endif
+
+	/* A loaned chain is linked in as is, allocate the headers only */
+	pkt = context_alloc_pkt(context, frags ? 0 : len, PKT_WAIT_TIME);
 	if (!pkt) {
 		return -ENOBUFS;
 	}
 
-	tmp_len = net_pkt_available_payload_buffer(
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+	if (net_context_get_ip_proto(context) != IPPROTO_TCP) {
+		/* Released when the packet is freed */
+		net_pkt_set_sndbuf_len(pkt, len);
+		atomic_add(&context->sndbuf_used, len);
+	}
+#endif
+
+	if (!frags) {
+		tmp_len = net_pkt_available_payload_buffer(
 				pkt, net_context_get_ip_proto(context));
-	if (tmp_len < len) {
-		len = tmp_len;
+		if (tmp_len < len) {
+			len = tmp_len;
+		}
 	}
 
 	context->send_cb = cb;
@@ -1658,7 +1760,7 @@ static int context_sendto(struct net_context *context,
 
 	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
 	    net_if_is_ip_offloaded(net_context_get_iface(context))) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, frags);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1676,7 +1778,7 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_ip_proto(context) == IPPROTO_UDP) {
 		ret = context_setup_udp_packet(context, pkt, buf, len, msghdr,
-					       dst_addr, addrlen);
+					       frags, dst_addr, addrlen);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1687,7 +1789,7 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_ip_proto(context) == IPPROTO_TCP) {
 
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, frags);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1701,7 +1803,7 @@ static int context_sendto(struct net_context *context,
 		ret = net_tcp_send_data(context, cb, user_data);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) &&
 		   net_context_get_family(context) == AF_PACKET) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, frags);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1717,7 +1819,7 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) &&
 		   net_context_get_family(context) == AF_CAN &&
 		   net_context_get_ip_proto(context) == CAN_RAW) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, frags);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1778,7 +1880,7 @@ int net_context_send(struct net_context *context,
 	}
 
 	ret = context_sendto(context, buf, len, &context->remote,
-			     addrlen, cb, timeout, user_data, false);
+			     addrlen, cb, timeout, user_data, false, NULL);
 unlock:
 	k_mutex_unlock(&context->lock);
 
@@ -1797,7 +1899,7 @@ int net_context_sendmsg(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, msghdr, 0, NULL, 0,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, true, NULL);
 
 	k_mutex_unlock(&context->lock);
 
@@ -1818,13 +1920,48 @@ int net_context_sendto(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, buf, len, dst_addr, addrlen,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, true, NULL);
 
 	k_mutex_unlock(&context->lock);
 
 	return ret;
 }
 
+int net_context_sendto_frags(struct net_context *context,
+			     struct net_buf *frags,
+			     const struct sockaddr *dst_addr,
+			     socklen_t addrlen,
+			     net_context_send_cb_t cb,
+			     k_timeout_t timeout,
+			     void *user_data)
+{
+	bool sendto = dst_addr != NULL;
+	int ret;
+
+	if (!frags) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	if (!sendto) {
+		if (!(context->flags & NET_CONTEXT_REMOTE_ADDR_SET)) {
+			ret = -EDESTADDRREQ;
+			goto unlock;
+		}
+
+		dst_addr = &context->remote;
+		addrlen = sizeof(context->remote);
+	}
+
+	ret = context_sendto(context, NULL, 0, dst_addr, addrlen,
+			     cb, timeout, user_data, sendto, frags);
+unlock:
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+
 enum net_verdict net_context_packet_received(struct net_conn *conn,
 					     struct net_pkt *pkt,
 					     union net_ip_header *ip_hdr,
@@ -2213,6 +2350,81 @@ static int set_context_sndtimeo(struct net_context *context,
 #endif
 }
 
+static int set_context_rcvbuf(struct net_context *context,
+			      const void *value, size_t len)
+{
+#if defined(CONFIG_NET_CONTEXT_RCVBUF)
+	uint32_t size;
+	int ret;
+
+	if (len != sizeof(uint32_t)) {
+		return -EINVAL;
+	}
+
+	size = *((uint32_t *)value);
+
+	if (net_context_get_ip_proto(context) == IPPROTO_TCP) {
+		ret = net_tcp_set_recv_buf(context, size);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	context->options.rcvbuf = size;
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+static int set_context_sndbuf(struct net_context *context,
+			      const void *value, size_t len)
+{
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+	if (len != sizeof(uint32_t)) {
+		return -EINVAL;
+	}
+
+	context->options.sndbuf = *((uint32_t *)value);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+static int set_context_reuseport(struct net_context *context,
+				 const void *value, size_t len)
+{
+#if defined(CONFIG_NET_CONTEXT_REUSEPORT)
+	if (len != sizeof(bool)) {
+		return -EINVAL;
+	}
+
+	/* Group membership is decided when the context is bound */
+	if (net_sin_ptr(&context->local)->sin_port) {
+		return -EISCONN;
+	}
+
+	context->options.reuseport = *((bool *)value);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+static int set_context_tcp_congestion(struct net_context *context,
+				      const void *value, size_t len)
+{
+	if (net_context_get_ip_proto(context) != IPPROTO_TCP) {
+		return -EINVAL;
+	}
+
+	return net_tcp_set_congestion(context, value, len);
+}
+
 int net_context_set_option(struct net_context *context,
 			   enum net_context_option option,
 			   const void *value, size_t len)
@@ -2243,6 +2455,18 @@ int net_context_set_option(struct net_context *context,
 	case NET_OPT_SNDTIMEO:
 		ret = set_context_sndtimeo(context, value, len);
 		break;
+	case NET_OPT_TCP_CONGESTION:
+		ret = set_context_tcp_congestion(context, value, len);
+		break;
+	case NET_OPT_RCVBUF:
+		ret = set_context_rcvbuf(context, value, len);
+		break;
+	case NET_OPT_SNDBUF:
+		ret = set_context_sndbuf(context, value, len);
+		break;
+	case NET_OPT_REUSEPORT:
+		ret = set_context_reuseport(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -2280,6 +2504,18 @@ int net_context_get_option(struct net_context *context,
 	case NET_OPT_SNDTIMEO:
 		ret = get_context_sndtimeo(context, value, len);
 		break;
+	case NET_OPT_TCP_CONGESTION:
+		ret = get_context_tcp_congestion(context, value, len);
+		break;
+	case NET_OPT_RCVBUF:
+		ret = get_context_rcvbuf(context, value, len);
+		break;
+	case NET_OPT_SNDBUF:
+		ret = get_context_sndbuf(context, value, len);
+		break;
+	case NET_OPT_REUSEPORT:
+		ret = get_context_reuseport(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -25,6 +25,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include "net_private.h"
 #include "ipv6.h"
 #include "ipv4_autoconf_internal.h"
+#include "tcp_internal.h"
 
 #include "net_stats.h"
 
@@ -204,6 +205,51 @@ static void update_txtime_stats_detail(struct net_pkt *pkt,
 	}
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+static bool need_tcp_segmentation(struct net_if *iface)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		return !(net_eth_get_hw_capabilities(iface) &
+			 ETHERNET_HW_TX_TSO);
+	}
+#endif
+
+	return true;
+}
+
+/* Split a large TCP packet into MSS sized segments for an interface
+ * which cannot do it in hardware. Like the L2 send function, the packet
+ * is only consumed on success.
+ */
+static int net_if_send_tcp_segments(struct net_if *iface,
+				    struct net_pkt *pkt)
+{
+	struct net_pkt *seg;
+	size_t offset = 0;
+	int sent = 0;
+	int ret;
+
+	while ((ret = net_tcp_gso_segment(pkt, &offset, &seg)) > 0) {
+		ret = net_if_l2(iface)->send(iface, seg);
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			return ret;
+		}
+
+		sent += ret;
+	}
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	net_pkt_unref(pkt);
+
+	return sent;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct net_linkaddr ll_dst = {
@@ -258,7 +304,14 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 			}
 		}
 
-		status = net_if_l2(iface)->send(iface, pkt);
+#if defined(CONFIG_NET_TCP_GSO)
+		if (net_pkt_gso_size(pkt) && need_tcp_segmentation(iface)) {
+			status = net_if_send_tcp_segments(iface, pkt);
+		} else
+#endif
+		{
+			status = net_if_l2(iface)->send(iface, pkt);
+		}
 
 		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
 			uint32_t end_tick = k_cycle_get_32();
@@ -695,6 +748,8 @@ static void iface_router_notify_deletion(struct net_if_router *router,
 					   net_if_router_ipv6(router))),
 			delete_reason);
 
+		net_ipv6_nbr_dst_cache_flush();
+
 		net_mgmt_event_notify_with_info(NET_EVENT_IPV6_ROUTER_DEL,
 						router->iface,
 						&router->address.in6_addr,
@@ -823,6 +878,7 @@ static struct net_if_router *iface_router_add(struct net_if *iface,
 		if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
 			memcpy(net_if_router_ipv6(&routers[i]), addr,
 			       sizeof(struct in6_addr));
+			net_ipv6_nbr_dst_cache_flush();
 			net_mgmt_event_notify_with_info(
 					NET_EVENT_IPV6_ROUTER_ADD, iface,
 					&routers[i].address.in6_addr,
@@ -892,6 +948,8 @@ void net_if_router_rm(struct net_if_router *router)
 
 	router->is_used = false;
 
+	net_ipv6_nbr_dst_cache_flush();
+
 	/* FIXME - remove timer */
 
 	k_mutex_unlock(&lock);
@@ -2240,6 +2298,8 @@ struct net_if_ipv6_prefix *net_if_ipv6_prefix_add(struct net_if *iface,
 		NET_DBG("[%d] interface %p prefix %s/%d added", i, iface,
 			log_strdup(net_sprint_ipv6_addr(prefix)), len);
 
+		net_ipv6_nbr_dst_cache_flush();
+
 		net_mgmt_event_notify_with_info(
 			NET_EVENT_IPV6_PREFIX_ADD, iface,
 			&ipv6->prefix[i].prefix, sizeof(struct in6_addr));
@@ -2287,6 +2347,8 @@ bool net_if_ipv6_prefix_rm(struct net_if *iface, struct in6_addr *addr,
 		 */
 		remove_prefix_addresses(iface, ipv6, addr, len);
 
+		net_ipv6_nbr_dst_cache_flush();
+
 		net_mgmt_event_notify_with_info(
 			NET_EVENT_IPV6_PREFIX_DEL, iface,
 			&ipv6->prefix[i].prefix, sizeof(struct in6_addr));
@@ -497,6 +497,24 @@ static inline struct net_buf_pool *get_data_pool(struct net_context *context)
 #define get_data_pool(...) NULL
 #endif /* CONFIG_NET_CONTEXT_NET_PKT_POOL */
 
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+static void pkt_sndbuf_release(struct net_pkt *pkt)
+{
+	atomic_t *used = &pkt->context->sndbuf_used;
+	atomic_val_t old;
+
+	/* The context may have been released and reset meanwhile, never
+	 * let the counter wrap below zero.
+	 */
+	do {
+		old = atomic_get(used);
+	} while (!atomic_cas(used, old,
+			     old > pkt->sndbuf_len ? old - pkt->sndbuf_len : 0));
+}
+#else
+#define pkt_sndbuf_release(pkt)
+#endif /* CONFIG_NET_CONTEXT_SNDBUF */
+
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
 void net_pkt_unref_debug(struct net_pkt *pkt, const char *caller, int line)
 {
@@ -586,6 +604,11 @@ done:
 		return;
 	}
 
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_SNDBUF) && pkt->context &&
+	    net_pkt_sndbuf_len(pkt)) {
+		pkt_sndbuf_release(pkt);
+	}
+
 	if (pkt->frags) {
 		net_pkt_frag_unref(pkt->frags);
 	}
@@ -816,6 +839,31 @@ bool net_pkt_compact(struct net_pkt *pkt)
 	return true;
 }
 
+#if defined(CONFIG_NET_CONTEXT_RCVBUF)
+enum net_pkt_mem_pressure net_pkt_mem_pressure(void)
+{
+	uint32_t free_pct;
+
+	free_pct = k_mem_slab_num_free_get(&rx_pkts) * 100U /
+		   CONFIG_NET_PKT_RX_COUNT;
+
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+	free_pct = MIN(free_pct, (uint32_t)atomic_get(&rx_bufs.avail_count) *
+			       100U / rx_bufs.buf_count);
+#endif
+
+	if (free_pct <= CONFIG_NET_PKT_PRESSURE_CRITICAL_PERCENT) {
+		return NET_PKT_MEM_PRESSURE_CRITICAL;
+	}
+
+	if (free_pct <= CONFIG_NET_PKT_PRESSURE_LOW_PERCENT) {
+		return NET_PKT_MEM_PRESSURE_LOW;
+	}
+
+	return NET_PKT_MEM_PRESSURE_NONE;
+}
+#endif /* CONFIG_NET_CONTEXT_RCVBUF */
+
 void net_pkt_get_info(struct k_mem_slab **rx,
 		      struct k_mem_slab **tx,
 		      struct net_buf_pool **rx_data,
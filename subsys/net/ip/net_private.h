@@ -90,6 +90,20 @@ static inline enum net_verdict net_ipv6_input(struct net_pkt *pkt,
 #endif
 extern bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt);
 extern void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
+
+#if NET_TC_FLOW_QUEUES > 1 && (NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0)
+/* Select the flow queue of a packet within its traffic class */
+extern int net_tc_flow_queue(struct net_pkt *pkt, bool rx);
+#else
+static inline int net_tc_flow_queue(struct net_pkt *pkt, bool rx)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(rx);
+
+	return 0;
+}
+#endif
+
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -203,6 +217,47 @@ static inline uint16_t net_calc_chksum_tcp(struct net_pkt *pkt)
 	return net_calc_chksum(pkt, IPPROTO_TCP);
 }
 
+/**
+ * @brief Update a checksum after a 16-bit field was rewritten (RFC 1624)
+ *
+ * All values are taken as they are stored in the packet, so no byte order
+ * conversion is needed. Note that a UDP checksum that ends up as 0 needs
+ * to be sent as 0xffff, see net_calc_chksum_udp().
+ *
+ * @param chksum Checksum covering the field
+ * @param old_val Previous value of the field
+ * @param new_val New value of the field
+ *
+ * @return Updated checksum
+ */
+static inline uint16_t net_chksum_update16(uint16_t chksum, uint16_t old_val,
+					   uint16_t new_val)
+{
+	/* HC' = ~(~HC + ~m + m') */
+	uint32_t sum = (uint16_t)~chksum + (uint16_t)~old_val + (uint32_t)new_val;
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return (uint16_t)~sum;
+}
+
+/**
+ * @brief Update a checksum after a field was rewritten (RFC 1624)
+ *
+ * Same as net_chksum_update16() for a field of several 16-bit words,
+ * e.g. an IP address in the pseudo header.
+ *
+ * @param chksum Checksum covering the field
+ * @param old_data Previous contents of the field
+ * @param new_data New contents of the field
+ * @param len Length of the field, must be even
+ *
+ * @return Updated checksum
+ */
+uint16_t net_chksum_update(uint16_t chksum, const uint8_t *old_data,
+			   const uint8_t *new_data, size_t len);
+
 static inline char *net_sprint_ll_addr(const uint8_t *ll, uint8_t ll_len)
 {
 	static char buf[sizeof("xx:xx:xx:xx:xx:xx:xx:xx")];
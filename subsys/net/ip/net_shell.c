@@ -248,6 +248,7 @@ struct ethernet_capabilities {
 static struct ethernet_capabilities eth_hw_caps[] = {
 	EC(ETHERNET_HW_TX_CHKSUM_OFFLOAD, "TX checksum offload"),
 	EC(ETHERNET_HW_RX_CHKSUM_OFFLOAD, "RX checksum offload"),
+	EC(ETHERNET_HW_TX_TSO,            "TCP segmentation offload"),
 	EC(ETHERNET_HW_VLAN,              "Virtual LAN"),
 	EC(ETHERNET_HW_VLAN_TAG_STRIP,    "VLAN Tag stripping"),
 	EC(ETHERNET_AUTO_NEGOTIATION_SET, "Auto negotiation"),
@@ -1209,6 +1210,11 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	   GET_STAT(iface, ipv6_nd.recv),
 	   GET_STAT(iface, ipv6_nd.sent),
 	   GET_STAT(iface, ipv6_nd.drop));
+	PR("IPv6 nbr hit   %d\tmiss\t%d\tctx hit\t%d\tevicted\t%d\n",
+	   GET_STAT(iface, ipv6_nd.nbr_hit),
+	   GET_STAT(iface, ipv6_nd.nbr_miss),
+	   GET_STAT(iface, ipv6_nd.nbr_ctx_hit),
+	   GET_STAT(iface, ipv6_nd.nbr_evicted));
 #endif /* CONFIG_NET_STATISTICS_IPV6_ND */
 #if defined(CONFIG_NET_STATISTICS_MLD)
 	PR("IPv6 MLD recv  %d\tsent\t%d\tdrop\t%d\n",
@@ -1259,6 +1265,13 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	   GET_STAT(iface, udp.chkerr));
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_SOCKET_BUF)
+	PR("Sock rcvbuf    %d\tpressure\t%d\tsndbuf\t%d\n",
+	   GET_STAT(iface, sock_buf.rcvbuf_drop),
+	   GET_STAT(iface, sock_buf.pressure_drop),
+	   GET_STAT(iface, sock_buf.sndbuf_full));
+#endif
+
 #if defined(CONFIG_NET_STATISTICS_TCP) && defined(CONFIG_NET_NATIVE_TCP)
 	PR("TCP bytes recv %u\tsent\t%d\tresent\t%d\n",
 	   GET_STAT(iface, tcp.bytes.received),
@@ -1480,6 +1493,29 @@ static void tcp_cb(struct tcp *conn, void *user_data)
 	(*count)++;
 }
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+static void tcp_cc_cb(struct tcp *conn, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *shell = data->shell;
+	const char *phase;
+
+	if (conn->state != TCP_ESTABLISHED) {
+		phase = "-";
+	} else if (conn->in_recovery) {
+		phase = "recovery";
+	} else if (conn->cwnd < conn->ssthresh) {
+		phase = "slow start";
+	} else {
+		phase = "avoidance";
+	}
+
+	PR("%p %-9s %10u %10u %6u %6u  %s\n",
+	   conn, conn->cc->name, conn->cwnd, conn->ssthresh,
+	   conn->srtt >> 3, conn->rto, phase);
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
 #if CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG
 static void tcp_sent_list_cb(struct tcp *conn, void *user_data)
 {
@@ -2057,6 +2093,13 @@ static int cmd_net_conn(const struct shell *shell, size_t argc, char *argv[])
 			}
 		}
 #endif /* CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG */
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+		PR("\nTCP        Algorithm       Cwnd   Ssthresh   SRTT    RTO  "
+		   "Phase\n");
+
+		net_tcp_foreach(tcp_cc_cb, &user_data);
+#endif
 	}
 
 #if CONFIG_NET_TCP_LOG_LEVEL < LOG_LEVEL_DBG
@@ -133,6 +133,13 @@ static inline void stats(struct net_if *iface)
 			 GET_STAT(iface, udp.chkerr));
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_SOCKET_BUF)
+		NET_INFO("Sock rcvbuf    %d\tpressure\t%d\tsndbuf\t%d",
+			 GET_STAT(iface, sock_buf.rcvbuf_drop),
+			 GET_STAT(iface, sock_buf.pressure_drop),
+			 GET_STAT(iface, sock_buf.sndbuf_full));
+#endif
+
 #if defined(CONFIG_NET_STATISTICS_TCP)
 		NET_INFO("TCP bytes recv %u\tsent\t%d",
 			 GET_STAT(iface, tcp.bytes.received),
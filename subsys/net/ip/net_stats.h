@@ -107,10 +107,34 @@ static inline void net_stats_update_ipv6_nd_drop(struct net_if *iface)
 {
 	UPDATE_STAT(iface, stats.ipv6_nd.drop++);
 }
+
+static inline void net_stats_update_ipv6_nd_nbr_hit(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.ipv6_nd.nbr_hit++);
+}
+
+static inline void net_stats_update_ipv6_nd_nbr_miss(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.ipv6_nd.nbr_miss++);
+}
+
+static inline void net_stats_update_ipv6_nd_nbr_ctx_hit(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.ipv6_nd.nbr_ctx_hit++);
+}
+
+static inline void net_stats_update_ipv6_nd_nbr_evicted(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.ipv6_nd.nbr_evicted++);
+}
 #else
 #define net_stats_update_ipv6_nd_sent(iface)
 #define net_stats_update_ipv6_nd_recv(iface)
 #define net_stats_update_ipv6_nd_drop(iface)
+#define net_stats_update_ipv6_nd_nbr_hit(iface)
+#define net_stats_update_ipv6_nd_nbr_miss(iface)
+#define net_stats_update_ipv6_nd_nbr_ctx_hit(iface)
+#define net_stats_update_ipv6_nd_nbr_evicted(iface)
 #endif /* CONFIG_NET_STATISTICS_IPV6_ND */
 
 #if defined(CONFIG_NET_STATISTICS_IPV4) && defined(CONFIG_NET_NATIVE_IPV4)
@@ -186,6 +210,28 @@ static inline void net_stats_update_udp_chkerr(struct net_if *iface)
 #define net_stats_update_udp_chkerr(iface)
 #endif /* CONFIG_NET_STATISTICS_UDP */
 
+#if defined(CONFIG_NET_STATISTICS_SOCKET_BUF)
+/* Socket buffer stats */
+static inline void net_stats_update_sock_rcvbuf_drop(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.sock_buf.rcvbuf_drop++);
+}
+
+static inline void net_stats_update_sock_pressure_drop(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.sock_buf.pressure_drop++);
+}
+
+static inline void net_stats_update_sock_sndbuf_full(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.sock_buf.sndbuf_full++);
+}
+#else
+#define net_stats_update_sock_rcvbuf_drop(iface)
+#define net_stats_update_sock_pressure_drop(iface)
+#define net_stats_update_sock_sndbuf_full(iface)
+#endif /* CONFIG_NET_STATISTICS_SOCKET_BUF */
+
 #if defined(CONFIG_NET_STATISTICS_TCP) && defined(CONFIG_NET_NATIVE_TCP)
 /* TCP stats */
 static inline void net_stats_update_tcp_sent(struct net_if *iface, uint32_t bytes)
@@ -13,31 +13,189 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <net/net_core.h>
 #include <net/net_pkt.h>
 #include <net/net_stats.h>
+#include <net/ethernet.h>
 
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "tcp_internal.h"
 
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
  * where y indicates the traffic class id. The value of y can be from 0 to 7.
+ * With flow queues, "q[y.z]" denotes the flow queue z of traffic class y.
  */
+#if NET_TC_FLOW_QUEUES > 1
+#define MAX_NAME_LEN sizeof("xx_q[y.z]")
+#else
 #define MAX_NAME_LEN sizeof("xx_q[y]")
+#endif
+
+/* Every traffic class has NET_TC_FLOW_QUEUES queues, the queues of class
+ * tc are found at index tc * NET_TC_FLOW_QUEUES onwards.
+ */
+#define NET_TC_TX_QUEUES (NET_TC_TX_COUNT * NET_TC_FLOW_QUEUES)
+#define NET_TC_RX_QUEUES (NET_TC_RX_COUNT * NET_TC_FLOW_QUEUES)
 
 /* Stacks for TX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_QUEUES,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_QUEUES,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
-static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
+static struct net_traffic_class tx_classes[NET_TC_TX_QUEUES];
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+static struct net_traffic_class rx_classes[NET_TC_RX_QUEUES];
+#endif
+
+#if NET_TC_FLOW_QUEUES > 1 && (NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0)
+static inline uint32_t flow_hash_mix(uint32_t hash, uint32_t val)
+{
+	hash ^= val;
+	hash *= 0x9e3779b1U;
+
+	return hash ^ (hash >> 15);
+}
+
+/* Hash the addresses, protocol and ports of the IP packet starting at the
+ * cursor. Fragments other than the first one carry no ports, so all the
+ * fragments of a datagram are hashed on the addresses only.
+ */
+static uint32_t flow_hash_ip(struct net_pkt *pkt)
+{
+	struct net_pkt_cursor l3;
+	uint32_t hash = 0U;
+	uint8_t proto = 0U;
+	uint32_t ports;
+	uint8_t vhl;
+
+	net_pkt_cursor_backup(pkt, &l3);
+	if (net_pkt_read_u8(pkt, &vhl)) {
+		return 0U;
+	}
+
+	net_pkt_cursor_restore(pkt, &l3);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && (vhl >> 4) == 4) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access,
+						      struct net_ipv4_hdr);
+		struct net_ipv4_hdr *hdr;
+
+		hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt,
+							      &ipv4_access);
+		if (!hdr) {
+			return 0U;
+		}
+
+		hash = flow_hash_mix(hash, UNALIGNED_GET((uint32_t *)hdr->src));
+		hash = flow_hash_mix(hash, UNALIGNED_GET((uint32_t *)hdr->dst));
+
+		if ((hdr->offset[0] & 0x3f) == 0U && hdr->offset[1] == 0U) {
+			proto = hdr->proto;
+		}
+
+		if (net_pkt_skip(pkt, (hdr->vhl & 0x0f) * 4U)) {
+			return hash;
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && (vhl >> 4) == 6) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv6_access,
+						      struct net_ipv6_hdr);
+		struct net_ipv6_hdr *hdr;
+		int i;
+
+		hdr = (struct net_ipv6_hdr *)net_pkt_get_data(pkt,
+							      &ipv6_access);
+		if (!hdr) {
+			return 0U;
+		}
+
+		for (i = 0; i < NET_IPV6_ADDR_SIZE; i += sizeof(uint32_t)) {
+			hash = flow_hash_mix(hash, UNALIGNED_GET(
+					     (uint32_t *)&hdr->src[i]));
+			hash = flow_hash_mix(hash, UNALIGNED_GET(
+					     (uint32_t *)&hdr->dst[i]));
+		}
+
+		/* Extension headers are not walked */
+		proto = hdr->nexthdr;
+
+		if (net_pkt_skip(pkt, sizeof(struct net_ipv6_hdr))) {
+			return hash;
+		}
+	} else {
+		return 0U;
+	}
+
+	if ((proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+	    !net_pkt_read(pkt, &ports, sizeof(ports))) {
+		hash = flow_hash_mix(hash, ports ^ proto);
+	}
+
+	return hash;
+}
+
+/* Skip the link layer header of a received packet, returns false if the
+ * packet does not carry IP.
+ */
+static bool flow_skip_l2(struct net_pkt *pkt)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		uint16_t type;
+
+		if (net_pkt_skip(pkt, 2 * sizeof(struct net_eth_addr)) ||
+		    net_pkt_read_be16(pkt, &type)) {
+			return false;
+		}
+
+		if (type == NET_ETH_PTYPE_VLAN &&
+		    (net_pkt_skip(pkt, sizeof(uint16_t)) ||
+		     net_pkt_read_be16(pkt, &type))) {
+			return false;
+		}
+
+		return type == NET_ETH_PTYPE_IP || type == NET_ETH_PTYPE_IPV6;
+	}
+#endif
+#if defined(CONFIG_NET_L2_DUMMY)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
+		return true;
+	}
+#endif
+	ARG_UNUSED(iface);
+
+	return false;
+}
+
+int net_tc_flow_queue(struct net_pkt *pkt, bool rx)
+{
+	struct net_pkt_cursor backup;
+	uint32_t hash;
+
+	hash = net_pkt_flow_hash(pkt);
+	if (hash == 0U) {
+		net_pkt_cursor_backup(pkt, &backup);
+		net_pkt_cursor_init(pkt);
+
+		/* Outgoing packets do not have the link layer header yet */
+		if (rx ? flow_skip_l2(pkt) :
+			 (net_pkt_family(pkt) == AF_INET ||
+			  net_pkt_family(pkt) == AF_INET6)) {
+			hash = flow_hash_ip(pkt);
+		}
+
+		net_pkt_cursor_restore(pkt, &backup);
+	}
+
+	return (hash ^ (hash >> 16)) % NET_TC_FLOW_QUEUES;
+}
 #endif
 
 #if NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0
@@ -52,7 +210,8 @@ bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 #if NET_TC_TX_COUNT > 0
 	net_pkt_set_tx_stats_tick(pkt, k_cycle_get_32());
 
-	submit_to_queue(&tx_classes[tc].fifo, pkt);
+	submit_to_queue(&tx_classes[tc * NET_TC_FLOW_QUEUES +
+				    net_tc_flow_queue(pkt, false)].fifo, pkt);
 #else
 	ARG_UNUSED(tc);
 	ARG_UNUSED(pkt);
@@ -65,7 +224,8 @@ void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 #if NET_TC_RX_COUNT > 0
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
-	submit_to_queue(&rx_classes[tc].fifo, pkt);
+	submit_to_queue(&rx_classes[tc * NET_TC_FLOW_QUEUES +
+				    net_tc_flow_queue(pkt, true)].fifo, pkt);
 #else
 	ARG_UNUSED(tc);
 	ARG_UNUSED(pkt);
@@ -248,6 +408,11 @@ static void tc_rx_handler(struct k_fifo *fifo)
 		}
 
 		net_process_rx_packet(pkt);
+
+		/* Nothing more to coalesce once the queue is drained */
+		if (IS_ENABLED(CONFIG_NET_TCP_GRO) && k_fifo_is_empty(fifo)) {
+			net_tcp_gro_flush();
+		}
 	}
 }
 #endif
@@ -268,6 +433,22 @@ static void tc_tx_handler(struct k_fifo *fifo)
 }
 #endif
 
+#if NET_TC_FLOW_QUEUES > 1 && defined(CONFIG_SCHED_CPU_MASK) && \
+	CONFIG_MP_NUM_CPUS > 1 && (NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0)
+/* Spread the flow queues of every traffic class over the CPUs */
+static void flow_queue_pin(k_tid_t tid, int queue)
+{
+	int cpu = (queue % NET_TC_FLOW_QUEUES) % CONFIG_MP_NUM_CPUS;
+
+	if (k_thread_cpu_mask_clear(tid) ||
+	    k_thread_cpu_mask_enable(tid, cpu)) {
+		NET_WARN("Cannot pin queue %d to CPU %d", queue, cpu);
+	}
+}
+#else
+#define flow_queue_pin(tid, queue)
+#endif
+
 /* Create a fifo for each traffic class we are using. All the network
  * traffic goes through these classes.
  */
@@ -285,12 +466,12 @@ void net_tc_tx_init(void)
 	net_if_foreach(net_tc_tx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_TX_COUNT; i++) {
+	for (i = 0; i < NET_TC_TX_QUEUES; i++) {
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = tx_tc2thread(i);
+		thread_priority = tx_tc2thread(i / NET_TC_FLOW_QUEUES);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -320,10 +501,18 @@ void net_tc_tx_init(void)
 		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
 			char name[MAX_NAME_LEN];
 
+#if NET_TC_FLOW_QUEUES > 1
+			snprintk(name, sizeof(name), "tx_q[%d.%d]",
+				 i / NET_TC_FLOW_QUEUES,
+				 i % NET_TC_FLOW_QUEUES);
+#else
 			snprintk(name, sizeof(name), "tx_q[%d]", i);
+#endif
 			k_thread_name_set(tid, name);
 		}
 
+		flow_queue_pin(tid, i);
+
 		k_thread_start(tid);
 	}
 #endif
@@ -343,12 +532,12 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < NET_TC_RX_QUEUES; i++) {
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		thread_priority = rx_tc2thread(i / NET_TC_FLOW_QUEUES);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -378,10 +567,18 @@ void net_tc_rx_init(void)
 		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
 			char name[MAX_NAME_LEN];
 
+#if NET_TC_FLOW_QUEUES > 1
+			snprintk(name, sizeof(name), "rx_q[%d.%d]",
+				 i / NET_TC_FLOW_QUEUES,
+				 i % NET_TC_FLOW_QUEUES);
+#else
 			snprintk(name, sizeof(name), "rx_q[%d]", i);
+#endif
 			k_thread_name_set(tid, name);
 		}
 
+		flow_queue_pin(tid, i);
+
 		k_thread_start(tid);
 	}
 #endif
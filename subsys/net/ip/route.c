@@ -28,16 +28,22 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 #include "icmpv6.h"
 #include "nbr.h"
 #include "route.h"
+#include "lpm.h"
 
 #if !defined(NET_ROUTE_EXTRA_DATA_SIZE)
 #define NET_ROUTE_EXTRA_DATA_SIZE 0
 #endif
 
 /* We keep track of the routes in a separate list so that we can remove
- * the oldest routes (at tail) if needed.
+ * the least recently used route if needed.
  */
 static sys_slist_t routes;
 
+/* Longest prefix match index of the routes. Lookups go through it without
+ * taking the lock, updates are done with the lock held.
+ */
+NET_LPM_DEFINE(route_lpm, CONFIG_NET_MAX_ROUTES, 128);
+
 /* Track currently active route lifetime timers */
 static sys_slist_t active_route_lifetime_timers;
 
@@ -274,51 +280,52 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 			route->iface);					\
 	} } while (0)
 
-/* Route was accessed, so place it in front of the routes list */
-static inline void update_route_access(struct net_route_entry *route)
+/* The least recently used route, removed when the table is full */
+static struct net_route_entry *route_oldest(void)
 {
-	sys_slist_find_and_remove(&routes, &route->node);
-	sys_slist_prepend(&routes, &route->node);
-}
+	struct net_route_entry *route, *oldest = NULL;
+	uint32_t now = k_uptime_get_32();
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
-{
-	struct net_route_entry *route, *found = NULL;
-	uint8_t longest_match = 0U;
-	int i;
+	SYS_SLIST_FOR_EACH_CONTAINER(&routes, route, node) {
+		if (!oldest ||
+		    now - route->last_used >= now - oldest->last_used) {
+			oldest = route;
+		}
+	}
 
-	k_mutex_lock(&lock, K_FOREVER);
+	return oldest;
+}
 
-	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
-		struct net_nbr *nbr = get_nbr(i);
+static bool route_iface_match(struct net_lpm_entry *entry, void *user_data)
+{
+	struct net_route_entry *route =
+		CONTAINER_OF(entry, struct net_route_entry, lpm);
 
-		if (!nbr->ref) {
-			continue;
-		}
+	return route->iface == (struct net_if *)user_data;
+}
 
-		if (iface && nbr->iface != iface) {
-			continue;
-		}
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found = NULL;
+	struct net_lpm_entry *entry;
+	int idx;
 
-		route = net_route_data(nbr);
+	idx = net_lpm_read_lock(&route_lpm);
 
-		if (route->prefix_len >= longest_match &&
-		    net_ipv6_is_prefix(dst->s6_addr,
-				       route->addr.s6_addr,
-				       route->prefix_len)) {
-			found = route;
-			longest_match = route->prefix_len;
-		}
+	entry = net_lpm_lookup(&route_lpm, dst->s6_addr,
+			       iface ? route_iface_match : NULL, iface);
+	if (entry) {
+		found = CONTAINER_OF(entry, struct net_route_entry, lpm);
+		found->last_used = k_uptime_get_32();
 	}
 
+	net_lpm_read_unlock(&route_lpm, idx);
+
 	if (found) {
 		net_route_info("Found", found, dst);
-
-		update_route_access(found);
 	}
 
-	k_mutex_unlock(&lock);
 	return found;
 }
 
@@ -408,14 +415,12 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 
 	nbr = nbr_new(iface, addr, prefix_len);
 	if (!nbr) {
-		/* Remove the oldest route and try again */
-		sys_snode_t *last = sys_slist_peek_tail(&routes);
-
-		sys_slist_find_and_remove(&routes, last);
-
-		route = CONTAINER_OF(last,
-				     struct net_route_entry,
-				     node);
+		/* Remove the least recently used route and try again */
+		route = route_oldest();
+		if (!route) {
+			NET_ERR("Neighbor route alloc failed!");
+			goto exit;
+		}
 
 		if (CONFIG_NET_ROUTE_LOG_LEVEL >= LOG_LEVEL_DBG) {
 			struct in6_addr *tmp;
@@ -459,6 +464,7 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	route = net_route_data(nbr);
 	route->iface = iface;
 	route->preference = preference;
+	route->last_used = k_uptime_get_32();
 
 	net_route_update_lifetime(route, lifetime);
 
@@ -473,6 +479,18 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	sys_slist_init(&route->nexthop);
 	sys_slist_prepend(&route->nexthop, &nexthop_route->node);
 
+	/* The route is complete, make it visible to lookups */
+	if (net_lpm_insert(&route_lpm, addr->s6_addr, prefix_len,
+			   &route->lpm) < 0) {
+		NET_ERR("Cannot add route to the lookup table!");
+		net_route_del(route);
+		route = NULL;
+		goto exit;
+	}
+
+	/* The route may give a new next hop to a destination */
+	net_ipv6_nbr_dst_cache_flush();
+
 	net_route_info("Added", route, addr);
 
 #if defined(CONFIG_NET_MGMT_EVENT_INFO)
@@ -604,8 +622,14 @@ int net_route_del(struct net_route_entry *route)
 		}
 	}
 
+	/* Waits for the lookups that may still use the route */
+	(void)net_lpm_remove(&route_lpm, route->addr.s6_addr,
+			     route->prefix_len, &route->lpm);
+
 	sys_slist_find_and_remove(&routes, &route->node);
 
+	net_ipv6_nbr_dst_cache_flush();
+
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
 		k_mutex_unlock(&lock);
@@ -20,6 +20,7 @@
 #include <net/net_timeout.h>
 
 #include "nbr.h"
+#include "lpm.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -58,6 +59,12 @@ struct net_route_entry {
 	/** Route lifetime timer. */
 	struct net_timeout lifetime;
 
+	/** Entry in the longest prefix match table. */
+	struct net_lpm_entry lpm;
+
+	/** Uptime in milliseconds when the route was last looked up. */
+	uint32_t last_used;
+
 	/** IPv6 address/prefix of the route. */
 	struct in6_addr addr;
 
@@ -40,10 +40,32 @@ static int tcp_window =
 	(CONFIG_NET_BUF_RX_COUNT * CONFIG_NET_BUF_DATA_SIZE) / 3;
 #endif
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+#define conn_rto(_conn) ((_conn)->rto)
+#else
+#define conn_rto(_conn) tcp_rto
+#endif
+
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
+#if defined(CONFIG_NET_CONN_HASH)
+#define TCP_HASH_SIZE BIT(CONFIG_NET_CONN_HASH_BITS)
+
+/* Connections with known end points, hashed by the remote end point and
+ * the local port.
+ */
+static sys_slist_t tcp_conn_hash[TCP_HASH_SIZE];
+static struct k_spinlock tcp_conn_hash_lock[TCP_HASH_SIZE];
+#endif
+
 static K_MUTEX_DEFINE(tcp_lock);
 
+#if defined(CONFIG_NET_TCP_GRO)
+/* Connections holding coalesced data until the receive queue is drained */
+static sys_slist_t tcp_gro_conns = SYS_SLIST_STATIC_INIT(&tcp_gro_conns);
+static struct k_spinlock tcp_gro_lock;
+#endif
+
 K_MEM_SLAB_DEFINE_STATIC(tcp_conns_slab, sizeof(struct tcp),
 				CONFIG_NET_MAX_CONTEXTS, 4);
 
@@ -426,6 +448,7 @@ static int tcp_conn_unref(struct tcp *conn)
 	k_work_cancel_delayable(&conn->timewait_timer);
 	k_work_cancel_delayable(&conn->fin_timer);
 
+	tcp_conn_hash_remove(conn);
 	sys_slist_find_and_remove(&tcp_conns, &conn->next);
 
 	memset(conn, 0, sizeof(*conn));
@@ -605,8 +628,29 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 	return buf;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+static void tcp_sack_parse(struct tcp_options *recv_options,
+			   const uint8_t *options, uint8_t opt_len)
+{
+	struct tcp_sack_block *blk;
+	int i;
+
+	for (i = 2; i < opt_len && recv_options->sack_cnt < NET_TCP_SACK_BLOCKS;
+	     i += NET_TCP_SACK_BLOCK_SIZE) {
+		blk = &recv_options->sack[recv_options->sack_cnt];
+
+		blk->start = ntohl(UNALIGNED_GET((uint32_t *)(options + i)));
+		blk->end = ntohl(UNALIGNED_GET((uint32_t *)(options + i + 4)));
+
+		if (net_tcp_seq_cmp(blk->end, blk->start) > 0) {
+			recv_options->sack_cnt++;
+		}
+	}
+}
+#endif
+
 static bool tcp_options_check(struct tcp_options *recv_options,
-			      struct net_pkt *pkt, ssize_t len)
+			      struct net_pkt *pkt, ssize_t len, bool syn)
 {
 	uint8_t options_buf[40]; /* TCP header max options size is 40 */
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
@@ -616,8 +660,20 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	/* MSS, window scale and SACK permitted are only sent in SYN
+	 * segments, the values negotiated there stay valid for the
+	 * lifetime of the connection.
+	 */
+	if (syn) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+		recv_options->sack_perm_found = false;
+	}
+
+	recv_options->ts_found = false;
+#if defined(CONFIG_NET_TCP_SACK)
+	recv_options->sack_cnt = 0;
+#endif
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -652,6 +708,10 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
+			if (!syn) {
+				break;
+			}
+
 			recv_options->mss =
 				ntohs(UNALIGNED_GET((uint16_t *)(options + 2)));
 			recv_options->mss_found = true;
@@ -663,8 +723,46 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			if (!syn) {
+				break;
+			}
+
+			recv_options->window = MIN(options[2],
+						   NET_TCP_MAX_WINDOW_SCALE);
 			recv_options->wnd_found = true;
+			NET_DBG("WS=%hu", recv_options->window);
+			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			if (syn) {
+				recv_options->sack_perm_found = true;
+			}
+			break;
+		case NET_TCP_TIMESTAMP_OPT:
+			if (opt_len != NET_TCP_TIMESTAMP_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->tsval =
+				ntohl(UNALIGNED_GET((uint32_t *)(options + 2)));
+			recv_options->tsecr =
+				ntohl(UNALIGNED_GET((uint32_t *)(options + 6)));
+			recv_options->ts_found = true;
+			break;
+		case NET_TCP_SACK_OPT:
+			if ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) {
+				result = false;
+				goto end;
+			}
+
+#if defined(CONFIG_NET_TCP_SACK)
+			tcp_sack_parse(recv_options, options, opt_len);
+#endif
 			break;
 		default:
 			continue;
@@ -762,8 +860,20 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+/* The window to advertise, the window in SYN segments is never scaled */
+static uint16_t tcp_adv_win(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = conn->recv_win;
+
+	if (!(flags & SYN)) {
+		win >>= conn->rcv_wscale;
+	}
+
+	return MIN(win, UINT16_MAX);
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -777,14 +887,10 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + opts_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(tcp_adv_win(conn, flags)), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
 	if (ACK & flags) {
@@ -811,23 +917,210 @@ static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
 	return -EINVAL;
 }
 
-static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+#if defined(CONFIG_NET_TCP_SACK)
+/* Get the block of contiguous queued data starting at buf, returns the
+ * first buffer after the block.
+ */
+static struct net_buf *tcp_sack_block_next(struct net_buf *buf,
+					   struct tcp_sack_block *blk)
 {
-	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
-	struct tcp_mss_option *mss;
-	uint32_t recv_mss;
+	blk->start = tcp_get_seq(buf);
+	blk->end = blk->start;
 
-	mss = net_pkt_get_data(pkt, &mss_opt_access);
-	if (!mss) {
-		return -ENOBUFS;
+	while (buf && tcp_get_seq(buf) == blk->end) {
+		blk->end += buf->len;
+		buf = buf->frags;
+	}
+
+	return buf;
+}
+
+/* Find the block of queued data containing seq */
+static bool tcp_sack_block_find(struct tcp *conn, uint32_t seq,
+				struct tcp_sack_block *blk)
+{
+	struct net_buf *buf = conn->queue_recv_data->buffer;
+
+	while (buf) {
+		buf = tcp_sack_block_next(buf, blk);
+
+		if (net_tcp_seq_cmp(seq, blk->start) >= 0 &&
+		    net_tcp_seq_cmp(seq, blk->end) < 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool tcp_sack_block_listed(struct tcp_sack_block *blocks, int cnt,
+				  struct tcp_sack_block *blk)
+{
+	int i;
+
+	for (i = 0; i < cnt; i++) {
+		if (blocks[i].start == blk->start) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Remember the segment queued at seq as the most recently received one.
+ * One segment is kept per block, segments of blocks that merged with it
+ * or that were passed to the application are forgotten.
+ */
+static void tcp_sack_recent_add(struct tcp *conn, uint32_t seq)
+{
+	struct tcp_sack_block blk, other;
+	uint32_t prev = seq;
+	int cnt = 1;
+	int i;
+
+	if (!tcp_sack_block_find(conn, seq, &blk)) {
+		return;
+	}
+
+	for (i = 0; i < conn->sack_recent_cnt && cnt < NET_TCP_SACK_BLOCKS;
+	     i++) {
+		uint32_t recent = conn->sack_recent[i];
+
+		if (!tcp_sack_block_find(conn, recent, &other) ||
+		    other.start == blk.start) {
+			continue;
+		}
+
+		/* Shift the list by one, it is scanned front to back */
+		conn->sack_recent[cnt - 1] = prev;
+		prev = recent;
+		cnt++;
+	}
+
+	conn->sack_recent[cnt - 1] = prev;
+	conn->sack_recent_cnt = cnt;
+}
+
+/* Collect the ranges of out-of-order data waiting in the receive queue.
+ * The block holding the most recently received segment comes first and
+ * the other blocks follow in the order they last received data, as
+ * required by RFC 2018 section 4, so the peer learns about the newest
+ * blocks even when not all of them fit.
+ */
+static int tcp_sack_blocks_get(struct tcp *conn, struct tcp_sack_block *blocks,
+			       int max)
+{
+	struct tcp_sack_block blk;
+	struct net_buf *buf;
+	int cnt = 0;
+	int i;
+
+	if (!CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT ||
+	    net_pkt_is_empty(conn->queue_recv_data)) {
+		return 0;
+	}
+
+	for (i = 0; i < conn->sack_recent_cnt && cnt < max; i++) {
+		if (tcp_sack_block_find(conn, conn->sack_recent[i], &blk) &&
+		    !tcp_sack_block_listed(blocks, cnt, &blk)) {
+			blocks[cnt++] = blk;
+		}
+	}
+
+	/* Blocks whose segments were not remembered follow in order */
+	buf = conn->queue_recv_data->buffer;
+	while (buf && cnt < max) {
+		buf = tcp_sack_block_next(buf, &blk);
+
+		if (!tcp_sack_block_listed(blocks, cnt, &blk)) {
+			blocks[cnt++] = blk;
+		}
+	}
+
+	return cnt;
+}
+
+static size_t tcp_sack_opt_add(struct tcp *conn, uint8_t *buf)
+{
+	struct tcp_sack_block blocks[NET_TCP_SACK_BLOCKS];
+	size_t len = 0;
+	int cnt, i;
+
+	/* Only three blocks fit together with the timestamps */
+	cnt = tcp_sack_blocks_get(conn, blocks,
+				  conn->ts_ok ? MIN(NET_TCP_SACK_BLOCKS, 3) :
+				  NET_TCP_SACK_BLOCKS);
+	if (cnt == 0) {
+		return 0;
+	}
+
+	buf[len++] = NET_TCP_NOP_OPT;
+	buf[len++] = NET_TCP_NOP_OPT;
+	buf[len++] = NET_TCP_SACK_OPT;
+	buf[len++] = 2 + cnt * NET_TCP_SACK_BLOCK_SIZE;
+
+	for (i = 0; i < cnt; i++) {
+		sys_put_be32(blocks[i].start, &buf[len]);
+		sys_put_be32(blocks[i].end, &buf[len + 4]);
+		len += NET_TCP_SACK_BLOCK_SIZE;
+	}
+
+	return len;
+}
+#endif
+
+/* Write the options of an outgoing segment to buf and return their length.
+ * The options are padded with NOPs so that the length is always a multiple
+ * of four. The buffer must have room for the 40 bytes of maximum options.
+ */
+static size_t tcp_options_build(struct tcp *conn, uint8_t flags, uint8_t *buf)
+{
+	bool syn = flags & SYN;
+	size_t len = 0;
+
+	if (conn->send_options.mss_found) {
+		buf[len++] = NET_TCP_MSS_OPT;
+		buf[len++] = NET_TCP_MSS_SIZE;
+		sys_put_be16(net_tcp_get_recv_mss(conn), &buf[len]);
+		len += 2;
+	}
+
+	if (syn && conn->wscale_ok) {
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_WINDOW_SCALE_OPT;
+		buf[len++] = NET_TCP_WINDOW_SCALE_SIZE;
+		buf[len++] = conn->rcv_wscale;
+	}
+
+	/* SACK permitted fills the padding in front of the timestamps */
+	if (syn && conn->sack_ok) {
+		if (!conn->ts_ok) {
+			buf[len++] = NET_TCP_NOP_OPT;
+			buf[len++] = NET_TCP_NOP_OPT;
+		}
+
+		buf[len++] = NET_TCP_SACK_PERM_OPT;
+		buf[len++] = NET_TCP_SACK_PERM_SIZE;
+	} else if (conn->ts_ok) {
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_NOP_OPT;
 	}
 
-	recv_mss = net_tcp_get_recv_mss(conn);
-	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+	if (conn->ts_ok) {
+		buf[len++] = NET_TCP_TIMESTAMP_OPT;
+		buf[len++] = NET_TCP_TIMESTAMP_SIZE;
+		sys_put_be32(k_uptime_get_32(), &buf[len]);
+		sys_put_be32(conn->ts_recent, &buf[len + 4]);
+		len += 8;
+	}
 
-	UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)mss);
+#if defined(CONFIG_NET_TCP_SACK)
+	if (!syn && conn->sack_ok) {
+		len += tcp_sack_opt_add(conn, &buf[len]);
+	}
+#endif
 
-	return net_pkt_set_data(pkt, &mss_opt_access);
+	return len;
 }
 
 static bool is_destination_local(struct net_pkt *pkt)
@@ -856,14 +1149,12 @@ static bool is_destination_local(struct net_pkt *pkt)
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	uint8_t opts[40]; /* TCP header max options size is 40 */
+	size_t opts_len = tcp_options_build(conn, flags, opts);
+	size_t alloc_len = sizeof(struct tcphdr) + opts_len;
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
-
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -882,20 +1173,30 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
-	if (conn->send_options.mss_found) {
-		ret = net_tcp_set_mss_opt(conn, pkt);
+	if (opts_len) {
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			tcp_pkt_unref(pkt);
 			goto out;
 		}
 	}
 
+#if defined(CONFIG_NET_TCP_GSO)
+	/* Packets to ourselves are delivered as they are, others are split
+	 * at the L2 which also computes the checksum of every segment.
+	 */
+	if (data && net_pkt_gso_size(data) && !is_destination_local(pkt)) {
+		net_pkt_set_gso_size(pkt, net_pkt_gso_size(data));
+		net_pkt_set_chksum_done(pkt, true);
+	}
+#endif
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -962,9 +1263,21 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 	return net_pkt_copy(to, from, len);
 }
 
+/* The amount of data that can be in flight, limited by the peer's receive
+ * window and the congestion window.
+ */
+static int tcp_send_win(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	return MIN((uint32_t)conn->send_win, conn->cwnd);
+#else
+	return conn->send_win;
+#endif
+}
+
 static bool tcp_window_full(struct tcp *conn)
 {
-	bool window_full = !(conn->unacked_len < conn->send_win);
+	bool window_full = !(conn->unacked_len < tcp_send_win(conn));
 
 	NET_DBG("conn: %p window_full=%hu", conn, window_full);
 
@@ -989,54 +1302,107 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+/* Send len bytes starting at offset pos of the send_data packet */
+static int tcp_send_segment(struct tcp *conn, int pos, int len)
 {
-	int ret = 0;
-	int pos, len;
 	struct net_pkt *pkt;
-
-	pos = conn->unacked_len;
-	len = MIN3(conn->send_data_total - conn->unacked_len,
-		   conn->send_win - conn->unacked_len,
-		   conn_mss(conn));
-	if (len == 0) {
-		NET_DBG("conn: %p no data to send", conn);
-		ret = -ENODATA;
-		goto out;
-	}
+	int ret;
 
 	pkt = tcp_pkt_alloc(conn, len);
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
 	ret = tcp_pkt_peek(pkt, conn->send_data, pos, len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
+		return -ENOBUFS;
+	}
+
+	if (len > conn_mss(conn)) {
+		net_pkt_set_gso_size(pkt, conn_mss(conn));
+	}
+
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + pos);
+
+	/* The data we want to send, has been moved to the send queue so we
+	 * can unref the head net_pkt. If there was an error, we need to remove
+	 * the packet anyway.
+	 */
+	tcp_pkt_unref(pkt);
+
+	return ret;
+}
+
+/* The largest amount of data to send in one packet. With segmentation
+ * offload this is a multiple of the MSS as the packet is split at the L2.
+ */
+static int tcp_send_seg_max(struct tcp *conn)
+{
+	int mss = conn_mss(conn);
+
+#if defined(CONFIG_NET_TCP_GSO)
+	return MAX(CONFIG_NET_TCP_GSO_MAX_SIZE / mss, 1) * mss;
+#else
+	return mss;
+#endif
+}
+
+static int tcp_send_data(struct tcp *conn)
+{
+	int ret = 0;
+	int pos, len, segs;
+
+	pos = conn->unacked_len;
+	len = MIN3(conn->send_data_total - conn->unacked_len,
+		   MAX(tcp_send_win(conn) - conn->unacked_len, 0),
+		   tcp_send_seg_max(conn));
+	if (len == 0) {
+		NET_DBG("conn: %p no data to send", conn);
+		ret = -ENODATA;
 		goto out;
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	ret = tcp_send_segment(conn, pos, len);
+	if (ret == -ENOBUFS && len > conn_mss(conn)) {
+		/* Not enough buffers for a large packet, send a single
+		 * segment instead.
+		 */
+		len = conn_mss(conn);
+		ret = tcp_send_segment(conn, pos, len);
+	}
+
 	if (ret == 0) {
 		conn->unacked_len += len;
 
+		for (segs = DIV_ROUND_UP(len, conn_mss(conn)); segs > 0;
+		     segs--) {
+			if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+				net_stats_update_tcp_seg_rexmit(conn->iface);
+			} else {
+				net_stats_update_tcp_seg_sent(conn->iface);
+			}
+		}
+
 		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
 			net_stats_update_tcp_resent(conn->iface, len);
-			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
 			net_stats_update_tcp_sent(conn->iface, len);
-			net_stats_update_tcp_seg_sent(conn->iface);
 		}
-	}
 
-	/* The data we want to send, has been moved to the send queue so we
-	 * can unref the head net_pkt. If there was an error, we need to remove
-	 * the packet anyway.
-	 */
-	tcp_pkt_unref(pkt);
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+		/* Time one segment per round-trip, never a retransmitted
+		 * one (Karn's algorithm).
+		 */
+		if (conn->data_mode == TCP_DATA_MODE_SEND &&
+		    !conn->rtt_pending) {
+			conn->rtt_pending = true;
+			conn->rtt_seq = conn->seq + conn->unacked_len;
+			conn->rtt_start = k_uptime_get_32();
+		}
+#endif
+	}
 
 	conn_send_data_dump(conn);
 
@@ -1086,7 +1452,7 @@ static int tcp_send_queued_data(struct tcp *conn)
 	if (subscribe) {
 		conn->send_data_retries = 0;
 		k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
-					    K_MSEC(tcp_rto));
+					    K_MSEC(conn_rto(conn)));
 	}
  out:
 	return ret;
@@ -1126,6 +1492,22 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	if (conn->unacked_len) {
+		conn->cc->timeout(conn);
+		tcp_cc_rto_backoff(conn);
+	}
+
+	conn->dup_ack_cnt = 0;
+	conn->in_recovery = false;
+	conn->rtt_pending = false;
+
+#if defined(CONFIG_NET_TCP_SACK)
+	/* The peer may have dropped the SACKed data, RFC 2018 section 8 */
+	conn->sacked_cnt = 0;
+#endif
+#endif
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -1156,7 +1538,7 @@ static void tcp_resend_data(struct k_work *work)
 	}
 
 	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
-				    K_MSEC(tcp_rto));
+				    K_MSEC(conn_rto(conn)));
 
  out:
 	k_mutex_unlock(&conn->lock);
@@ -1258,6 +1640,11 @@ static struct tcp *tcp_conn_alloc(void)
 	k_work_init_delayable(&conn->send_data_timer, tcp_resend_data);
 	k_work_init_delayable(&conn->recv_queue_timer, tcp_cleanup_recv_queue);
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	conn->cc = tcp_cc_default();
+	conn->rto = tcp_rto;
+#endif
+
 	tcp_conn_ref(conn);
 
 	sys_slist_append(&tcp_conns, &conn->next);
@@ -1298,6 +1685,73 @@ out:
 	return ret;
 }
 
+#if defined(CONFIG_NET_CONN_HASH)
+static uint32_t tcp_conn_hash_idx(union tcp_endpoint *remote,
+				  uint16_t local_port)
+{
+	const void *addr = remote->sa.sa_family == AF_INET6 ?
+		(const void *)&remote->sin6.sin6_addr :
+		(const void *)&remote->sin.sin_addr;
+
+	return net_conn_hash(IPPROTO_TCP, remote->sa.sa_family, addr,
+			     remote->sin.sin_port, local_port) &
+		(TCP_HASH_SIZE - 1);
+}
+
+/* Must be called once the end points of the connection are set */
+static void tcp_conn_hash_add(struct tcp *conn)
+{
+	uint32_t idx = tcp_conn_hash_idx(&conn->dst, conn->src.sin.sin_port);
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&tcp_conn_hash_lock[idx]);
+	sys_slist_prepend(&tcp_conn_hash[idx], &conn->hash_next);
+	k_spin_unlock(&tcp_conn_hash_lock[idx], key);
+}
+
+static void tcp_conn_hash_remove(struct tcp *conn)
+{
+	uint32_t idx = tcp_conn_hash_idx(&conn->dst, conn->src.sin.sin_port);
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&tcp_conn_hash_lock[idx]);
+	sys_slist_find_and_remove(&tcp_conn_hash[idx], &conn->hash_next);
+	k_spin_unlock(&tcp_conn_hash_lock[idx], key);
+}
+
+static struct tcp *tcp_conn_search(struct net_pkt *pkt)
+{
+	union tcp_endpoint remote, local;
+	struct tcp *conn = NULL;
+	k_spinlock_key_t key;
+	uint32_t idx;
+	size_t len;
+
+	if (tcp_endpoint_set(&remote, pkt, TCP_EP_SRC) < 0 ||
+	    tcp_endpoint_set(&local, pkt, TCP_EP_DST) < 0) {
+		return NULL;
+	}
+
+	len = tcp_endpoint_len(remote.sa.sa_family);
+	idx = tcp_conn_hash_idx(&remote, local.sin.sin_port);
+
+	key = k_spin_lock(&tcp_conn_hash_lock[idx]);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp_conn_hash[idx], conn, hash_next) {
+		if (!memcmp(&conn->dst, &remote, len) &&
+		    !memcmp(&conn->src, &local, len)) {
+			break;
+		}
+	}
+
+	k_spin_unlock(&tcp_conn_hash_lock[idx], key);
+
+	return conn;
+}
+#else
+#define tcp_conn_hash_add(...)
+#define tcp_conn_hash_remove(...)
+
 static bool tcp_endpoint_cmp(union tcp_endpoint *ep, struct net_pkt *pkt,
 			     enum pkt_addr which)
 {
@@ -1331,13 +1785,211 @@ static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 
 	return found ? conn : NULL;
 }
+#endif /* CONFIG_NET_CONN_HASH */
 
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
 
-static enum net_verdict tcp_recv(struct net_conn *net_conn,
-				 struct net_pkt *pkt,
-				 union net_ip_header *ip,
-				 union net_proto_header *proto,
+#if defined(CONFIG_NET_TCP_GRO)
+/* Held data owns a reference to its connection, so the connection stays
+ * around until the data is processed or dropped. The caller of
+ * tcp_gro_detach() gets that reference with the packet and must release
+ * it with tcp_conn_unref() once done with the packet.
+ */
+static struct net_pkt *tcp_gro_detach(struct tcp *conn)
+{
+	k_spinlock_key_t key = k_spin_lock(&tcp_gro_lock);
+	struct net_pkt *pkt = conn->gro_pkt;
+
+	if (pkt) {
+		sys_slist_find_and_remove(&tcp_gro_conns, &conn->gro_next);
+		conn->gro_pkt = NULL;
+	}
+
+	k_spin_unlock(&tcp_gro_lock, key);
+
+	return pkt;
+}
+
+static void tcp_gro_attach(struct tcp *conn, struct net_pkt *pkt)
+{
+	k_spinlock_key_t key;
+
+	tcp_conn_ref(conn);
+
+	key = k_spin_lock(&tcp_gro_lock);
+
+	conn->gro_pkt = pkt;
+	conn->gro_tid = k_current_get();
+	sys_slist_append(&tcp_gro_conns, &conn->gro_next);
+
+	k_spin_unlock(&tcp_gro_lock, key);
+}
+
+/* TCP header of a segment with its options in contiguous memory */
+static struct tcphdr *tcp_gro_th_get(struct net_pkt *pkt)
+{
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	struct tcphdr *th = th_get(pkt);
+
+	if (th && !net_pkt_is_contiguous(pkt, th_off(th) * 4)) {
+		if (tcp_pkt_linearize(pkt, ip_len, th_off(th) * 4) < 0) {
+			return NULL;
+		}
+
+		th = th_get(pkt);
+	}
+
+	return th;
+}
+
+/* Whether the segment carries the next in-order data and nothing else */
+static bool tcp_gro_can_hold(struct tcp *conn, struct net_pkt *pkt)
+{
+	struct tcphdr *th = th_get(pkt);
+	size_t len = tcp_data_len(pkt);
+	bool ret;
+
+	if (!th || th_flags(th) != ACK || len == 0 ||
+	    len >= CONFIG_NET_TCP_GRO_MAX_SIZE) {
+		return false;
+	}
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+	ret = conn->state == TCP_ESTABLISHED && th_seq(th) == conn->ack;
+	k_mutex_unlock(&conn->lock);
+
+	return ret;
+}
+
+/* Append the data of pkt to the coalesced packet if it directly follows
+ * it and the headers only differ in the sequence number, the window and
+ * the PSH flag. The header of pkt is dropped and its data buffers are
+ * moved to the coalesced packet.
+ */
+static bool tcp_gro_merge(struct net_pkt *held, struct net_pkt *pkt)
+{
+	size_t held_len = tcp_data_len(held);
+	size_t len = tcp_data_len(pkt);
+	struct tcphdr *th, *th_new;
+	size_t hdr_len;
+
+	if (len == 0 || held_len + len > CONFIG_NET_TCP_GRO_MAX_SIZE) {
+		return false;
+	}
+
+	th = tcp_gro_th_get(held);
+	th_new = tcp_gro_th_get(pkt);
+	if (!th || !th_new) {
+		return false;
+	}
+
+	if ((th_flags(th_new) & ~PSH) != ACK ||
+	    th_off(th_new) != th_off(th) ||
+	    th_seq(th_new) != th_seq(th) + held_len ||
+	    th_ack(th_new) != th_ack(th) ||
+	    memcmp(th + 1, th_new + 1, (th_off(th) - 5) * 4) != 0) {
+		return false;
+	}
+
+	UNALIGNED_PUT(UNALIGNED_GET(&th_new->th_win), &th->th_win);
+	UNALIGNED_PUT(th_flags(th) | (th_flags(th_new) & PSH), &th->th_flags);
+
+	hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+		th_off(th_new) * 4;
+	if (tcp_pkt_pull(pkt, hdr_len) < 0) {
+		return false;
+	}
+
+	net_buf_frag_add(held->buffer, pkt->buffer);
+	pkt->buffer = NULL;
+
+	return true;
+}
+
+/* Coalesce the in-order data segments of a connection, the result is
+ * passed to tcp_in() when a segment cannot be merged, when PSH is seen,
+ * when the size limit is reached or when the receive queue is drained.
+ */
+static void tcp_gro_in(struct tcp *conn, struct net_pkt *pkt)
+{
+	struct net_pkt *held;
+
+	/* The connection must survive the processing of two segments */
+	tcp_conn_ref(conn);
+
+	held = tcp_gro_detach(conn);
+	if (held) {
+		bool merged = tcp_gro_merge(held, pkt);
+
+		if (merged && !(th_flags(th_get(held)) & PSH) &&
+		    tcp_data_len(held) < CONFIG_NET_TCP_GRO_MAX_SIZE) {
+			tcp_gro_attach(conn, held);
+		} else {
+			tcp_in(conn, held);
+			tcp_pkt_unref(held);
+		}
+
+		/* The reference of the held data */
+		tcp_conn_unref(conn);
+
+		if (merged) {
+			goto out;
+		}
+	}
+
+	if (tcp_gro_can_hold(conn, pkt)) {
+		tcp_gro_attach(conn, net_pkt_ref(pkt));
+		goto out;
+	}
+
+	tcp_in(conn, pkt);
+out:
+	tcp_conn_unref(conn);
+}
+
+void net_tcp_gro_flush(void)
+{
+	k_tid_t tid = k_current_get();
+	struct net_pkt *pkt;
+	struct tcp *conn;
+
+	do {
+		k_spinlock_key_t key = k_spin_lock(&tcp_gro_lock);
+
+		pkt = NULL;
+
+		/* Only the data held by this queue, the segments of other
+		 * queues may still be followed by more data.
+		 */
+		SYS_SLIST_FOR_EACH_CONTAINER(&tcp_gro_conns, conn, gro_next) {
+			if (conn->gro_tid == tid) {
+				sys_slist_find_and_remove(&tcp_gro_conns,
+							  &conn->gro_next);
+				pkt = conn->gro_pkt;
+				conn->gro_pkt = NULL;
+				break;
+			}
+		}
+
+		k_spin_unlock(&tcp_gro_lock, key);
+
+		if (pkt) {
+			tcp_in(conn, pkt);
+			tcp_pkt_unref(pkt);
+
+			/* May free the connection if it was closed while
+			 * the data was held.
+			 */
+			tcp_conn_unref(conn);
+		}
+	} while (pkt);
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
+static enum net_verdict tcp_recv(struct net_conn *net_conn,
+				 struct net_pkt *pkt,
+				 union net_ip_header *ip,
+				 union net_proto_header *proto,
 				 void *user_data)
 {
 	struct tcp *conn;
@@ -1365,10 +2017,35 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 		net_ipaddr_copy(&conn_old->context->remote, &conn->dst.sa);
 
 		conn->accepted_conn = conn_old;
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+		/* Inherit the algorithm selected for the listening socket */
+		conn->cc = conn_old->cc;
+#endif
+
+#if defined(CONFIG_NET_CONTEXT_RCVBUF)
+		/* The buffer size of the listening socket applies to
+		 * the accepted connections as well.
+		 */
+		if (conn_old->context->options.rcvbuf) {
+			(void)net_tcp_set_recv_buf(conn->context,
+					conn_old->context->options.rcvbuf);
+			conn->context->options.rcvbuf =
+				conn_old->context->options.rcvbuf;
+		}
+#endif
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+		conn->context->options.sndbuf =
+			conn_old->context->options.sndbuf;
+#endif
 	}
  in:
 	if (conn) {
+#if defined(CONFIG_NET_TCP_GRO)
+		tcp_gro_in(conn, pkt);
+#else
 		tcp_in(conn, pkt);
+#endif
 	}
 
 	return NET_DROP;
@@ -1506,6 +2183,8 @@ static struct tcp *tcp_conn_new(struct net_pkt *pkt)
 		goto err;
 	}
 
+	tcp_conn_hash_add(conn);
+
 	NET_DBG("conn: src: %s, dst: %s",
 		log_strdup(net_sprint_addr(conn->src.sa.sa_family,
 				(const void *)&conn->src.sin.sin_addr)),
@@ -1574,6 +2253,63 @@ err:
 	return conn;
 }
 
+/* Smallest window scale shift that can represent our receive window */
+static uint8_t tcp_wscale_get(void)
+{
+	uint8_t shift = 0;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE)) {
+		return 0;
+	}
+
+	while (shift < NET_TCP_MAX_WINDOW_SCALE &&
+	       ((uint32_t)tcp_window >> shift) > UINT16_MAX) {
+		shift++;
+	}
+
+	return shift;
+}
+
+/* Options offered in our SYN. The ones the peer does not send back in its
+ * SYN-ACK are turned off again by tcp_options_negotiate().
+ */
+static void tcp_options_offer(struct tcp *conn)
+{
+	conn->wscale_ok = IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE);
+	conn->ts_ok = IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS);
+	conn->sack_ok = IS_ENABLED(CONFIG_NET_TCP_SACK);
+	conn->rcv_wscale = tcp_wscale_get();
+	conn->ts_recent = 0U;
+}
+
+/* Settle the options from the peer's SYN or SYN-ACK, an option is only used
+ * if both ends have sent it.
+ */
+static void tcp_options_negotiate(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+
+	conn->wscale_ok = IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+		opts->wnd_found;
+	conn->ts_ok = IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS) && opts->ts_found;
+	conn->sack_ok = IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+		opts->sack_perm_found;
+
+	if (conn->wscale_ok) {
+		conn->snd_wscale = opts->window;
+		conn->rcv_wscale = tcp_wscale_get();
+	} else {
+		conn->snd_wscale = 0U;
+		conn->rcv_wscale = 0U;
+	}
+
+	conn->ts_recent = conn->ts_ok ? opts->tsval : 0U;
+
+	NET_DBG("conn: %p wscale %d (%hu/%hu) ts %d sack %d", conn,
+		conn->wscale_ok, (uint16_t)conn->snd_wscale,
+		(uint16_t)conn->rcv_wscale, conn->ts_ok, conn->sack_ok);
+}
+
 static bool tcp_validate_seq(struct tcp *conn, struct tcphdr *hdr)
 {
 	return (net_tcp_seq_cmp(th_seq(hdr), conn->ack) >= 0) &&
@@ -1663,6 +2399,10 @@ static void tcp_queue_recv_data(struct tcp *conn, struct net_pkt *pkt,
 		/* We need to keep the received data but free the pkt */
 		pkt->buffer = NULL;
 
+#if defined(CONFIG_NET_TCP_SACK)
+		tcp_sack_recent_add(conn, seq_start);
+#endif
+
 		if (!k_work_delayable_is_pending(&conn->recv_queue_timer)) {
 			k_work_reschedule_for_queue(
 				&tcp_work_q, &conn->recv_queue_timer,
@@ -1710,6 +2450,248 @@ static void tcp_out_of_order_data(struct tcp *conn, struct net_pkt *pkt,
 	tcp_queue_recv_data(conn, pkt, data_len, seq);
 }
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+#if defined(CONFIG_NET_TCP_SACK)
+/* Insert a block into the scoreboard, merging it with the blocks it overlaps
+ * or touches. If the scoreboard is full the highest block is forgotten, that
+ * only causes a needless retransmission.
+ */
+static void tcp_sack_insert(struct tcp *conn, struct tcp_sack_block blk)
+{
+	struct tcp_sack_block *sacked = conn->sacked;
+	int cnt = conn->sacked_cnt;
+	int i = 0, j;
+
+	while (i < cnt && net_tcp_seq_cmp(sacked[i].end, blk.start) < 0) {
+		i++;
+	}
+
+	for (j = i; j < cnt && net_tcp_seq_cmp(sacked[j].start, blk.end) <= 0;
+	     j++) {
+		if (net_tcp_seq_cmp(sacked[j].start, blk.start) < 0) {
+			blk.start = sacked[j].start;
+		}
+
+		if (net_tcp_seq_cmp(sacked[j].end, blk.end) > 0) {
+			blk.end = sacked[j].end;
+		}
+	}
+
+	if (i == j) {
+		if (cnt == NET_TCP_SACK_BLOCKS) {
+			if (i == cnt) {
+				return;
+			}
+
+			cnt--;
+		}
+
+		memmove(&sacked[i + 1], &sacked[i], (cnt - i) * sizeof(blk));
+		cnt++;
+	} else {
+		memmove(&sacked[i + 1], &sacked[j], (cnt - j) * sizeof(blk));
+		cnt -= j - i - 1;
+	}
+
+	sacked[i] = blk;
+	conn->sacked_cnt = cnt;
+}
+
+/* Merge the SACK blocks of a received ACK into the scoreboard */
+static void tcp_sack_update(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+	uint32_t snd_max = conn->seq + conn->unacked_len;
+	int i;
+
+	for (i = 0; i < opts->sack_cnt; i++) {
+		/* Ignore D-SACKs and blocks beyond the data in flight */
+		if (net_tcp_seq_cmp(opts->sack[i].start, conn->seq) < 0 ||
+		    net_tcp_seq_cmp(opts->sack[i].end, snd_max) > 0) {
+			continue;
+		}
+
+		tcp_sack_insert(conn, opts->sack[i]);
+	}
+}
+
+/* Forget the blocks that have been cumulatively acknowledged */
+static void tcp_sack_prune(struct tcp *conn)
+{
+	int i, cnt = 0;
+
+	for (i = 0; i < conn->sacked_cnt; i++) {
+		struct tcp_sack_block blk = conn->sacked[i];
+
+		if (net_tcp_seq_cmp(blk.end, conn->seq) <= 0) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(blk.start, conn->seq) < 0) {
+			blk.start = conn->seq;
+		}
+
+		conn->sacked[cnt++] = blk;
+	}
+
+	conn->sacked_cnt = cnt;
+}
+
+/* Find the first hole at or after *seq that is below a SACKed block. Returns
+ * the length of the hole, at most one MSS, or 0 if there is no such hole.
+ */
+static int tcp_sack_next_hole(struct tcp *conn, uint32_t *seq)
+{
+	uint32_t pos = *seq;
+	int i;
+
+	for (i = 0; i < conn->sacked_cnt; i++) {
+		if (net_tcp_seq_cmp(pos, conn->sacked[i].start) < 0) {
+			*seq = pos;
+			return MIN(conn->sacked[i].start - pos,
+				   (uint32_t)conn_mss(conn));
+		}
+
+		if (net_tcp_seq_cmp(pos, conn->sacked[i].end) < 0) {
+			pos = conn->sacked[i].end;
+		}
+	}
+
+	return 0;
+}
+
+/* Retransmit the next hole reported by the peer that has not been
+ * retransmitted yet in this recovery episode (RFC 6675 NextSeg rule 1).
+ */
+static bool tcp_sack_retransmit(struct tcp *conn)
+{
+	uint32_t seq = conn->sack_rexmit;
+	int len;
+
+	if (net_tcp_seq_cmp(seq, conn->seq) < 0) {
+		seq = conn->seq;
+	}
+
+	len = tcp_sack_next_hole(conn, &seq);
+	if (len == 0 || tcp_send_segment(conn, seq - conn->seq, len) < 0) {
+		return false;
+	}
+
+	NET_DBG("conn: %p SACK retransmit seq %u len %d", conn, seq, len);
+
+	net_stats_update_tcp_resent(conn->iface, len);
+	net_stats_update_tcp_seg_rexmit(conn->iface);
+	conn->sack_rexmit = seq + len;
+
+	return true;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+/* Retransmit the first unacknowledged segment without waiting for the
+ * retransmission timer.
+ */
+static void tcp_fast_retransmit(struct tcp *conn)
+{
+	int len = MIN(conn->unacked_len, conn_mss(conn));
+
+	/* Karn's algorithm, the timed segment may now be ambiguous */
+	conn->rtt_pending = false;
+
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->sack_rexmit = conn->seq;
+
+	if (conn->sacked_cnt > 0 && tcp_sack_retransmit(conn)) {
+		return;
+	}
+#endif
+
+	if (len > 0 && tcp_send_segment(conn, 0, len) == 0) {
+		net_stats_update_tcp_resent(conn->iface, len);
+		net_stats_update_tcp_seg_rexmit(conn->iface);
+	}
+}
+
+static void tcp_cc_dup_ack(struct tcp *conn)
+{
+	uint32_t mss = conn_mss(conn);
+
+	if (conn->in_recovery) {
+		/* Each duplicate ACK means a segment has left the network */
+		conn->cwnd = MIN(conn->cwnd + mss, TCP_CC_CWND_MAX);
+
+#if defined(CONFIG_NET_TCP_SACK)
+		/* Fill the holes reported by the peer before new data */
+		if (conn->sacked_cnt > 0 && tcp_sack_retransmit(conn)) {
+			return;
+		}
+#endif
+
+		(void)tcp_send_queued_data(conn);
+		return;
+	}
+
+	if (++conn->dup_ack_cnt < TCP_CC_DUP_ACK_THRESHOLD) {
+		return;
+	}
+
+	NET_DBG("conn: %p fast retransmit seq %u", conn, conn->seq);
+
+	conn->cc->congestion(conn);
+	conn->cwnd = conn->ssthresh + TCP_CC_DUP_ACK_THRESHOLD * mss;
+	conn->recover = conn->seq + conn->unacked_len;
+	conn->in_recovery = true;
+
+	tcp_fast_retransmit(conn);
+}
+
+static void tcp_cc_new_ack(struct tcp *conn, uint32_t len_acked)
+{
+	conn->dup_ack_cnt = 0;
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	/* The echoed timestamp gives an RTT sample for every ACK, RFC 7323 */
+	if (conn->ts_ok && conn->recv_options.ts_found &&
+	    conn->recv_options.tsecr != 0U) {
+		conn->rtt_pending = false;
+		tcp_cc_rtt_sample(conn, k_uptime_get_32() -
+				  conn->recv_options.tsecr);
+	} else
+#endif
+	if (conn->rtt_pending &&
+	    net_tcp_seq_cmp(conn->seq, conn->rtt_seq) >= 0) {
+		conn->rtt_pending = false;
+		tcp_cc_rtt_sample(conn, k_uptime_get_32() - conn->rtt_start);
+	}
+
+	if (!conn->in_recovery) {
+		conn->cc->ack(conn, len_acked);
+		conn->cwnd = MIN(conn->cwnd, TCP_CC_CWND_MAX);
+		return;
+	}
+
+	if (net_tcp_seq_cmp(conn->seq, conn->recover) >= 0) {
+		/* Full acknowledgment, leave fast recovery */
+		conn->in_recovery = false;
+		conn->cwnd = conn->ssthresh;
+		return;
+	}
+
+	/* Partial acknowledgment (RFC 6582), retransmit the next missing
+	 * segment and deflate the window by the amount of new data acked.
+	 */
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->sacked_cnt > 0) {
+		(void)tcp_sack_retransmit(conn);
+	} else
+#endif
+	{
+		tcp_fast_retransmit(conn);
+	}
+	conn->cwnd -= MIN(conn->cwnd, len_acked);
+	conn->cwnd += conn_mss(conn);
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
 /* TCP state machine, everything happens here */
 static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 {
@@ -1724,6 +2706,9 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	struct k_fifo *recv_data_fifo;
 	size_t len;
 	int ret;
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	uint32_t prev_send_win;
+#endif
 
 	if (th) {
 		/* Currently we ignore ECN and CWR flags */
@@ -1732,6 +2717,10 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 	k_mutex_lock(&conn->lock, K_FOREVER);
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	prev_send_win = conn->send_win;
+#endif
+
 	NET_DBG("%s", log_strdup(tcp_conn_state(conn, pkt)));
 
 	if (th && th_off(th) < 5) {
@@ -1754,7 +2743,8 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	}
 
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
-						  tcp_options_len)) {
+						  tcp_options_len,
+						  th_flags(th) & SYN)) {
 		NET_DBG("DROP: Invalid TCP option list");
 		tcp_out(conn, RST);
 		conn_state(conn, TCP_CLOSED);
@@ -1766,6 +2756,16 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 		conn->send_win = ntohs(th_win(th));
 
+		/* The window in SYN segments is never scaled, RFC 7323 */
+		if (!(th_flags(th) & SYN)) {
+			conn->send_win <<= conn->snd_wscale;
+		}
+
+		if (conn->ts_ok && conn->recv_options.ts_found &&
+		    net_tcp_seq_cmp(th_seq(th), conn->ack) <= 0) {
+			conn->ts_recent = conn->recv_options.tsval;
+		}
+
 #if defined(CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE)
 		if (CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE) {
 			max_win = CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE;
@@ -1794,6 +2794,8 @@ next_state:
 	switch (conn->state) {
 	case TCP_LISTEN:
 		if (FL(&fl, ==, SYN)) {
+			tcp_options_negotiate(conn);
+
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
@@ -1808,6 +2810,8 @@ next_state:
 						    &conn->establish_timer,
 						    ACK_TIMEOUT);
 		} else {
+			tcp_options_offer(conn);
+
 			conn->send_options.mss_found = true;
 			tcp_out(conn, SYN);
 			conn->send_options.mss_found = false;
@@ -1852,6 +2856,7 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			tcp_options_negotiate(conn);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				if (tcp_data_get(conn, pkt, &len) < 0) {
@@ -1906,6 +2911,22 @@ next_state:
 			break;
 		}
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+#if defined(CONFIG_NET_TCP_SACK)
+		if (th && conn->sack_ok) {
+			tcp_sack_update(conn);
+		}
+#endif
+
+		if (th && th_ack(th) == conn->seq && len == 0 &&
+		    conn->unacked_len > 0 &&
+		    conn->send_win == prev_send_win &&
+		    conn->data_mode == TCP_DATA_MODE_SEND &&
+		    !(th_flags(th) & (SYN | FIN))) {
+			tcp_cc_dup_ack(conn);
+		}
+#endif
+
 		if (th && net_tcp_seq_cmp(th_ack(th), conn->seq) > 0) {
 			uint32_t len_acked = th_ack(th) - conn->seq;
 
@@ -1932,6 +2953,13 @@ next_state:
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+#if defined(CONFIG_NET_TCP_SACK)
+			tcp_sack_prune(conn);
+#endif
+			tcp_cc_new_ack(conn, len_acked);
+#endif
+
 			conn_send_data_dump(conn);
 
 			if (!k_work_delayable_remaining_get(
@@ -1977,6 +3005,11 @@ next_state:
 			} else if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT) {
 				tcp_out_of_order_data(conn, pkt, len,
 						      th_seq(th));
+
+				/* Tell the peer what we have queued */
+				if (conn->sack_ok && len) {
+					tcp_out(conn, ACK);
+				}
 			}
 		}
 		break;
@@ -2044,6 +3077,11 @@ next_state:
 	if (next) {
 		pkt = NULL;
 		th = NULL;
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+		if (next == TCP_ESTABLISHED) {
+			tcp_cc_start(conn);
+		}
+#endif
 		conn_state(conn, next);
 		next = 0;
 
@@ -2117,7 +3155,7 @@ int net_tcp_put(struct net_context *context)
 			 */
 			k_work_reschedule_for_queue(&tcp_work_q,
 						    &conn->send_data_timer,
-						    K_MSEC(tcp_rto));
+						    K_MSEC(conn_rto(conn)));
 		} else {
 			int ret;
 
@@ -2167,7 +3205,7 @@ int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta)
 	}
 
 	new_win = ((struct tcp *)context->tcp)->recv_win + delta;
-	if (new_win < 0 || new_win > UINT16_MAX) {
+	if (new_win < 0 || new_win > NET_TCP_MAX_WIN) {
 		return -EINVAL;
 	}
 
@@ -2176,6 +3214,84 @@ int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta)
 	return 0;
 }
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+int net_tcp_set_congestion(struct net_context *context, const char *name,
+			   size_t len)
+{
+	struct tcp *conn = context->tcp;
+	const struct tcp_cc *cc;
+
+	if (!conn) {
+		return -EPROTOTYPE;
+	}
+
+	cc = tcp_cc_find(name, strnlen(name, len));
+	if (!cc) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (cc != conn->cc) {
+		conn->cc = cc;
+
+		/* The window is kept, only the algorithm state is reset */
+		if (conn->state == TCP_ESTABLISHED) {
+			conn->cc->init(conn);
+		}
+	}
+
+	k_mutex_unlock(&conn->lock);
+
+	return 0;
+}
+
+int net_tcp_get_congestion(struct net_context *context, char *name,
+			   size_t *len)
+{
+	struct tcp *conn = context->tcp;
+	size_t name_len;
+
+	if (!conn) {
+		return -EPROTOTYPE;
+	}
+
+	name_len = MIN(*len, strlen(conn->cc->name) + 1);
+	memcpy(name, conn->cc->name, name_len);
+	*len = name_len;
+
+	return 0;
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
+#if defined(CONFIG_NET_CONTEXT_RCVBUF)
+int net_tcp_set_recv_buf(struct net_context *context, uint32_t size)
+{
+	struct tcp *conn = context->tcp;
+	uint32_t old_size;
+	int64_t new_win;
+
+	if (!conn) {
+		return -EPROTOTYPE;
+	}
+
+	old_size = context->options.rcvbuf ? context->options.rcvbuf :
+		   (uint32_t)tcp_window;
+	if (size == 0U) {
+		size = tcp_window;
+	}
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	new_win = (int64_t)conn->recv_win + size - old_size;
+	conn->recv_win = CLAMP(new_win, 0, NET_TCP_MAX_WIN);
+
+	k_mutex_unlock(&conn->lock);
+
+	return 0;
+}
+#endif /* CONFIG_NET_CONTEXT_RCVBUF */
+
 /* net_context queues the outgoing data for the TCP connection */
 int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 {
@@ -2223,6 +3339,18 @@ int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 
 	len = net_pkt_get_len(pkt);
 
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+	/* Unacknowledged and not yet sent data counts against the send
+	 * buffer, a write is always accepted when nothing is pending.
+	 */
+	if (context->options.sndbuf && conn->send_data_total > 0 &&
+	    conn->send_data_total + len > context->options.sndbuf) {
+		net_stats_update_sock_sndbuf_full(conn->iface);
+		ret = -EAGAIN;
+		goto out;
+	}
+#endif
+
 	if (conn->send_data->buffer) {
 		orig_buf = net_buf_frag_last(conn->send_data->buffer);
 	}
@@ -2300,6 +3428,9 @@ int net_tcp_connect(struct net_context *context,
 	conn = context->tcp;
 	conn->iface = net_context_get_iface(context);
 
+	/* The end points are rewritten below, so rehash the connection */
+	tcp_conn_hash_remove(conn);
+
 	switch (net_context_get_family(context)) {
 		const struct in_addr *ip4;
 		const struct in6_addr *ip6;
@@ -2348,6 +3479,10 @@ int net_tcp_connect(struct net_context *context,
 		ret = -EPROTONOSUPPORT;
 	}
 
+	if (ret == 0) {
+		tcp_conn_hash_add(conn);
+	}
+
 	if (!(IS_ENABLED(CONFIG_NET_TEST_PROTOCOL) ||
 	      IS_ENABLED(CONFIG_NET_TEST))) {
 		conn->seq = tcp_init_isn(&conn->src.sa, &conn->dst.sa);
@@ -2495,6 +3630,10 @@ int net_tcp_finalize(struct net_pkt *pkt)
 		return -ENOBUFS;
 	}
 
+	if (net_pkt_is_chksum_done(pkt)) {
+		return net_pkt_set_data(pkt, &tcp_access);
+	}
+
 	tcp_hdr->chksum = 0U;
 
 	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
@@ -2504,6 +3643,137 @@ int net_tcp_finalize(struct net_pkt *pkt)
 	return net_pkt_set_data(pkt, &tcp_access);
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_segment(struct net_pkt *pkt, size_t *offset,
+			struct net_pkt **seg)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	size_t hdr_len, data_len, len;
+	struct net_pkt *out;
+	struct tcphdr *th;
+	uint32_t seq;
+	uint8_t flags;
+	int ret;
+
+	*seg = NULL;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, ip_len)) {
+		return -EINVAL;
+	}
+
+	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!th) {
+		return -EINVAL;
+	}
+
+	hdr_len = ip_len + th_off(th) * 4;
+	seq = th_seq(th);
+	flags = th_flags(th);
+
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+	if (*offset >= data_len) {
+		return 0;
+	}
+
+	len = MIN(data_len - *offset, net_pkt_gso_size(pkt));
+
+	out = net_pkt_alloc_with_buffer(net_pkt_iface(pkt), hdr_len + len,
+					AF_UNSPEC, 0, TCP_PKT_ALLOC_TIMEOUT);
+	if (!out) {
+		return -ENOBUFS;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_copy(out, pkt, hdr_len) ||
+	    net_pkt_skip(pkt, *offset) ||
+	    net_pkt_copy(out, pkt, len)) {
+		ret = -ENOBUFS;
+		goto fail;
+	}
+
+	net_pkt_set_family(out, net_pkt_family(pkt));
+	net_pkt_set_context(out, net_pkt_context(pkt));
+	net_pkt_set_priority(out, net_pkt_priority(pkt));
+	net_pkt_set_vlan_tag(out, net_pkt_vlan_tag(pkt));
+	net_pkt_set_ip_hdr_len(out, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_ipv4_opts_len(out, net_pkt_ipv4_opts_len(pkt));
+	net_pkt_set_ipv6_ext_len(out, net_pkt_ipv6_ext_len(pkt));
+	net_pkt_set_ipv6_next_hdr(out, net_pkt_ipv6_next_hdr(pkt));
+	memcpy(&out->lladdr_src, &pkt->lladdr_src, sizeof(out->lladdr_src));
+	memcpy(&out->lladdr_dst, &pkt->lladdr_dst, sizeof(out->lladdr_dst));
+
+	net_pkt_cursor_init(out);
+	net_pkt_set_overwrite(out, true);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(out) == AF_INET) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access,
+						      struct net_ipv4_hdr);
+		struct net_ipv4_hdr *ipv4_hdr;
+		uint16_t id;
+
+		ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(
+							out, &ipv4_access);
+		if (!ipv4_hdr) {
+			ret = -ENOBUFS;
+			goto fail;
+		}
+
+		/* Every segment is a datagram of its own */
+		id = ((ipv4_hdr->id[0] << 8) | ipv4_hdr->id[1]) +
+			*offset / net_pkt_gso_size(pkt);
+		ipv4_hdr->id[0] = id >> 8;
+		ipv4_hdr->id[1] = id;
+		ipv4_hdr->chksum = 0U;
+
+		net_pkt_set_data(out, &ipv4_access);
+		net_pkt_cursor_init(out);
+	}
+
+	if (net_pkt_skip(out, ip_len)) {
+		ret = -ENOBUFS;
+		goto fail;
+	}
+
+	th = (struct tcphdr *)net_pkt_get_data(out, &tcp_access);
+	if (!th) {
+		ret = -ENOBUFS;
+		goto fail;
+	}
+
+	UNALIGNED_PUT(htonl(seq + *offset), &th->th_seq);
+
+	/* Only the last segment keeps the PSH and FIN flags */
+	if (*offset + len < data_len) {
+		UNALIGNED_PUT(flags & ~(PSH | FIN), &th->th_flags);
+	}
+
+	if (net_pkt_set_data(out, &tcp_access)) {
+		ret = -ENOBUFS;
+		goto fail;
+	}
+
+	ret = tcp_finalize_pkt(out);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	*offset += len;
+	*seg = out;
+
+	return len;
+
+fail:
+	net_pkt_unref(out);
+
+	return ret;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 				  struct net_pkt_data_access *tcp_access)
 {
@@ -2546,6 +3816,7 @@ static enum net_verdict tcp_input(struct net_conn *net_conn,
 			conn = context->tcp;
 			tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 			tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+			tcp_conn_hash_add(conn);
 			/* Make an extra reference, the sanity check suite
 			 * will delete the connection explicitly
 			 */
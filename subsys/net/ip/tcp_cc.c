@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <string.h>
+#include <zephyr.h>
+#include <net/net_pkt.h>
+#include <net/net_context.h>
+#include "net_private.h"
+#include "tcp_internal.h"
+#include "tcp_cc.h"
+
+#define TCP_RTO_MIN_MS CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT
+#define TCP_RTO_MAX_MS CONFIG_NET_TCP_MAX_RETRANSMISSION_TIMEOUT
+
+/* Initial window, RFC 3390 */
+static uint32_t tcp_cc_initial_window(uint32_t mss)
+{
+	return MIN(4 * mss, MAX(2 * mss, 4380U));
+}
+
+/* Slow start with appropriate byte counting, RFC 5681 and RFC 3465 */
+static void tcp_cc_slow_start(struct tcp *conn, uint32_t acked)
+{
+	conn->cwnd += MIN(acked, (uint32_t)conn_mss(conn));
+}
+
+static uint32_t tcp_cc_flight_half(struct tcp *conn)
+{
+	return MAX((uint32_t)conn->unacked_len / 2,
+		   2U * (uint32_t)conn_mss(conn));
+}
+
+static void newreno_init(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+static void newreno_ack(struct tcp *conn, uint32_t acked)
+{
+	uint32_t mss = conn_mss(conn);
+
+	if (conn->cwnd < conn->ssthresh) {
+		tcp_cc_slow_start(conn, acked);
+		return;
+	}
+
+	/* Congestion avoidance, roughly one MSS per round-trip time */
+	conn->cwnd += MAX(1U, (uint32_t)((uint64_t)mss * acked / conn->cwnd));
+}
+
+static void newreno_congestion(struct tcp *conn)
+{
+	conn->ssthresh = tcp_cc_flight_half(conn);
+}
+
+static void newreno_timeout(struct tcp *conn)
+{
+	conn->ssthresh = tcp_cc_flight_half(conn);
+	conn->cwnd = conn_mss(conn);
+}
+
+static const struct tcp_cc tcp_cc_newreno = {
+	.name = "reno",
+	.init = newreno_init,
+	.ack = newreno_ack,
+	.congestion = newreno_congestion,
+	.timeout = newreno_timeout,
+};
+
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+/* RFC 8312 constants: C = 0.4 and beta_cubic = 0.7. The window is kept in
+ * bytes and the time in milliseconds so the cubic term becomes
+ * 0.4 * mss * (t / 1000)^3 = 4 * mss * t^3 / 10^10.
+ */
+#define CUBIC_BETA_NUM 7
+#define CUBIC_BETA_DEN 10
+#define CUBIC_MAX_DELTA_MS 100000
+
+static uint32_t cubic_root(uint64_t x)
+{
+	uint64_t y = 0;
+	int s;
+
+	for (s = 63; s >= 0; s -= 3) {
+		uint64_t b;
+
+		y <<= 1;
+		b = 3 * y * (y + 1) + 1;
+		if ((x >> s) >= b) {
+			x -= b << s;
+			y++;
+		}
+	}
+
+	return (uint32_t)y;
+}
+
+static void cubic_init(struct tcp *conn)
+{
+	memset(&conn->cc_data.cubic, 0, sizeof(conn->cc_data.cubic));
+}
+
+static void cubic_ack(struct tcp *conn, uint32_t acked)
+{
+	struct tcp_cc_cubic *cubic = &conn->cc_data.cubic;
+	uint32_t mss = conn_mss(conn);
+	uint32_t now = k_uptime_get_32();
+	uint64_t offs, d, inc;
+	uint32_t target;
+	int64_t t;
+
+	if (conn->cwnd < conn->ssthresh) {
+		tcp_cc_slow_start(conn, acked);
+		return;
+	}
+
+	if (cubic->epoch_start == 0) {
+		cubic->epoch_start = now ? now : 1;
+
+		if (conn->cwnd < cubic->w_max) {
+			/* K = cbrt((W_max - cwnd) / C), in ms */
+			cubic->k = cubic_root((uint64_t)(cubic->w_max -
+							 conn->cwnd) *
+					      2500000000ULL / mss);
+			cubic->origin = cubic->w_max;
+		} else {
+			cubic->k = 0;
+			cubic->origin = conn->cwnd;
+		}
+
+		cubic->w_est = conn->cwnd;
+	}
+
+	/* Target window one round-trip time from now */
+	t = (int64_t)(uint32_t)(now - cubic->epoch_start) +
+		(conn->srtt >> 3) - cubic->k;
+	d = MIN((uint64_t)(t < 0 ? -t : t), (uint64_t)CUBIC_MAX_DELTA_MS);
+	offs = (d * d * d / 1000U) * mss * 4U / 10000000U;
+
+	if (t < 0) {
+		target = cubic->origin - MIN(offs, (uint64_t)cubic->origin);
+	} else {
+		target = MIN(cubic->origin + offs, (uint64_t)TCP_CC_CWND_MAX);
+	}
+
+	/* TCP friendly region: W_est grows by 3 * (1 - beta) / (1 + beta)
+	 * segments per round-trip time.
+	 */
+	cubic->w_est += (uint64_t)acked * mss * 9U / (17U * conn->cwnd);
+	if (cubic->w_est > target) {
+		target = cubic->w_est;
+	}
+
+	if (target > conn->cwnd) {
+		inc = (uint64_t)(target - conn->cwnd) * acked / conn->cwnd;
+	} else {
+		inc = (uint64_t)mss * acked / (100U * conn->cwnd);
+	}
+
+	/* Do not grow faster than 1.5 times per round-trip time */
+	conn->cwnd += MIN(inc, (uint64_t)(acked / 2));
+}
+
+static void cubic_congestion(struct tcp *conn)
+{
+	struct tcp_cc_cubic *cubic = &conn->cc_data.cubic;
+	uint32_t mss = conn_mss(conn);
+
+	cubic->epoch_start = 0;
+
+	/* Fast convergence, release bandwidth to new flows */
+	if (conn->cwnd < cubic->w_max) {
+		cubic->w_max = (uint64_t)conn->cwnd *
+			(CUBIC_BETA_DEN + CUBIC_BETA_NUM) /
+			(2 * CUBIC_BETA_DEN);
+	} else {
+		cubic->w_max = conn->cwnd;
+	}
+
+	conn->ssthresh = MAX((uint32_t)((uint64_t)conn->cwnd *
+					CUBIC_BETA_NUM / CUBIC_BETA_DEN),
+			     2U * mss);
+}
+
+static void cubic_timeout(struct tcp *conn)
+{
+	cubic_congestion(conn);
+	conn->cwnd = conn_mss(conn);
+}
+
+static const struct tcp_cc tcp_cc_cubic = {
+	.name = "cubic",
+	.init = cubic_init,
+	.ack = cubic_ack,
+	.congestion = cubic_congestion,
+	.timeout = cubic_timeout,
+};
+#endif /* CONFIG_NET_TCP_CC_CUBIC */
+
+static const struct tcp_cc *const tcp_cc_algos[] = {
+	&tcp_cc_newreno,
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+	&tcp_cc_cubic,
+#endif
+};
+
+const struct tcp_cc *tcp_cc_find(const char *name, size_t len)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(tcp_cc_algos); i++) {
+		if (strlen(tcp_cc_algos[i]->name) == len &&
+		    !strncmp(tcp_cc_algos[i]->name, name, len)) {
+			return tcp_cc_algos[i];
+		}
+	}
+
+	return NULL;
+}
+
+const struct tcp_cc *tcp_cc_default(void)
+{
+#if defined(CONFIG_NET_TCP_CC_DEFAULT_CUBIC)
+	return &tcp_cc_cubic;
+#else
+	return &tcp_cc_newreno;
+#endif
+}
+
+void tcp_cc_start(struct tcp *conn)
+{
+	conn->cwnd = tcp_cc_initial_window(conn_mss(conn));
+	conn->ssthresh = TCP_CC_CWND_MAX;
+	conn->dup_ack_cnt = 0;
+	conn->in_recovery = false;
+	conn->rtt_pending = false;
+
+	conn->cc->init(conn);
+
+	NET_DBG("conn: %p cc %s cwnd %u", conn, conn->cc->name, conn->cwnd);
+}
+
+void tcp_cc_rtt_sample(struct tcp *conn, uint32_t rtt)
+{
+	rtt = MAX(rtt, 1U);
+
+	if (conn->srtt == 0) {
+		conn->srtt = rtt << 3;
+		conn->rttvar = rtt << 1;
+	} else {
+		int32_t delta = (int32_t)rtt - (int32_t)(conn->srtt >> 3);
+
+		conn->srtt += delta;
+		if (delta < 0) {
+			delta = -delta;
+		}
+
+		delta -= conn->rttvar >> 2;
+		conn->rttvar += delta;
+	}
+
+	conn->rto = CLAMP((conn->srtt >> 3) + conn->rttvar,
+			  TCP_RTO_MIN_MS, TCP_RTO_MAX_MS);
+
+	NET_DBG("conn: %p rtt %u srtt %u rttvar %u rto %u", conn, rtt,
+		conn->srtt >> 3, conn->rttvar >> 2, conn->rto);
+}
+
+void tcp_cc_rto_backoff(struct tcp *conn)
+{
+	conn->rto = MIN(conn->rto * 2, (uint32_t)TCP_RTO_MAX_MS);
+}
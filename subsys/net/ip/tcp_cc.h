@@ -0,0 +1,116 @@
+/** @file
+ @brief TCP congestion control
+
+ This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __TCP_CC_H
+#define __TCP_CC_H
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct tcp;
+
+/** Number of duplicate ACKs that trigger a fast retransmit */
+#define TCP_CC_DUP_ACK_THRESHOLD 3
+
+/** Upper bound of the congestion window in bytes */
+#define TCP_CC_CWND_MAX (1U << 30)
+
+/** CUBIC per connection state */
+struct tcp_cc_cubic {
+	uint32_t w_max;       /* window before the last reduction, bytes */
+	uint32_t w_est;       /* TCP friendly window estimate, bytes */
+	uint32_t origin;      /* window where the cubic curve plateaus */
+	uint32_t k;           /* time to reach origin, ms */
+	uint32_t epoch_start; /* start of the current epoch, ms, 0 if none */
+};
+
+/** Per connection state of the congestion control algorithms */
+union tcp_cc_data {
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+	struct tcp_cc_cubic cubic;
+#endif
+	uint32_t unused;
+};
+
+/**
+ * Congestion control algorithm. The generic TCP code takes care of
+ * duplicate ACK detection, fast retransmit and fast recovery, and the
+ * algorithm decides how the congestion window is grown and reduced.
+ * All callbacks are called with the connection lock held.
+ */
+struct tcp_cc {
+	/** Algorithm name as used with the TCP_CONGESTION socket option */
+	const char *name;
+
+	/** Reset the algorithm specific state of the connection */
+	void (*init)(struct tcp *conn);
+
+	/** New data was acknowledged outside of fast recovery */
+	void (*ack)(struct tcp *conn, uint32_t acked);
+
+	/** Loss was detected by duplicate ACKs, set the ssthresh */
+	void (*congestion)(struct tcp *conn);
+
+	/** Retransmission timer expired, set the ssthresh and cwnd */
+	void (*timeout)(struct tcp *conn);
+};
+
+/**
+ * @brief Find a congestion control algorithm by name
+ *
+ * @param name Algorithm name, does not need to be null terminated
+ * @param len Length of the name
+ *
+ * @return Algorithm or NULL if not found
+ */
+const struct tcp_cc *tcp_cc_find(const char *name, size_t len);
+
+/**
+ * @brief Get the algorithm used by new connections
+ *
+ * @return Default congestion control algorithm
+ */
+const struct tcp_cc *tcp_cc_default(void);
+
+/**
+ * @brief Initialize the congestion state when a connection is established
+ *
+ * Sets the initial window (RFC 3390) and an unlimited slow start
+ * threshold, and resets the algorithm specific state.
+ *
+ * @param conn TCP connection
+ */
+void tcp_cc_start(struct tcp *conn);
+
+/**
+ * @brief Feed a round-trip time sample to the RTO estimator (RFC 6298)
+ *
+ * @param conn TCP connection
+ * @param rtt Measured round-trip time in milliseconds
+ */
+void tcp_cc_rtt_sample(struct tcp *conn, uint32_t rtt);
+
+/**
+ * @brief Back off the retransmission timeout after a timer expiry
+ *
+ * @param conn TCP connection
+ */
+void tcp_cc_rto_backoff(struct tcp *conn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TCP_CC_H */
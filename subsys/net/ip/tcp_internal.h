@@ -272,6 +272,48 @@ static inline int net_tcp_finalize(struct net_pkt *pkt)
 }
 #endif
 
+/**
+ * @brief Build the next segment of a TCP segmentation offload packet
+ *
+ * @details The segment gets a copy of the IP and TCP headers of the large
+ * packet, fixed up for its part of the payload, followed by at most
+ * net_pkt_gso_size() bytes of data. The segment is finalized so it can be
+ * given to the L2 as is.
+ *
+ * @param pkt Large network packet, starting with the IP header
+ * @param offset Payload offset of the segment, advanced past its data
+ * @param seg The new segment, NULL when all the data has been segmented
+ *
+ * @return Payload length of the segment, 0 when all the data has been
+ *         segmented, negative errno otherwise.
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_segment(struct net_pkt *pkt, size_t *offset,
+			struct net_pkt **seg);
+#else
+static inline int net_tcp_gso_segment(struct net_pkt *pkt, size_t *offset,
+				      struct net_pkt **seg)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(offset);
+
+	*seg = NULL;
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Pass the coalesced received data of all connections to TCP
+ *
+ * @details Called by the receive queue when it becomes empty.
+ */
+#if defined(CONFIG_NET_TCP_GRO)
+void net_tcp_gro_flush(void);
+#else
+#define net_tcp_gro_flush(...)
+#endif
+
 /**
  * @brief Get pointer to TCP header in net_pkt
  *
@@ -338,6 +380,83 @@ static inline int net_tcp_update_recv_wnd(struct net_context *context,
 }
 #endif
 
+/**
+ * @brief Set the receive buffer size of a TCP connection
+ *
+ * @details The advertised receive window is resized by the difference
+ * between the new and the old buffer size, so data which is already
+ * waiting to be read keeps counting against it.
+ *
+ * @param context Network context
+ * @param size Receive buffer size in bytes, 0 restores the default
+ *
+ * @return 0 on success, -EPROTOTYPE if there is no TCP context,
+ *         -EPROTONOSUPPORT if TCP is not supported
+ */
+#if defined(CONFIG_NET_NATIVE_TCP) && defined(CONFIG_NET_CONTEXT_RCVBUF)
+int net_tcp_set_recv_buf(struct net_context *context, uint32_t size);
+#else
+static inline int net_tcp_set_recv_buf(struct net_context *context,
+				       uint32_t size)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(size);
+
+	return -EPROTONOSUPPORT;
+}
+#endif
+
+/**
+ * @brief Select the congestion control algorithm of a TCP connection
+ *
+ * @param context Network context
+ * @param name Algorithm name, e.g. "reno" or "cubic"
+ * @param len Maximum length of the name
+ *
+ * @return 0 on success, -EPROTOTYPE if there is no TCP context, -ENOENT
+ *         if the algorithm is not available, -ENOTSUP if congestion
+ *         control is not enabled
+ */
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+int net_tcp_set_congestion(struct net_context *context, const char *name,
+			   size_t len);
+#else
+static inline int net_tcp_set_congestion(struct net_context *context,
+					 const char *name, size_t len)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(name);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Get the name of the congestion control algorithm of a connection
+ *
+ * @param context Network context
+ * @param name Buffer for the algorithm name
+ * @param len Size of the buffer, updated to the length of the copied name
+ *
+ * @return 0 on success, -EPROTOTYPE if there is no TCP context, -ENOTSUP
+ *         if congestion control is not enabled
+ */
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+int net_tcp_get_congestion(struct net_context *context, char *name,
+			   size_t *len);
+#else
+static inline int net_tcp_get_congestion(struct net_context *context,
+					 char *name, size_t *len)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(name);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+}
+#endif
+
 /**
  * @brief Queue a TCP FIN packet if needed to close the socket
  *
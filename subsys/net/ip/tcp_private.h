@@ -5,6 +5,7 @@
  */
 
 #include "tp.h"
+#include "tcp_cc.h"
 
 #define is(_a, _b) (strcmp((_a), (_b)) == 0)
 
@@ -125,7 +126,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                                \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -172,10 +173,6 @@ enum th_flags {
 	CWR = BIT(7),
 };
 
-struct tcp_mss_option {
-	uint32_t option;
-};
-
 enum tcp_state {
 	TCP_LISTEN = 1,
 	TCP_SYN_SENT,
@@ -206,25 +203,67 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
+#define NET_TCP_TIMESTAMP_OPT    8
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+#define NET_TCP_TIMESTAMP_SIZE    10
+
+/* Largest shift count allowed by RFC 7323 */
+#define NET_TCP_MAX_WINDOW_SCALE 14
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+#define NET_TCP_MAX_WIN (UINT16_MAX << NET_TCP_MAX_WINDOW_SCALE)
+#else
+#define NET_TCP_MAX_WIN UINT16_MAX
+#endif
+
+#if defined(CONFIG_NET_TCP_SACK)
+#define NET_TCP_SACK_BLOCKS CONFIG_NET_TCP_SACK_BLOCKS
+#else
+#define NET_TCP_SACK_BLOCKS 0
+#endif
+
+struct tcp_sack_block {
+	uint32_t start; /* first sequence number of the block */
+	uint32_t end;   /* sequence number following the block */
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+	uint32_t tsval;
+	uint32_t tsecr;
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack[NET_TCP_SACK_BLOCKS];
+	uint8_t sack_cnt;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+	bool ts_found : 1;
 };
 
 struct tcp { /* TCP connection */
 	sys_snode_t next;
+#if defined(CONFIG_NET_CONN_HASH)
+	sys_snode_t hash_next;
+#endif
 	struct net_context *context;
 	struct net_pkt *send_data;
 	struct net_pkt *queue_recv_data;
+#if defined(CONFIG_NET_TCP_GRO)
+	sys_snode_t gro_next;
+	struct net_pkt *gro_pkt; /* coalesced in-order data, not yet handled */
+	k_tid_t gro_tid;         /* receive queue thread holding gro_pkt */
+#endif
 	struct net_if *iface;
 	void *recv_user_data;
 	sys_slist_t send_queue;
@@ -259,9 +298,39 @@ struct tcp { /* TCP connection */
 	enum tcp_data_mode data_mode;
 	uint32_t seq;
 	uint32_t ack;
-	uint16_t recv_win;
-	uint16_t send_win;
+	uint32_t recv_win;
+	uint32_t send_win;
 	uint8_t send_data_retries;
+	uint8_t snd_wscale; /* shift applied to the peer's window */
+	uint8_t rcv_wscale; /* shift applied to our advertised window */
+	uint32_t ts_recent; /* last timestamp to echo back to the peer */
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Blocks the peer has selectively acknowledged, sorted by seq */
+	struct tcp_sack_block sacked[NET_TCP_SACK_BLOCKS];
+	uint8_t sacked_cnt;
+	uint32_t sack_rexmit; /* end of the last hole retransmitted */
+	/* Queued out-of-order segments, one per block, most recent first */
+	uint32_t sack_recent[NET_TCP_SACK_BLOCKS];
+	uint8_t sack_recent_cnt;
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	const struct tcp_cc *cc;
+	union tcp_cc_data cc_data;
+	uint32_t cwnd;      /* congestion window, bytes */
+	uint32_t ssthresh;  /* slow start threshold, bytes */
+	uint32_t recover;   /* highest seq sent when recovery started */
+	uint32_t rtt_seq;   /* seq acknowledging the timed segment */
+	uint32_t rtt_start; /* uptime when the timed segment was sent */
+	uint32_t srtt;      /* smoothed RTT, ms << 3 */
+	uint32_t rttvar;    /* RTT variation, ms << 2 */
+	uint32_t rto;       /* retransmission timeout, ms */
+	uint8_t dup_ack_cnt;
+	bool rtt_pending : 1;
+	bool in_recovery : 1;
+#endif
+	bool wscale_ok : 1; /* window scaling in use on this connection */
+	bool ts_ok : 1;     /* timestamps in use on this connection */
+	bool sack_ok : 1;   /* SACK permitted on this connection */
 	bool in_retransmission : 1;
 	bool in_connect : 1;
 	bool in_close : 1;
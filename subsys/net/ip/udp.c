@@ -51,7 +51,8 @@ int net_udp_finalize(struct net_pkt *pkt)
 
 	udp_hdr->len = htons(length);
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) &&
+	    !net_pkt_is_chksum_done(pkt)) {
 		udp_hdr->chksum = net_calc_chksum_udp(pkt);
 	}
 
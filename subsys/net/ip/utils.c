@@ -25,6 +25,8 @@ LOG_MODULE_REGISTER(net_utils, CONFIG_NET_UTILS_LOG_LEVEL);
 #include <net/net_core.h>
 #include <net/socket_can.h>
 
+#include "net_private.h"
+
 char *net_sprint_addr(sa_family_t af, const void *addr)
 {
 #define NBUFS 3
@@ -487,34 +489,89 @@ int z_vrfy_net_addr_pton(sa_family_t family, const char *src,
 #include <syscalls/net_addr_pton_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
-static uint16_t calc_chksum(uint16_t sum, const uint8_t *data, size_t len)
+#if !defined(CONFIG_NET_CHKSUM_ARCH)
+/* One's complement sum of the data as native order 16-bit words, folded
+ * to 16 bits. Aligned 32-bit words are added to a 64-bit accumulator so
+ * the carries only need to be folded back once at the end. When the data
+ * starts at an odd address every word is summed byte swapped, which is
+ * undone on the result.
+ */
+static uint16_t chksum_native(const uint8_t *data, size_t len)
 {
-	const uint8_t *end;
-	uint16_t tmp;
+	bool odd = ((uintptr_t)data & 1) != 0;
+	uint64_t sum = 0U;
 
-	end = data + len - 1;
+	if (len == 0) {
+		return 0;
+	}
 
-	while (data < end) {
-		tmp = (data[0] << 8) + data[1];
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	if (odd) {
+		sum = ntohs(*data);
+		data++;
+		len--;
+	}
 
+	if (len >= 2 && ((uintptr_t)data & 2) != 0) {
+		sum += *(const uint16_t *)data;
 		data += 2;
+		len -= 2;
 	}
 
-	if (data == end) {
-		tmp = data[0] << 8;
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	while (len >= 16) {
+		const uint32_t *word = (const uint32_t *)data;
+
+		sum += (uint64_t)word[0] + word[1] + word[2] + word[3];
+		data += 16;
+		len -= 16;
+	}
+
+	while (len >= 4) {
+		sum += *(const uint32_t *)data;
+		data += 4;
+		len -= 4;
+	}
+
+	if (len >= 2) {
+		sum += *(const uint16_t *)data;
+		data += 2;
+		len -= 2;
+	}
+
+	if (len > 0) {
+		sum += ntohs((uint16_t)*data << 8);
+	}
+
+	sum = (sum & 0xffffffffU) + (sum >> 32);
+	sum = (sum & 0xffffffffU) + (sum >> 32);
+	sum = (sum & 0xffffU) + (sum >> 16);
+	sum = (sum & 0xffffU) + (sum >> 16);
+
+	return odd ? __bswap_16((uint16_t)sum) : (uint16_t)sum;
+}
+#else
+#define chksum_native(data, len) arch_net_chksum(data, len)
+#endif /* !CONFIG_NET_CHKSUM_ARCH */
+
+static uint16_t calc_chksum(uint16_t sum, const uint8_t *data, size_t len)
+{
+	/* The callers keep the sum of the big endian words */
+	uint16_t tmp = ntohs(chksum_native(data, len));
+
+	sum += tmp;
+	if (sum < tmp) {
+		sum++;
 	}
 
 	return sum;
 }
 
+uint16_t net_chksum_update(uint16_t chksum, const uint8_t *old_data,
+			   const uint8_t *new_data, size_t len)
+{
+	return net_chksum_update16(chksum, chksum_native(old_data, len),
+				   chksum_native(new_data, len));
+}
+
 static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 {
 	struct net_pkt_cursor *cur = &pkt->cursor;
@@ -189,6 +189,10 @@ static int zsock_socket_internal(int family, int type, int proto)
 	 */
 	k_condvar_init(&ctx->cond.recv);
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	sys_slist_init(&ctx->epoll_items);
+#endif
+
 	/* TCP context is effectively owned by both application
 	 * and the stack: stack may detect that peer closed/aborted
 	 * connection, but it must not dispose of the context behind
@@ -242,6 +246,11 @@ static inline int z_vrfy_zsock_socket(int family, int type, int proto)
 
 int zsock_close_ctx(struct net_context *ctx)
 {
+	/* Drop the socket from epoll instances before the context can be
+	 * reused.
+	 */
+	zsock_epoll_ctx_closed(ctx);
+
 	/* Reset callbacks to avoid any race conditions while
 	 * flushing queues. No need to check return values here,
 	 * as these are fail-free operations and we're closing
@@ -344,8 +353,12 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 				       NULL);
 		k_fifo_init(&new_ctx->recv_q);
 		k_condvar_init(&new_ctx->cond.recv);
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+		sys_slist_init(&new_ctx->epoll_items);
+#endif
 
 		k_fifo_put(&parent->accept_q, new_ctx);
+		zsock_epoll_notify(parent);
 
 		/* TCP context is effectively owned by both application
 		 * and the stack: stack may detect that peer closed/aborted
@@ -358,6 +371,55 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 	}
 }
 
+#if defined(CONFIG_NET_CONTEXT_RCVBUF)
+/* Charge a datagram to the receive buffer of the socket. Returns false if
+ * it does not fit, either because of the limit set with SO_RCVBUF or
+ * because the RX pool is under pressure and the socket already holds
+ * unread data. A datagram is always accepted by an empty socket.
+ */
+static bool zsock_rcvbuf_charge(struct net_context *ctx, struct net_pkt *pkt)
+{
+	atomic_val_t used = atomic_get(&ctx->rcvbuf_used);
+	uint32_t limit = ctx->options.rcvbuf;
+	size_t len = net_pkt_remaining_data(pkt);
+
+	if (used > 0) {
+		switch (net_pkt_mem_pressure()) {
+		case NET_PKT_MEM_PRESSURE_CRITICAL:
+			net_stats_update_sock_pressure_drop(net_pkt_iface(pkt));
+			return false;
+		case NET_PKT_MEM_PRESSURE_LOW:
+			if (limit == 0U || used + len > limit / 2U) {
+				net_stats_update_sock_pressure_drop(
+							net_pkt_iface(pkt));
+				return false;
+			}
+			break;
+		default:
+			break;
+		}
+
+		if (limit && used + len > limit) {
+			net_stats_update_sock_rcvbuf_drop(net_pkt_iface(pkt));
+			return false;
+		}
+	}
+
+	atomic_add(&ctx->rcvbuf_used, len);
+
+	return true;
+}
+
+static void zsock_rcvbuf_release(struct net_context *ctx,
+				 struct net_pkt *pkt)
+{
+	atomic_sub(&ctx->rcvbuf_used, net_pkt_remaining_data(pkt));
+}
+#else
+#define zsock_rcvbuf_charge(ctx, pkt) true
+#define zsock_rcvbuf_release(ctx, pkt)
+#endif /* CONFIG_NET_CONTEXT_RCVBUF */
+
 static void zsock_received_cb(struct net_context *ctx,
 			      struct net_pkt *pkt,
 			      union net_ip_header *ip_hdr,
@@ -392,6 +454,15 @@ static void zsock_received_cb(struct net_context *ctx,
 		goto unlock;
 	}
 
+	/* Datagrams are dropped when the receive buffer is full, stream
+	 * sockets are limited by the TCP receive window instead.
+	 */
+	if (net_context_get_type(ctx) != SOCK_STREAM &&
+	    !zsock_rcvbuf_charge(ctx, pkt)) {
+		net_pkt_unref(pkt);
+		goto unlock;
+	}
+
 	/* Normal packet */
 	net_pkt_set_eof(pkt, false);
 
@@ -404,6 +475,8 @@ unlock:
 		(void)k_mutex_unlock(ctx->cond.lock);
 	}
 
+	zsock_epoll_notify(ctx);
+
 	/* Let reader to wake if it was sleeping */
 	(void)k_condvar_signal(&ctx->cond.recv);
 }
@@ -421,6 +494,8 @@ int zsock_shutdown_ctx(struct net_context *ctx, int how)
 
 		zsock_flush_queue(ctx);
 
+		zsock_epoll_notify(ctx);
+
 		/* Let reader to wake if it was sleeping */
 		(void)k_condvar_signal(&ctx->cond.recv);
 	} else if (how == ZSOCK_SHUT_WR || how == ZSOCK_SHUT_RDWR) {
@@ -656,9 +731,10 @@ static inline int z_vrfy_zsock_accept(int sock, struct sockaddr *addr,
 #define WAIT_BUFS K_MSEC(100)
 #define MAX_WAIT_BUFS K_SECONDS(10)
 
-ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
-			 int flags,
-			 const struct sockaddr *dest_addr, socklen_t addrlen)
+static ssize_t zsock_send_common(struct net_context *ctx, const void *buf,
+				 size_t len, struct net_buf *frags, int flags,
+				 const struct sockaddr *dest_addr,
+				 socklen_t addrlen)
 {
 	k_timeout_t timeout = K_FOREVER;
 	uint64_t buf_timeout = 0;
@@ -682,7 +758,12 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 	}
 
 	while (1) {
-		if (dest_addr) {
+		if (frags) {
+			status = net_context_sendto_frags(ctx, frags, dest_addr,
+							  addrlen, NULL,
+							  timeout,
+							  ctx->user_data);
+		} else if (dest_addr) {
 			status = net_context_sendto(ctx, buf, len, dest_addr,
 						    addrlen, NULL, timeout,
 						    ctx->user_data);
@@ -727,6 +808,14 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 	return status;
 }
 
+ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
+			 int flags,
+			 const struct sockaddr *dest_addr, socklen_t addrlen)
+{
+	return zsock_send_common(ctx, buf, len, NULL, flags, dest_addr,
+				 addrlen);
+}
+
 ssize_t z_impl_zsock_sendto(int sock, const void *buf, size_t len, int flags,
 			   const struct sockaddr *dest_addr, socklen_t addrlen)
 {
@@ -1022,18 +1111,182 @@ int zsock_wait_data(struct net_context *ctx, k_timeout_t *timeout)
 	return 0;
 }
 
+static int zsock_put_cmsg(struct msghdr *msg, size_t *offset, int level,
+			  int type, const void *data, size_t len)
+{
+	struct cmsghdr *cmsg;
+
+	if (*offset + CMSG_SPACE(len) > msg->msg_controllen) {
+		msg->msg_flags |= ZSOCK_MSG_CTRUNC;
+		return -ENOMEM;
+	}
+
+	cmsg = (struct cmsghdr *)((uint8_t *)msg->msg_control + *offset);
+	cmsg->cmsg_len = CMSG_LEN(len);
+	cmsg->cmsg_level = level;
+	cmsg->cmsg_type = type;
+	memcpy(CMSG_DATA(cmsg), data, len);
+
+	*offset += CMSG_SPACE(len);
+
+	return 0;
+}
+
+/* Add the ancillary data taken from the IP header */
+static void zsock_recv_cmsg_ip(struct net_pkt *pkt, struct msghdr *msg,
+			       size_t *offset, uintptr_t wanted)
+{
+	struct net_pkt_cursor backup;
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) &&
+	    net_pkt_family(pkt) == AF_INET) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access,
+						      struct net_ipv4_hdr);
+		struct net_ipv4_hdr *ipv4_hdr;
+
+		ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(
+							pkt, &ipv4_access);
+		if (ipv4_hdr && (wanted & SOCK_RECV_PKTINFO)) {
+			struct in_pktinfo info = {
+				.ipi_ifindex =
+				net_if_get_by_iface(net_pkt_iface(pkt)),
+			};
+
+			net_ipv4_addr_copy_raw((uint8_t *)&info.ipi_addr,
+					       ipv4_hdr->dst);
+			info.ipi_spec_dst = info.ipi_addr;
+
+			(void)zsock_put_cmsg(msg, offset, IPPROTO_IP,
+					     IP_PKTINFO, &info, sizeof(info));
+		}
+
+		if (ipv4_hdr && (wanted & SOCK_RECV_TCLASS)) {
+			uint8_t tos = ipv4_hdr->tos;
+
+			(void)zsock_put_cmsg(msg, offset, IPPROTO_IP,
+					     IP_TOS, &tos, sizeof(tos));
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv6_access,
+						      struct net_ipv6_hdr);
+		struct net_ipv6_hdr *ipv6_hdr;
+
+		ipv6_hdr = (struct net_ipv6_hdr *)net_pkt_get_data(
+							pkt, &ipv6_access);
+		if (ipv6_hdr && (wanted & SOCK_RECV_PKTINFO)) {
+			struct in6_pktinfo info = {
+				.ipi6_ifindex =
+				net_if_get_by_iface(net_pkt_iface(pkt)),
+			};
+
+			net_ipv6_addr_copy_raw((uint8_t *)&info.ipi6_addr,
+					       ipv6_hdr->dst);
+
+			(void)zsock_put_cmsg(msg, offset, IPPROTO_IPV6,
+					     IPV6_PKTINFO, &info, sizeof(info));
+		}
+
+		if (ipv6_hdr && (wanted & SOCK_RECV_TCLASS)) {
+			int tclass = ((ipv6_hdr->vtc & 0x0f) << 4) |
+				     (ipv6_hdr->tcflow >> 4);
+
+			(void)zsock_put_cmsg(msg, offset, IPPROTO_IPV6,
+					     IPV6_TCLASS, &tclass,
+					     sizeof(tclass));
+		}
+	}
+
+	net_pkt_cursor_restore(pkt, &backup);
+}
+
+/* Fill msg_control with the ancillary data enabled on the socket */
+static void zsock_recv_cmsg(struct net_context *ctx, struct net_pkt *pkt,
+			    struct msghdr *msg)
+{
+	uintptr_t wanted = sock_get_flag(ctx, SOCK_RECV_PKTINFO |
+					 SOCK_RECV_TCLASS |
+					 SOCK_RECV_TIMESTAMP);
+	size_t offset = 0;
+
+	if (msg->msg_control == NULL) {
+		msg->msg_controllen = 0;
+		return;
+	}
+
+	/* Packets from offloaded IP stack do not have IP headers */
+	if ((wanted & (SOCK_RECV_PKTINFO | SOCK_RECV_TCLASS)) &&
+	    !(IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	      net_if_is_ip_offloaded(net_context_get_iface(ctx)))) {
+		zsock_recv_cmsg_ip(pkt, msg, &offset, wanted);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_TIMESTAMP) &&
+	    (wanted & SOCK_RECV_TIMESTAMP)) {
+		(void)zsock_put_cmsg(msg, &offset, SOL_SOCKET, SO_TIMESTAMPNS,
+				     net_pkt_timestamp(pkt),
+				     sizeof(struct net_ptp_time));
+	}
+
+	msg->msg_controllen = offset;
+}
+
+static int zsock_recv_src_addr(struct net_context *ctx, struct net_pkt *pkt,
+			       struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		/*
+		 * Packets from offloaded IP stack do not have IP
+		 * headers, so src address cannot be figured out at this
+		 * point. The best we can do is returning remote address
+		 * if that was set using connect() call.
+		 */
+		if (ctx->flags & NET_CONTEXT_REMOTE_ADDR_SET) {
+			memcpy(src_addr, &ctx->remote,
+			       MIN(*addrlen, sizeof(ctx->remote)));
+		} else {
+			return -ENOTSUP;
+		}
+	} else {
+		int rv;
+
+		rv = sock_get_pkt_src_addr(pkt, net_context_get_ip_proto(ctx),
+					   src_addr, *addrlen);
+		if (rv < 0) {
+			LOG_ERR("sock_get_pkt_src_addr %d", rv);
+			return rv;
+		}
+	}
+
+	/* addrlen is a value-result argument, set to actual
+	 * size of source address
+	 */
+	if (src_addr->sa_family == AF_INET) {
+		*addrlen = sizeof(struct sockaddr_in);
+	} else if (src_addr->sa_family == AF_INET6) {
+		*addrlen = sizeof(struct sockaddr_in6);
+	} else {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
 static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
-				       void *buf,
-				       size_t max_len,
-				       int flags,
-				       struct sockaddr *src_addr,
-				       socklen_t *addrlen)
+				       struct msghdr *msg,
+				       int flags)
 {
 	k_timeout_t timeout = K_FOREVER;
+	struct sockaddr *src_addr = msg->msg_name;
 	size_t recv_len = 0;
-	size_t read_len;
+	size_t read_len = 0;
 	struct net_pkt_cursor backup;
 	struct net_pkt *pkt;
+	size_t i;
 
 	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
 		timeout = K_NO_WAIT;
@@ -1062,6 +1315,9 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 		pkt = k_fifo_peek_head(&ctx->recv_q);
 	} else {
 		pkt = k_fifo_get(&ctx->recv_q, timeout);
+		if (pkt) {
+			zsock_rcvbuf_release(ctx, pkt);
+		}
 	}
 
 	if (!pkt) {
@@ -1071,55 +1327,35 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 
 	net_pkt_cursor_backup(pkt, &backup);
 
-	if (src_addr && addrlen) {
-		if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
-		    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
-			/*
-			 * Packets from offloaded IP stack do not have IP
-			 * headers, so src address cannot be figured out at this
-			 * point. The best we can do is returning remote address
-			 * if that was set using connect() call.
-			 */
-			if (ctx->flags & NET_CONTEXT_REMOTE_ADDR_SET) {
-				memcpy(src_addr, &ctx->remote,
-				       MIN(*addrlen, sizeof(ctx->remote)));
-			} else {
-				errno = ENOTSUP;
-				goto fail;
-			}
-		} else {
-			int rv;
-
-			rv = sock_get_pkt_src_addr(pkt, net_context_get_ip_proto(ctx),
-						   src_addr, *addrlen);
-			if (rv < 0) {
-				errno = -rv;
-				LOG_ERR("sock_get_pkt_src_addr %d", rv);
-				goto fail;
-			}
-		}
+	if (src_addr && msg->msg_namelen > 0) {
+		int rv;
 
-		/* addrlen is a value-result argument, set to actual
-		 * size of source address
-		 */
-		if (src_addr->sa_family == AF_INET) {
-			*addrlen = sizeof(struct sockaddr_in);
-		} else if (src_addr->sa_family == AF_INET6) {
-			*addrlen = sizeof(struct sockaddr_in6);
-		} else {
-			errno = ENOTSUP;
+		rv = zsock_recv_src_addr(ctx, pkt, src_addr, &msg->msg_namelen);
+		if (rv < 0) {
+			errno = -rv;
 			goto fail;
 		}
 	}
 
 	recv_len = net_pkt_remaining_data(pkt);
-	read_len = MIN(recv_len, max_len);
 
-	if (net_pkt_read(pkt, buf, read_len)) {
-		errno = ENOBUFS;
-		goto fail;
+	for (i = 0; i < msg->msg_iovlen && read_len < recv_len; i++) {
+		size_t len = MIN(recv_len - read_len, msg->msg_iov[i].iov_len);
+
+		if (net_pkt_read(pkt, msg->msg_iov[i].iov_base, len)) {
+			errno = ENOBUFS;
+			goto fail;
+		}
+
+		read_len += len;
+	}
+
+	if (read_len < recv_len) {
+		msg->msg_flags |= ZSOCK_MSG_TRUNC;
 	}
 
+	zsock_recv_cmsg(ctx, pkt, msg);
+
 	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) &&
 	    !(flags & ZSOCK_MSG_PEEK)) {
 		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
@@ -1274,7 +1510,24 @@ ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
 	}
 
 	if (sock_type == SOCK_DGRAM) {
-		return zsock_recv_dgram(ctx, buf, max_len, flags, src_addr, addrlen);
+		struct iovec iov = {
+			.iov_base = buf,
+			.iov_len = max_len,
+		};
+		struct msghdr msg = {
+			.msg_name = src_addr,
+			.msg_namelen = addrlen ? *addrlen : 0,
+			.msg_iov = &iov,
+			.msg_iovlen = 1,
+		};
+		ssize_t ret;
+
+		ret = zsock_recv_dgram(ctx, &msg, flags);
+		if (ret >= 0 && addrlen) {
+			*addrlen = msg.msg_namelen;
+		}
+
+		return ret;
 	} else if (sock_type == SOCK_STREAM) {
 		return zsock_recv_stream(ctx, buf, max_len, flags);
 	} else {
@@ -1322,127 +1575,638 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
-/* As this is limited function, we don't follow POSIX signature, with
- * "..." instead of last arg.
- */
-int z_impl_zsock_fcntl(int sock, int cmd, int flags)
+ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
+			  int flags)
 {
-	const struct socket_op_vtable *vtable;
-	struct k_mutex *lock;
-	void *obj;
-	int ret;
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	ssize_t total = 0;
+	ssize_t ret;
+	size_t i;
 
-	obj = get_sock_vtable(sock, &vtable, &lock);
-	if (obj == NULL) {
-		errno = EBADF;
-		return -1;
+	msg->msg_flags = 0;
+
+	if (sock_type == SOCK_DGRAM) {
+		return zsock_recv_dgram(ctx, msg, flags);
+	} else if (sock_type != SOCK_STREAM) {
+		__ASSERT(0, "Unknown socket type");
+		return 0;
 	}
 
-	(void)k_mutex_lock(lock, K_FOREVER);
+	/* No address nor ancillary data for stream sockets */
+	msg->msg_namelen = 0;
+	msg->msg_controllen = 0;
 
-	ret = z_fdtable_call_ioctl((const struct fd_op_vtable *)vtable,
-				   obj, cmd, flags);
+	for (i = 0; i < msg->msg_iovlen; i++) {
+		size_t len = msg->msg_iov[i].iov_len;
 
-	k_mutex_unlock(lock);
+		if (len == 0) {
+			continue;
+		}
 
-	return ret;
+		ret = zsock_recv_stream(ctx, msg->msg_iov[i].iov_base, len,
+					flags);
+		if (ret < 0) {
+			return total > 0 ? total : ret;
+		}
+
+		total += ret;
+
+		/* Only the first buffer may wait, and peeking further would
+		 * return the same data again.
+		 */
+		if ((size_t)ret < len || (flags & ZSOCK_MSG_PEEK)) {
+			break;
+		}
+
+		flags |= ZSOCK_MSG_DONTWAIT;
+	}
+
+	return total;
 }
 
-#ifdef CONFIG_USERSPACE
-static inline int z_vrfy_zsock_fcntl(int sock, int cmd, int flags)
+ssize_t z_impl_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 {
-	return z_impl_zsock_fcntl(sock, cmd, flags);
+	VTABLE_CALL(recvmsg, sock, msg, flags);
 }
-#include <syscalls/zsock_fcntl_mrsh.c>
-#endif
 
-static int zsock_poll_prepare_ctx(struct net_context *ctx,
-				  struct zsock_pollfd *pfd,
-				  struct k_poll_event **pev,
-				  struct k_poll_event *pev_end)
+#ifdef CONFIG_USERSPACE
+/* Copy a message header and its iovec array from user mode and check that
+ * the buffers it refers to can be accessed. The data itself is not copied.
+ */
+static int zsock_msghdr_from_user(struct msghdr *kmsg,
+				  const struct msghdr *umsg, bool write)
 {
-	if (pfd->events & ZSOCK_POLLIN) {
-		if (*pev == pev_end) {
-			return -ENOMEM;
-		}
+	size_t iov_size;
+	size_t i;
 
-		(*pev)->obj = &ctx->recv_q;
-		(*pev)->type = K_POLL_TYPE_FIFO_DATA_AVAILABLE;
-		(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
-		(*pev)->state = K_POLL_STATE_NOT_READY;
-		(*pev)++;
+	if (z_user_from_copy(kmsg, (void *)umsg, sizeof(*kmsg))) {
+		return -EFAULT;
 	}
 
-	if (pfd->events & ZSOCK_POLLOUT) {
-		return -EALREADY;
+	if (size_mul_overflow(kmsg->msg_iovlen, sizeof(struct iovec),
+			      &iov_size)) {
+		return -EFAULT;
 	}
 
-	/* If socket is already in EOF, it can be reported
-	 * immediately, so we tell poll() to short-circuit wait.
-	 */
-	if (sock_is_eof(ctx)) {
-		return -EALREADY;
+	if (iov_size == 0) {
+		kmsg->msg_iov = NULL;
+	} else {
+		kmsg->msg_iov = z_user_alloc_from_copy(kmsg->msg_iov,
+						       iov_size);
+		if (!kmsg->msg_iov) {
+			return -ENOMEM;
+		}
 	}
 
-	return 0;
-}
-
-static int zsock_poll_update_ctx(struct net_context *ctx,
-				 struct zsock_pollfd *pfd,
-				 struct k_poll_event **pev)
-{
-	ARG_UNUSED(ctx);
-
-	/* For now, assume that socket is always writable */
-	if (pfd->events & ZSOCK_POLLOUT) {
-		pfd->revents |= ZSOCK_POLLOUT;
+	for (i = 0; i < kmsg->msg_iovlen; i++) {
+		if (Z_SYSCALL_MEMORY(kmsg->msg_iov[i].iov_base,
+				     kmsg->msg_iov[i].iov_len, write)) {
+			goto fault;
+		}
 	}
 
-	if (pfd->events & ZSOCK_POLLIN) {
-		if ((*pev)->state != K_POLL_STATE_NOT_READY || sock_is_eof(ctx)) {
-			pfd->revents |= ZSOCK_POLLIN;
-		}
-		(*pev)++;
+	if (kmsg->msg_name && Z_SYSCALL_MEMORY(kmsg->msg_name,
+					       kmsg->msg_namelen, write)) {
+		goto fault;
 	}
 
-	if (sock_is_eof(ctx)) {
-		pfd->revents |= ZSOCK_POLLHUP;
+	if (kmsg->msg_control && Z_SYSCALL_MEMORY(kmsg->msg_control,
+						  kmsg->msg_controllen,
+						  write)) {
+		goto fault;
 	}
 
 	return 0;
+
+fault:
+	k_free(kmsg->msg_iov);
+	return -EFAULT;
 }
 
-static inline int time_left(uint32_t start, uint32_t timeout)
+/* Return the value-result fields of a received message to user mode */
+static int zsock_msghdr_to_user(struct msghdr *umsg,
+				const struct msghdr *kmsg)
 {
-	uint32_t elapsed = k_uptime_get_32() - start;
+	if (z_user_to_copy(&umsg->msg_namelen, &kmsg->msg_namelen,
+			   sizeof(kmsg->msg_namelen)) ||
+	    z_user_to_copy(&umsg->msg_controllen, &kmsg->msg_controllen,
+			   sizeof(kmsg->msg_controllen)) ||
+	    z_user_to_copy(&umsg->msg_flags, &kmsg->msg_flags,
+			   sizeof(kmsg->msg_flags))) {
+		return -EFAULT;
+	}
 
-	return timeout - elapsed;
+	return 0;
 }
 
-int zsock_poll_internal(struct zsock_pollfd *fds, int nfds, k_timeout_t timeout)
+static inline ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg,
+					   int flags)
 {
-	bool retry;
-	int ret = 0;
-	int i;
-	struct zsock_pollfd *pfd;
-	struct k_poll_event poll_events[CONFIG_NET_SOCKETS_POLL_MAX];
-	struct k_poll_event *pev;
-	struct k_poll_event *pev_end = poll_events + ARRAY_SIZE(poll_events);
-	const struct fd_op_vtable *vtable;
-	struct k_mutex *lock;
-	uint64_t end;
-	bool offload = false;
-	const struct fd_op_vtable *offl_vtable = NULL;
-	void *offl_ctx = NULL;
+	struct msghdr msg_copy;
+	ssize_t ret;
 
-	end = sys_clock_timeout_end_calc(timeout);
+	ret = zsock_msghdr_from_user(&msg_copy, msg, true);
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
 
-	pev = poll_events;
-	for (pfd = fds, i = nfds; i--; pfd++) {
-		void *ctx;
-		int result;
+	ret = z_impl_zsock_recvmsg(sock, &msg_copy, flags);
 
-		/* Per POSIX, negative fd's are just ignored */
+	k_free(msg_copy.msg_iov);
+
+	if (ret >= 0) {
+		Z_OOPS(zsock_msghdr_to_user(msg, &msg_copy));
+	}
+
+	return ret;
+}
+#include <syscalls/zsock_recvmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int count;
+	ssize_t ret = 0;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL || vtable->recvmsg == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (count = 0; count < vlen; count++) {
+		ret = vtable->recvmsg(obj, &msgvec[count].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	k_mutex_unlock(lock);
+
+	/* An error after the first message is reported by the next call */
+	if (count == 0 && ret < 0) {
+		return -1;
+	}
+
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock,
+					struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct zsock_mmsghdr *vec_copy;
+	unsigned int done = 0;
+	unsigned int i;
+	size_t vec_size;
+	int ret;
+
+	if (size_mul_overflow(vlen, sizeof(*msgvec), &vec_size) ||
+	    vec_size == 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	vec_copy = z_user_alloc_from_copy(msgvec, vec_size);
+	if (!vec_copy) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	for (done = 0; done < vlen; done++) {
+		ret = zsock_msghdr_from_user(&vec_copy[done].msg_hdr,
+					     &msgvec[done].msg_hdr, true);
+		if (ret < 0) {
+			errno = -ret;
+			ret = -1;
+			goto out;
+		}
+	}
+
+	ret = z_impl_zsock_recvmmsg(sock, vec_copy, vlen, flags);
+
+	for (i = 0; ret > 0 && i < (unsigned int)ret; i++) {
+		Z_OOPS(zsock_msghdr_to_user(&msgvec[i].msg_hdr,
+					    &vec_copy[i].msg_hdr));
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_len,
+				      &vec_copy[i].msg_len,
+				      sizeof(msgvec[i].msg_len)));
+	}
+
+out:
+	for (i = 0; i < done; i++) {
+		k_free(vec_copy[i].msg_hdr.msg_iov);
+	}
+
+	k_free(vec_copy);
+
+	return ret;
+}
+#include <syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int count;
+	ssize_t ret = 0;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL || vtable->sendmsg == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (count = 0; count < vlen; count++) {
+		ret = vtable->sendmsg(obj, &msgvec[count].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+	}
+
+	k_mutex_unlock(lock);
+
+	/* An error after the first message is reported by the next call */
+	if (count == 0 && ret < 0) {
+		return -1;
+	}
+
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock,
+					struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct zsock_mmsghdr *vec_copy;
+	unsigned int done = 0;
+	unsigned int i;
+	size_t vec_size;
+	int ret;
+
+	if (size_mul_overflow(vlen, sizeof(*msgvec), &vec_size) ||
+	    vec_size == 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	vec_copy = z_user_alloc_from_copy(msgvec, vec_size);
+	if (!vec_copy) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	/* The stack copies the data into packets, so user buffers are only
+	 * checked for read access, same as with zsock_sendto().
+	 */
+	for (done = 0; done < vlen; done++) {
+		ret = zsock_msghdr_from_user(&vec_copy[done].msg_hdr,
+					     &msgvec[done].msg_hdr, false);
+		if (ret < 0) {
+			errno = -ret;
+			ret = -1;
+			goto out;
+		}
+	}
+
+	ret = z_impl_zsock_sendmmsg(sock, vec_copy, vlen, flags);
+
+	for (i = 0; ret > 0 && i < (unsigned int)ret; i++) {
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_len,
+				      &vec_copy[i].msg_len,
+				      sizeof(msgvec[i].msg_len)));
+	}
+
+out:
+	for (i = 0; i < done; i++) {
+		k_free(vec_copy[i].msg_hdr.msg_iov);
+	}
+
+	k_free(vec_copy);
+
+	return ret;
+}
+#include <syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+/* Zero-copy calls only work on sockets of the native stack */
+static struct net_context *zsock_zc_get_ctx(int sock, struct k_mutex **lock)
+{
+	const struct socket_op_vtable *vtable;
+	struct net_context *ctx;
+
+	ctx = get_sock_vtable(sock, &vtable, lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return NULL;
+	}
+
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return NULL;
+	}
+
+	return ctx;
+}
+
+/* Hand the unread part of the packet over as a bare buffer chain */
+static struct net_buf *zsock_pkt_detach(struct net_pkt *pkt)
+{
+	struct net_buf *head = pkt->cursor.buf;
+
+	/* Drop the fragments which were read already, i.e. the headers */
+	while (pkt->buffer != head) {
+		net_pkt_frag_del(pkt, NULL, pkt->buffer);
+	}
+
+	net_buf_pull(head, pkt->cursor.pos - head->data);
+
+	pkt->buffer = NULL;
+	net_pkt_cursor_init(pkt);
+
+	return head;
+}
+
+static ssize_t zsock_recv_zc_ctx(struct net_context *ctx,
+				 struct net_buf **buf, int flags,
+				 struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	size_t len;
+	int ret;
+
+	if (sock_type == SOCK_STREAM) {
+		if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+			errno = ENOTCONN;
+			return -1;
+		}
+
+		if (sock_is_eof(ctx)) {
+			return 0;
+		}
+	} else if (sock_type != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+
+		ret = zsock_wait_data(ctx, &timeout);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	/* Stream data is already there unless the wait was cancelled */
+	pkt = k_fifo_get(&ctx->recv_q,
+			 sock_type == SOCK_STREAM ? K_NO_WAIT : timeout);
+	if (!pkt) {
+		if (sock_type == SOCK_STREAM && sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		errno = EAGAIN;
+		return -1;
+	}
+
+	if (sock_type == SOCK_DGRAM) {
+		zsock_rcvbuf_release(ctx, pkt);
+
+		if (src_addr && addrlen && *addrlen > 0) {
+			ret = zsock_recv_src_addr(ctx, pkt, src_addr, addrlen);
+			if (ret < 0) {
+				net_pkt_unref(pkt);
+				errno = -ret;
+				return -1;
+			}
+		}
+	} else if (net_pkt_eof(pkt)) {
+		sock_set_eof(ctx);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	len = net_pkt_remaining_data(pkt);
+	if (len > 0) {
+		*buf = zsock_pkt_detach(pkt);
+	}
+
+	net_pkt_unref(pkt);
+
+	if (sock_type == SOCK_STREAM) {
+		net_context_update_recv_wnd(ctx, len);
+	}
+
+	return len;
+}
+
+ssize_t zsock_recvfrom_zc(int sock, struct net_buf **buf, int flags,
+			  struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t ret;
+
+	if (buf == NULL || (flags & ~ZSOCK_MSG_DONTWAIT)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	*buf = NULL;
+
+	ctx = zsock_zc_get_ctx(sock, &lock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_recv_zc_ctx(ctx, buf, flags, src_addr, addrlen);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+ssize_t zsock_sendto_zc(int sock, struct net_buf *buf, int flags,
+			const struct sockaddr *dest_addr, socklen_t addrlen)
+{
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t ret;
+
+	if (buf == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ctx = zsock_zc_get_ctx(sock, &lock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_send_common(ctx, NULL, 0, buf, flags, dest_addr, addrlen);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
+/* As this is limited function, we don't follow POSIX signature, with
+ * "..." instead of last arg.
+ */
+int z_impl_zsock_fcntl(int sock, int cmd, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	int ret;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = z_fdtable_call_ioctl((const struct fd_op_vtable *)vtable,
+				   obj, cmd, flags);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_fcntl(int sock, int cmd, int flags)
+{
+	return z_impl_zsock_fcntl(sock, cmd, flags);
+}
+#include <syscalls/zsock_fcntl_mrsh.c>
+#endif
+
+static int zsock_poll_prepare_ctx(struct net_context *ctx,
+				  struct zsock_pollfd *pfd,
+				  struct k_poll_event **pev,
+				  struct k_poll_event *pev_end)
+{
+	if (pfd->events & ZSOCK_POLLIN) {
+		if (*pev == pev_end) {
+			return -ENOMEM;
+		}
+
+		(*pev)->obj = &ctx->recv_q;
+		(*pev)->type = K_POLL_TYPE_FIFO_DATA_AVAILABLE;
+		(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
+		(*pev)->state = K_POLL_STATE_NOT_READY;
+		(*pev)++;
+	}
+
+	if (pfd->events & ZSOCK_POLLOUT) {
+		return -EALREADY;
+	}
+
+	/* If socket is already in EOF, it can be reported
+	 * immediately, so we tell poll() to short-circuit wait.
+	 */
+	if (sock_is_eof(ctx)) {
+		return -EALREADY;
+	}
+
+	return 0;
+}
+
+static int zsock_poll_update_ctx(struct net_context *ctx,
+				 struct zsock_pollfd *pfd,
+				 struct k_poll_event **pev)
+{
+	ARG_UNUSED(ctx);
+
+	/* For now, assume that socket is always writable */
+	if (pfd->events & ZSOCK_POLLOUT) {
+		pfd->revents |= ZSOCK_POLLOUT;
+	}
+
+	if (pfd->events & ZSOCK_POLLIN) {
+		if ((*pev)->state != K_POLL_STATE_NOT_READY || sock_is_eof(ctx)) {
+			pfd->revents |= ZSOCK_POLLIN;
+		}
+		(*pev)++;
+	}
+
+	if (sock_is_eof(ctx)) {
+		pfd->revents |= ZSOCK_POLLHUP;
+	}
+
+	return 0;
+}
+
+static inline int time_left(uint32_t start, uint32_t timeout)
+{
+	uint32_t elapsed = k_uptime_get_32() - start;
+
+	return timeout - elapsed;
+}
+
+int zsock_poll_internal(struct zsock_pollfd *fds, int nfds, k_timeout_t timeout)
+{
+	bool retry;
+	int ret = 0;
+	int i;
+	struct zsock_pollfd *pfd;
+	struct k_poll_event poll_events[CONFIG_NET_SOCKETS_POLL_MAX];
+	struct k_poll_event *pev;
+	struct k_poll_event *pev_end = poll_events + ARRAY_SIZE(poll_events);
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	uint64_t end;
+	bool offload = false;
+	const struct fd_op_vtable *offl_vtable = NULL;
+	void *offl_ctx = NULL;
+
+	end = sys_clock_timeout_end_calc(timeout);
+
+	pev = poll_events;
+	for (pfd = fds, i = nfds; i--; pfd++) {
+		void *ctx;
+		int result;
+
+		/* Per POSIX, negative fd's are just ignored */
 		if (pfd->fd < 0) {
 			continue;
 		}
@@ -1713,6 +2477,59 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 			}
 			break;
 
+		case SO_REUSEPORT:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_REUSEPORT)) {
+				bool reuseport;
+
+				if (*optlen != sizeof(int)) {
+					errno = EINVAL;
+					return -1;
+				}
+
+				ret = net_context_get_option(ctx,
+							     NET_OPT_REUSEPORT,
+							     &reuseport, NULL);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				*(int *)optval = reuseport;
+
+				return 0;
+			}
+
+			break;
+
+		case SO_RCVBUF:
+		case SO_SNDBUF:
+			if ((optname == SO_RCVBUF &&
+			     IS_ENABLED(CONFIG_NET_CONTEXT_RCVBUF)) ||
+			    (optname == SO_SNDBUF &&
+			     IS_ENABLED(CONFIG_NET_CONTEXT_SNDBUF))) {
+				uint32_t size;
+
+				if (*optlen != sizeof(int)) {
+					errno = EINVAL;
+					return -1;
+				}
+
+				ret = net_context_get_option(ctx,
+					optname == SO_RCVBUF ? NET_OPT_RCVBUF :
+							       NET_OPT_SNDBUF,
+					&size, NULL);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				*(int *)optval = (int)size;
+
+				return 0;
+			}
+
+			break;
+
 		case SO_PROTOCOL: {
 			int proto = (int)net_context_get_ip_proto(ctx);
 
@@ -1727,6 +2544,26 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 		}
 		}
 
+		break;
+
+	case IPPROTO_TCP:
+		switch (optname) {
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CONTROL)) {
+				ret = net_context_get_option(ctx,
+							NET_OPT_TCP_CONGESTION,
+							optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+		}
+
 		break;
 	}
 
@@ -1771,6 +2608,24 @@ int z_vrfy_zsock_getsockopt(int sock, int level, int optname,
 #include <syscalls/zsock_getsockopt_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+static int sock_set_recv_flag(struct net_context *ctx, uintptr_t flag,
+			      const void *optval, socklen_t optlen)
+{
+	if (net_context_get_type(ctx) != SOCK_DGRAM) {
+		errno = ENOPROTOOPT;
+		return -1;
+	}
+
+	if (optval == NULL || optlen != sizeof(int)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	sock_set_flag(ctx, flag, *(const int *)optval ? flag : 0);
+
+	return 0;
+}
+
 int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			 const void *optval, socklen_t optlen)
 {
@@ -1785,6 +2640,31 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			 */
 			return 0;
 
+		case SO_REUSEPORT:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_REUSEPORT)) {
+				bool reuseport;
+
+				if (optlen != sizeof(int)) {
+					errno = EINVAL;
+					return -1;
+				}
+
+				reuseport = *(const int *)optval != 0;
+
+				ret = net_context_set_option(ctx,
+							     NET_OPT_REUSEPORT,
+							     &reuseport,
+							     sizeof(reuseport));
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case SO_PRIORITY:
 			if (IS_ENABLED(CONFIG_NET_CONTEXT_PRIORITY)) {
 				ret = net_context_set_option(ctx,
@@ -1863,6 +2743,36 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 
 			break;
 
+		case SO_RCVBUF:
+		case SO_SNDBUF:
+			if ((optname == SO_RCVBUF &&
+			     IS_ENABLED(CONFIG_NET_CONTEXT_RCVBUF)) ||
+			    (optname == SO_SNDBUF &&
+			     IS_ENABLED(CONFIG_NET_CONTEXT_SNDBUF))) {
+				uint32_t size;
+
+				if (optlen != sizeof(int) ||
+				    *(const int *)optval < 0) {
+					errno = EINVAL;
+					return -1;
+				}
+
+				size = *(const int *)optval;
+
+				ret = net_context_set_option(ctx,
+					optname == SO_RCVBUF ? NET_OPT_RCVBUF :
+							       NET_OPT_SNDBUF,
+					&size, sizeof(size));
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case SO_TXTIME:
 			if (IS_ENABLED(CONFIG_NET_CONTEXT_TXTIME)) {
 				ret = net_context_set_option(ctx,
@@ -1878,6 +2788,15 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 
 			break;
 
+		case SO_TIMESTAMPNS:
+			if (IS_ENABLED(CONFIG_NET_PKT_TIMESTAMP)) {
+				return sock_set_recv_flag(ctx,
+							  SOCK_RECV_TIMESTAMP,
+							  optval, optlen);
+			}
+
+			break;
+
 		case SO_SOCKS5:
 			if (IS_ENABLED(CONFIG_SOCKS)) {
 				ret = net_context_set_option(ctx,
@@ -1949,6 +2868,33 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			 * existing apps.
 			 */
 			return 0;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CONTROL)) {
+				ret = net_context_set_option(ctx,
+							NET_OPT_TCP_CONGESTION,
+							optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+		}
+		break;
+
+	case IPPROTO_IP:
+		switch (optname) {
+		case IP_PKTINFO:
+			return sock_set_recv_flag(ctx, SOCK_RECV_PKTINFO,
+						  optval, optlen);
+
+		case IP_RECVTOS:
+			return sock_set_recv_flag(ctx, SOCK_RECV_TCLASS,
+						  optval, optlen);
 		}
 		break;
 
@@ -1959,6 +2905,14 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			 * existing apps.
 			 */
 			return 0;
+
+		case IPV6_RECVPKTINFO:
+			return sock_set_recv_flag(ctx, SOCK_RECV_PKTINFO,
+						  optval, optlen);
+
+		case IPV6_RECVTCLASS:
+			return sock_set_recv_flag(ctx, SOCK_RECV_TCLASS,
+						  optval, optlen);
 		}
 		break;
 	}
@@ -2188,6 +3142,11 @@ static ssize_t sock_sendmsg_vmeth(void *obj, const struct msghdr *msg,
 	return zsock_sendmsg_ctx(obj, msg, flags);
 }
 
+static ssize_t sock_recvmsg_vmeth(void *obj, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg_ctx(obj, msg, flags);
+}
+
 static ssize_t sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				   int flags, struct sockaddr *src_addr,
 				   socklen_t *addrlen)
@@ -2233,6 +3192,7 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.accept = sock_accept_vmeth,
 	.sendto = sock_sendto_vmeth,
 	.sendmsg = sock_sendmsg_vmeth,
+	.recvmsg = sock_recvmsg_vmeth,
 	.recvfrom = sock_recvfrom_vmeth,
 	.getsockopt = sock_getsockopt_vmeth,
 	.setsockopt = sock_setsockopt_vmeth,
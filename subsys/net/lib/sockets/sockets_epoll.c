@@ -0,0 +1,746 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Epoll-style readiness notification for native sockets.
+ *
+ * Every watched socket has one item per epoll instance. The item is
+ * linked to the net_context so that the receive path can move it to the
+ * ready list of its instance when data, a new connection or EOF
+ * arrives. Waiting only walks the ready list, so the cost of a wakeup
+ * does not depend on the number of watched sockets.
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_sock_epoll, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <kernel.h>
+#include <errno.h>
+#include <string.h>
+#include <net/socket.h>
+#include <syscall_handler.h>
+#include <sys/fdtable.h>
+#include <sys/math_extras.h>
+
+#include "sockets_internal.h"
+
+/* Events which can be reported, clearing them disables the item. Native
+ * sockets have no error state, ZSOCK_EPOLLERR is never reported.
+ */
+#define EPOLL_EVENTS_MASK (ZSOCK_EPOLLIN | ZSOCK_EPOLLOUT | ZSOCK_EPOLLHUP)
+
+struct zsock_epoll {
+	/** All items of the instance */
+	sys_dlist_t items;
+	/** Items which were seen ready and not yet reported */
+	sys_dlist_t ready;
+	/** Raised when an item is queued to the ready list */
+	struct k_poll_signal ready_sig;
+	/** Lock of the descriptor, protects waiters and closed */
+	struct k_mutex *lock;
+	/** Signalled when a waiter leaves a closed instance */
+	struct k_condvar drained;
+	/** Number of threads in zsock_epoll_wait() */
+	int waiters;
+	/** The descriptor is being closed */
+	bool closed;
+};
+
+struct epoll_item {
+	/** Node in zsock_epoll.items */
+	sys_dnode_t ep_node;
+	/** Node in zsock_epoll.ready, linked while the item is queued */
+	sys_dnode_t ready_node;
+	/** Node in net_context.epoll_items */
+	sys_snode_t ctx_node;
+	struct zsock_epoll *ep;
+	struct net_context *ctx;
+	uint32_t events;
+	union zsock_epoll_data data;
+};
+
+extern const struct socket_op_vtable sock_fd_op_vtable;
+static const struct socket_op_vtable epoll_fd_op_vtable;
+
+/* Protects the item lists of all the instances and sockets, it is taken
+ * from the network receive path so it must never be held for long.
+ */
+static struct k_spinlock epoll_lock;
+
+static uint32_t epoll_item_revents(struct epoll_item *item)
+{
+	struct net_context *ctx = item->ctx;
+	uint32_t revents;
+
+	if ((item->events & EPOLL_EVENTS_MASK) == 0U) {
+		return 0;
+	}
+
+	/* Native sockets are always writable, same as in poll() */
+	revents = ZSOCK_EPOLLOUT;
+
+	/* recv_q and accept_q are in union */
+	if (!k_fifo_is_empty(&ctx->recv_q)) {
+		revents |= ZSOCK_EPOLLIN;
+	}
+
+	if (sock_is_eof(ctx)) {
+		revents |= ZSOCK_EPOLLIN | ZSOCK_EPOLLHUP;
+	}
+
+	return revents & item->events;
+}
+
+/* Must be called with epoll_lock held */
+static void epoll_item_queue(struct epoll_item *item)
+{
+	if (sys_dnode_is_linked(&item->ready_node) ||
+	    epoll_item_revents(item) == 0U) {
+		return;
+	}
+
+	sys_dlist_append(&item->ep->ready, &item->ready_node);
+	(void)k_poll_signal_raise(&item->ep->ready_sig, 0);
+}
+
+/* Must be called with epoll_lock held */
+static void epoll_item_unlink(struct epoll_item *item)
+{
+	sys_dlist_remove(&item->ep_node);
+
+	if (sys_dnode_is_linked(&item->ready_node)) {
+		sys_dlist_remove(&item->ready_node);
+	}
+}
+
+/* Must be called with epoll_lock held */
+static struct epoll_item *epoll_item_find(struct zsock_epoll *ep,
+					  struct net_context *ctx)
+{
+	struct epoll_item *item;
+
+	/* The list holds one item per instance watching the socket */
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->epoll_items, item, ctx_node) {
+		if (item->ep == ep) {
+			return item;
+		}
+	}
+
+	return NULL;
+}
+
+void zsock_epoll_notify(struct net_context *ctx)
+{
+	k_spinlock_key_t key = k_spin_lock(&epoll_lock);
+	struct epoll_item *item;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->epoll_items, item, ctx_node) {
+		epoll_item_queue(item);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+}
+
+void zsock_epoll_ctx_closed(struct net_context *ctx)
+{
+	sys_slist_t closed;
+	struct epoll_item *item;
+	sys_snode_t *node;
+	k_spinlock_key_t key;
+
+	sys_slist_init(&closed);
+
+	key = k_spin_lock(&epoll_lock);
+
+	while ((node = sys_slist_get(&ctx->epoll_items)) != NULL) {
+		item = CONTAINER_OF(node, struct epoll_item, ctx_node);
+		epoll_item_unlink(item);
+		sys_slist_append(&closed, node);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	while ((node = sys_slist_get(&closed)) != NULL) {
+		k_free(CONTAINER_OF(node, struct epoll_item, ctx_node));
+	}
+}
+
+/* Drop the queued items which are no longer ready and tell whether
+ * any is left.
+ */
+static bool epoll_has_ready(struct zsock_epoll *ep)
+{
+	k_spinlock_key_t key = k_spin_lock(&epoll_lock);
+	struct epoll_item *item, *next;
+	bool ready = false;
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&ep->ready, item, next, ready_node) {
+		if (epoll_item_revents(item) != 0U) {
+			ready = true;
+			break;
+		}
+
+		sys_dlist_remove(&item->ready_node);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	return ready;
+}
+
+static int epoll_collect(struct zsock_epoll *ep,
+			 struct zsock_epoll_event *events, int maxevents)
+{
+	k_spinlock_key_t key;
+	struct epoll_item *item;
+	sys_dlist_t requeue;
+	sys_dnode_t *node;
+	uint32_t revents;
+	int count = 0;
+
+	sys_dlist_init(&requeue);
+
+	key = k_spin_lock(&epoll_lock);
+
+	while (count < maxevents) {
+		node = sys_dlist_get(&ep->ready);
+		if (node == NULL) {
+			break;
+		}
+
+		item = CONTAINER_OF(node, struct epoll_item, ready_node);
+
+		/* The socket could have been drained since it was queued */
+		revents = epoll_item_revents(item);
+		if (revents == 0U) {
+			continue;
+		}
+
+		events[count].events = revents;
+		events[count].data = item->data;
+		count++;
+
+		if (item->events & ZSOCK_EPOLLONESHOT) {
+			item->events &= ~EPOLL_EVENTS_MASK;
+		} else if (!(item->events & ZSOCK_EPOLLET)) {
+			/* Level triggered items stay queued and are checked
+			 * again on the next wait.
+			 */
+			sys_dlist_append(&requeue, node);
+		}
+	}
+
+	while ((node = sys_dlist_get(&requeue)) != NULL) {
+		sys_dlist_append(&ep->ready, node);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	return count;
+}
+
+static struct zsock_epoll *epoll_new(void)
+{
+	struct zsock_epoll *ep;
+
+#ifdef CONFIG_USERSPACE
+	struct z_object *zo = z_dynamic_object_create(sizeof(*ep));
+
+	if (zo == NULL) {
+		ep = NULL;
+	} else {
+		ep = zo->name;
+		zo->type = K_OBJ_NET_SOCKET;
+	}
+#else
+	ep = k_malloc(sizeof(*ep));
+#endif
+	if (ep == NULL) {
+		return NULL;
+	}
+
+	sys_dlist_init(&ep->items);
+	sys_dlist_init(&ep->ready);
+	k_poll_signal_init(&ep->ready_sig);
+	k_condvar_init(&ep->drained);
+	ep->lock = NULL;
+	ep->waiters = 0;
+	ep->closed = false;
+
+	return ep;
+}
+
+static void epoll_delete(struct zsock_epoll *ep)
+{
+#ifdef CONFIG_USERSPACE
+	k_object_free(ep);
+#else
+	k_free(ep);
+#endif
+}
+
+int z_impl_zsock_epoll_create(int flags)
+{
+	struct zsock_epoll *ep;
+	int fd;
+
+	if (flags != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	fd = z_reserve_fd();
+	if (fd < 0) {
+		return -1;
+	}
+
+	ep = epoll_new();
+	if (ep == NULL) {
+		z_free_fd(fd);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	z_finalize_fd(fd, ep, (const struct fd_op_vtable *)&epoll_fd_op_vtable);
+
+	NET_DBG("epoll: ep=%p, fd=%d", ep, fd);
+
+	return fd;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_create(int flags)
+{
+	return z_impl_zsock_epoll_create(flags);
+}
+#include <syscalls/zsock_epoll_create_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+static int epoll_ctl_add(struct zsock_epoll *ep, struct net_context *ctx,
+			 struct zsock_epoll_event *event)
+{
+	struct epoll_item *item;
+	k_spinlock_key_t key;
+
+	item = k_malloc(sizeof(*item));
+	if (item == NULL) {
+		return -ENOMEM;
+	}
+
+	memset(item, 0, sizeof(*item));
+	item->ep = ep;
+	item->ctx = ctx;
+	item->events = event->events | ZSOCK_EPOLLHUP;
+	item->data = event->data;
+
+	key = k_spin_lock(&epoll_lock);
+
+	if (epoll_item_find(ep, ctx) != NULL) {
+		k_spin_unlock(&epoll_lock, key);
+		k_free(item);
+		return -EEXIST;
+	}
+
+	sys_dlist_append(&ep->items, &item->ep_node);
+	sys_slist_append(&ctx->epoll_items, &item->ctx_node);
+	epoll_item_queue(item);
+
+	k_spin_unlock(&epoll_lock, key);
+
+	return 0;
+}
+
+static int epoll_ctl_mod(struct zsock_epoll *ep, struct net_context *ctx,
+			 struct zsock_epoll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&epoll_lock);
+	struct epoll_item *item;
+
+	item = epoll_item_find(ep, ctx);
+	if (item == NULL) {
+		k_spin_unlock(&epoll_lock, key);
+		return -ENOENT;
+	}
+
+	item->events = event->events | ZSOCK_EPOLLHUP;
+	item->data = event->data;
+	epoll_item_queue(item);
+
+	k_spin_unlock(&epoll_lock, key);
+
+	return 0;
+}
+
+static int epoll_ctl_del(struct zsock_epoll *ep, struct net_context *ctx)
+{
+	k_spinlock_key_t key = k_spin_lock(&epoll_lock);
+	struct epoll_item *item;
+
+	item = epoll_item_find(ep, ctx);
+	if (item == NULL) {
+		k_spin_unlock(&epoll_lock, key);
+		return -ENOENT;
+	}
+
+	sys_slist_find_and_remove(&ctx->epoll_items, &item->ctx_node);
+	epoll_item_unlink(item);
+
+	k_spin_unlock(&epoll_lock, key);
+
+	k_free(item);
+
+	return 0;
+}
+
+int z_impl_zsock_epoll_ctl(int epfd, int op, int fd,
+			   struct zsock_epoll_event *event)
+{
+	const struct fd_op_vtable *vtable;
+	struct zsock_epoll *ep;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	int ret;
+
+	ep = z_get_fd_obj(epfd, (const struct fd_op_vtable *)
+			  &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	ctx = z_get_fd_obj_and_vtable(fd, &vtable, &lock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	/* Readiness is tracked by the native socket receive path, TLS,
+	 * offloaded and other descriptors can only be used with poll().
+	 */
+	if (vtable != (const struct fd_op_vtable *)&sock_fd_op_vtable) {
+		errno = EPERM;
+		return -1;
+	}
+
+	if (op != ZSOCK_EPOLL_CTL_DEL && event == NULL) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	/* Keep the socket from being closed under us */
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		ret = epoll_ctl_add(ep, ctx, event);
+		break;
+	case ZSOCK_EPOLL_CTL_MOD:
+		ret = epoll_ctl_mod(ep, ctx, event);
+		break;
+	case ZSOCK_EPOLL_CTL_DEL:
+		ret = epoll_ctl_del(ep, ctx);
+		break;
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_mutex_unlock(lock);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_ctl(int epfd, int op, int fd,
+					 struct zsock_epoll_event *event)
+{
+	struct zsock_epoll_event event_copy;
+
+	if (event != NULL) {
+		Z_OOPS(z_user_from_copy(&event_copy, (void *)event,
+					sizeof(event_copy)));
+		event = &event_copy;
+	}
+
+	return z_impl_zsock_epoll_ctl(epfd, op, fd, event);
+}
+#include <syscalls/zsock_epoll_ctl_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+/* Wait for ready items, returns their number or a negative errno value */
+static int epoll_wait_events(struct zsock_epoll *ep,
+			     struct zsock_epoll_event *events, int maxevents,
+			     int timeout)
+{
+	struct k_poll_event pev;
+	k_timeout_t poll_timeout;
+	uint64_t end;
+	int count;
+	int ret;
+
+	if (timeout < 0) {
+		poll_timeout = K_FOREVER;
+	} else {
+		poll_timeout = K_MSEC(timeout);
+	}
+
+	end = sys_clock_timeout_end_calc(poll_timeout);
+
+	while (true) {
+		/* Reset before collecting so that an item queued after the
+		 * ready list was emptied wakes up the k_poll() below. The
+		 * signal raised by close is not lost either.
+		 */
+		k_poll_signal_reset(&ep->ready_sig);
+
+		if (ep->closed) {
+			return -EBADF;
+		}
+
+		count = epoll_collect(ep, events, maxevents);
+		if (count > 0 || K_TIMEOUT_EQ(poll_timeout, K_NO_WAIT)) {
+			return count;
+		}
+
+		k_poll_event_init(&pev, K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &ep->ready_sig);
+
+		ret = k_poll(&pev, 1, poll_timeout);
+		if (ret == -EAGAIN) {
+			return 0;
+		} else if (ret < 0) {
+			return ret;
+		}
+
+		if (!K_TIMEOUT_EQ(poll_timeout, K_FOREVER)) {
+			int64_t remaining = end - sys_clock_tick_get();
+
+			if (remaining <= 0) {
+				poll_timeout = K_NO_WAIT;
+			} else {
+				poll_timeout = Z_TIMEOUT_TICKS(remaining);
+			}
+		}
+	}
+}
+
+int z_impl_zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			    int maxevents, int timeout)
+{
+	struct zsock_epoll *ep;
+	int ret;
+
+	ep = z_get_fd_obj(epfd, (const struct fd_op_vtable *)
+			  &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (events == NULL || maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* A close waits for the registered waiters to leave before the
+	 * instance is freed.
+	 */
+	(void)k_mutex_lock(ep->lock, K_FOREVER);
+	ep->waiters++;
+	k_mutex_unlock(ep->lock);
+
+	ret = epoll_wait_events(ep, events, maxevents, timeout);
+
+	(void)k_mutex_lock(ep->lock, K_FOREVER);
+	ep->waiters--;
+	if (ep->closed) {
+		(void)k_condvar_signal(&ep->drained);
+	}
+	k_mutex_unlock(ep->lock);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_wait(int epfd,
+					  struct zsock_epoll_event *events,
+					  int maxevents, int timeout)
+{
+	struct zsock_epoll_event *events_copy;
+	size_t events_size;
+	int ret;
+
+	if (maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (size_mul_overflow(maxevents, sizeof(struct zsock_epoll_event),
+			      &events_size)) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	events_copy = z_user_alloc_from_copy((void *)events, events_size);
+	if (events_copy == NULL) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	ret = z_impl_zsock_epoll_wait(epfd, events_copy, maxevents, timeout);
+
+	if (ret > 0) {
+		z_user_to_copy((void *)events, events_copy,
+			       ret * sizeof(struct zsock_epoll_event));
+	}
+
+	k_free(events_copy);
+
+	return ret;
+}
+#include <syscalls/zsock_epoll_wait_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+static ssize_t epoll_read_write(void *obj, void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t epoll_write(void *obj, const void *buffer, size_t count)
+{
+	return epoll_read_write(obj, (void *)buffer, count);
+}
+
+static int epoll_close(void *obj)
+{
+	struct zsock_epoll *ep = obj;
+	struct epoll_item *item;
+	k_spinlock_key_t key;
+	sys_dnode_t *node;
+	sys_dlist_t closed;
+
+	/* Called with the descriptor lock held, which the condition
+	 * variable releases while the waiters wake up and leave.
+	 */
+	ep->closed = true;
+
+	while (ep->waiters > 0) {
+		/* A raise only wakes up one waiter */
+		(void)k_poll_signal_raise(&ep->ready_sig, 0);
+		(void)k_condvar_wait(&ep->drained, ep->lock, K_FOREVER);
+	}
+
+	sys_dlist_init(&closed);
+
+	key = k_spin_lock(&epoll_lock);
+
+	while ((node = sys_dlist_get(&ep->items)) != NULL) {
+		item = CONTAINER_OF(node, struct epoll_item, ep_node);
+		sys_slist_find_and_remove(&item->ctx->epoll_items,
+					  &item->ctx_node);
+
+		if (sys_dnode_is_linked(&item->ready_node)) {
+			sys_dlist_remove(&item->ready_node);
+		}
+
+		sys_dlist_append(&closed, node);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	while ((node = sys_dlist_get(&closed)) != NULL) {
+		k_free(CONTAINER_OF(node, struct epoll_item, ep_node));
+	}
+
+	epoll_delete(ep);
+
+	return 0;
+}
+
+static int epoll_ioctl(void *obj, unsigned int request, va_list args)
+{
+	struct zsock_epoll *ep = obj;
+	struct zsock_pollfd *pfd;
+	struct k_poll_event **pev;
+	struct k_poll_event *pev_end;
+
+	switch (request) {
+	case ZFD_IOCTL_POLL_PREPARE:
+		pfd = va_arg(args, struct zsock_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+		pev_end = va_arg(args, struct k_poll_event *);
+
+		if (!(pfd->events & ZSOCK_POLLIN)) {
+			return 0;
+		}
+
+		if (*pev == pev_end) {
+			return -ENOMEM;
+		}
+
+		k_poll_signal_reset(&ep->ready_sig);
+		k_poll_event_init(*pev, K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &ep->ready_sig);
+		(*pev)++;
+
+		/* Tell poll() to short-circuit wait */
+		if (epoll_has_ready(ep)) {
+			return -EALREADY;
+		}
+
+		return 0;
+
+	case ZFD_IOCTL_POLL_UPDATE:
+		pfd = va_arg(args, struct zsock_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+
+		if (!(pfd->events & ZSOCK_POLLIN)) {
+			return 0;
+		}
+
+		if (epoll_has_ready(ep)) {
+			pfd->revents |= ZSOCK_POLLIN;
+		} else if ((*pev)->state != K_POLL_STATE_NOT_READY) {
+			/* Only stale items were queued, wait again */
+			k_poll_signal_reset(&ep->ready_sig);
+			(*pev)->state = K_POLL_STATE_NOT_READY;
+			(*pev)++;
+			return -EAGAIN;
+		}
+
+		(*pev)++;
+
+		return 0;
+
+	case ZFD_IOCTL_SET_LOCK:
+		ep->lock = va_arg(args, struct k_mutex *);
+		return 0;
+
+	default:
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+}
+
+static const struct socket_op_vtable epoll_fd_op_vtable = {
+	.fd_vtable = {
+		.read = epoll_read_write,
+		.write = epoll_write,
+		.close = epoll_close,
+		.ioctl = epoll_ioctl,
+	},
+};
@@ -46,6 +46,12 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/ssl_cookie.h>
 #include <mbedtls/error.h>
 #include <mbedtls/debug.h>
+#if defined(MBEDTLS_SSL_CACHE_C)
+#include <mbedtls/ssl_cache.h>
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+#include <mbedtls/ssl_ticket.h>
+#endif
 #endif /* CONFIG_MBEDTLS */
 
 #include "sockets_internal.h"
@@ -117,6 +123,37 @@ __net_socket struct tls_context {
 	/** Information whether TLS handshake is complete or not. */
 	struct k_sem tls_established;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE)
+	/** Work running the handshake of a non-blocking socket. */
+	struct k_work_poll handshake_work;
+
+	/** Event on the underlying socket the handshake work waits for. */
+	struct k_poll_event handshake_event;
+
+	/** Signal raised when the non-blocking handshake is finished. */
+	struct k_poll_signal handshake_done;
+
+	/** Information whether the non-blocking handshake is running. */
+	atomic_t handshake_pending;
+
+	/** Result of the non-blocking handshake. */
+	int handshake_error;
+
+	/** Time when the non-blocking handshake was started. */
+	uint32_t handshake_start;
+
+	/** Information whether the socket is being closed. */
+	bool handshake_cancel;
+
+	/** Information whether poll() waits for the handshake signal. */
+	bool handshake_polled;
+#endif /* CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE */
+
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+	/** TLS client peer address, used to find the session to resume. */
+	struct sockaddr session_peer_addr;
+#endif /* CONFIG_NET_SOCKETS_TLS_SESSION_CACHE */
+
 	/** TLS specific option values. */
 	struct {
 		/** Select which credentials to use with TLS. */
@@ -193,6 +230,20 @@ static struct tls_context tls_contexts[CONFIG_NET_SOCKETS_TLS_MAX_CONTEXTS];
 /* A mutex for protecting TLS context allocation. */
 static struct k_mutex context_lock;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE)
+K_KERNEL_STACK_DEFINE(tls_handshake_stack,
+		      CONFIG_NET_SOCKETS_TLS_HANDSHAKE_STACK_SIZE);
+
+/* A work queue running the handshakes of non-blocking sockets. */
+static struct k_work_q tls_handshake_q;
+
+/* A mutex for protecting the handshake work resubmission against close. */
+static struct k_mutex handshake_lock;
+
+/* Retry period of a handshake which could not send all its data. */
+#define TLS_HANDSHAKE_WRITE_RETRY_MS 10
+#endif /* CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE */
+
 bool net_socket_is_tls(void *obj)
 {
 	return PART_OF_ARRAY(tls_contexts, (struct tls_context *)obj);
@@ -281,6 +332,288 @@ static int dtls_timing_get_delay(void *data)
 }
 #endif /* CONFIG_NET_SOCKETS_ENABLE_DTLS */
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+/** Longest hostname of a cached client session. */
+#define TLS_SESSION_HOSTNAME_LEN 64
+
+/** TLS client session kept for resumption. */
+struct tls_session_cache {
+	/** Peer the session was established with. */
+	struct sockaddr peer_addr;
+
+	/** Hostname the peer was verified against. */
+	char hostname[TLS_SESSION_HOSTNAME_LEN];
+
+	/** Uptime when the session was stored. */
+	int64_t timestamp;
+
+	/** mbedTLS session. */
+	mbedtls_ssl_session session;
+
+	/** Information whether the entry holds a session. */
+	bool is_used;
+};
+
+/* Sessions of TLS clients, shared by all sockets. */
+static struct tls_session_cache
+	client_sessions[CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_SIZE];
+
+/* A mutex for protecting the session caches, mbedTLS does not lock them. */
+static struct k_mutex session_lock;
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+/* Session ID cache of TLS servers, shared by all sockets. */
+static mbedtls_ssl_cache_context server_cache;
+#endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+/* Session ticket keys of TLS servers, shared by all sockets. */
+static mbedtls_ssl_ticket_context server_ticket;
+static bool server_ticket_ready;
+#endif
+
+static const char *tls_session_hostname(struct tls_context *ctx)
+{
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+	if (ctx->ssl.hostname != NULL) {
+		return ctx->ssl.hostname;
+	}
+#endif
+
+	return "";
+}
+
+static bool tls_session_peer_match(const struct sockaddr *addr1,
+				   const struct sockaddr *addr2)
+{
+	if (addr1->sa_family != addr2->sa_family) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && addr1->sa_family == AF_INET6) {
+		return (net_sin6(addr1)->sin6_port ==
+			net_sin6(addr2)->sin6_port) &&
+			net_ipv6_addr_cmp(&net_sin6(addr1)->sin6_addr,
+					  &net_sin6(addr2)->sin6_addr);
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		   addr1->sa_family == AF_INET) {
+		return (net_sin(addr1)->sin_port ==
+			net_sin(addr2)->sin_port) &&
+			net_ipv4_addr_cmp(&net_sin(addr1)->sin_addr,
+					  &net_sin(addr2)->sin_addr);
+	}
+
+	return false;
+}
+
+/* Find the session of the peer, must be called with session_lock held. */
+static struct tls_session_cache *tls_session_find(struct tls_context *ctx)
+{
+	const char *hostname = tls_session_hostname(ctx);
+	struct tls_session_cache *entry;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(client_sessions); i++) {
+		entry = &client_sessions[i];
+
+		if (entry->is_used &&
+		    tls_session_peer_match(&entry->peer_addr,
+					   &ctx->session_peer_addr) &&
+		    strcmp(entry->hostname, hostname) == 0) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Offer the session of the last handshake with the same peer. */
+static void tls_session_restore(struct tls_context *ctx)
+{
+	struct tls_session_cache *entry;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	entry = tls_session_find(ctx);
+	if (entry == NULL) {
+		goto out;
+	}
+
+	if (k_uptime_get() - entry->timestamp >
+	    CONFIG_NET_SOCKETS_TLS_SESSION_LIFETIME * MSEC_PER_SEC) {
+		mbedtls_ssl_session_free(&entry->session);
+		entry->is_used = false;
+		goto out;
+	}
+
+	if (mbedtls_ssl_set_session(&ctx->ssl, &entry->session) != 0) {
+		NET_DBG("Failed to restore TLS session");
+	}
+
+out:
+	k_mutex_unlock(&session_lock);
+}
+
+/* Keep the session of a TLS client after a successful handshake. */
+static void tls_session_save(struct tls_context *ctx)
+{
+	const char *hostname = tls_session_hostname(ctx);
+	struct tls_session_cache *entry;
+	int i;
+
+	/* Only TLS clients know their peer address. */
+	if (ctx->session_peer_addr.sa_family == AF_UNSPEC ||
+	    strlen(hostname) >= TLS_SESSION_HOSTNAME_LEN) {
+		return;
+	}
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	entry = tls_session_find(ctx);
+	if (entry == NULL) {
+		/* Take a free entry, or the least recently stored one. */
+		entry = &client_sessions[0];
+
+		for (i = 0; i < ARRAY_SIZE(client_sessions); i++) {
+			if (!client_sessions[i].is_used) {
+				entry = &client_sessions[i];
+				break;
+			}
+
+			if (client_sessions[i].timestamp < entry->timestamp) {
+				entry = &client_sessions[i];
+			}
+		}
+	}
+
+	mbedtls_ssl_session_free(&entry->session);
+	entry->is_used = false;
+
+	if (mbedtls_ssl_get_session(&ctx->ssl, &entry->session) != 0) {
+		NET_DBG("Failed to save TLS session");
+		goto out;
+	}
+
+	memcpy(&entry->peer_addr, &ctx->session_peer_addr,
+	       sizeof(entry->peer_addr));
+	strcpy(entry->hostname, hostname);
+	entry->timestamp = k_uptime_get();
+	entry->is_used = true;
+
+out:
+	k_mutex_unlock(&session_lock);
+}
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+static int tls_session_cache_get(void *data, mbedtls_ssl_session *session)
+{
+	int ret;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+	ret = mbedtls_ssl_cache_get(data, session);
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+
+static int tls_session_cache_set(void *data,
+				 const mbedtls_ssl_session *session)
+{
+	int ret;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+	ret = mbedtls_ssl_cache_set(data, session);
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+#endif /* MBEDTLS_SSL_CACHE_C */
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+static int tls_session_ticket_write(void *p_ticket,
+				    const mbedtls_ssl_session *session,
+				    unsigned char *start,
+				    const unsigned char *end,
+				    size_t *tlen, uint32_t *lifetime)
+{
+	int ret;
+
+	/* Ticket keys are rotated on write. */
+	k_mutex_lock(&session_lock, K_FOREVER);
+	ret = mbedtls_ssl_ticket_write(p_ticket, session, start, end,
+				       tlen, lifetime);
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+
+static int tls_session_ticket_parse(void *p_ticket,
+				    mbedtls_ssl_session *session,
+				    unsigned char *buf, size_t len)
+{
+	int ret;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+	ret = mbedtls_ssl_ticket_parse(p_ticket, session, buf, len);
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+#endif /* MBEDTLS_SSL_TICKET_C */
+
+static void tls_session_cache_init(void)
+{
+	k_mutex_init(&session_lock);
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+	mbedtls_ssl_cache_init(&server_cache);
+	mbedtls_ssl_cache_set_max_entries(&server_cache,
+				CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_SIZE);
+#if defined(MBEDTLS_HAVE_TIME)
+	mbedtls_ssl_cache_set_timeout(&server_cache,
+				CONFIG_NET_SOCKETS_TLS_SESSION_LIFETIME);
+#endif
+#endif /* MBEDTLS_SSL_CACHE_C */
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	mbedtls_ssl_ticket_init(&server_ticket);
+
+	if (mbedtls_ssl_ticket_setup(&server_ticket, tls_ctr_drbg_random,
+				     NULL, MBEDTLS_CIPHER_AES_256_GCM,
+				     CONFIG_NET_SOCKETS_TLS_SESSION_LIFETIME) != 0) {
+		NET_ERR("Failed to set up TLS session tickets");
+	} else {
+		server_ticket_ready = true;
+	}
+#endif /* MBEDTLS_SSL_TICKET_C */
+}
+
+/* Let a TLS server resume the sessions of all its sockets. */
+static void tls_session_cache_conf(struct tls_context *ctx)
+{
+	ARG_UNUSED(ctx);
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+	mbedtls_ssl_conf_session_cache(&ctx->config, &server_cache,
+				       tls_session_cache_get,
+				       tls_session_cache_set);
+#endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	if (server_ticket_ready) {
+		mbedtls_ssl_conf_session_tickets_cb(&ctx->config,
+						    tls_session_ticket_write,
+						    tls_session_ticket_parse,
+						    &server_ticket);
+	}
+#endif
+}
+#else
+static inline void tls_session_restore(struct tls_context *ctx) {}
+static inline void tls_session_save(struct tls_context *ctx) {}
+static inline void tls_session_cache_conf(struct tls_context *ctx) {}
+#endif /* CONFIG_NET_SOCKETS_TLS_SESSION_CACHE */
+
 /* Initialize TLS internals. */
 static int tls_init(const struct device *unused)
 {
@@ -299,6 +632,21 @@ static int tls_init(const struct device *unused)
 	mbedtls_debug_set_threshold(CONFIG_MBEDTLS_DEBUG_LEVEL);
 #endif
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+	tls_session_cache_init();
+#endif
+
+#if defined(CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE)
+	k_mutex_init(&handshake_lock);
+
+	k_work_queue_start(&tls_handshake_q, tls_handshake_stack,
+			   K_KERNEL_STACK_SIZEOF(tls_handshake_stack),
+			   K_PRIO_PREEMPT(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_PRIORITY),
+			   NULL);
+
+	k_thread_name_set(&tls_handshake_q.thread, "tls_handshake");
+#endif
+
 	return 0;
 }
 
@@ -971,6 +1319,7 @@ static int tls_mbedtls_handshake(struct tls_context *context, bool block)
 
 	if (ret == 0) {
 		k_sem_give(&context->tls_established);
+		tls_session_save(context);
 	}
 
 	context->handshake_in_progress = false;
@@ -1071,6 +1420,10 @@ static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 			     tls_ctr_drbg_random,
 			     NULL);
 
+	if (is_server) {
+		tls_session_cache_conf(context);
+	}
+
 	ret = tls_mbedtls_set_credentials(context);
 	if (ret != 0) {
 		return ret;
@@ -1515,10 +1868,187 @@ free_fd:
 	return -1;
 }
 
+#if defined(CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE)
+static bool tls_is_nonblock(int sock)
+{
+	int sock_flags = zsock_fcntl(sock, F_GETFL, 0);
+
+	return sock_flags >= 0 && (sock_flags & O_NONBLOCK);
+}
+
+/* Handshakes of non-blocking sockets run in the work queue. */
+static inline bool tls_handshake_is_async(int sock)
+{
+	return tls_is_nonblock(sock);
+}
+
+/* Wait in the work queue until the underlying socket has data. Returns
+ * -EALREADY if the handshake can continue right away.
+ */
+static int tls_handshake_wait(struct tls_context *ctx, int remaining)
+{
+	struct zsock_pollfd pfd = {
+		.fd = ctx->sock,
+		.events = ZSOCK_POLLIN,
+	};
+	struct k_poll_event *pev = &ctx->handshake_event;
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	int ret;
+
+	/* Sockets do not signal when they become writable again, so retry
+	 * shortly if mbedTLS could not send the whole record.
+	 */
+	if (ctx->ssl.out_left > 0) {
+		remaining = MIN(remaining, TLS_HANDSHAKE_WRITE_RETRY_MS);
+	}
+
+	obj = z_get_fd_obj_and_vtable(
+		ctx->sock, (const struct fd_op_vtable **)&vtable, &lock);
+	if (obj == NULL) {
+		return -EBADF;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	ret = z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_PREPARE,
+				   &pfd, &pev, pev + 1);
+	k_mutex_unlock(lock);
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	k_mutex_lock(&handshake_lock, K_FOREVER);
+
+	if (ctx->handshake_cancel) {
+		ret = -ECANCELED;
+	} else {
+		ret = k_work_poll_submit_to_queue(&tls_handshake_q,
+						  &ctx->handshake_work,
+						  &ctx->handshake_event, 1,
+						  K_MSEC(remaining));
+	}
+
+	k_mutex_unlock(&handshake_lock);
+
+	return ret;
+}
+
+static void tls_handshake_work_handler(struct k_work *work)
+{
+	struct k_work_poll *pwork = CONTAINER_OF(work, struct k_work_poll,
+						 work);
+	struct tls_context *ctx = CONTAINER_OF(pwork, struct tls_context,
+					       handshake_work);
+	int remaining;
+	int ret;
+
+	do {
+		remaining = time_left(ctx->handshake_start,
+				      CONFIG_NET_SOCKETS_TLS_HANDSHAKE_TIMEOUT);
+		if (remaining <= 0) {
+			NET_ERR("TLS handshake timeout");
+			ret = -ETIMEDOUT;
+			break;
+		}
+
+		ctx->flags = ZSOCK_MSG_DONTWAIT;
+
+		ret = tls_mbedtls_handshake(ctx, false);
+		if (ret != -EAGAIN) {
+			break;
+		}
+
+		ret = tls_handshake_wait(ctx, remaining);
+		if (ret == 0) {
+			/* The work is run again once there is data. */
+			return;
+		}
+	} while (ret == -EALREADY);
+
+	ctx->flags = 0;
+	ctx->handshake_error = ret;
+	atomic_set(&ctx->handshake_pending, 0);
+
+	k_poll_signal_raise(&ctx->handshake_done, ret);
+}
+
+/* Run the handshake in the handshake work queue, the socket reports
+ * EAGAIN until it is finished.
+ */
+static void tls_handshake_start(struct tls_context *ctx)
+{
+	k_work_poll_init(&ctx->handshake_work, tls_handshake_work_handler);
+	k_poll_signal_init(&ctx->handshake_done);
+
+	ctx->handshake_start = k_uptime_get_32();
+	ctx->handshake_error = 0;
+	ctx->handshake_cancel = false;
+	atomic_set(&ctx->handshake_pending, 1);
+
+	(void)k_work_submit_to_queue(&tls_handshake_q,
+				     &ctx->handshake_work.work);
+}
+
+/* Check the handshake before the socket is used for data. Blocking calls
+ * wait for a running handshake to finish.
+ */
+static int tls_handshake_check(struct tls_context *ctx, int flags)
+{
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+		&ctx->handshake_done);
+
+	if (atomic_get(&ctx->handshake_pending)) {
+		if ((flags & ZSOCK_MSG_DONTWAIT) || tls_is_nonblock(ctx->sock)) {
+			return -EAGAIN;
+		}
+
+		(void)k_poll(&event, 1, K_FOREVER);
+	}
+
+	return ctx->handshake_error;
+}
+
+/* Stop the handshake work before the context is released. */
+static void tls_handshake_cancel(struct tls_context *ctx)
+{
+	struct k_work_sync sync;
+
+	k_mutex_lock(&handshake_lock, K_FOREVER);
+	ctx->handshake_cancel = true;
+	k_mutex_unlock(&handshake_lock);
+
+	if (k_work_poll_cancel(&ctx->handshake_work) != 0) {
+		/* Queued or running, the work does not resubmit itself
+		 * anymore.
+		 */
+		(void)k_work_cancel_sync(&ctx->handshake_work.work, &sync);
+	}
+}
+#else
+static inline bool tls_handshake_is_async(int sock)
+{
+	return false;
+}
+
+static inline void tls_handshake_start(struct tls_context *ctx) {}
+
+static inline int tls_handshake_check(struct tls_context *ctx, int flags)
+{
+	return 0;
+}
+
+static inline void tls_handshake_cancel(struct tls_context *ctx) {}
+#endif /* CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE */
+
 int ztls_close_ctx(struct tls_context *ctx)
 {
 	int ret, err = 0;
 
+	tls_handshake_cancel(ctx);
+
 	/* Try to send close notification. */
 	ctx->flags = 0;
 
@@ -1550,17 +2080,31 @@ int ztls_connect_ctx(struct tls_context *ctx, const struct sockaddr *addr,
 	}
 
 	if (ctx->type == SOCK_STREAM) {
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+		memcpy(&ctx->session_peer_addr, addr,
+		       MIN(addrlen, sizeof(ctx->session_peer_addr)));
+#endif
+
 		/* Do the handshake for TLS, not DTLS. */
 		ret = tls_mbedtls_init(ctx, false);
 		if (ret < 0) {
 			goto error;
 		}
 
+		tls_session_restore(ctx);
+
 		/* Do not use any socket flags during the handshake. */
 		ctx->flags = 0;
 
-		/* TODO For simplicity, TLS handshake blocks the socket
-		 * even for non-blocking socket.
+		if (tls_handshake_is_async(ctx->sock)) {
+			tls_handshake_start(ctx);
+			ret = -EINPROGRESS;
+			goto error;
+		}
+
+		/* Unless CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE is enabled,
+		 * TLS handshake blocks the socket even for non-blocking
+		 * socket.
 		 */
 		ret = tls_mbedtls_handshake(ctx, true);
 		if (ret < 0) {
@@ -1619,8 +2163,13 @@ int ztls_accept_ctx(struct tls_context *parent, struct sockaddr *addr,
 	/* Do not use any socket flags during the handshake. */
 	child->flags = 0;
 
-	/* TODO For simplicity, TLS handshake blocks the socket even for
-	 * non-blocking socket.
+	if (tls_handshake_is_async(parent->sock)) {
+		tls_handshake_start(child);
+		return fd;
+	}
+
+	/* Unless CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE is enabled, TLS
+	 * handshake blocks the socket even for non-blocking socket.
 	 */
 	ret = tls_mbedtls_handshake(child, true);
 	if (ret < 0) {
@@ -1746,6 +2295,14 @@ ssize_t ztls_sendto_ctx(struct tls_context *ctx, const void *buf, size_t len,
 			int flags, const struct sockaddr *dest_addr,
 			socklen_t addrlen)
 {
+	int ret;
+
+	ret = tls_handshake_check(ctx, flags);
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
 	ctx->flags = flags;
 
 	/* TLS */
@@ -2043,6 +2600,8 @@ ssize_t ztls_recvfrom_ctx(struct tls_context *ctx, void *buf, size_t max_len,
 			  int flags, struct sockaddr *src_addr,
 			  socklen_t *addrlen)
 {
+	int ret;
+
 	if (flags & ZSOCK_MSG_PEEK) {
 		/* TODO mbedTLS does not support 'peeking' This could be
 		 * bypassed by having intermediate buffer for peeking
@@ -2051,6 +2610,12 @@ ssize_t ztls_recvfrom_ctx(struct tls_context *ctx, void *buf, size_t max_len,
 		return -1;
 	}
 
+	ret = tls_handshake_check(ctx, flags);
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
 	ctx->flags = flags;
 
 	/* TLS */
@@ -2088,6 +2653,97 @@ static int ztls_poll_prepare_pollin(struct tls_context *ctx)
 	return 0;
 }
 
+#if defined(CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE)
+/* Report the end of the non-blocking handshake. The handshake work polls
+ * the underlying socket in the meantime, so only the handshake signal is
+ * waited for.
+ */
+static int ztls_poll_prepare_handshake(struct tls_context *ctx,
+				       struct k_poll_event **pev,
+				       struct k_poll_event *pev_end)
+{
+	if (*pev == pev_end) {
+		return -ENOMEM;
+	}
+
+	(*pev)->obj = &ctx->handshake_done;
+	(*pev)->type = K_POLL_TYPE_SIGNAL;
+	(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
+	(*pev)->state = K_POLL_STATE_NOT_READY;
+	(*pev)++;
+
+	ctx->handshake_polled = true;
+
+	return 0;
+}
+
+static int ztls_poll_update_handshake(struct tls_context *ctx,
+				      struct zsock_pollfd *pfd,
+				      struct k_poll_event **pev)
+{
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	int ret;
+	short events = pfd->events;
+
+	ctx->handshake_polled = false;
+
+	if ((*pev)->state == K_POLL_STATE_NOT_READY) {
+		/* Handshake still running. */
+		(*pev)++;
+		return 0;
+	}
+
+	if (ctx->handshake_error < 0) {
+		pfd->revents |= ZSOCK_POLLERR | ZSOCK_POLLHUP;
+		(*pev)++;
+		return 0;
+	}
+
+	if (pfd->events & ZSOCK_POLLOUT) {
+		pfd->revents |= ZSOCK_POLLOUT;
+	}
+
+	if ((pfd->events & ZSOCK_POLLIN) &&
+	    mbedtls_ssl_get_bytes_avail(&ctx->ssl) > 0) {
+		pfd->revents |= ZSOCK_POLLIN;
+	}
+
+	if (pfd->revents != 0 || !(pfd->events & ZSOCK_POLLIN)) {
+		(*pev)++;
+		return 0;
+	}
+
+	/* Handshake is complete, reconfigure the k_poll_event to monitor
+	 * the underlying socket now.
+	 */
+	obj = z_get_fd_obj_and_vtable(
+		ctx->sock, (const struct fd_op_vtable **)&vtable, &lock);
+	if (obj == NULL) {
+		return -EBADF;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	pfd->events = ZSOCK_POLLIN;
+	ret = z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_PREPARE,
+				   pfd, pev, *pev + 1);
+	pfd->events = events;
+
+	k_mutex_unlock(lock);
+
+	if (ret != 0 && ret != -EALREADY) {
+		return ret;
+	}
+
+	/* Return -EAGAIN to signal to poll() that it should make another
+	 * iteration with the event reconfigured above.
+	 */
+	return -EAGAIN;
+}
+#endif /* CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE */
+
 static int ztls_poll_prepare_ctx(struct tls_context *ctx,
 				 struct zsock_pollfd *pfd,
 				 struct k_poll_event **pev,
@@ -2099,6 +2755,17 @@ static int ztls_poll_prepare_ctx(struct tls_context *ctx,
 	int ret;
 	short events = pfd->events;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE)
+	/* A failed handshake raised the signal already, so it is reported
+	 * right away.
+	 */
+	if ((pfd->events & (ZSOCK_POLLIN | ZSOCK_POLLOUT)) &&
+	    (atomic_get(&ctx->handshake_pending) ||
+	     ctx->handshake_error < 0)) {
+		return ztls_poll_prepare_handshake(ctx, pev, pev_end);
+	}
+#endif
+
 	/* DTLS client should wait for the handshake to complete before
 	 * it actually starts to poll for data.
 	 */
@@ -2243,6 +2910,12 @@ static int ztls_poll_update_ctx(struct tls_context *ctx,
 	int ret;
 	short events = pfd->events;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE)
+	if (ctx->handshake_polled) {
+		return ztls_poll_update_handshake(ctx, pfd, pev);
+	}
+#endif
+
 	obj = z_get_fd_obj_and_vtable(
 		ctx->sock, (const struct fd_op_vtable **)&vtable, &lock);
 	if (obj == NULL) {
@@ -2475,7 +3148,25 @@ int ztls_getsockopt_ctx(struct tls_context *ctx, int level, int optname,
 			return -1;
 		}
 		return err;
-	} else if (level != SOL_TLS) {
+	}
+
+#if defined(CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE)
+	if ((level == SOL_SOCKET) && (optname == SO_ERROR)) {
+		/* Report the result of a non-blocking handshake. */
+		if (*optlen < sizeof(int)) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		*(int *)optval = atomic_get(&ctx->handshake_pending) ?
+				 0 : -ctx->handshake_error;
+		*optlen = sizeof(int);
+
+		return 0;
+	}
+#endif
+
+	if (level != SOL_TLS) {
 		return zsock_getsockopt(ctx->sock, level, optname,
 					optval, optlen);
 	}
@@ -33,11 +33,44 @@ extern "C" {
 #define NVS_NAMECNT_ID 0x8000
 #define NVS_NAME_ID_OFFSET 0x4000
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+/* With the name index a hash of each setting's name and a hash of the first
+ * component of the name are kept for every name ID, so that saving a setting
+ * or loading a subtree only has to read the names that can match. An unused
+ * name ID has a zero name hash.
+ *
+ * The index is stored in blocks of NVS_NAME_INDEX_CHUNK entries, block n
+ * covering name IDs NVS_NAMECNT_ID + 1 + n * NVS_NAME_INDEX_CHUNK onwards is
+ * stored at NVS_NAME_INDEX_ID + n. A block is written before a new name is
+ * and after a name is deleted, so an index entry may point to a missing name
+ * but never the other way round. Missing blocks are rebuilt from the names
+ * when the backend is initialized.
+ *
+ * The largest name ID in use is stored at NVS_NAME_INDEX_CNT_ID as well,
+ * whenever it is stored at NVS_NAMECNT_ID. An image built without the index
+ * only updates the latter, so if the two differ, or a name ID unused in the
+ * index holds a name, the index is rebuilt.
+ */
+#define NVS_NAME_INDEX_CNT_ID 0x7DFF
+#define NVS_NAME_INDEX_ID 0x7E00
+#define NVS_NAME_INDEX_CHUNK 32
+#define NVS_NAME_INDEX_SIZE ROUND_UP(CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE, \
+				     NVS_NAME_INDEX_CHUNK)
+
+struct settings_nvs_index_entry {
+	uint16_t name_hash;
+	uint16_t root_hash;
+};
+#endif
+
 struct settings_nvs {
 	struct settings_store cf_store;
 	struct nvs_fs cf_nvs;
 	uint16_t last_name_id;
 	const char *flash_dev_name;
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	struct settings_nvs_index_entry name_index[NVS_NAME_INDEX_SIZE];
+#endif
 };
 
 /* register nvs to be a source of settings */
@@ -12,6 +12,7 @@
 #include "settings/settings_nvs.h"
 #include "settings_priv.h"
 #include <storage/flash_map.h>
+#include <sys/crc.h>
 
 #include <logging/log.h>
 LOG_MODULE_DECLARE(settings, CONFIG_SETTINGS_LOG_LEVEL);
@@ -48,6 +49,185 @@ static ssize_t settings_nvs_read_fn(void *back_end, void *data, size_t len)
 	return rc;
 }
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+static uint16_t settings_nvs_hash(const char *name, size_t len)
+{
+	uint16_t hash = crc16_ccitt(0xffff, (const uint8_t *)name, len);
+
+	/* zero marks an unused name ID */
+	return hash ? hash : 1;
+}
+
+static void settings_nvs_index_set(struct settings_nvs_index_entry *entry,
+				   const char *name)
+{
+	entry->name_hash = settings_nvs_hash(name, strlen(name));
+	entry->root_hash = settings_nvs_hash(name,
+					     settings_name_next(name, NULL));
+}
+
+static struct settings_nvs_index_entry *
+settings_nvs_index_get(struct settings_nvs *cf, uint16_t name_id)
+{
+	uint16_t idx = name_id - NVS_NAMECNT_ID - 1;
+
+	if (idx >= NVS_NAME_INDEX_SIZE) {
+		return NULL;
+	}
+
+	return &cf->name_index[idx];
+}
+
+/* write the index block holding the entry of name_id */
+static int settings_nvs_index_store(struct settings_nvs *cf, uint16_t name_id)
+{
+	uint16_t chunk;
+	ssize_t rc;
+
+	chunk = (name_id - NVS_NAMECNT_ID - 1) / NVS_NAME_INDEX_CHUNK;
+	rc = nvs_write(&cf->cf_nvs, NVS_NAME_INDEX_ID + chunk,
+		       &cf->name_index[chunk * NVS_NAME_INDEX_CHUNK],
+		       NVS_NAME_INDEX_CHUNK *
+		       sizeof(struct settings_nvs_index_entry));
+
+	return (rc < 0) ? rc : 0;
+}
+
+static int settings_nvs_index_clear(struct settings_nvs *cf, uint16_t name_id)
+{
+	struct settings_nvs_index_entry *entry;
+
+	entry = settings_nvs_index_get(cf, name_id);
+	if (!entry || entry->name_hash == 0U) {
+		return 0;
+	}
+
+	entry->name_hash = 0U;
+	entry->root_hash = 0U;
+
+	return settings_nvs_index_store(cf, name_id);
+}
+
+/* check that the name IDs unused in an index block hold no name, one may
+ * have been written by an image built without the index
+ */
+static bool settings_nvs_index_valid(struct settings_nvs *cf, uint16_t chunk)
+{
+	struct settings_nvs_index_entry *entries;
+	uint16_t name_id;
+	char buf;
+
+	entries = &cf->name_index[chunk * NVS_NAME_INDEX_CHUNK];
+
+	for (int i = 0; i < NVS_NAME_INDEX_CHUNK; i++) {
+		name_id = NVS_NAMECNT_ID + 1 + chunk * NVS_NAME_INDEX_CHUNK + i;
+		if (name_id > cf->last_name_id) {
+			break;
+		}
+
+		if (entries[i].name_hash == 0U &&
+		    nvs_read(&cf->cf_nvs, name_id, &buf, sizeof(buf)) > 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* read the index blocks covering the name IDs in use, blocks that are
+ * missing or out of date are rebuilt from the stored names.
+ */
+static int settings_nvs_index_load(struct settings_nvs *cf)
+{
+	const size_t chunk_size = NVS_NAME_INDEX_CHUNK *
+				  sizeof(struct settings_nvs_index_entry);
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	struct settings_nvs_index_entry *entries;
+	uint16_t chunk, name_id, used, index_last_name_id;
+	bool rebuild;
+	ssize_t rc;
+
+	(void)memset(cf->name_index, 0, sizeof(cf->name_index));
+	used = MIN(cf->last_name_id - NVS_NAMECNT_ID, NVS_NAME_INDEX_SIZE);
+
+	/* An index stored along with another largest name ID, or none at
+	 * all, doesn't know about every name
+	 */
+	rc = nvs_read(&cf->cf_nvs, NVS_NAME_INDEX_CNT_ID, &index_last_name_id,
+		      sizeof(index_last_name_id));
+	rebuild = (rc != sizeof(index_last_name_id)) ||
+		  (index_last_name_id != cf->last_name_id);
+
+	for (chunk = 0; chunk * NVS_NAME_INDEX_CHUNK < used; chunk++) {
+		entries = &cf->name_index[chunk * NVS_NAME_INDEX_CHUNK];
+
+		if (!rebuild) {
+			rc = nvs_read(&cf->cf_nvs, NVS_NAME_INDEX_ID + chunk,
+				      entries, chunk_size);
+			if (rc == (ssize_t)chunk_size &&
+			    settings_nvs_index_valid(cf, chunk)) {
+				continue;
+			}
+		}
+
+		LOG_DBG("Rebuilding name index block %u", chunk);
+		(void)memset(entries, 0, chunk_size);
+
+		for (int i = 0; i < NVS_NAME_INDEX_CHUNK; i++) {
+			name_id = NVS_NAMECNT_ID + 1 +
+				  chunk * NVS_NAME_INDEX_CHUNK + i;
+			if (name_id > cf->last_name_id) {
+				break;
+			}
+
+			rc = nvs_read(&cf->cf_nvs, name_id, &name,
+				      sizeof(name) - 1);
+			if (rc <= 0) {
+				continue;
+			}
+
+			name[MIN((size_t)rc, sizeof(name) - 1)] = '\0';
+			settings_nvs_index_set(&entries[i], name);
+		}
+
+		rc = settings_nvs_index_store(cf, NVS_NAMECNT_ID + 1 +
+					      chunk * NVS_NAME_INDEX_CHUNK);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	if (rebuild) {
+		rc = nvs_write(&cf->cf_nvs, NVS_NAME_INDEX_CNT_ID,
+			       &cf->last_name_id, sizeof(cf->last_name_id));
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SETTINGS_NVS_NAME_INDEX */
+
+/* store the largest name ID in use, with the name index it is recorded
+ * there too
+ */
+static int settings_nvs_last_name_id_store(struct settings_nvs *cf)
+{
+	ssize_t rc;
+
+	rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID, &cf->last_name_id,
+		       sizeof(uint16_t));
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	if (rc >= 0) {
+		rc = nvs_write(&cf->cf_nvs, NVS_NAME_INDEX_CNT_ID,
+			       &cf->last_name_id, sizeof(uint16_t));
+	}
+#endif
+
+	return (rc < 0) ? rc : 0;
+}
+
 int settings_nvs_src(struct settings_nvs *cf)
 {
 	cf->cf_store.cs_itf = &settings_nvs_itf;
@@ -74,6 +254,16 @@ static int settings_nvs_load(struct settings_store *cs,
 	char buf;
 	ssize_t rc1, rc2;
 	uint16_t name_id = NVS_NAMECNT_ID;
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	struct settings_nvs_index_entry *entry;
+	uint16_t root_hash = 0U;
+	int root_len;
+
+	root_len = settings_name_next(arg ? arg->subtree : NULL, NULL);
+	if (root_len > 0) {
+		root_hash = settings_nvs_hash(arg->subtree, root_len);
+	}
+#endif
 
 	name_id = cf->last_name_id + 1;
 
@@ -84,6 +274,15 @@ static int settings_nvs_load(struct settings_store *cs,
 			break;
 		}
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+		/* Skip unused name IDs and names outside of the subtree */
+		entry = settings_nvs_index_get(cf, name_id);
+		if (entry && ((entry->name_hash == 0U) ||
+			      (root_hash && entry->root_hash != root_hash))) {
+			continue;
+		}
+#endif
+
 		/* In the NVS backend, each setting item is stored in two NVS
 		 * entries one for the setting's name and one with the
 		 * setting's value.
@@ -93,6 +292,10 @@ static int settings_nvs_load(struct settings_store *cs,
 			       &buf, sizeof(buf));
 
 		if ((rc1 <= 0) && (rc2 <= 0)) {
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+			/* Index entry left behind by an interrupted save */
+			(void)settings_nvs_index_clear(cf, name_id);
+#endif
 			continue;
 		}
 
@@ -104,11 +307,13 @@ static int settings_nvs_load(struct settings_store *cs,
 			 */
 			if (name_id == cf->last_name_id) {
 				cf->last_name_id--;
-				nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
-					  &cf->last_name_id, sizeof(uint16_t));
+				(void)settings_nvs_last_name_id_store(cf);
 			}
 			nvs_delete(&cf->cf_nvs, name_id);
 			nvs_delete(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET);
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+			(void)settings_nvs_index_clear(cf, name_id);
+#endif
 			continue;
 		}
 
@@ -136,11 +341,18 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 	uint16_t name_id, write_name_id;
 	bool delete, write_name;
 	int rc = 0;
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	struct settings_nvs_index_entry *entry, name_entry;
+#endif
 
 	if (!name) {
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	settings_nvs_index_set(&name_entry, name);
+#endif
+
 	/* Find out if we are doing a delete */
 	delete = ((value == NULL) || (val_len == 0));
 
@@ -154,6 +366,19 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 			break;
 		}
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+		/* Only read the names whose hash matches */
+		entry = settings_nvs_index_get(cf, name_id);
+		if (entry && entry->name_hash == 0U) {
+			write_name_id = name_id;
+			continue;
+		}
+
+		if (entry && entry->name_hash != name_entry.name_hash) {
+			continue;
+		}
+#endif
+
 		rc = nvs_read(&cf->cf_nvs, name_id, &rdname, sizeof(rdname));
 
 		if (rc < 0) {
@@ -172,8 +397,7 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 
 		if ((delete) && (name_id == cf->last_name_id)) {
 			cf->last_name_id--;
-			rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
-				       &cf->last_name_id, sizeof(uint16_t));
+			rc = settings_nvs_last_name_id_store(cf);
 			if (rc < 0) {
 				/* Error: can't to store
 				 * the largest name ID in use.
@@ -190,6 +414,12 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 					NVS_NAME_ID_OFFSET);
 			}
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+			if (rc >= 0) {
+				rc = settings_nvs_index_clear(cf, name_id);
+			}
+#endif
+
 			if (rc < 0) {
 				return rc;
 			}
@@ -210,6 +440,18 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 		return -ENOMEM;
 	}
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	/* the index has to know about a name before it is written */
+	entry = settings_nvs_index_get(cf, write_name_id);
+	if (write_name && entry) {
+		*entry = name_entry;
+		rc = settings_nvs_index_store(cf, write_name_id);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+#endif
+
 	/* write the value */
 	rc = nvs_write(&cf->cf_nvs, write_name_id + NVS_NAME_ID_OFFSET,
 		       value, val_len);
@@ -228,8 +470,7 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 	/* update the last_name_id and write to flash if required*/
 	if (write_name_id > cf->last_name_id) {
 		cf->last_name_id = write_name_id;
-		rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID, &cf->last_name_id,
-			       sizeof(uint16_t));
+		rc = settings_nvs_last_name_id_store(cf);
 	}
 
 	if (rc < 0) {
@@ -263,6 +504,13 @@ int settings_nvs_backend_init(struct settings_nvs *cf)
 		cf->last_name_id = last_name_id;
 	}
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	rc = settings_nvs_index_load(cf);
+	if (rc) {
+		return rc;
+	}
+#endif
+
 	LOG_DBG("Initialized");
 	return 0;
 }
@@ -309,12 +309,26 @@
 	sys_trace_k_msgq_put_blocking(msgq, data, timeout)
 #define sys_port_trace_k_msgq_put_exit(msgq, timeout, ret)                                         \
 	sys_trace_k_msgq_put_exit(msgq, data, timeout, ret)
+#define sys_port_trace_k_msgq_put_many_enter(msgq, timeout)                                        \
+	sys_trace_k_msgq_put_many_enter(msgq, data, num, timeout)
+#define sys_port_trace_k_msgq_put_many_blocking(msgq, timeout)                                     \
+	sys_trace_k_msgq_put_many_blocking(msgq, data, num, timeout)
+#define sys_port_trace_k_msgq_put_many_exit(msgq, timeout, ret)                                    \
+	sys_trace_k_msgq_put_many_exit(msgq, data, num, timeout, ret)
+#define sys_port_trace_k_msgq_reserve(msgq, ret) sys_trace_k_msgq_reserve(msgq, slot, ret)
+#define sys_port_trace_k_msgq_commit(msgq, ret) sys_trace_k_msgq_commit(msgq, send, ret)
 #define sys_port_trace_k_msgq_get_enter(msgq, timeout)                                             \
 	sys_trace_k_msgq_get_enter(msgq, data, timeout)
 #define sys_port_trace_k_msgq_get_blocking(msgq, timeout)                                          \
 	sys_trace_k_msgq_get_blocking(msgq, data, timeout)
 #define sys_port_trace_k_msgq_get_exit(msgq, timeout, ret)                                         \
 	sys_trace_k_msgq_get_exit(msgq, data, timeout, ret)
+#define sys_port_trace_k_msgq_get_many_enter(msgq, timeout)                                        \
+	sys_trace_k_msgq_get_many_enter(msgq, data, num, timeout)
+#define sys_port_trace_k_msgq_get_many_blocking(msgq, timeout)                                     \
+	sys_trace_k_msgq_get_many_blocking(msgq, data, num, timeout)
+#define sys_port_trace_k_msgq_get_many_exit(msgq, timeout, ret)                                    \
+	sys_trace_k_msgq_get_many_exit(msgq, data, num, timeout, ret)
 #define sys_port_trace_k_msgq_peek(msgq, ret) sys_trace_k_msgq_peek(msgq, data, ret)
 #define sys_port_trace_k_msgq_purge(msgq) sys_trace_k_msgq_purge(msgq)
 
@@ -650,6 +664,20 @@ void sys_trace_k_msgq_put_exit(struct k_msgq *msgq, const void *data, k_timeout_
 void sys_trace_k_msgq_get_enter(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 void sys_trace_k_msgq_get_blocking(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 void sys_trace_k_msgq_get_exit(struct k_msgq *msgq, const void *data, k_timeout_t timeout, int ret);
+void sys_trace_k_msgq_put_many_enter(struct k_msgq *msgq, const void *data, uint32_t num,
+				     k_timeout_t timeout);
+void sys_trace_k_msgq_put_many_blocking(struct k_msgq *msgq, const void *data, uint32_t num,
+					k_timeout_t timeout);
+void sys_trace_k_msgq_put_many_exit(struct k_msgq *msgq, const void *data, uint32_t num,
+				    k_timeout_t timeout, int ret);
+void sys_trace_k_msgq_get_many_enter(struct k_msgq *msgq, const void *data, uint32_t num,
+				     k_timeout_t timeout);
+void sys_trace_k_msgq_get_many_blocking(struct k_msgq *msgq, const void *data, uint32_t num,
+					k_timeout_t timeout);
+void sys_trace_k_msgq_get_many_exit(struct k_msgq *msgq, const void *data, uint32_t num,
+				    k_timeout_t timeout, int ret);
+void sys_trace_k_msgq_reserve(struct k_msgq *msgq, void **slot, int ret);
+void sys_trace_k_msgq_commit(struct k_msgq *msgq, bool send, int ret);
 void sys_trace_k_msgq_peek(struct k_msgq *msgq, void *data, int ret);
 void sys_trace_k_msgq_purge(struct k_msgq *msgq);
 
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/crc.h>
+#include <timing/timing.h>
+
+/* CRC-32 throughput benchmark.  Runs crc32_ieee() and crc32_c() over
+ * buffers of increasing size and reports the average cost of a call.
+ * The buffer starts one byte past a word boundary so the alignment
+ * prologue of the word based implementations is part of the figure.
+ */
+
+#define N_RUNS 32
+#define MAX_SIZE 4096
+
+static const size_t sizes[] = { 16, 64, 256, 1024, 4096 };
+
+static uint8_t __aligned(8) buf[MAX_SIZE + 1];
+
+static volatile uint32_t sink;
+
+static uint32_t run_ieee(const uint8_t *data, size_t len)
+{
+	return crc32_ieee(data, len);
+}
+
+static uint32_t run_c(const uint8_t *data, size_t len)
+{
+	return crc32_c(0, data, len, true, true);
+}
+
+static void run(const char *name, uint32_t (*fn)(const uint8_t *, size_t),
+		size_t size)
+{
+	timing_t start, end;
+	uint64_t cycles;
+	uint32_t avg;
+
+	start = timing_counter_get();
+	for (int run = 0; run < N_RUNS; run++) {
+		sink = fn(buf + 1, size);
+	}
+	end = timing_counter_get();
+
+	cycles = timing_cycles_get(&start, &end);
+	avg = (uint32_t)(cycles / N_RUNS);
+
+	printk("%s size %5u %8u cycles %5u bytes/kcycle\n", name,
+	       (uint32_t)size, avg,
+	       (uint32_t)(1000ULL * size / MAX(avg, 1U)));
+}
+
+static const char *implementation(void)
+{
+	if (IS_ENABLED(CONFIG_CRC32_ARCH)) {
+		return "cpu instructions";
+	} else if (IS_ENABLED(CONFIG_CRC32_SLICE_BY_8)) {
+		return "slice-by-8";
+	} else if (IS_ENABLED(CONFIG_CRC32_SLICE_BY_4)) {
+		return "slice-by-4";
+	}
+
+	return "nibble";
+}
+
+void main(void)
+{
+	uint32_t state = 1U;
+
+	for (int i = 0; i < sizeof(buf); i++) {
+		/* xorshift32 */
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		buf[i] = (uint8_t)state;
+	}
+
+	timing_init();
+	timing_start();
+
+	printk("crc32 implementation: %s\n", implementation());
+
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		run("crc32_ieee", run_ieee, sizes[i]);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		run("crc32_c   ", run_c, sizes[i]);
+	}
+
+	timing_stop();
+	printk("fin\n");
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/ring_buffer.h>
+#include <sys/spsc_ring.h>
+#include <sys/mpmc_ring.h>
+
+/* Ring throughput between CPUs.  A producer pinned to CPU 0 and a
+ * consumer pinned to CPU 1 move NUM_ELEMS elements through a ring, the
+ * main thread measures from starting them to joining both.  The baseline
+ * is a ring_buf protected by a spinlock, as drivers share one between an
+ * ISR and a thread today.  The consumer checks the sequence numbers, so
+ * lost or reordered elements are reported.
+ */
+
+#define NUM_ELEMS 100000
+#define RING_LEN 64
+#define STACK_SIZE 1024
+
+struct elem {
+	uint32_t seq;
+	uint32_t payload;
+};
+
+enum mode {
+	MODE_RING_BUF,
+	MODE_SPSC,
+	MODE_SPSC_WAIT,
+	MODE_MPMC,
+};
+
+/* With a single CPU both threads share it, so a side finding the ring
+ * full or empty has to let the other one run
+ */
+#if CONFIG_MP_NUM_CPUS > 1
+#define PRODUCER_CPU 0
+#define CONSUMER_CPU 1
+#define retry() do { } while (false)
+#else
+#define PRODUCER_CPU 0
+#define CONSUMER_CPU 0
+#define retry() k_yield()
+#endif
+
+RING_BUF_DECLARE(ring_buf, sizeof(struct elem) * RING_LEN);
+static struct k_spinlock ring_buf_lock;
+SYS_SPSC_RING_DEFINE(spsc, sizeof(struct elem), RING_LEN);
+SYS_MPMC_RING_DEFINE(mpmc, sizeof(struct elem), RING_LEN);
+
+static uint32_t errors;
+
+static struct k_thread producer_thread;
+static struct k_thread consumer_thread;
+static K_THREAD_STACK_DEFINE(producer_stack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(consumer_stack, STACK_SIZE);
+
+static int ring_buf_locked_put(struct elem *e)
+{
+	k_spinlock_key_t key = k_spin_lock(&ring_buf_lock);
+	uint32_t n = ring_buf_put(&ring_buf, (uint8_t *)e, sizeof(*e));
+
+	k_spin_unlock(&ring_buf_lock, key);
+
+	return n == sizeof(*e) ? 0 : -EAGAIN;
+}
+
+static int ring_buf_locked_get(struct elem *e)
+{
+	k_spinlock_key_t key = k_spin_lock(&ring_buf_lock);
+	uint32_t n = 0U;
+
+	/* Only whole elements are put, so checking the size first keeps
+	 * a get from consuming half of one
+	 */
+	if (ring_buf_size_get(&ring_buf) >= sizeof(*e)) {
+		n = ring_buf_get(&ring_buf, (uint8_t *)e, sizeof(*e));
+	}
+	k_spin_unlock(&ring_buf_lock, key);
+
+	return n == sizeof(*e) ? 0 : -EAGAIN;
+}
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	enum mode mode = POINTER_TO_INT(p1);
+	struct elem e = { .payload = 0xa5a5a5a5 };
+	uint32_t seq;
+	int ret;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (seq = 0U; seq < NUM_ELEMS; seq++) {
+		e.seq = seq;
+
+		for (;;) {
+			switch (mode) {
+			case MODE_RING_BUF:
+				ret = ring_buf_locked_put(&e);
+				break;
+			case MODE_SPSC:
+			case MODE_SPSC_WAIT:
+				ret = sys_spsc_ring_put(&spsc, &e);
+				break;
+			default:
+				ret = sys_mpmc_ring_put(&mpmc, &e);
+				break;
+			}
+
+			if (ret == 0) {
+				break;
+			}
+
+			retry();
+		}
+	}
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	enum mode mode = POINTER_TO_INT(p1);
+	struct elem e;
+	uint32_t seq;
+	int ret;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (seq = 0U; seq < NUM_ELEMS; seq++) {
+		for (;;) {
+			switch (mode) {
+			case MODE_RING_BUF:
+				ret = ring_buf_locked_get(&e);
+				break;
+			case MODE_SPSC:
+				ret = sys_spsc_ring_get(&spsc, &e);
+				break;
+			case MODE_SPSC_WAIT:
+				ret = sys_spsc_ring_get_wait(&spsc, &e,
+							     K_FOREVER);
+				break;
+			default:
+				ret = sys_mpmc_ring_get(&mpmc, &e);
+				break;
+			}
+
+			if (ret == 0) {
+				break;
+			}
+
+			retry();
+		}
+
+		if (e.seq != seq) {
+			errors++;
+		}
+	}
+}
+
+static void start(struct k_thread *thread, k_thread_stack_t *stack,
+		  k_thread_entry_t entry, enum mode mode, int cpu)
+{
+	k_thread_create(thread, stack, STACK_SIZE, entry,
+			INT_TO_POINTER(mode), NULL, NULL, K_PRIO_PREEMPT(1),
+			0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+	k_thread_cpu_mask_clear(thread);
+	k_thread_cpu_mask_enable(thread, cpu);
+#else
+	ARG_UNUSED(cpu);
+#endif
+	k_thread_start(thread);
+}
+
+static void run(const char *name, enum mode mode)
+{
+	uint32_t cycles;
+
+	cycles = k_cycle_get_32();
+	start(&consumer_thread, consumer_stack, consumer, mode, CONSUMER_CPU);
+	start(&producer_thread, producer_stack, producer, mode, PRODUCER_CPU);
+	k_thread_join(&producer_thread, K_FOREVER);
+	k_thread_join(&consumer_thread, K_FOREVER);
+	cycles = k_cycle_get_32() - cycles;
+
+	printk("%-20s %5u cycles/elem\n", name, cycles / NUM_ELEMS);
+}
+
+void main(void)
+{
+	printk("Rings, %u byte elements, %u CPUs\n",
+	       (unsigned int)sizeof(struct elem), CONFIG_MP_NUM_CPUS);
+
+	run("ring_buf + spinlock", MODE_RING_BUF);
+	run("spsc", MODE_SPSC);
+	run("spsc get_wait", MODE_SPSC_WAIT);
+	run("mpmc", MODE_MPMC);
+
+	if (errors != 0U) {
+		printk("FAIL: %u elements out of order\n", errors);
+		return;
+	}
+
+	printk("fin\n");
+}
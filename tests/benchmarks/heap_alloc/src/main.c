@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/sys_heap.h>
+#include <timing/timing.h>
+
+/* Heap allocation microbenchmark.  The first part allocates a burst
+ * of equally sized blocks with k_malloc() and frees them again, the
+ * way network buffers and messages are used, and reports the average
+ * cost of each call.  The second part runs sys_heap_stress() on a
+ * private heap and reports the average cost of an operation.  Build
+ * with and without CONFIG_SYS_HEAP_SLAB to compare.
+ */
+
+#define BURST 32
+#define N_RUNS 50
+#define STRESS_OPS 20000
+#define STRESS_HEAP_SZ 8192
+
+static const size_t sizes[] = { 16, 32, 64, 128 };
+
+static void *blocks[BURST];
+
+static char __aligned(8) stress_mem[STRESS_HEAP_SZ];
+static char __aligned(8) stress_scratch[STRESS_HEAP_SZ / 2];
+static struct sys_heap stress_heap;
+
+static uint32_t rand_state = 1;
+
+static uint32_t next_rand(void)
+{
+	/* xorshift32 */
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+	return rand_state;
+}
+
+static void run_malloc(size_t size)
+{
+	uint64_t malloc_cycles = 0U, free_cycles = 0U;
+	timing_t start, end;
+
+	for (int run = 0; run < N_RUNS; run++) {
+		for (int i = 0; i < BURST; i++) {
+			start = timing_counter_get();
+			blocks[i] = k_malloc(size);
+			end = timing_counter_get();
+			malloc_cycles += timing_cycles_get(&start, &end);
+		}
+
+		for (int i = 0; i < BURST; i++) {
+			start = timing_counter_get();
+			k_free(blocks[i]);
+			end = timing_counter_get();
+			free_cycles += timing_cycles_get(&start, &end);
+		}
+	}
+
+	printk("size %5u malloc %6u free %6u cycles\n", (uint32_t)size,
+	       (uint32_t)(malloc_cycles / (N_RUNS * BURST)),
+	       (uint32_t)(free_cycles / (N_RUNS * BURST)));
+}
+
+/* sys_heap_stress() picks sizes with a power law, skew them further
+ * towards the small blocks the caches are meant for.  The caches are
+ * used the way k_heap uses them.
+ */
+static void *stress_alloc(void *arg, size_t bytes)
+{
+	void *p;
+
+	if ((next_rand() & 3U) != 0U) {
+		bytes = 8U + (next_rand() % 96U);
+	}
+
+#ifdef CONFIG_SYS_HEAP_SLAB
+	p = sys_heap_slab_alloc(arg, 0, bytes);
+	if (p != NULL) {
+		return p;
+	}
+#endif
+
+	p = sys_heap_alloc(arg, bytes);
+
+#ifdef CONFIG_SYS_HEAP_SLAB
+	if (p == NULL && sys_heap_slab_flush(arg)) {
+		p = sys_heap_alloc(arg, bytes);
+	}
+#endif
+
+	return p;
+}
+
+static void stress_free(void *arg, void *p)
+{
+#ifdef CONFIG_SYS_HEAP_SLAB
+	if (sys_heap_slab_free(arg, p)) {
+		return;
+	}
+#endif
+
+	sys_heap_free(arg, p);
+}
+
+static void run_stress(void)
+{
+	struct z_heap_stress_result result;
+	timing_t start, end;
+	uint64_t cycles;
+
+	sys_heap_init(&stress_heap, stress_mem, sizeof(stress_mem));
+
+	start = timing_counter_get();
+	sys_heap_stress(stress_alloc, stress_free, &stress_heap,
+			sizeof(stress_mem), STRESS_OPS,
+			stress_scratch, sizeof(stress_scratch), 50, &result);
+	end = timing_counter_get();
+	cycles = timing_cycles_get(&start, &end);
+
+	printk("stress %6u ops %6u cycles/op\n", STRESS_OPS,
+	       (uint32_t)(cycles / STRESS_OPS));
+}
+
+void main(void)
+{
+	timing_init();
+	timing_start();
+
+	printk("sys_heap size class caches: %s\n",
+	       IS_ENABLED(CONFIG_SYS_HEAP_SLAB) ? "enabled" : "disabled");
+
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		run_malloc(sizes[i]);
+	}
+
+	run_stress();
+
+	timing_stop();
+	printk("fin\n");
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* Memory slab allocation under SMP load.  Every worker thread is pinned
+ * to its own CPU and allocates BURST blocks, then frees them again, for
+ * NUM_ROUNDS rounds.  The main thread measures from starting the workers
+ * to joining them.  Every worker writes its id into its blocks and checks
+ * it before freeing them, so a block handed out twice is reported.
+ */
+
+#define NUM_ROUNDS 10000
+#define BURST 8
+#define BLOCK_SIZE 64
+#define STACK_SIZE 1024
+#define NUM_WORKERS CONFIG_MP_NUM_CPUS
+
+K_MEM_SLAB_DEFINE_STATIC(slab, BLOCK_SIZE, BURST * NUM_WORKERS, 4);
+
+static uint32_t errors;
+
+static struct k_thread worker_threads[NUM_WORKERS];
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_WORKERS, STACK_SIZE);
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	uintptr_t id = POINTER_TO_UINT(p1);
+	uintptr_t *blocks[BURST];
+	int round, i;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (round = 0; round < NUM_ROUNDS; round++) {
+		for (i = 0; i < BURST; i++) {
+			k_mem_slab_alloc(&slab, (void **)&blocks[i], K_FOREVER);
+			*blocks[i] = id;
+		}
+
+		for (i = 0; i < BURST; i++) {
+			if (*blocks[i] != id) {
+				errors++;
+			}
+			k_mem_slab_free(&slab, (void **)&blocks[i]);
+		}
+	}
+}
+
+static void run(int num_workers)
+{
+	char name[16];
+	uint32_t cycles;
+	int i;
+
+	cycles = k_cycle_get_32();
+
+	for (i = 0; i < num_workers; i++) {
+		k_thread_create(&worker_threads[i], worker_stacks[i],
+				STACK_SIZE, worker, UINT_TO_POINTER(i), NULL,
+				NULL, K_PRIO_PREEMPT(1), 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+		k_thread_cpu_mask_clear(&worker_threads[i]);
+		k_thread_cpu_mask_enable(&worker_threads[i], i);
+#endif
+		k_thread_start(&worker_threads[i]);
+	}
+
+	for (i = 0; i < num_workers; i++) {
+		k_thread_join(&worker_threads[i], K_FOREVER);
+	}
+
+	cycles = k_cycle_get_32() - cycles;
+
+	if (k_mem_slab_num_used_get(&slab) != 0U) {
+		errors++;
+	}
+
+	snprintk(name, sizeof(name), "%d threads", num_workers);
+	printk("%-17s %5u cycles/alloc+free\n", name,
+	       cycles / (NUM_ROUNDS * BURST));
+}
+
+void main(void)
+{
+	printk("Memory slab, %d CPUs, magazines: %c\n", NUM_WORKERS,
+	       IS_ENABLED(CONFIG_MEM_SLAB_MAGAZINE) ? 'y' : 'n');
+
+	run(1);
+	run(NUM_WORKERS);
+
+	if (errors != 0U) {
+		printk("FAIL: %u blocks corrupted or leaked\n", errors);
+		return;
+	}
+
+	printk("fin\n");
+}
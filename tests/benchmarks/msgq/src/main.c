@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <app_memory/app_memdomain.h>
+
+/* Message queue throughput.  A producer and a consumer thread of the
+ * same priority move NUM_MSGS messages through a queue, the main thread
+ * measures from starting them to joining both.  The consumer checks the
+ * sequence numbers, so lost or reordered messages are reported.
+ */
+
+#define NUM_MSGS 20000
+#define QUEUE_LEN 64
+#define BATCH 16
+#define STACK_SIZE 2048
+
+#ifdef CONFIG_USERSPACE
+K_APPMEM_PARTITION_DEFINE(bench_part);
+#define BENCH_DATA K_APP_DMEM(bench_part)
+#define THREAD_OPTIONS K_USER
+#else
+#define BENCH_DATA
+#define THREAD_OPTIONS 0
+#endif
+
+struct msg {
+	uint32_t seq;
+	uint32_t payload[3];
+};
+
+enum mode {
+	MODE_SINGLE,
+	MODE_BATCH,
+	MODE_RESERVE,
+};
+
+/* The buffer is accessible to the threads so k_msgq_reserve() works in
+ * user mode
+ */
+static BENCH_DATA char __aligned(4) buffer[sizeof(struct msg) * QUEUE_LEN];
+static BENCH_DATA uint32_t errors;
+static struct k_msgq msgq;
+
+#ifdef CONFIG_USERSPACE
+static struct k_mem_domain domain;
+#endif
+static struct k_thread producer_thread;
+static struct k_thread consumer_thread;
+static K_THREAD_STACK_DEFINE(producer_stack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(consumer_stack, STACK_SIZE);
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	enum mode mode = POINTER_TO_INT(p1);
+	struct msg batch[BATCH];
+	struct msg *slot;
+	uint32_t seq = 0U;
+	int i, n, ret;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (seq < NUM_MSGS) {
+		switch (mode) {
+		case MODE_SINGLE:
+			batch[0].seq = seq++;
+			k_msgq_put(&msgq, &batch[0], K_FOREVER);
+			break;
+		case MODE_BATCH:
+			n = MIN(BATCH, NUM_MSGS - seq);
+			for (i = 0; i < n; i++) {
+				batch[i].seq = seq++;
+			}
+
+			for (i = 0; i < n; i += ret) {
+				ret = k_msgq_put_many(&msgq, &batch[i], n - i,
+						      K_FOREVER);
+			}
+			break;
+		case MODE_RESERVE:
+			if (k_msgq_reserve(&msgq, (void **)&slot) != 0) {
+				/* full, let the consumer run */
+				k_yield();
+				break;
+			}
+
+			slot->seq = seq++;
+			k_msgq_commit(&msgq, true);
+			break;
+		}
+	}
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	enum mode mode = POINTER_TO_INT(p1);
+	struct msg batch[BATCH];
+	uint32_t seq = 0U;
+	int i, n;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (seq < NUM_MSGS) {
+		if (mode == MODE_SINGLE) {
+			k_msgq_get(&msgq, &batch[0], K_FOREVER);
+			n = 1;
+		} else {
+			n = k_msgq_get_many(&msgq, batch, BATCH, K_FOREVER);
+		}
+
+		for (i = 0; i < n; i++) {
+			if (batch[i].seq != seq++) {
+				errors++;
+			}
+		}
+	}
+}
+
+static void start(struct k_thread *thread, k_thread_stack_t *stack,
+		  k_thread_entry_t entry, enum mode mode)
+{
+	k_thread_create(thread, stack, STACK_SIZE, entry,
+			INT_TO_POINTER(mode), NULL, NULL, K_PRIO_PREEMPT(1),
+			THREAD_OPTIONS, K_FOREVER);
+#ifdef CONFIG_USERSPACE
+	k_mem_domain_add_thread(&domain, thread);
+	k_thread_access_grant(thread, &msgq);
+#endif
+	k_thread_start(thread);
+}
+
+static void run(const char *name, enum mode mode)
+{
+	uint32_t cycles;
+
+	k_msgq_init(&msgq, buffer, sizeof(struct msg), QUEUE_LEN);
+
+	cycles = k_cycle_get_32();
+	start(&consumer_thread, consumer_stack, consumer, mode);
+	start(&producer_thread, producer_stack, producer, mode);
+	k_thread_join(&producer_thread, K_FOREVER);
+	k_thread_join(&consumer_thread, K_FOREVER);
+	cycles = k_cycle_get_32() - cycles;
+
+	printk("%-25s %5u cycles/msg\n", name, cycles / NUM_MSGS);
+}
+
+void main(void)
+{
+#ifdef CONFIG_USERSPACE
+	struct k_mem_partition *parts[] = { &bench_part };
+
+	k_mem_domain_init(&domain, ARRAY_SIZE(parts), parts);
+#endif
+
+	printk("Message queue, %u byte messages, user mode: %c\n",
+	       (unsigned int)sizeof(struct msg),
+	       IS_ENABLED(CONFIG_USERSPACE) ? 'y' : 'n');
+
+	run("put/get", MODE_SINGLE);
+	run("put_many/get_many", MODE_BATCH);
+	run("reserve/commit", MODE_RESERVE);
+
+	if (errors != 0U) {
+		printk("FAIL: %u messages out of order\n", errors);
+		return;
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <drivers/flash.h>
+#include <storage/flash_map.h>
+#include <fs/nvs.h>
+#include <timing/timing.h>
+
+/* NVS lookup microbenchmark.  For each population size the storage
+ * partition is cleared and that many IDs are written, then the average
+ * cost of reading a stored ID, of reading an ID that was never written
+ * and of rewriting an ID with unchanged data is measured.  All three
+ * have to find the latest allocation table entry of the ID, which
+ * without CONFIG_NVS_LOOKUP_CACHE means walking the table backwards.
+ */
+
+#define SECTOR_COUNT 32
+#define N_RUNS 200
+#define MISSING_ID 0xF000
+
+static const int populations[] = { 10, 100, 500 };
+
+static struct nvs_fs fs;
+
+static int mount(void)
+{
+	const struct flash_area *fa;
+	struct flash_pages_info info;
+	int rc;
+
+	rc = flash_area_open(FLASH_AREA_ID(storage), &fa);
+	if (rc) {
+		return rc;
+	}
+
+	fs.flash_device = flash_area_get_device(fa);
+	fs.offset = fa->fa_off;
+	flash_area_close(fa);
+
+	rc = flash_get_page_info_by_offs(fs.flash_device, fs.offset, &info);
+	if (rc) {
+		return rc;
+	}
+
+	fs.sector_size = info.size;
+	fs.sector_count = SECTOR_COUNT;
+
+	return nvs_mount(&fs);
+}
+
+static void run(int count)
+{
+	uint64_t read_cycles = 0U, miss_cycles = 0U, write_cycles = 0U;
+	timing_t start, end;
+	uint32_t data;
+	ssize_t len;
+	int rc;
+
+	rc = nvs_clear(&fs);
+	if (rc == 0) {
+		rc = mount();
+	}
+	if (rc) {
+		printk("mount failed: %d\n", rc);
+		return;
+	}
+
+	for (uint16_t id = 0; id < count; id++) {
+		data = id;
+		len = nvs_write(&fs, id, &data, sizeof(data));
+		if (len < 0) {
+			printk("nvs_write failed: %d\n", (int)len);
+			return;
+		}
+	}
+
+	for (int i = 0; i < N_RUNS; i++) {
+		uint16_t id = i % count;
+
+		start = timing_counter_get();
+		len = nvs_read(&fs, id, &data, sizeof(data));
+		end = timing_counter_get();
+		read_cycles += timing_cycles_get(&start, &end);
+
+		if (len != sizeof(data) || data != id) {
+			printk("nvs_read failed for id %u: %d\n", id,
+			       (int)len);
+			return;
+		}
+	}
+
+	for (int i = 0; i < N_RUNS; i++) {
+		start = timing_counter_get();
+		len = nvs_read(&fs, MISSING_ID, &data, sizeof(data));
+		end = timing_counter_get();
+		miss_cycles += timing_cycles_get(&start, &end);
+	}
+
+	/* Unchanged data is not written again, this only does the lookup
+	 * and the comparison.
+	 */
+	for (int i = 0; i < N_RUNS; i++) {
+		uint16_t id = i % count;
+
+		data = id;
+		start = timing_counter_get();
+		(void)nvs_write(&fs, id, &data, sizeof(data));
+		end = timing_counter_get();
+		write_cycles += timing_cycles_get(&start, &end);
+	}
+
+	printk("ids %5d read %6u miss %6u write %6u cycles\n", count,
+	       (uint32_t)(read_cycles / N_RUNS),
+	       (uint32_t)(miss_cycles / N_RUNS),
+	       (uint32_t)(write_cycles / N_RUNS));
+}
+
+void main(void)
+{
+	int rc;
+
+	rc = mount();
+	if (rc) {
+		printk("mount failed: %d\n", rc);
+		return;
+	}
+
+	timing_init();
+	timing_start();
+
+	printk("NVS lookup cache: %s\n",
+	       IS_ENABLED(CONFIG_NVS_LOOKUP_CACHE) ? "enabled" : "disabled");
+
+	for (int i = 0; i < ARRAY_SIZE(populations); i++) {
+		run(populations[i]);
+	}
+
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	struct nvs_lookup_cache_stats stats;
+
+	if (nvs_lookup_cache_stats_get(&fs, &stats) == 0) {
+		printk("lookups %u hits %u\n", stats.lookups, stats.hits);
+	}
+#endif
+
+	timing_stop();
+	printk("fin\n");
+}
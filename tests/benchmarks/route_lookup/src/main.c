@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr.h>
+#include <string.h>
+#include <sys/printk.h>
+
+#include "lpm.h"
+
+/* Route lookup benchmark.  The same set of random routes is stored in the
+ * longest prefix match trie and in an array which is scanned under a
+ * mutex, like the routing table did before it used the trie.  Both are
+ * then asked for the route of N_LOOKUPS addresses.
+ */
+
+#define MAX_ROUTES 1000
+#define N_KEYS 256
+#define N_LOOKUPS 10000
+
+struct route {
+	struct net_lpm_entry lpm;
+	uint8_t prefix[16];
+	uint8_t prefix_len;
+};
+
+NET_LPM_DEFINE(lpm6, MAX_ROUTES, 128);
+NET_LPM_DEFINE(lpm4, MAX_ROUTES, 32);
+
+static K_MUTEX_DEFINE(scan_lock);
+
+static struct route routes[MAX_ROUTES];
+static uint8_t keys[N_KEYS][16];
+
+/* Keeps the compiler from dropping the lookups */
+static volatile uintptr_t sink;
+
+static uint32_t seed = 0x12345678;
+
+/* Deterministic so that every run uses the same routes */
+static uint32_t next_rand(void)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+
+	return seed;
+}
+
+static void rand_fill(uint8_t *buf, int from, int len)
+{
+	for (int i = from; i < len; i++) {
+		buf[i] = next_rand();
+	}
+}
+
+static bool prefix_match(const uint8_t *addr, const uint8_t *prefix,
+			 uint8_t len)
+{
+	uint8_t mask;
+
+	if (memcmp(addr, prefix, len / 8)) {
+		return false;
+	}
+
+	if (len % 8 == 0) {
+		return true;
+	}
+
+	mask = 0xff << (8 - len % 8);
+
+	return (addr[len / 8] & mask) == (prefix[len / 8] & mask);
+}
+
+static struct route *scan_lookup(int count, const uint8_t *key)
+{
+	struct route *found = NULL;
+	uint8_t longest = 0U;
+
+	k_mutex_lock(&scan_lock, K_FOREVER);
+
+	for (int i = 0; i < count; i++) {
+		if (routes[i].prefix_len < longest) {
+			continue;
+		}
+
+		if (prefix_match(key, routes[i].prefix, routes[i].prefix_len)) {
+			found = &routes[i];
+			longest = routes[i].prefix_len;
+		}
+	}
+
+	k_mutex_unlock(&scan_lock);
+
+	return found;
+}
+
+static struct route *lpm_lookup(struct net_lpm *lpm, const uint8_t *key)
+{
+	struct net_lpm_entry *entry;
+	int idx;
+
+	idx = net_lpm_read_lock(lpm);
+	entry = net_lpm_lookup(lpm, key, NULL, NULL);
+	net_lpm_read_unlock(lpm, idx);
+
+	return entry ? CONTAINER_OF(entry, struct route, lpm) : NULL;
+}
+
+static void make_routes(int count, int bytes)
+{
+	struct route *route;
+
+	for (int i = 0; i < count; i++) {
+		route = &routes[i];
+
+		memset(route->prefix, 0, sizeof(route->prefix));
+
+		if (bytes == 16) {
+			/* Mostly /64 prefixes, some /48 and some host routes */
+			route->prefix[0] = 0x20;
+			route->prefix[1] = 0x01;
+			route->prefix[2] = 0x0d;
+			route->prefix[3] = 0xb8;
+			rand_fill(route->prefix, 4, 16);
+
+			switch (next_rand() % 8) {
+			case 0:
+				route->prefix_len = 48;
+				break;
+			case 1:
+				route->prefix_len = 128;
+				break;
+			default:
+				route->prefix_len = 64;
+				break;
+			}
+		} else {
+			route->prefix[0] = 10;
+			rand_fill(route->prefix, 1, 4);
+			route->prefix_len = 16 + next_rand() % 17;
+		}
+	}
+
+	/* Each key is covered by a random route, the host bits are random */
+	for (int i = 0; i < N_KEYS; i++) {
+		route = &routes[next_rand() % count];
+
+		rand_fill(keys[i], 0, bytes);
+		memcpy(keys[i], route->prefix, route->prefix_len / 8);
+		if (route->prefix_len % 8) {
+			uint8_t mask = 0xff << (8 - route->prefix_len % 8);
+
+			keys[i][route->prefix_len / 8] =
+				(route->prefix[route->prefix_len / 8] & mask) |
+				(keys[i][route->prefix_len / 8] & ~mask);
+		}
+	}
+}
+
+static void report(const char *name, int count, uint32_t cycles)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(cycles);
+
+	if (ns == 0) {
+		ns = 1;
+	}
+
+	printk("%-10s %5d routes %10u lookups/s\n", name, count,
+	       (uint32_t)(N_LOOKUPS * 1000000000ULL / ns));
+}
+
+static int run(const char *family, struct net_lpm *lpm, int bytes,
+	       int count)
+{
+	struct route *expected, *found;
+	char name[16];
+	uint32_t start, cycles;
+	int i, ret;
+
+	make_routes(count, bytes);
+
+	for (i = 0; i < count; i++) {
+		ret = net_lpm_insert(lpm, routes[i].prefix,
+				     routes[i].prefix_len, &routes[i].lpm);
+		if (ret < 0) {
+			printk("cannot insert route %d (%d)\n", i, ret);
+			return ret;
+		}
+	}
+
+	/* Duplicate prefixes may return different routes, the prefix
+	 * length must be the same.
+	 */
+	for (i = 0; i < N_KEYS; i++) {
+		expected = scan_lookup(count, keys[i]);
+		found = lpm_lookup(lpm, keys[i]);
+
+		if (!found || found->prefix_len != expected->prefix_len) {
+			printk("%s: wrong route for key %d\n", family, i);
+			return -EINVAL;
+		}
+	}
+
+	start = k_cycle_get_32();
+	for (i = 0; i < N_LOOKUPS; i++) {
+		sink = (uintptr_t)lpm_lookup(lpm, keys[i % N_KEYS]);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	snprintk(name, sizeof(name), "%s lpm", family);
+	report(name, count, cycles);
+
+	start = k_cycle_get_32();
+	for (i = 0; i < N_LOOKUPS; i++) {
+		sink = (uintptr_t)scan_lookup(count, keys[i % N_KEYS]);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	snprintk(name, sizeof(name), "%s scan", family);
+	report(name, count, cycles);
+
+	for (i = 0; i < count; i++) {
+		(void)net_lpm_remove(lpm, routes[i].prefix,
+				     routes[i].prefix_len, &routes[i].lpm);
+	}
+
+	return 0;
+}
+
+void main(void)
+{
+	static const int counts[] = { 10, 100, MAX_ROUTES };
+
+	for (int i = 0; i < ARRAY_SIZE(counts); i++) {
+		if (run("ipv6", &lpm6, 16, counts[i]) < 0) {
+			return;
+		}
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(counts); i++) {
+		if (run("ipv4", &lpm4, 4, counts[i]) < 0) {
+			return;
+		}
+	}
+
+	printk("fin\n");
+}
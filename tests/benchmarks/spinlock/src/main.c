@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <spinlock.h>
+
+/* Spinlock contention benchmark.  One thread is pinned to every CPU
+ * and all of them take the same spinlock in a loop until the main
+ * thread stops them.  Each thread records how long k_spin_lock() took
+ * in a log2 histogram, from which the per CPU latency distribution is
+ * printed.  The number of locks taken by each CPU shows how fair the
+ * lock is.  Build with CONFIG_SPINLOCK_TAS, CONFIG_SPINLOCK_TICKET and
+ * CONFIG_SPINLOCK_MCS to compare the implementations.
+ */
+
+#define RUN_MS 1000
+#define STACK_SIZE 1024
+#define HIST_BUCKETS 33
+
+/* Work done with the lock held, in loop iterations */
+#define HOLD_LOOPS 20
+
+#if defined(CONFIG_SPINLOCK_TICKET)
+#define LOCK_NAME "ticket"
+#elif defined(CONFIG_SPINLOCK_MCS)
+#define LOCK_NAME "mcs"
+#else
+#define LOCK_NAME "tas"
+#endif
+
+struct cpu_stats {
+	uint32_t locks;
+	uint32_t max;
+	uint64_t total;
+	uint32_t hist[HIST_BUCKETS];
+};
+
+static struct k_spinlock lock;
+static volatile uint32_t shared_count;
+static atomic_t ready;
+static atomic_t stop;
+
+static struct cpu_stats stats[CONFIG_MP_NUM_CPUS];
+static struct k_thread threads[CONFIG_MP_NUM_CPUS];
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_NUM_CPUS, STACK_SIZE);
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	struct cpu_stats *st = p1;
+	volatile int spin;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Start all CPUs at the same time */
+	atomic_inc(&ready);
+	while (atomic_get(&ready) < CONFIG_MP_NUM_CPUS) {
+	}
+
+	while (!atomic_get(&stop)) {
+		uint32_t start = k_cycle_get_32();
+		k_spinlock_key_t key = k_spin_lock(&lock);
+		uint32_t dt = k_cycle_get_32() - start;
+
+		shared_count++;
+		for (spin = 0; spin < HOLD_LOOPS; spin++) {
+		}
+
+		k_spin_unlock(&lock, key);
+
+		st->locks++;
+		st->total += dt;
+		st->max = MAX(st->max, dt);
+		st->hist[32 - __builtin_clz(dt | 1)]++;
+	}
+}
+
+/* Upper bound of the histogram bucket holding the pct percentile */
+static uint32_t percentile(struct cpu_stats *st, int pct)
+{
+	uint64_t target = (uint64_t)st->locks * pct / 100;
+	uint64_t sum = 0;
+	int i;
+
+	for (i = 0; i < HIST_BUCKETS - 1; i++) {
+		sum += st->hist[i];
+		if (sum > target) {
+			break;
+		}
+	}
+
+	return BIT64(i) - 1;
+}
+
+void main(void)
+{
+	uint32_t total = 0;
+	int i;
+
+	printk("Spinlock: %s, %d CPUs\n", LOCK_NAME, CONFIG_MP_NUM_CPUS);
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, worker,
+				&stats[i], NULL, NULL, K_PRIO_PREEMPT(1), 0,
+				K_FOREVER);
+		k_thread_cpu_mask_clear(&threads[i]);
+		k_thread_cpu_mask_enable(&threads[i], i);
+		k_thread_start(&threads[i]);
+	}
+
+	k_msleep(RUN_MS);
+	atomic_set(&stop, 1);
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct cpu_stats *st = &stats[i];
+
+		printk("cpu %d locks %8u avg %5u p50 %5u p90 %5u p99 %5u "
+		       "max %6u cycles\n", i, st->locks,
+		       st->locks ? (uint32_t)(st->total / st->locks) : 0,
+		       percentile(st, 50), percentile(st, 90),
+		       percentile(st, 99), st->max);
+
+		total += st->locks;
+	}
+
+	if (total != shared_count) {
+		printk("FAIL: %u locks but %u increments\n", total,
+		       shared_count);
+		return;
+	}
+
+	printk("fin\n");
+}
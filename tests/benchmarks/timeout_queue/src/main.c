@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <timeout_q.h>
+#include <timing/timing.h>
+
+/* Timeout queue microbenchmark.  For each population size the
+ * kernel timeout queue is filled with that many pending timeouts
+ * (with pseudo-random expiries far enough out that none fire during
+ * the run), then the average cost of inserting and of cancelling one
+ * more timeout is measured.  Build with CONFIG_TIMEOUT_QUEUE_DLIST
+ * and CONFIG_TIMEOUT_QUEUE_WHEEL to compare the backends.
+ */
+
+#define MAX_PENDING 10000
+#define N_RUNS 200
+
+/* Keep everything comfortably in the future */
+#define BASE_TICKS (10 * CONFIG_SYS_CLOCK_TICKS_PER_SEC)
+#define SPREAD_TICKS (3600 * CONFIG_SYS_CLOCK_TICKS_PER_SEC)
+
+static struct _timeout pending[MAX_PENDING];
+static struct _timeout probe[N_RUNS];
+
+static const int populations[] = { 10, 1000, 10000 };
+
+static uint32_t rand_state = 1;
+
+static uint32_t next_rand(void)
+{
+	/* xorshift32, good enough for spreading expiries */
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+	return rand_state;
+}
+
+static k_timeout_t rand_timeout(void)
+{
+	return K_TICKS(BASE_TICKS + (next_rand() % SPREAD_TICKS));
+}
+
+static void dummy_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+static void run(int count)
+{
+	uint64_t add_cycles = 0U, abort_cycles = 0U;
+	timing_t start, end;
+
+	for (int i = 0; i < count; i++) {
+		z_add_timeout(&pending[i], dummy_fn, rand_timeout());
+	}
+
+	for (int i = 0; i < N_RUNS; i++) {
+		k_timeout_t to = rand_timeout();
+
+		start = timing_counter_get();
+		z_add_timeout(&probe[i], dummy_fn, to);
+		end = timing_counter_get();
+		add_cycles += timing_cycles_get(&start, &end);
+	}
+
+	for (int i = 0; i < N_RUNS; i++) {
+		start = timing_counter_get();
+		z_abort_timeout(&probe[i]);
+		end = timing_counter_get();
+		abort_cycles += timing_cycles_get(&start, &end);
+	}
+
+	for (int i = 0; i < count; i++) {
+		z_abort_timeout(&pending[i]);
+	}
+
+	printk("pending %5d add %6u abort %6u cycles\n", count,
+	       (uint32_t)(add_cycles / N_RUNS),
+	       (uint32_t)(abort_cycles / N_RUNS));
+}
+
+void main(void)
+{
+	for (int i = 0; i < MAX_PENDING; i++) {
+		z_init_timeout(&pending[i]);
+	}
+	for (int i = 0; i < N_RUNS; i++) {
+		z_init_timeout(&probe[i]);
+	}
+
+	timing_init();
+	timing_start();
+
+	printk("Timeout queue backend: %s\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_WHEEL) ? "wheel" : "dlist");
+
+	for (int i = 0; i < ARRAY_SIZE(populations); i++) {
+		run(populations[i]);
+	}
+
+	timing_stop();
+	printk("fin\n");
+}
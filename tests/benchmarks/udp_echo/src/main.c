@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+
+/* UDP echo throughput benchmark.  The client sends BATCH datagrams to the
+ * server, the server echoes all of them back to their source and the
+ * client reads the replies.  Everything runs in one thread over the
+ * loopback interface, so the figure is dominated by the per call cost of
+ * the socket layer which recvmmsg()/sendmmsg() amortize over the batch.
+ */
+
+#define SERVER_PORT 4242
+#define CLIENT_PORT 9898
+
+#define BATCH 16
+#define PAYLOAD 32
+#define N_ROUNDS 256
+
+static struct sockaddr_in6 server_addr;
+static struct sockaddr_in6 client_addr;
+
+static uint8_t tx_buf[PAYLOAD];
+static uint8_t rx_buf[BATCH][PAYLOAD];
+static struct sockaddr_in6 src_addr[BATCH];
+
+static struct mmsghdr msgs[BATCH];
+static struct iovec iov[BATCH];
+
+static int make_sock(struct sockaddr_in6 *addr, uint16_t port)
+{
+	int sock;
+
+	addr->sin6_family = AF_INET6;
+	addr->sin6_port = htons(port);
+	inet_pton(AF_INET6, CONFIG_NET_CONFIG_MY_IPV6_ADDR, &addr->sin6_addr);
+
+	sock = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0) {
+		return sock;
+	}
+
+	if (bind(sock, (struct sockaddr *)addr, sizeof(*addr)) < 0) {
+		close(sock);
+		return -1;
+	}
+
+	return sock;
+}
+
+static int run_single(int c_sock, int s_sock)
+{
+	socklen_t addrlen;
+	int i;
+
+	for (i = 0; i < BATCH; i++) {
+		if (sendto(c_sock, tx_buf, sizeof(tx_buf), 0,
+			   (struct sockaddr *)&server_addr,
+			   sizeof(server_addr)) < 0) {
+			return -1;
+		}
+	}
+
+	for (i = 0; i < BATCH; i++) {
+		addrlen = sizeof(src_addr[i]);
+		if (recvfrom(s_sock, rx_buf[i], sizeof(rx_buf[i]), 0,
+			     (struct sockaddr *)&src_addr[i], &addrlen) < 0) {
+			return -1;
+		}
+
+		if (sendto(s_sock, rx_buf[i], sizeof(rx_buf[i]), 0,
+			   (struct sockaddr *)&src_addr[i], addrlen) < 0) {
+			return -1;
+		}
+	}
+
+	for (i = 0; i < BATCH; i++) {
+		if (recv(c_sock, rx_buf[i], sizeof(rx_buf[i]), 0) < 0) {
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static void prepare_msgs(void *name, socklen_t namelen, bool tx)
+{
+	for (int i = 0; i < BATCH; i++) {
+		iov[i].iov_base = tx ? (void *)tx_buf : (void *)rx_buf[i];
+		iov[i].iov_len = PAYLOAD;
+		msgs[i].msg_hdr.msg_name = name != NULL ? name : &src_addr[i];
+		msgs[i].msg_hdr.msg_namelen = namelen;
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_control = NULL;
+		msgs[i].msg_hdr.msg_controllen = 0;
+	}
+}
+
+static int recv_batch(int sock)
+{
+	int done = 0;
+	int ret;
+
+	while (done < BATCH) {
+		ret = recvmmsg(sock, msgs + done, BATCH - done,
+			       MSG_WAITFORONE, NULL);
+		if (ret < 0) {
+			return ret;
+		}
+
+		done += ret;
+	}
+
+	return 0;
+}
+
+static int run_batch(int c_sock, int s_sock)
+{
+	prepare_msgs(&server_addr, sizeof(server_addr), true);
+	if (sendmmsg(c_sock, msgs, BATCH, 0) != BATCH) {
+		return -1;
+	}
+
+	/* The received headers carry the source, echo them back as is */
+	prepare_msgs(NULL, sizeof(struct sockaddr_in6), false);
+	if (recv_batch(s_sock) < 0) {
+		return -1;
+	}
+
+	if (sendmmsg(s_sock, msgs, BATCH, 0) != BATCH) {
+		return -1;
+	}
+
+	prepare_msgs(NULL, 0, false);
+	return recv_batch(c_sock);
+}
+
+static void run(const char *name, int (*fn)(int, int), int c_sock,
+		int s_sock)
+{
+	uint32_t packets = 0U;
+	int64_t start;
+	int64_t ms;
+
+	start = k_uptime_get();
+	for (int round = 0; round < N_ROUNDS; round++) {
+		if (fn(c_sock, s_sock) < 0) {
+			printk("%s failed (%d)\n", name, errno);
+			return;
+		}
+
+		packets += 2 * BATCH;
+	}
+	ms = k_uptime_get() - start;
+	if (ms == 0) {
+		ms = 1;
+	}
+
+	printk("%-20s %6u packets in %5u ms %8u packets/s\n", name, packets,
+	       (uint32_t)ms, (uint32_t)(packets * 1000ULL / ms));
+}
+
+void main(void)
+{
+	int c_sock;
+	int s_sock;
+
+	memset(tx_buf, 0xa5, sizeof(tx_buf));
+
+	s_sock = make_sock(&server_addr, SERVER_PORT);
+	c_sock = make_sock(&client_addr, CLIENT_PORT);
+	if (s_sock < 0 || c_sock < 0) {
+		printk("cannot create sockets (%d)\n", errno);
+		return;
+	}
+
+	printk("udp echo: batch %d, payload %d bytes\n", BATCH, PAYLOAD);
+
+	run("sendto/recvfrom", run_single, c_sock, s_sock);
+	run("sendmmsg/recvmmsg", run_batch, c_sock, s_sock);
+
+	close(c_sock);
+	close(s_sock);
+
+	printk("fin\n");
+}
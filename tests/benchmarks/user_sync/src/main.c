@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/mutex.h>
+#include <sys/sem.h>
+#include <app_memory/app_memdomain.h>
+
+/* Cost of uncontended synchronization in user mode.  Every operation
+ * runs in a new user thread, the main thread measures from creating it
+ * to joining it and subtracts the cost of a thread doing nothing.
+ * k_cycle_get_32() can't be used from user mode on every platform.
+ */
+
+#define ITERATIONS 10000
+#define STACK_SIZE 1024
+
+K_APPMEM_PARTITION_DEFINE(bench_part);
+#define BENCH_DATA K_APP_DMEM(bench_part)
+
+BENCH_DATA SYS_MUTEX_DEFINE(mutex);
+BENCH_DATA SYS_SEM_DEFINE(sem, 1, 1);
+K_MUTEX_DEFINE(kernel_mutex);
+
+static struct k_mem_domain domain;
+static struct k_thread thread;
+static K_THREAD_STACK_DEFINE(stack, STACK_SIZE);
+
+typedef void (*bench_fn_t)(void);
+
+static void nothing(void)
+{
+}
+
+static void sys_mutex_loop(void)
+{
+	for (int i = 0; i < ITERATIONS; i++) {
+		sys_mutex_lock(&mutex, K_FOREVER);
+		sys_mutex_unlock(&mutex);
+	}
+}
+
+static void sys_sem_loop(void)
+{
+	for (int i = 0; i < ITERATIONS; i++) {
+		sys_sem_take(&sem, K_FOREVER);
+		sys_sem_give(&sem);
+	}
+}
+
+static void k_mutex_loop(void)
+{
+	for (int i = 0; i < ITERATIONS; i++) {
+		k_mutex_lock(&kernel_mutex, K_FOREVER);
+		k_mutex_unlock(&kernel_mutex);
+	}
+}
+
+static void user_entry(void *p1, void *p2, void *p3)
+{
+	bench_fn_t fn = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	fn();
+}
+
+static uint32_t run(bench_fn_t fn)
+{
+	uint32_t start = k_cycle_get_32();
+
+	k_thread_create(&thread, stack, STACK_SIZE, user_entry, fn, NULL,
+			NULL, K_PRIO_PREEMPT(1), K_USER, K_FOREVER);
+	k_mem_domain_add_thread(&domain, &thread);
+	k_thread_access_grant(&thread, &kernel_mutex);
+	k_thread_start(&thread);
+	k_thread_join(&thread, K_FOREVER);
+
+	return k_cycle_get_32() - start;
+}
+
+static void report(const char *name, bench_fn_t fn, uint32_t overhead)
+{
+	uint32_t cycles = run(fn);
+
+	cycles = cycles > overhead ? cycles - overhead : 0;
+
+	printk("%-25s %5u cycles\n", name, cycles / ITERATIONS);
+}
+
+void main(void)
+{
+	struct k_mem_partition *parts[] = { &bench_part };
+	uint32_t overhead;
+
+	printk("User mode synchronization, sys_mutex fast path: %c\n",
+	       IS_ENABLED(CONFIG_SYS_MUTEX_FAST) ? 'y' : 'n');
+
+	k_mem_domain_init(&domain, ARRAY_SIZE(parts), parts);
+
+	/* Warm up the caches */
+	run(sys_mutex_loop);
+	overhead = run(nothing);
+
+	report("sys_mutex lock/unlock", sys_mutex_loop, overhead);
+	report("sys_sem take/give", sys_sem_loop, overhead);
+	report("k_mutex lock/unlock", k_mutex_loop, overhead);
+
+	printk("fin\n");
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define BATCH_LEN 4
+
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+extern struct k_msgq msgq;
+static ZTEST_BMEM char __aligned(4) bbuffer[MSG_SIZE * BATCH_LEN];
+static ZTEST_DMEM uint32_t tx_data[BATCH_LEN + 2] = { 1, 2, 3, 4, 5, 6 };
+static ZTEST_BMEM uint32_t rx_data[2 * BATCH_LEN];
+static ZTEST_BMEM uint32_t pend_data;
+static ZTEST_BMEM int pend_ret;
+
+static void put_get_many(struct k_msgq *q, uint32_t len)
+{
+	int ret;
+
+	/* move the read and write pointers so the batches wrap around */
+	ret = k_msgq_put(q, &tx_data[0], K_NO_WAIT);
+	zassert_equal(ret, 0, NULL);
+	ret = k_msgq_get(q, &rx_data[0], K_NO_WAIT);
+	zassert_equal(ret, 0, NULL);
+
+	/**TESTPOINT: only the messages which fit are put*/
+	ret = k_msgq_put_many(q, tx_data, len + 2, K_NO_WAIT);
+	zassert_equal(ret, len, NULL);
+	zassert_equal(k_msgq_num_used_get(q), len, NULL);
+
+	ret = k_msgq_put_many(q, tx_data, 1, K_NO_WAIT);
+	zassert_equal(ret, -ENOMSG, NULL);
+
+	/**TESTPOINT: messages are received in order*/
+	ret = k_msgq_get_many(q, rx_data, len - 1, K_NO_WAIT);
+	zassert_equal(ret, len - 1, NULL);
+	ret = k_msgq_get_many(q, &rx_data[len - 1], len, K_NO_WAIT);
+	zassert_equal(ret, 1, NULL);
+
+	for (int i = 0; i < len; i++) {
+		zassert_equal(rx_data[i], tx_data[i], NULL);
+	}
+
+	ret = k_msgq_get_many(q, rx_data, len, K_NO_WAIT);
+	zassert_equal(ret, -ENOMSG, NULL);
+	ret = k_msgq_get_many(q, rx_data, len, TIMEOUT);
+	zassert_equal(ret, -EAGAIN, NULL);
+}
+
+static void get_many_entry(void *p1, void *p2, void *p3)
+{
+	pend_ret = k_msgq_get_many((struct k_msgq *)p1, &pend_data,
+				   BATCH_LEN, K_FOREVER);
+}
+
+static void put_many_entry(void *p1, void *p2, void *p3)
+{
+	pend_ret = k_msgq_put_many((struct k_msgq *)p1, &tx_data[BATCH_LEN],
+				   2, K_FOREVER);
+}
+
+static void put_entry(void *p1, void *p2, void *p3)
+{
+	pend_ret = k_msgq_put((struct k_msgq *)p1, &tx_data[1], K_FOREVER);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test sending and receiving several messages at once
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+void test_msgq_put_get_many(void)
+{
+	k_msgq_init(&msgq, bbuffer, MSG_SIZE, BATCH_LEN);
+
+	put_get_many(&msgq, BATCH_LEN);
+}
+
+/**
+ * @brief Test waking up waiting threads with batches
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+void test_msgq_pend_many(void)
+{
+	int ret;
+
+	k_msgq_init(&msgq, bbuffer, MSG_SIZE, BATCH_LEN);
+
+	/**TESTPOINT: a waiting reader gets the first message of a batch*/
+	k_thread_create(&tdata, tstack, STACK_SIZE, get_many_entry, &msgq,
+			NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	ret = k_msgq_put_many(&msgq, tx_data, 3, K_NO_WAIT);
+	zassert_equal(ret, 3, NULL);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(pend_ret, 1, NULL);
+	zassert_equal(pend_data, tx_data[0], NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), 2, NULL);
+
+	ret = k_msgq_put_many(&msgq, &tx_data[3], 2, K_NO_WAIT);
+	zassert_equal(ret, 2, NULL);
+
+	/**TESTPOINT: a waiting writer is let in when messages are taken*/
+	k_thread_create(&tdata, tstack, STACK_SIZE, put_many_entry, &msgq,
+			NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	ret = k_msgq_get_many(&msgq, rx_data, 2, K_NO_WAIT);
+	zassert_equal(ret, 2, NULL);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(pend_ret, 1, NULL);
+
+	/* only the first message of the waiting writer was sent */
+	ret = k_msgq_get_many(&msgq, rx_data, BATCH_LEN, K_NO_WAIT);
+	zassert_equal(ret, 3, NULL);
+	zassert_equal(rx_data[0], tx_data[3], NULL);
+	zassert_equal(rx_data[1], tx_data[4], NULL);
+	zassert_equal(rx_data[2], tx_data[4], NULL);
+}
+
+/**
+ * @brief Test writing a message in place
+ * @see k_msgq_reserve(), k_msgq_commit()
+ */
+void test_msgq_reserve(void)
+{
+	uint32_t *slot;
+	uint32_t rx;
+	int ret;
+
+	k_msgq_init(&msgq, bbuffer, MSG_SIZE, BATCH_LEN);
+
+	zassert_equal(k_msgq_commit(&msgq, true), -EINVAL, NULL);
+
+	ret = k_msgq_reserve(&msgq, (void **)&slot);
+	zassert_equal(ret, 0, NULL);
+	zassert_equal(k_msgq_num_free_get(&msgq), BATCH_LEN - 1, NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), 0, NULL);
+
+	/**TESTPOINT: nothing else can be put while a slot is reserved*/
+	zassert_equal(k_msgq_reserve(&msgq, (void **)&slot), -EBUSY, NULL);
+	zassert_equal(k_msgq_put(&msgq, &tx_data[1], K_NO_WAIT), -EBUSY,
+		      NULL);
+	zassert_equal(k_msgq_put_many(&msgq, tx_data, 2, K_NO_WAIT), -EBUSY,
+		      NULL);
+
+	/**TESTPOINT: writers wait for the commit within their timeout*/
+	zassert_equal(k_msgq_put(&msgq, &tx_data[1], TIMEOUT), -EAGAIN,
+		      NULL);
+	zassert_equal(k_msgq_put_many(&msgq, tx_data, 2, TIMEOUT), -EAGAIN,
+		      NULL);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, put_entry, &msgq,
+			NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+	zassert_equal(k_msgq_num_used_get(&msgq), 0, NULL);
+
+	/**TESTPOINT: the waiting writer puts its message after the commit*/
+	*slot = MSG0;
+	zassert_equal(k_msgq_commit(&msgq, true), 0, NULL);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(pend_ret, 0, NULL);
+	zassert_equal(k_msgq_get(&msgq, &rx, K_NO_WAIT), 0, NULL);
+	zassert_equal(rx, MSG0, NULL);
+	zassert_equal(k_msgq_get(&msgq, &rx, K_NO_WAIT), 0, NULL);
+	zassert_equal(rx, tx_data[1], NULL);
+
+	/**TESTPOINT: a dropped slot sends nothing*/
+	ret = k_msgq_reserve(&msgq, (void **)&slot);
+	zassert_equal(ret, 0, NULL);
+	zassert_equal(k_msgq_commit(&msgq, false), 0, NULL);
+	zassert_equal(k_msgq_num_free_get(&msgq), BATCH_LEN, NULL);
+	zassert_equal(k_msgq_get(&msgq, &rx, K_NO_WAIT), -ENOMSG, NULL);
+
+	/**TESTPOINT: a committed message goes to a waiting reader*/
+	k_thread_create(&tdata, tstack, STACK_SIZE, get_many_entry, &msgq,
+			NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	ret = k_msgq_reserve(&msgq, (void **)&slot);
+	zassert_equal(ret, 0, NULL);
+	*slot = MSG1;
+	zassert_equal(k_msgq_commit(&msgq, true), 0, NULL);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(pend_ret, 1, NULL);
+	zassert_equal(pend_data, MSG1, NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), 0, NULL);
+
+	/**TESTPOINT: a full queue has no slot to reserve*/
+	ret = k_msgq_put_many(&msgq, tx_data, BATCH_LEN, K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN, NULL);
+	zassert_equal(k_msgq_reserve(&msgq, (void **)&slot), -ENOMSG, NULL);
+}
+
+#ifdef CONFIG_USERSPACE
+/**
+ * @brief Test sending and receiving several messages at once in user mode
+ * @see k_msgq_alloc_init(), k_msgq_put_many(), k_msgq_get_many()
+ */
+void test_msgq_user_put_get_many(void)
+{
+	struct k_msgq *q;
+
+	q = k_object_alloc(K_OBJ_MSGQ);
+	zassert_not_null(q, "couldn't alloc message queue");
+	zassert_false(k_msgq_alloc_init(q, MSG_SIZE, MSGQ_LEN), NULL);
+
+	put_get_many(q, MSGQ_LEN);
+}
+#endif
+
+/**
+ * @}
+ */
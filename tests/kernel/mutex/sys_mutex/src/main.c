@@ -65,6 +65,13 @@ ZTEST_BMEM SYS_MUTEX_DEFINE(mutex_4);
 #ifdef CONFIG_USERSPACE
 static SYS_MUTEX_DEFINE(no_access_mutex);
 #endif
+#ifdef CONFIG_SYS_MUTEX_FAST
+static ZTEST_BMEM SYS_MUTEX_DEFINE(forged_mutex);
+
+/* Never started, and no test thread is granted access to it */
+static struct k_thread forged_owner;
+static K_THREAD_STACK_DEFINE(forged_owner_stack, STACKSIZE);
+#endif
 static ZTEST_BMEM SYS_MUTEX_DEFINE(not_my_mutex);
 static ZTEST_BMEM SYS_MUTEX_DEFINE(bad_count_mutex);
 extern void test_mutex_multithread_competition(void);
@@ -359,8 +366,10 @@ void test_supervisor_access(void)
 {
 	int rv;
 
-#ifdef CONFIG_USERSPACE
-	/* coverage for get_k_mutex checks */
+#if defined(CONFIG_USERSPACE) && !defined(CONFIG_SYS_MUTEX_FAST)
+	/* coverage for get_k_mutex checks, the fast path doesn't check the
+	 * mutex pointer
+	 */
 	rv = sys_mutex_lock((struct sys_mutex *)NULL, K_NO_WAIT);
 	zassert_true(rv == -EINVAL, "accepted bad mutex pointer");
 	rv = sys_mutex_lock((struct sys_mutex *)k_current_get(), K_NO_WAIT);
@@ -369,7 +378,7 @@ void test_supervisor_access(void)
 	zassert_true(rv == -EINVAL, "accepted bad mutex pointer");
 	rv = sys_mutex_unlock((struct sys_mutex *)k_current_get());
 	zassert_true(rv == -EINVAL, "accepted object that was not a mutex");
-#endif /* CONFIG_USERSPACE */
+#endif /* CONFIG_USERSPACE && !CONFIG_SYS_MUTEX_FAST */
 
 	rv = sys_mutex_unlock(&not_my_mutex);
 	zassert_true(rv == -EPERM, "unlocked a mutex that wasn't owner");
@@ -379,16 +388,28 @@ void test_supervisor_access(void)
 
 void test_user_access(void)
 {
-#ifdef CONFIG_USERSPACE
+#if defined(CONFIG_USERSPACE) && !defined(CONFIG_SYS_MUTEX_FAST)
 	int rv;
 
 	rv = sys_mutex_lock(&no_access_mutex, K_NO_WAIT);
 	zassert_true(rv == -EACCES, "accessed mutex not in memory domain");
 	rv = sys_mutex_unlock(&no_access_mutex);
 	zassert_true(rv == -EACCES, "accessed mutex not in memory domain");
+#elif defined(CONFIG_SYS_MUTEX_FAST)
+	int rv;
+
+	/* The owner is read from user memory, so writing a thread we have
+	 * no permission on there must not make it the k_mutex owner
+	 */
+	atomic_set(&forged_mutex.val, (atomic_val_t)&forged_owner);
+	rv = sys_mutex_lock(&forged_mutex, K_NO_WAIT);
+	zassert_true(rv == -EINVAL, "accepted owner without permission");
+	zassert_true(atomic_get(&forged_mutex.val) ==
+		     (atomic_val_t)&forged_owner, "mutex state changed");
+	atomic_set(&forged_mutex.val, 0);
 #else
 	ztest_test_skip();
-#endif /* CONFIG_USERSPACE */
+#endif /* CONFIG_USERSPACE && !CONFIG_SYS_MUTEX_FAST */
 }
 
 K_THREAD_DEFINE(THREAD_05, STACKSIZE, thread_05, NULL, NULL, NULL,
@@ -417,6 +438,11 @@ void test_main(void)
 #ifdef CONFIG_USERSPACE
 	k_thread_access_grant(k_current_get(),
 			      &thread_12_thread_data, &thread_12_stack_area);
+#endif
+#ifdef CONFIG_SYS_MUTEX_FAST
+	k_thread_create(&forged_owner, forged_owner_stack, STACKSIZE,
+			(k_thread_entry_t)thread_12, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(12), 0, K_FOREVER);
 #endif
 	rv = sys_mutex_lock(&not_my_mutex, K_NO_WAIT);
 	if (rv != 0) {
@@ -796,11 +796,14 @@ void test_smp_release_global_lock(void)
 enum sync_t {
 	LOCK_IRQ,
 	LOCK_SEM,
-	LOCK_MUTEX
+	LOCK_MUTEX,
+	LOCK_SPIN
 };
 
 static int global_cnt;
 static struct k_mutex smp_mutex;
+static struct k_spinlock smp_spinlock;
+static k_spinlock_key_t smp_spinlock_key;
 
 static void (*sync_lock)(void *);
 static void (*sync_unlock)(void *);
@@ -840,6 +843,17 @@ static void sync_unlock_mutex(void *k)
 	k_mutex_unlock(&smp_mutex);
 }
 
+static void sync_lock_spin(void *k)
+{
+	/* only the lock holder uses the key, so it can be shared */
+	smp_spinlock_key = k_spin_lock(&smp_spinlock);
+}
+
+static void sync_unlock_spin(void *k)
+{
+	k_spin_unlock(&smp_spinlock, smp_spinlock_key);
+}
+
 static void sync_init(int lock_type)
 {
 	switch (lock_type) {
@@ -857,6 +871,10 @@ static void sync_init(int lock_type)
 		sync_unlock = sync_unlock_mutex;
 		k_mutex_init(&smp_mutex);
 		break;
+	case LOCK_SPIN:
+		sync_lock = sync_lock_spin;
+		sync_unlock = sync_unlock_spin;
+		break;
 
 	default:
 		sync_lock = sync_unlock = sync_lock_dummy;
@@ -931,11 +949,12 @@ static int run_concurrency(int type, void *func)
  * they both do locking then unlocking for LOOP_COUNT times. It shall be no
  * deadlock happened and total global count shall be 3 * LOOP COUNT.
  *
- * We show the 4 kinds of scenairo:
+ * We show the 5 kinds of scenairo:
  * - No any lock used
  * - Use global irq lock
  * - Use semaphore
  * - Use mutex
+ * - Use spinlock, of the implementation selected by SPINLOCK_IMPL
  */
 void test_inc_concurrency(void)
 {
@@ -950,6 +969,104 @@ void test_inc_concurrency(void)
 	/* increasing global var with irq lock */
 	zassert_true(run_concurrency(LOCK_MUTEX, inc_global_cnt),
 			"total count %d is wrong(M)", global_cnt);
+
+	/* increasing global var with spinlock */
+	zassert_true(run_concurrency(LOCK_SPIN, inc_global_cnt),
+			"total count %d is wrong(S)", global_cnt);
+}
+
+static atomic_t spinners_started;
+static volatile bool spinners_stop;
+static volatile bool woken_ran;
+static volatile bool woken_ran_in_time;
+
+static void woken_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	woken_ran = true;
+}
+
+static void low_spin_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	atomic_inc(&spinners_started);
+
+	while (!spinners_stop) {
+		k_busy_wait(100);
+	}
+}
+
+static void high_spin_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (atomic_get(&spinners_started) < THREADS_NUM - 1) {
+		k_busy_wait(100);
+	}
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* Make this CPU the one the woken thread last ran on, so it
+	 * is the queue it would be put on by default
+	 */
+	t2.base.runq_cpu = curr_cpu();
+#endif
+	k_thread_start(&t2);
+
+	for (int i = 0; i < TIMEOUT && !woken_ran; i++) {
+		k_busy_wait(100);
+	}
+
+	woken_ran_in_time = woken_ran;
+	spinners_stop = true;
+}
+
+/**
+ * @brief Test that a woken thread preempts lower priority work elsewhere
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details A high priority thread keeps one CPU busy while low priority
+ * threads keep all the others busy.  The high priority thread then
+ * wakes a thread of intermediate priority which, with per-CPU run
+ * queues, last ran on the high priority thread's CPU.  It must run on
+ * one of the other CPUs before the high priority thread is done,
+ * rather than wait behind it while lower priority threads run.
+ */
+void test_preempt_lower_cpu(void)
+{
+	atomic_set(&spinners_started, 0);
+	spinners_stop = false;
+	woken_ran = false;
+	woken_ran_in_time = false;
+
+	k_thread_create(&t2, t2_stack, T2_STACK_SIZE, woken_fn,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(5), 0, K_FOREVER);
+
+	for (int i = 1; i < THREADS_NUM; i++) {
+		k_thread_create(&tthread[i], tstack[i], STACK_SIZE,
+				low_spin_fn, NULL, NULL, NULL,
+				K_PRIO_PREEMPT(10), 0, K_NO_WAIT);
+	}
+
+	k_thread_create(&tthread[0], tstack[0], STACK_SIZE, high_spin_fn,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(2), 0, K_NO_WAIT);
+
+	for (int i = 0; i < THREADS_NUM; i++) {
+		k_thread_join(&tthread[i], K_FOREVER);
+	}
+	k_thread_join(&t2, K_FOREVER);
+
+	zassert_true(woken_ran, "woken thread never ran");
+	zassert_true(woken_ran_in_time,
+		     "woken thread waited behind a higher priority thread");
 }
 
 /**
@@ -1033,6 +1150,7 @@ void test_main(void)
 			 ztest_unit_test(test_workq_on_smp),
 			 ztest_unit_test(test_smp_release_global_lock),
 			 ztest_unit_test(test_inc_concurrency),
+			 ztest_unit_test(test_preempt_lower_cpu),
 			 ztest_unit_test(test_smp_switch_torture)
 			 );
 	ztest_run_test_suite(smp);
@@ -20,6 +20,27 @@ static struct k_spinlock bounce_lock;
 
 volatile int bounce_owner, bounce_done;
 
+#define CONTENTION_LOOPS 10000
+#define NESTED_LOCKS 4
+
+static struct k_thread contention_threads[CONFIG_MP_NUM_CPUS - 1];
+static K_THREAD_STACK_ARRAY_DEFINE(contention_stacks, CONFIG_MP_NUM_CPUS - 1,
+				   CPU1_STACK_SIZE);
+static struct k_spinlock contention_lock;
+static volatile int contention_cnt;
+
+/* Whether the lock is held, for every spinlock implementation */
+static bool spinlock_is_locked(struct k_spinlock *l)
+{
+#if defined(CONFIG_SPINLOCK_TICKET)
+	return atomic_get(&l->next) != atomic_get(&l->owner);
+#elif defined(CONFIG_SPINLOCK_MCS)
+	return atomic_ptr_get(&l->tail) != NULL;
+#else
+	return l->locked;
+#endif
+}
+
 /**
  * @brief Tests for spinlock
  *
@@ -43,15 +64,103 @@ void test_spinlock_basic(void)
 	k_spinlock_key_t key;
 	static struct k_spinlock l;
 
-	zassert_true(!l.locked, "Spinlock initialized to locked");
+	zassert_true(!spinlock_is_locked(&l), "Spinlock initialized to locked");
 
 	key = k_spin_lock(&l);
 
-	zassert_true(l.locked, "Spinlock failed to lock");
+	zassert_true(spinlock_is_locked(&l), "Spinlock failed to lock");
 
 	k_spin_unlock(&l, key);
 
-	zassert_true(!l.locked, "Spinlock failed to unlock");
+	zassert_true(!spinlock_is_locked(&l), "Spinlock failed to unlock");
+}
+
+static void contention_fn(void *p1, void *p2, void *p3)
+{
+	k_spinlock_key_t key;
+	int i, cnt;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (i = 0; i < CONTENTION_LOOPS; i++) {
+		key = k_spin_lock(&contention_lock);
+
+		/* Updates are lost if two CPUs get here at the same time */
+		cnt = contention_cnt;
+		k_busy_wait(1);
+		contention_cnt = cnt + 1;
+
+		k_spin_unlock(&contention_lock, key);
+	}
+}
+
+/**
+ * @brief Test mutual exclusion with every CPU contending for a spinlock
+ *
+ * @details Every CPU increments a counter protected by the same lock
+ * many times, no increment may be lost and the lock is free at the end.
+ *
+ * @ingroup kernel_spinlock_tests
+ *
+ * @see k_spin_lock(), k_spin_unlock()
+ */
+void test_spinlock_contention(void)
+{
+	int i;
+
+	contention_cnt = 0;
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS - 1; i++) {
+		k_thread_create(&contention_threads[i], contention_stacks[i],
+				CPU1_STACK_SIZE, contention_fn, NULL, NULL,
+				NULL, 0, 0, K_NO_WAIT);
+	}
+
+	contention_fn(NULL, NULL, NULL);
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS - 1; i++) {
+		k_thread_join(&contention_threads[i], K_FOREVER);
+	}
+
+	zassert_equal(contention_cnt, CONFIG_MP_NUM_CPUS * CONTENTION_LOOPS,
+		      "Lost %d increments",
+		      CONFIG_MP_NUM_CPUS * CONTENTION_LOOPS - contention_cnt);
+	zassert_true(!spinlock_is_locked(&contention_lock),
+		     "Spinlock still locked");
+}
+
+/**
+ * @brief Test holding several spinlocks at the same time
+ *
+ * @details Nested locks are taken and released many more times than
+ * the MCS lock has queue nodes per CPU, so a node that is not given
+ * back on unlock is found.
+ *
+ * @ingroup kernel_spinlock_tests
+ *
+ * @see k_spin_lock(), k_spin_unlock()
+ */
+void test_spinlock_nested(void)
+{
+	static struct k_spinlock locks[NESTED_LOCKS];
+	k_spinlock_key_t keys[NESTED_LOCKS];
+	int round, i;
+
+	for (round = 0; round < 64; round++) {
+		for (i = 0; i < NESTED_LOCKS; i++) {
+			keys[i] = k_spin_lock(&locks[i]);
+			zassert_true(spinlock_is_locked(&locks[i]),
+				     "Spinlock %d failed to lock", i);
+		}
+
+		for (i = NESTED_LOCKS - 1; i >= 0; i--) {
+			k_spin_unlock(&locks[i], keys[i]);
+			zassert_true(!spinlock_is_locked(&locks[i]),
+				     "Spinlock %d failed to unlock", i);
+		}
+	}
 }
 
 void bounce_once(int id)
@@ -151,7 +260,8 @@ void test_spinlock_mutual_exclusion(void)
 
 	key = k_spin_lock(&lock_runtime);
 
-	zassert_true(lock_runtime.locked, "Spinlock failed to lock");
+	zassert_true(spinlock_is_locked(&lock_runtime),
+		     "Spinlock failed to lock");
 
 	/* check irq has not locked */
 	zassert_true(arch_irq_unlocked(key.key),
@@ -171,7 +281,8 @@ void test_spinlock_mutual_exclusion(void)
 
 	k_spin_unlock(&lock_runtime, key);
 
-	zassert_true(!lock_runtime.locked, "Spinlock failed to unlock");
+	zassert_true(!spinlock_is_locked(&lock_runtime),
+		     "Spinlock failed to unlock");
 }
 
 
@@ -184,6 +295,8 @@ void test_main(void)
 {
 	ztest_test_suite(spinlock,
 			 ztest_unit_test(test_spinlock_basic),
+			 ztest_unit_test(test_spinlock_contention),
+			 ztest_unit_test(test_spinlock_nested),
 			 ztest_unit_test(test_spinlock_bounce),
 			 ztest_unit_test(test_spinlock_mutual_exclusion),
 			 ztest_unit_test(test_spinlock_no_recursive),
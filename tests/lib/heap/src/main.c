@@ -8,6 +8,7 @@
 #include <sys/sys_heap.h>
 #include <sys/heap_listener.h>
 #include <inttypes.h>
+#include "heap.h"
 
 /* Guess at a value for heap size based on available memory on the
  * platform, with workarounds.
@@ -41,15 +42,6 @@
 #define BIG_HEAP_SZ MIN(256 * 1024, MEMSZ / 3)
 #define SMALL_HEAP_SZ MIN(BIG_HEAP_SZ, 2048)
 
-/* With enabling SYS_HEAP_RUNTIME_STATS, the size of struct z_heap
- * will increase 16 bytes on 64 bit CPU.
- */
-#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
-#define SOLO_FREE_HEADER_HEAP_SZ (80)
-#else
-#define SOLO_FREE_HEADER_HEAP_SZ (64)
-#endif
-
 #define SCRATCH_SZ (sizeof(heapmem) / 2)
 
 /* The test memory.  Make them pointer arrays for robust alignment
@@ -238,6 +230,28 @@ static void test_big_heap(void)
 	log_result(BIG_HEAP_SZ, &result);
 }
 
+/* Size of the heap below, which struct z_heap and its buckets make 64
+ * bytes or more depending on the configuration.  The number of buckets
+ * depends on the heap size, so grow it until they fit.
+ */
+static size_t solo_free_header_heap_sz(void)
+{
+	struct z_heap h;
+	chunksz_t heap_sz, chunk0_sz = chunksz(sizeof(struct z_heap));
+
+	do {
+		/* allocation header and memory, solo free header */
+		heap_sz = chunk0_sz + 3U;
+		h.end_chunk = heap_sz;
+		chunk0_sz = chunksz(sizeof(struct z_heap) +
+				    (bucket_idx(&h, heap_sz) + 1) *
+				    sizeof(struct z_heap_bucket));
+	} while (chunk0_sz + 3U != heap_sz);
+
+	/* plus the end marker */
+	return heap_sz * CHUNK_UNIT + heap_footer_bytes(heap_sz * CHUNK_UNIT);
+}
+
 /* Test a heap with a solo free header.  A solo free header can exist
  * only on a heap with 64 bit CPU (or chunk_header_bytes() == 8).
  * With 64 bytes heap and 1 byte allocation on a big heap, we get:
@@ -259,7 +273,7 @@ static void test_solo_free_header(void)
 
 	TC_PRINT("Testing solo free header in a heap\n");
 
-	sys_heap_init(&heap, heapmem, SOLO_FREE_HEADER_HEAP_SZ);
+	sys_heap_init(&heap, heapmem, solo_free_header_heap_sz());
 	if (sizeof(void *) > 4U) {
 		sys_heap_alloc(&heap, 1);
 		zassert_true(sys_heap_validate(&heap), "");
@@ -485,6 +499,87 @@ static void test_heap_listeners(void)
 #endif /* CONFIG_SYS_HEAP_LISTENER */
 }
 
+/* Small blocks freed into the size class caches are handed out again
+ * from there, until the caches are bypassed or flushed back into the
+ * heap.
+ */
+static void test_slab(void)
+{
+#ifdef CONFIG_SYS_HEAP_SLAB
+	struct sys_heap heap;
+	void *p[CONFIG_SYS_HEAP_SLAB_DEPTH + 1];
+	void *big;
+	size_t big_sz;
+	int i;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	/* Largest block an empty heap can hand out */
+	for (big_sz = SMALL_HEAP_SZ; big_sz > 0; big_sz -= 8) {
+		big = sys_heap_alloc(&heap, big_sz);
+		if (big != NULL) {
+			sys_heap_free(&heap, big);
+			break;
+		}
+	}
+	zassert_true(big_sz > 0, "empty heap allocation failed");
+
+	for (i = 0; i < ARRAY_SIZE(p); i++) {
+		p[i] = sys_heap_alloc(&heap, 24);
+		zassert_not_null(p[i], "allocation failed");
+	}
+
+	/* sys_heap_free() never caches */
+	sys_heap_free(&heap, p[0]);
+	zassert_is_null(sys_heap_slab_alloc(&heap, 0, 24),
+			"sys_heap_free() cached the block");
+	p[0] = sys_heap_alloc(&heap, 24);
+	zassert_not_null(p[0], "allocation failed");
+
+	for (i = 0; i < CONFIG_SYS_HEAP_SLAB_DEPTH; i++) {
+		zassert_true(sys_heap_slab_free(&heap, p[i]),
+			     "block not cached");
+	}
+	zassert_false(sys_heap_slab_free(&heap, p[i]),
+		      "block cached in a full class");
+	sys_heap_free(&heap, p[i]);
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+	/* LIFO order, the last cached block comes first */
+	zassert_equal(sys_heap_slab_alloc(&heap, 0, 24),
+		      p[CONFIG_SYS_HEAP_SLAB_DEPTH - 1], "not from the cache");
+	zassert_is_null(sys_heap_slab_alloc(&heap, 0, 200),
+			"uncached size allocated from the cache");
+	zassert_is_null(sys_heap_slab_alloc(&heap, 64, 24),
+			"aligned allocation from the cache");
+
+	/* Bypassed caches refuse blocks */
+	sys_heap_slab_bypass(&heap, true);
+	zassert_false(sys_heap_slab_free(&heap,
+					 p[CONFIG_SYS_HEAP_SLAB_DEPTH - 1]),
+		      "block cached while bypassed");
+	sys_heap_slab_bypass(&heap, false);
+	zassert_true(sys_heap_slab_free(&heap,
+					p[CONFIG_SYS_HEAP_SLAB_DEPTH - 1]),
+		     "block not cached");
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+	/* The cached blocks are only available after a flush */
+	zassert_is_null(sys_heap_alloc(&heap, big_sz),
+			"cached blocks merged into the heap");
+	zassert_true(sys_heap_slab_flush(&heap), "nothing flushed");
+	zassert_false(sys_heap_slab_flush(&heap), "flushed twice");
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+	big = sys_heap_alloc(&heap, big_sz);
+	zassert_not_null(big, "caches not flushed");
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+	sys_heap_free(&heap, big);
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(lib_heap_test,
@@ -493,7 +588,8 @@ void test_main(void)
 			 ztest_unit_test(test_fragmentation),
 			 ztest_unit_test(test_big_heap),
 			 ztest_unit_test(test_solo_free_header),
-			 ztest_unit_test(test_heap_listeners)
+			 ztest_unit_test(test_heap_listeners),
+			 ztest_unit_test(test_slab)
 			 );
 
 	ztest_run_test_suite(lib_heap_test);
@@ -0,0 +1,536 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <sys/spsc_ring.h>
+#include <sys/mpmc_ring.h>
+
+#define RING_LEN 4
+#define LAPS 5
+
+#define NUM_PRODUCERS 3
+#define NUM_CONSUMERS 3
+#define ELEMS_PER_PRODUCER 2000
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+struct elem {
+	uint32_t id;
+	uint32_t seq;
+};
+
+SYS_SPSC_RING_DEFINE(spsc, sizeof(struct elem), RING_LEN);
+SYS_MPMC_RING_DEFINE(mpmc, sizeof(struct elem), RING_LEN);
+
+/* Lets the same checks run on both rings */
+struct ring_ops {
+	int (*put)(void *ring, const struct elem *e);
+	int (*get)(void *ring, struct elem *e);
+	int (*get_wait)(void *ring, struct elem *e, k_timeout_t timeout);
+	void (*poll_prepare)(void *ring, struct k_poll_event *event);
+	void (*poll_finish)(void *ring);
+};
+
+static int spsc_put(void *ring, const struct elem *e)
+{
+	return sys_spsc_ring_put(ring, e);
+}
+
+static int spsc_get(void *ring, struct elem *e)
+{
+	return sys_spsc_ring_get(ring, e);
+}
+
+static int spsc_get_wait(void *ring, struct elem *e, k_timeout_t timeout)
+{
+	return sys_spsc_ring_get_wait(ring, e, timeout);
+}
+
+static void spsc_poll_prepare(void *ring, struct k_poll_event *event)
+{
+	sys_spsc_ring_poll_prepare(ring, event);
+}
+
+static void spsc_poll_finish(void *ring)
+{
+	sys_spsc_ring_poll_finish(ring);
+}
+
+static int mpmc_put(void *ring, const struct elem *e)
+{
+	return sys_mpmc_ring_put(ring, e);
+}
+
+static int mpmc_get(void *ring, struct elem *e)
+{
+	return sys_mpmc_ring_get(ring, e);
+}
+
+static int mpmc_get_wait(void *ring, struct elem *e, k_timeout_t timeout)
+{
+	return sys_mpmc_ring_get_wait(ring, e, timeout);
+}
+
+static void mpmc_poll_prepare(void *ring, struct k_poll_event *event)
+{
+	sys_mpmc_ring_poll_prepare(ring, event);
+}
+
+static void mpmc_poll_finish(void *ring)
+{
+	sys_mpmc_ring_poll_finish(ring);
+}
+
+static const struct ring_ops spsc_ops = {
+	.put = spsc_put,
+	.get = spsc_get,
+	.get_wait = spsc_get_wait,
+	.poll_prepare = spsc_poll_prepare,
+	.poll_finish = spsc_poll_finish,
+};
+
+static const struct ring_ops mpmc_ops = {
+	.put = mpmc_put,
+	.get = mpmc_get,
+	.get_wait = mpmc_get_wait,
+	.poll_prepare = mpmc_poll_prepare,
+	.poll_finish = mpmc_poll_finish,
+};
+
+/* Put and get through an empty ring of len elements, starting at every
+ * offset into the buffer, then keep it nearly full while the indexes go
+ * around it. The ring is empty again at the end.
+ */
+static void check_fifo(const struct ring_ops *ops, void *ring, uint32_t len)
+{
+	struct elem e = { 0 };
+	uint32_t put_seq = 0U;
+	uint32_t get_seq = 0U;
+	uint32_t round, i, n;
+
+	for (round = 0U; round < LAPS * len; round++) {
+		n = (round % len) + 1U;
+
+		for (i = 0U; i < n; i++) {
+			e.seq = put_seq++;
+			zassert_equal(ops->put(ring, &e), 0,
+				      "put %u failed", e.seq);
+		}
+
+		if (n == len) {
+			zassert_equal(ops->put(ring, &e), -EAGAIN,
+				      "put into a full ring");
+		}
+
+		for (i = 0U; i < n; i++) {
+			zassert_equal(ops->get(ring, &e), 0, "get failed");
+			zassert_equal(e.seq, get_seq++, "element out of order");
+		}
+
+		zassert_equal(ops->get(ring, &e), -EAGAIN,
+			      "get from an empty ring");
+	}
+
+	for (i = 0U; i < len - 1U; i++) {
+		e.seq = put_seq++;
+		zassert_equal(ops->put(ring, &e), 0, "put %u failed", e.seq);
+	}
+
+	for (round = 0U; round < LAPS * len; round++) {
+		e.seq = put_seq++;
+		zassert_equal(ops->put(ring, &e), 0, "put %u failed", e.seq);
+		zassert_equal(ops->get(ring, &e), 0, "get failed");
+		zassert_equal(e.seq, get_seq++, "element out of order");
+	}
+
+	while (get_seq != put_seq) {
+		zassert_equal(ops->get(ring, &e), 0, "element lost");
+		zassert_equal(e.seq, get_seq++, "element out of order");
+	}
+
+	zassert_equal(ops->get(ring, &e), -EAGAIN, "get from an empty ring");
+}
+
+/**
+ * @brief Test that elements come out of a SPSC ring in order while the
+ * indexes go around the buffer and wrap at 2^32
+ */
+void test_spsc_wraparound(void)
+{
+	uint32_t idx = (uint32_t)-(RING_LEN * 2 + 1);
+
+	check_fifo(&spsc_ops, &spsc, RING_LEN);
+
+	/* The free running indexes wrap while the ring is used */
+	atomic_set(&spsc.head, (atomic_val_t)idx);
+	atomic_set(&spsc.tail, (atomic_val_t)idx);
+	spsc.tail_cache = idx;
+	spsc.head_cache = idx;
+
+	check_fifo(&spsc_ops, &spsc, RING_LEN);
+}
+
+/**
+ * @brief Test a SPSC ring of a single element
+ */
+void test_spsc_one_elem(void)
+{
+	static struct elem buf[1];
+	static struct sys_spsc_ring ring;
+
+	sys_spsc_ring_init(&ring, buf, sizeof(struct elem), 1);
+	check_fifo(&spsc_ops, &ring, 1);
+}
+
+/**
+ * @brief Test that claimed elements are only handed over by the finish
+ * calls
+ */
+void test_spsc_claim_finish(void)
+{
+	struct elem *claimed[RING_LEN];
+	struct elem *e;
+	int i;
+
+	e = sys_spsc_ring_put_claim(&spsc);
+	zassert_not_null(e, "can't claim in an empty ring");
+	e->seq = 0U;
+
+	/* Claiming again returns the same element */
+	zassert_equal_ptr(sys_spsc_ring_put_claim(&spsc), e,
+			  "claim moved on without finish");
+	zassert_is_null(sys_spsc_ring_get_claim(&spsc),
+			"element visible before put finish");
+
+	sys_spsc_ring_put_finish(&spsc);
+
+	zassert_equal_ptr(sys_spsc_ring_get_claim(&spsc), e,
+			  "element not read in place");
+	zassert_equal_ptr(sys_spsc_ring_get_claim(&spsc), e,
+			  "claim moved on without finish");
+	zassert_equal(e->seq, 0U, "element changed");
+	sys_spsc_ring_get_finish(&spsc);
+	zassert_is_null(sys_spsc_ring_get_claim(&spsc),
+			"element still there after get finish");
+
+	for (i = 0; i < RING_LEN; i++) {
+		claimed[i] = sys_spsc_ring_put_claim(&spsc);
+		zassert_not_null(claimed[i], "can't claim element %d", i);
+		claimed[i]->seq = i + 1;
+		sys_spsc_ring_put_finish(&spsc);
+	}
+
+	zassert_is_null(sys_spsc_ring_put_claim(&spsc), "claim in a full ring");
+
+	/* An element being read is not free yet */
+	e = sys_spsc_ring_get_claim(&spsc);
+	zassert_equal_ptr(e, claimed[0], "wrong element");
+	zassert_is_null(sys_spsc_ring_put_claim(&spsc),
+			"element free before get finish");
+	sys_spsc_ring_get_finish(&spsc);
+	zassert_equal_ptr(sys_spsc_ring_put_claim(&spsc), claimed[0],
+			  "element not free after get finish");
+
+	for (i = 1; i < RING_LEN; i++) {
+		e = sys_spsc_ring_get_claim(&spsc);
+		zassert_equal_ptr(e, claimed[i], "wrong element");
+		zassert_equal(e->seq, i + 1, "element out of order");
+		sys_spsc_ring_get_finish(&spsc);
+	}
+
+	zassert_is_null(sys_spsc_ring_get_claim(&spsc),
+			"claim in an empty ring");
+}
+
+/**
+ * @brief Test that elements come out of a MPMC ring in order while the
+ * indexes go around the buffer and wrap at 2^32
+ */
+void test_mpmc_wraparound(void)
+{
+	static atomic_t buf[SYS_MPMC_RING_BUF_SIZE(sizeof(struct elem),
+						   RING_LEN)];
+	size_t slot_words = SYS_MPMC_RING_BUF_SIZE(sizeof(struct elem), 1);
+	uint32_t idx = (uint32_t)-(RING_LEN * 2);
+	static struct sys_mpmc_ring ring;
+	int i;
+
+	check_fifo(&mpmc_ops, &mpmc, RING_LEN);
+
+	/* An empty ring at idx, every element free for the lap starting
+	 * at idx
+	 */
+	sys_mpmc_ring_init(&ring, buf, sizeof(struct elem), RING_LEN);
+	atomic_set(&ring.head, (atomic_val_t)idx);
+	atomic_set(&ring.tail, (atomic_val_t)idx);
+	for (i = 0; i < RING_LEN; i++) {
+		atomic_set(&buf[i * slot_words], (atomic_val_t)idx);
+	}
+
+	check_fifo(&mpmc_ops, &ring, RING_LEN);
+}
+
+/**
+ * @brief Test that a full element of the smallest MPMC ring is not
+ * overwritten
+ */
+void test_mpmc_two_elems(void)
+{
+	static atomic_t buf[SYS_MPMC_RING_BUF_SIZE(sizeof(struct elem), 2)];
+	static struct sys_mpmc_ring ring;
+	struct elem e = { 0 };
+
+	sys_mpmc_ring_init(&ring, buf, sizeof(struct elem), 2);
+
+	e.seq = 1U;
+	zassert_equal(sys_mpmc_ring_put(&ring, &e), 0, "put failed");
+	e.seq = 2U;
+	zassert_equal(sys_mpmc_ring_put(&ring, &e), 0, "put failed");
+	e.seq = 3U;
+	zassert_equal(sys_mpmc_ring_put(&ring, &e), -EAGAIN,
+		      "put into a full ring");
+
+	zassert_equal(sys_mpmc_ring_get(&ring, &e), 0, "get failed");
+	zassert_equal(e.seq, 1U, "element overwritten");
+	zassert_equal(sys_mpmc_ring_get(&ring, &e), 0, "get failed");
+	zassert_equal(e.seq, 2U, "element overwritten");
+
+	check_fifo(&mpmc_ops, &ring, 2);
+}
+
+struct delayed_put {
+	struct k_work_delayable work;
+	const struct ring_ops *ops;
+	void *ring;
+	struct elem e;
+};
+
+static void delayed_put_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct delayed_put *put = CONTAINER_OF(dwork, struct delayed_put,
+					       work);
+
+	(void)put->ops->put(put->ring, &put->e);
+}
+
+static void delayed_put(struct delayed_put *put, const struct ring_ops *ops,
+			void *ring, uint32_t seq)
+{
+	put->ops = ops;
+	put->ring = ring;
+	put->e.seq = seq;
+	k_work_init_delayable(&put->work, delayed_put_handler);
+	k_work_schedule(&put->work, K_MSEC(10));
+}
+
+/* The put is on the stack of the test, wait until the work is done */
+static void delayed_put_sync(struct delayed_put *put)
+{
+	struct k_work_sync sync;
+
+	(void)k_work_flush_delayable(&put->work, &sync);
+}
+
+static void check_get_wait(const struct ring_ops *ops, void *ring)
+{
+	struct delayed_put put;
+	struct elem e;
+
+	zassert_equal(ops->get_wait(ring, &e, K_NO_WAIT), -EAGAIN,
+		      "got an element from an empty ring");
+	zassert_equal(ops->get_wait(ring, &e, K_MSEC(10)), -EAGAIN,
+		      "got an element from an empty ring");
+
+	e.seq = 1U;
+	zassert_equal(ops->put(ring, &e), 0, "put failed");
+	zassert_equal(ops->get_wait(ring, &e, K_NO_WAIT), 0,
+		      "element not found");
+	zassert_equal(e.seq, 1U, "wrong element");
+
+	/* The consumer is woken up by the put */
+	delayed_put(&put, ops, ring, 2U);
+	zassert_equal(ops->get_wait(ring, &e, K_SECONDS(1)), 0,
+		      "not woken up by put");
+	delayed_put_sync(&put);
+	zassert_equal(e.seq, 2U, "wrong element");
+	zassert_equal(ops->get(ring, &e), -EAGAIN, "ring not empty");
+}
+
+static void check_poll(const struct ring_ops *ops, void *ring,
+		       struct k_sem *sem)
+{
+	struct k_poll_event event;
+	struct delayed_put put;
+	struct elem e;
+
+	/* Not ready while the ring is empty */
+	ops->poll_prepare(ring, &event);
+	zassert_equal(k_poll(&event, 1, K_NO_WAIT), -EAGAIN,
+		      "poll ready on an empty ring");
+	ops->poll_finish(ring);
+
+	/* Ready right away when the ring has elements */
+	e.seq = 1U;
+	zassert_equal(ops->put(ring, &e), 0, "put failed");
+	ops->poll_prepare(ring, &event);
+	zassert_equal(k_poll(&event, 1, K_NO_WAIT), 0,
+		      "poll not ready with an element");
+	ops->poll_finish(ring);
+	zassert_equal(ops->get(ring, &e), 0, "element not found");
+	zassert_equal(e.seq, 1U, "wrong element");
+
+	/* Signalled by a put while waiting */
+	delayed_put(&put, ops, ring, 2U);
+	ops->poll_prepare(ring, &event);
+	zassert_equal(k_poll(&event, 1, K_SECONDS(1)), 0,
+		      "poll not signalled by put");
+	ops->poll_finish(ring);
+	delayed_put_sync(&put);
+	zassert_equal(ops->get(ring, &e), 0, "element not found");
+	zassert_equal(e.seq, 2U, "wrong element");
+
+	/* Nobody waits anymore, so a put does not signal */
+	zassert_equal(ops->put(ring, &e), 0, "put failed");
+	zassert_equal(k_sem_count_get(sem), 0U, "put signalled nobody");
+	zassert_equal(ops->get(ring, &e), 0, "element not found");
+}
+
+/**
+ * @brief Test waiting for a SPSC ring with get_wait and k_poll()
+ */
+void test_spsc_wait(void)
+{
+	check_get_wait(&spsc_ops, &spsc);
+	check_poll(&spsc_ops, &spsc, &spsc.sem);
+}
+
+/**
+ * @brief Test waiting for a MPMC ring with get_wait and k_poll()
+ */
+void test_mpmc_wait(void)
+{
+	check_get_wait(&mpmc_ops, &mpmc);
+	check_poll(&mpmc_ops, &mpmc, &mpmc.sem);
+}
+
+static struct k_thread producer_threads[NUM_PRODUCERS];
+static struct k_thread consumer_threads[NUM_CONSUMERS];
+static K_THREAD_STACK_ARRAY_DEFINE(producer_stacks, NUM_PRODUCERS,
+				   STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(consumer_stacks, NUM_CONSUMERS,
+				   STACK_SIZE);
+
+static atomic_t received;
+static atomic_t received_cnt[NUM_PRODUCERS];
+static atomic_t received_sum[NUM_PRODUCERS];
+static atomic_t errors;
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	struct elem e = { .id = POINTER_TO_UINT(p1) };
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (e.seq = 0U; e.seq < ELEMS_PER_PRODUCER; e.seq++) {
+		while (sys_mpmc_ring_put(&mpmc, &e) != 0) {
+			k_yield();
+		}
+	}
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	uint32_t next[NUM_PRODUCERS] = { 0 };
+	struct elem e;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (atomic_get(&received) < NUM_PRODUCERS * ELEMS_PER_PRODUCER) {
+		if (sys_mpmc_ring_get_wait(&mpmc, &e, K_MSEC(10)) != 0) {
+			continue;
+		}
+
+		/* Elements of one producer are claimed in order, so every
+		 * consumer sees them in order
+		 */
+		if (e.id >= NUM_PRODUCERS || e.seq < next[e.id]) {
+			atomic_inc(&errors);
+			continue;
+		}
+
+		next[e.id] = e.seq + 1U;
+		atomic_inc(&received_cnt[e.id]);
+		atomic_add(&received_sum[e.id], e.seq);
+		atomic_inc(&received);
+	}
+}
+
+/**
+ * @brief Test that several producers and consumers move every element
+ * through a MPMC ring exactly once
+ */
+void test_mpmc_concurrent(void)
+{
+	struct elem e;
+	int i;
+
+	atomic_set(&received, 0);
+	atomic_set(&errors, 0);
+
+	for (i = 0; i < NUM_CONSUMERS; i++) {
+		k_thread_create(&consumer_threads[i], consumer_stacks[i],
+				STACK_SIZE, consumer, NULL, NULL, NULL,
+				K_PRIO_PREEMPT(5), 0, K_NO_WAIT);
+	}
+
+	for (i = 0; i < NUM_PRODUCERS; i++) {
+		atomic_set(&received_cnt[i], 0);
+		atomic_set(&received_sum[i], 0);
+		k_thread_create(&producer_threads[i], producer_stacks[i],
+				STACK_SIZE, producer, UINT_TO_POINTER(i), NULL,
+				NULL, K_PRIO_PREEMPT(5), 0, K_NO_WAIT);
+	}
+
+	for (i = 0; i < NUM_PRODUCERS; i++) {
+		k_thread_join(&producer_threads[i], K_FOREVER);
+	}
+
+	for (i = 0; i < NUM_CONSUMERS; i++) {
+		k_thread_join(&consumer_threads[i], K_FOREVER);
+	}
+
+	zassert_equal(atomic_get(&errors), 0, "elements out of order");
+
+	for (i = 0; i < NUM_PRODUCERS; i++) {
+		zassert_equal(atomic_get(&received_cnt[i]), ELEMS_PER_PRODUCER,
+			      "elements of producer %d lost or duplicated", i);
+		zassert_equal(atomic_get(&received_sum[i]),
+			      ELEMS_PER_PRODUCER * (ELEMS_PER_PRODUCER - 1) / 2,
+			      "elements of producer %d corrupted", i);
+	}
+
+	zassert_equal(sys_mpmc_ring_get(&mpmc, &e), -EAGAIN,
+		      "ring not empty");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(lockfree_ring,
+			 ztest_unit_test(test_spsc_wraparound),
+			 ztest_unit_test(test_spsc_one_elem),
+			 ztest_unit_test(test_spsc_claim_finish),
+			 ztest_unit_test(test_spsc_wait),
+			 ztest_unit_test(test_mpmc_wraparound),
+			 ztest_unit_test(test_mpmc_two_elems),
+			 ztest_unit_test(test_mpmc_wait),
+			 ztest_unit_test(test_mpmc_concurrent)
+			 );
+
+	ztest_run_test_suite(lockfree_ring);
+}
@@ -135,6 +135,8 @@ static uint32_t dad_time[3];
 static bool test_failed;
 static struct k_sem wait_data;
 static bool recv_cb_called;
+static struct k_sem sent_data;
+static uint8_t sent_lladdr[sizeof(struct net_eth_addr)];
 
 #define WAIT_TIME 250
 #define WAIT_TIME_LONG MSEC_PER_SEC
@@ -243,6 +245,10 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 		return -ENODATA;
 	}
 
+	/* Remember where the packet went for the neighbor cache tests */
+	memcpy(sent_lladdr, net_pkt_lladdr_dst(pkt)->addr, sizeof(sent_lladdr));
+	k_sem_give(&sent_data);
+
 	icmp = get_icmp_hdr(pkt);
 
 	/* Reply with RA messge */
@@ -372,6 +378,7 @@ static void test_init(void)
 
 	/* The semaphore is there to wait the data to be received. */
 	k_sem_init(&wait_data, 0, UINT_MAX);
+	k_sem_init(&sent_data, 0, UINT_MAX);
 
 }
 
@@ -1505,6 +1512,210 @@ static void test_dst_is_other_iface_mcast_recv(void)
 	net_context_put(ctx);
 }
 
+static void nbr_rm_cb(struct net_nbr *nbr, void *user_data)
+{
+	struct in6_addr addr;
+
+	ARG_UNUSED(user_data);
+
+	/* The address goes away with the entry */
+	net_ipaddr_copy(&addr, &net_ipv6_nbr_data(nbr)->addr);
+	net_ipv6_nbr_rm(nbr->iface, &addr);
+}
+
+/* Neighbor id is 2001:db8::1xx with link layer address 00:00:5e:00:53:yy */
+static void nbr_addr(uint8_t id, struct in6_addr *addr)
+{
+	net_ipv6_addr_create(addr, 0x2001, 0x0db8, 0, 0, 0, 0, 0, 0x0100 | id);
+}
+
+static struct net_nbr *nbr_add(uint8_t id, uint8_t ll_id, bool is_router,
+			       enum net_ipv6_nbr_state state)
+{
+	uint8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, ll_id };
+	struct net_linkaddr lladdr = {
+		.addr = mac,
+		.len = sizeof(mac),
+		.type = NET_LINK_ETHERNET,
+	};
+	struct in6_addr addr;
+	struct net_nbr *nbr;
+
+	nbr_addr(id, &addr);
+
+	nbr = net_ipv6_nbr_add(TEST_NET_IF, &addr, &lladdr, is_router, state);
+	zassert_not_null(nbr, "Cannot add neighbor %d", id);
+
+	return nbr;
+}
+
+static bool nbr_exists(uint8_t id)
+{
+	struct in6_addr addr;
+
+	nbr_addr(id, &addr);
+
+	return net_ipv6_nbr_lookup(TEST_NET_IF, &addr) != NULL;
+}
+
+/**
+ * @brief IPv6 neighbor table full, least recently used neighbor evicted
+ */
+static void test_nbr_lru_eviction(void)
+{
+	uint32_t now = k_uptime_get_32();
+	struct net_nbr *nbr;
+	uint8_t i;
+
+	net_ipv6_nbr_foreach(nbr_rm_cb, NULL);
+
+	/* Neighbor 0 is the least recently used one, but a router */
+	for (i = 0U; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
+		nbr = nbr_add(i, i, i == 0U, NET_IPV6_NBR_STATE_REACHABLE);
+		net_ipv6_nbr_data(nbr)->last_used =
+			now - (CONFIG_NET_IPV6_MAX_NEIGHBORS - i) * 10U;
+	}
+
+	/* Reachable neighbors are evicted too when none is stale */
+	nbr_add(CONFIG_NET_IPV6_MAX_NEIGHBORS, CONFIG_NET_IPV6_MAX_NEIGHBORS,
+		false, NET_IPV6_NBR_STATE_REACHABLE);
+
+	zassert_true(nbr_exists(0), "Router evicted");
+	zassert_false(nbr_exists(1), "Least recently used neighbor kept");
+
+	for (i = 2U; i <= CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
+		zassert_true(nbr_exists(i), "Neighbor %d evicted", i);
+	}
+
+	/* A new link layer address makes the most recently used neighbor
+	 * stale, and a stale neighbor goes before older reachable ones.
+	 */
+	i = CONFIG_NET_IPV6_MAX_NEIGHBORS;
+	nbr = nbr_add(i, 0xff, false, NET_IPV6_NBR_STATE_REACHABLE);
+	zassert_equal(net_ipv6_nbr_data(nbr)->state, NET_IPV6_NBR_STATE_STALE,
+		      "Neighbor %d not stale", i);
+
+	nbr_add(i + 1, i + 1, false, NET_IPV6_NBR_STATE_REACHABLE);
+
+	zassert_false(nbr_exists(i), "Stale neighbor kept");
+	zassert_true(nbr_exists(2), "Reachable neighbor evicted");
+
+	net_ipv6_nbr_foreach(nbr_rm_cb, NULL);
+}
+
+static void nbr_ctx_connect(struct net_context **ctx, struct in6_addr *dst)
+{
+	struct sockaddr_in6 addr = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(PEER_PORT),
+	};
+	int ret;
+
+	net_ipaddr_copy(&addr.sin6_addr, dst);
+
+	net_ctx_create(ctx);
+
+	ret = net_context_connect(*ctx, (struct sockaddr *)&addr, sizeof(addr),
+				  NULL, K_NO_WAIT, NULL);
+	zassert_equal(ret, 0, "Cannot connect (%d)", ret);
+}
+
+/* Send from a connected context and check whether the packet went to
+ * the given link layer address.
+ */
+static void nbr_ctx_send(struct net_context *ctx, const uint8_t *lladdr,
+			 bool expected)
+{
+	static const char payload[] = "foobar";
+	int ret;
+
+	k_sem_reset(&sent_data);
+
+	ret = net_context_send(ctx, payload, sizeof(payload), NULL, K_NO_WAIT,
+			       NULL);
+	zassert_true(ret >= 0, "Cannot send (%d)", ret);
+
+	zassert_equal(k_sem_take(&sent_data, K_MSEC(WAIT_TIME)), 0,
+		      "Nothing sent");
+
+	if (expected) {
+		zassert_mem_equal(sent_lladdr, lladdr, sizeof(sent_lladdr),
+				  "Sent to the wrong neighbor");
+	} else {
+		zassert_true(memcmp(sent_lladdr, lladdr, sizeof(sent_lladdr)),
+			     "Sent to a removed neighbor");
+	}
+}
+
+/**
+ * @brief IPv6 connected context stops using a removed route or neighbor
+ */
+static void test_nbr_dst_cache_flush(void)
+{
+	struct in6_addr prefix = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0 } } };
+	struct in6_addr routed = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x01, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0x05 } } };
+	struct net_if_ipv6_prefix *ifprefix;
+	struct net_route_entry *route;
+	struct net_context *ctx;
+	struct net_nbr *nbr;
+	uint8_t lladdr[sizeof(struct net_eth_addr)];
+	struct in6_addr dst;
+
+	net_ipv6_nbr_foreach(nbr_rm_cb, NULL);
+
+	/* A destination behind a router */
+	nbr = nbr_add(1, 1, true, NET_IPV6_NBR_STATE_REACHABLE);
+	memcpy(lladdr, net_nbr_get_lladdr(nbr->idx)->addr, sizeof(lladdr));
+
+	route = net_route_add(TEST_NET_IF, &routed, 128,
+			      &net_ipv6_nbr_data(nbr)->addr,
+			      NET_IPV6_ND_INFINITE_LIFETIME,
+			      NET_ROUTE_PREFERENCE_MEDIUM);
+	zassert_not_null(route, "Cannot add route");
+
+	nbr_ctx_connect(&ctx, &routed);
+	nbr_ctx_send(ctx, lladdr, true);
+	nbr_ctx_send(ctx, lladdr, true);
+
+#if defined(CONFIG_NET_IPV6_NBR_DST_CACHE)
+	zassert_equal_ptr(ctx->ipv6_nbr_cache.nbr, nbr, "Router not cached");
+#endif
+
+	zassert_equal(net_route_del(route), 0, "Cannot delete route");
+	nbr_ctx_send(ctx, lladdr, false);
+
+	net_context_put(ctx);
+	net_ipv6_nbr_foreach(nbr_rm_cb, NULL);
+
+	/* A destination on the link */
+	ifprefix = net_if_ipv6_prefix_add(TEST_NET_IF, &prefix, 64,
+					  NET_IPV6_ND_INFINITE_LIFETIME);
+	zassert_not_null(ifprefix, "Cannot add prefix");
+
+	nbr = nbr_add(5, 5, false, NET_IPV6_NBR_STATE_REACHABLE);
+	memcpy(lladdr, net_nbr_get_lladdr(nbr->idx)->addr, sizeof(lladdr));
+	nbr_addr(5, &dst);
+
+	nbr_ctx_connect(&ctx, &dst);
+	nbr_ctx_send(ctx, lladdr, true);
+	nbr_ctx_send(ctx, lladdr, true);
+
+#if defined(CONFIG_NET_IPV6_NBR_DST_CACHE)
+	zassert_equal_ptr(ctx->ipv6_nbr_cache.nbr, nbr, "Neighbor not cached");
+#endif
+
+	/* A neighbor solicitation is sent instead */
+	zassert_true(net_ipv6_nbr_rm(TEST_NET_IF, &dst),
+		     "Cannot remove neighbor");
+	nbr_ctx_send(ctx, lladdr, false);
+
+	net_context_put(ctx);
+	net_ipv6_nbr_foreach(nbr_rm_cb, NULL);
+	net_if_ipv6_prefix_rm(TEST_NET_IF, &prefix, 64);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_ipv6_fn,
@@ -1537,7 +1748,9 @@ void test_main(void)
 			 ztest_unit_test(test_dst_org_scope_mcast_recv),
 			 ztest_unit_test(test_dst_unknown_group_mcast_recv),
 			 ztest_unit_test(test_dst_unjoined_group_mcast_recv),
-			 ztest_unit_test(test_dst_is_other_iface_mcast_recv)
+			 ztest_unit_test(test_dst_is_other_iface_mcast_recv),
+			 ztest_unit_test(test_nbr_lru_eviction),
+			 ztest_unit_test(test_nbr_dst_cache_flush)
 			 );
 	ztest_run_test_suite(test_ipv6_fn);
 }
@@ -0,0 +1,330 @@
+/* main.c - Application main entry point */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/types.h>
+#include <ztest.h>
+#include <stdbool.h>
+#include <errno.h>
+
+#include <net/net_ip.h>
+
+#include "lpm.h"
+
+#define MAX_PREFIXES 4
+
+#define ADDR4(a, b, c, d) ((const uint8_t[]){ (a), (b), (c), (d) })
+
+struct test_route {
+	struct net_lpm_entry lpm;
+	int iface;
+};
+
+NET_LPM_DEFINE(lpm4, MAX_PREFIXES, 32);
+NET_LPM_DEFINE(lpm6, MAX_PREFIXES, 128);
+
+/* Only room for a single prefix */
+NET_LPM_DEFINE(lpm_small, 1, 32);
+
+static struct test_route routes[MAX_PREFIXES];
+
+static int nodes_in_use(struct net_lpm *lpm)
+{
+	int i, count = 0;
+
+	for (i = 0; i < lpm->node_count; i++) {
+		if (lpm->nodes[i].in_use) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+static void check_empty(struct net_lpm *lpm)
+{
+	zassert_is_null(atomic_ptr_get(&lpm->root), "Table not empty");
+	zassert_equal(nodes_in_use(lpm), 0, "%d nodes leaked",
+		      nodes_in_use(lpm));
+}
+
+static bool match_iface(struct net_lpm_entry *entry, void *user_data)
+{
+	struct test_route *route = CONTAINER_OF(entry, struct test_route, lpm);
+
+	return route->iface == POINTER_TO_INT(user_data);
+}
+
+static struct test_route *lookup(struct net_lpm *lpm, const uint8_t *key,
+				 net_lpm_match_cb_t cb, void *user_data)
+{
+	struct net_lpm_entry *entry;
+	int idx;
+
+	idx = net_lpm_read_lock(lpm);
+	entry = net_lpm_lookup(lpm, key, cb, user_data);
+	net_lpm_read_unlock(lpm, idx);
+
+	return entry ? CONTAINER_OF(entry, struct test_route, lpm) : NULL;
+}
+
+static void test_insert_remove(void)
+{
+	struct in6_addr net, subnet, host, key;
+	int ret;
+
+	net_ipv6_addr_create(&net, 0x2001, 0x0db8, 0, 0, 0, 0, 0, 0);
+	net_ipv6_addr_create(&subnet, 0x2001, 0x0db8, 1, 0, 0, 0, 0, 0);
+	net_ipv6_addr_create(&host, 0x2001, 0x0db8, 1, 0, 0, 0, 0, 1);
+
+	ret = net_lpm_insert(&lpm6, net.s6_addr, 32, &routes[0].lpm);
+	zassert_equal(ret, 0, "Cannot insert /32 (%d)", ret);
+
+	ret = net_lpm_insert(&lpm6, host.s6_addr, 128, &routes[2].lpm);
+	zassert_equal(ret, 0, "Cannot insert /128 (%d)", ret);
+
+	/* Lands between the two others */
+	ret = net_lpm_insert(&lpm6, subnet.s6_addr, 48, &routes[1].lpm);
+	zassert_equal(ret, 0, "Cannot insert /48 (%d)", ret);
+
+	zassert_equal(nodes_in_use(&lpm6), 3, "%d nodes in use",
+		      nodes_in_use(&lpm6));
+
+	zassert_equal_ptr(lookup(&lpm6, host.s6_addr, NULL, NULL), &routes[2],
+			  "Host route not found");
+
+	net_ipv6_addr_create(&key, 0x2001, 0x0db8, 1, 0, 0, 0, 0, 2);
+	zassert_equal_ptr(lookup(&lpm6, key.s6_addr, NULL, NULL), &routes[1],
+			  "Subnet route not found");
+
+	net_ipv6_addr_create(&key, 0x2001, 0x0db8, 2, 0, 0, 0, 0, 1);
+	zassert_equal_ptr(lookup(&lpm6, key.s6_addr, NULL, NULL), &routes[0],
+			  "Network route not found");
+
+	net_ipv6_addr_create(&key, 0x2001, 0x0db9, 0, 0, 0, 0, 0, 1);
+	zassert_is_null(lookup(&lpm6, key.s6_addr, NULL, NULL),
+			"Unexpected match");
+
+	/* The node of the subnet is not needed as a branch point */
+	ret = net_lpm_remove(&lpm6, subnet.s6_addr, 48, &routes[1].lpm);
+	zassert_equal(ret, 0, "Cannot remove /48 (%d)", ret);
+	zassert_equal(nodes_in_use(&lpm6), 2, "%d nodes in use",
+		      nodes_in_use(&lpm6));
+
+	net_ipv6_addr_create(&key, 0x2001, 0x0db8, 1, 0, 0, 0, 0, 2);
+	zassert_equal_ptr(lookup(&lpm6, key.s6_addr, NULL, NULL), &routes[0],
+			  "Network route not found");
+	zassert_equal_ptr(lookup(&lpm6, host.s6_addr, NULL, NULL), &routes[2],
+			  "Host route not found");
+
+	ret = net_lpm_remove(&lpm6, host.s6_addr, 128, &routes[2].lpm);
+	zassert_equal(ret, 0, "Cannot remove /128 (%d)", ret);
+
+	ret = net_lpm_remove(&lpm6, net.s6_addr, 32, &routes[0].lpm);
+	zassert_equal(ret, 0, "Cannot remove /32 (%d)", ret);
+
+	check_empty(&lpm6);
+}
+
+static void test_branch_collapse(void)
+{
+	int ret;
+
+	/* Two siblings need a branch node without values */
+	ret = net_lpm_insert(&lpm4, ADDR4(10, 1, 0, 0), 16, &routes[0].lpm);
+	zassert_equal(ret, 0, "Cannot insert (%d)", ret);
+
+	ret = net_lpm_insert(&lpm4, ADDR4(10, 2, 0, 0), 16, &routes[1].lpm);
+	zassert_equal(ret, 0, "Cannot insert (%d)", ret);
+
+	zassert_equal(nodes_in_use(&lpm4), 3, "%d nodes in use",
+		      nodes_in_use(&lpm4));
+
+	/* The branch node goes away with the leaf */
+	ret = net_lpm_remove(&lpm4, ADDR4(10, 1, 0, 0), 16, &routes[0].lpm);
+	zassert_equal(ret, 0, "Cannot remove (%d)", ret);
+	zassert_equal(nodes_in_use(&lpm4), 1, "%d nodes in use",
+		      nodes_in_use(&lpm4));
+
+	zassert_is_null(lookup(&lpm4, ADDR4(10, 1, 2, 3), NULL, NULL),
+			"Removed route found");
+	zassert_equal_ptr(lookup(&lpm4, ADDR4(10, 2, 2, 3), NULL, NULL),
+			  &routes[1], "Sibling route not found");
+
+	/* A parent with a value is kept */
+	ret = net_lpm_insert(&lpm4, ADDR4(10, 0, 0, 0), 8, &routes[2].lpm);
+	zassert_equal(ret, 0, "Cannot insert (%d)", ret);
+
+	ret = net_lpm_remove(&lpm4, ADDR4(10, 2, 0, 0), 16, &routes[1].lpm);
+	zassert_equal(ret, 0, "Cannot remove (%d)", ret);
+	zassert_equal(nodes_in_use(&lpm4), 1, "%d nodes in use",
+		      nodes_in_use(&lpm4));
+
+	zassert_equal_ptr(lookup(&lpm4, ADDR4(10, 2, 2, 3), NULL, NULL),
+			  &routes[2], "Parent route not found");
+
+	ret = net_lpm_remove(&lpm4, ADDR4(10, 0, 0, 0), 8, &routes[2].lpm);
+	zassert_equal(ret, 0, "Cannot remove (%d)", ret);
+
+	check_empty(&lpm4);
+}
+
+static void test_duplicate(void)
+{
+	int ret;
+
+	ret = net_lpm_insert(&lpm4, ADDR4(192, 168, 0, 0), 16, &routes[0].lpm);
+	zassert_equal(ret, 0, "Cannot insert (%d)", ret);
+
+	ret = net_lpm_insert(&lpm4, ADDR4(192, 168, 0, 0), 16, &routes[1].lpm);
+	zassert_equal(ret, 0, "Cannot insert duplicate (%d)", ret);
+
+	zassert_equal(nodes_in_use(&lpm4), 1, "%d nodes in use",
+		      nodes_in_use(&lpm4));
+
+	/* The value added last is found first */
+	zassert_equal_ptr(lookup(&lpm4, ADDR4(192, 168, 1, 1), NULL, NULL),
+			  &routes[1], "Last value not found");
+
+	ret = net_lpm_remove(&lpm4, ADDR4(192, 168, 0, 0), 16, &routes[1].lpm);
+	zassert_equal(ret, 0, "Cannot remove (%d)", ret);
+	zassert_equal(nodes_in_use(&lpm4), 1, "%d nodes in use",
+		      nodes_in_use(&lpm4));
+
+	zassert_equal_ptr(lookup(&lpm4, ADDR4(192, 168, 1, 1), NULL, NULL),
+			  &routes[0], "Remaining value not found");
+
+	/* Remove the value at the end of the list */
+	ret = net_lpm_insert(&lpm4, ADDR4(192, 168, 0, 0), 16, &routes[1].lpm);
+	zassert_equal(ret, 0, "Cannot insert duplicate (%d)", ret);
+
+	ret = net_lpm_remove(&lpm4, ADDR4(192, 168, 0, 0), 16, &routes[0].lpm);
+	zassert_equal(ret, 0, "Cannot remove (%d)", ret);
+
+	zassert_equal_ptr(lookup(&lpm4, ADDR4(192, 168, 1, 1), NULL, NULL),
+			  &routes[1], "Remaining value not found");
+
+	ret = net_lpm_remove(&lpm4, ADDR4(192, 168, 0, 0), 16, &routes[1].lpm);
+	zassert_equal(ret, 0, "Cannot remove (%d)", ret);
+
+	check_empty(&lpm4);
+}
+
+static void test_match_cb(void)
+{
+	const uint8_t *key = ADDR4(10, 1, 2, 3);
+	int i, ret;
+
+	routes[0].iface = 1;
+	routes[1].iface = 2;
+	routes[2].iface = 3;
+
+	ret = net_lpm_insert(&lpm4, ADDR4(10, 0, 0, 0), 8, &routes[0].lpm);
+	zassert_equal(ret, 0, "Cannot insert (%d)", ret);
+
+	for (i = 1; i <= 2; i++) {
+		ret = net_lpm_insert(&lpm4, ADDR4(10, 1, 0, 0), 16,
+				     &routes[i].lpm);
+		zassert_equal(ret, 0, "Cannot insert (%d)", ret);
+	}
+
+	for (i = 0; i <= 2; i++) {
+		zassert_equal_ptr(lookup(&lpm4, key, match_iface,
+					 INT_TO_POINTER(routes[i].iface)),
+				  &routes[i], "Route of iface %d not found",
+				  routes[i].iface);
+	}
+
+	zassert_is_null(lookup(&lpm4, key, match_iface, INT_TO_POINTER(4)),
+			"Route of another iface found");
+
+	zassert_equal_ptr(lookup(&lpm4, key, NULL, NULL), &routes[2],
+			  "Longest prefix not found");
+
+	ret = net_lpm_remove(&lpm4, ADDR4(10, 0, 0, 0), 8, &routes[0].lpm);
+	zassert_equal(ret, 0, "Cannot remove (%d)", ret);
+
+	for (i = 1; i <= 2; i++) {
+		ret = net_lpm_remove(&lpm4, ADDR4(10, 1, 0, 0), 16,
+				     &routes[i].lpm);
+		zassert_equal(ret, 0, "Cannot remove (%d)", ret);
+	}
+
+	check_empty(&lpm4);
+}
+
+static void test_enoent(void)
+{
+	int ret;
+
+	ret = net_lpm_remove(&lpm4, ADDR4(10, 1, 0, 0), 16, &routes[0].lpm);
+	zassert_equal(ret, -ENOENT, "Removed from an empty table (%d)", ret);
+
+	ret = net_lpm_insert(&lpm4, ADDR4(10, 1, 0, 0), 16, &routes[0].lpm);
+	zassert_equal(ret, 0, "Cannot insert (%d)", ret);
+
+	ret = net_lpm_remove(&lpm4, ADDR4(10, 1, 0, 0), 16, &routes[1].lpm);
+	zassert_equal(ret, -ENOENT, "Removed another value (%d)", ret);
+
+	ret = net_lpm_remove(&lpm4, ADDR4(10, 1, 0, 0), 24, &routes[0].lpm);
+	zassert_equal(ret, -ENOENT, "Removed a longer prefix (%d)", ret);
+
+	ret = net_lpm_remove(&lpm4, ADDR4(10, 0, 0, 0), 8, &routes[0].lpm);
+	zassert_equal(ret, -ENOENT, "Removed a shorter prefix (%d)", ret);
+
+	ret = net_lpm_remove(&lpm4, ADDR4(10, 2, 0, 0), 16, &routes[0].lpm);
+	zassert_equal(ret, -ENOENT, "Removed another prefix (%d)", ret);
+
+	ret = net_lpm_remove(&lpm4, ADDR4(10, 1, 0, 0), 16, &routes[0].lpm);
+	zassert_equal(ret, 0, "Cannot remove (%d)", ret);
+
+	ret = net_lpm_remove(&lpm4, ADDR4(10, 1, 0, 0), 16, &routes[0].lpm);
+	zassert_equal(ret, -ENOENT, "Removed twice (%d)", ret);
+
+	ret = net_lpm_insert(&lpm4, ADDR4(10, 1, 0, 0), 33, &routes[0].lpm);
+	zassert_equal(ret, -EINVAL, "Inserted a too long prefix (%d)", ret);
+
+	check_empty(&lpm4);
+}
+
+static void test_no_free_nodes(void)
+{
+	int ret;
+
+	ret = net_lpm_insert(&lpm_small, ADDR4(10, 1, 0, 0), 16,
+			     &routes[0].lpm);
+	zassert_equal(ret, 0, "Cannot insert (%d)", ret);
+
+	/* A sibling needs two more nodes, the one allocated is released */
+	ret = net_lpm_insert(&lpm_small, ADDR4(10, 2, 0, 0), 16,
+			     &routes[1].lpm);
+	zassert_equal(ret, -ENOMEM, "Inserted without free nodes (%d)", ret);
+	zassert_equal(nodes_in_use(&lpm_small), 1, "%d nodes in use",
+		      nodes_in_use(&lpm_small));
+
+	zassert_is_null(lookup(&lpm_small, ADDR4(10, 2, 2, 3), NULL, NULL),
+			"Failed insert found");
+
+	ret = net_lpm_remove(&lpm_small, ADDR4(10, 1, 0, 0), 16,
+			     &routes[0].lpm);
+	zassert_equal(ret, 0, "Cannot remove (%d)", ret);
+
+	check_empty(&lpm_small);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_lpm_test,
+			 ztest_unit_test(test_insert_remove),
+			 ztest_unit_test(test_branch_collapse),
+			 ztest_unit_test(test_duplicate),
+			 ztest_unit_test(test_match_cb),
+			 ztest_unit_test(test_enoent),
+			 ztest_unit_test(test_no_free_nodes));
+
+	ztest_run_test_suite(net_lpm_test);
+}
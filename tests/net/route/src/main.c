@@ -544,6 +544,50 @@ static void test_route_preference(void)
 	net_route_del(entry);
 }
 
+static void test_route_overflow(void)
+{
+	struct net_route_entry *extra;
+	int i;
+
+	/* Routes added in a burst usually share the same timestamp, the
+	 * first one added is still the oldest.
+	 */
+	for (i = 0; i < max_routes; i++) {
+		test_routes[i] = net_route_add(my_iface,
+					       &dest_addresses[i], 128,
+					       &peer_addr,
+					       NET_IPV6_ND_INFINITE_LIFETIME,
+					       NET_ROUTE_PREFERENCE_LOW);
+		zassert_not_null(test_routes[i], "Route add failed");
+	}
+
+	extra = net_route_add(my_iface,
+			      &dest_addr, 128,
+			      &peer_addr,
+			      NET_IPV6_ND_INFINITE_LIFETIME,
+			      NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(extra, "Route add to a full table failed");
+
+	zassert_is_null(net_route_lookup(my_iface, &dest_addresses[0]),
+			"Oldest route not removed");
+
+	for (i = 1; i < max_routes; i++) {
+		zassert_not_null(net_route_lookup(my_iface,
+						  &dest_addresses[i]),
+				 "Route %d removed", i);
+	}
+
+	zassert_equal_ptr(net_route_lookup(my_iface, &dest_addr), extra,
+			  "New route not found");
+
+	for (i = 1; i < max_routes; i++) {
+		zassert_false(net_route_del(test_routes[i]),
+			      "Route del failed");
+	}
+
+	zassert_false(net_route_del(extra), "Route del failed");
+}
+
 
 /*test case main entry*/
 void test_main(void)
@@ -566,6 +610,7 @@ void test_main(void)
 			ztest_unit_test(test_route_add_many),
 			ztest_unit_test(test_route_del_many),
 			ztest_unit_test(test_route_lifetime),
-			ztest_unit_test(test_route_preference));
+			ztest_unit_test(test_route_preference),
+			ztest_unit_test(test_route_overflow));
 	ztest_run_test_suite(test_route);
 }
@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <stdio.h>
+#include <ztest_assert.h>
+
+#include <net/socket.h>
+#include <sys/fdtable.h>
+
+#include "../../socket_helpers.h"
+
+#define BUF_AND_SIZE(buf) buf, sizeof(buf) - 1
+#define STRLEN(buf) (sizeof(buf) - 1)
+
+#define TEST_STR_SMALL "test"
+
+#define SERVER_PORT 4242
+#define CLIENT_PORT 9898
+
+/* On QEMU, a wait takes +10ms from the requested time. */
+#define FUZZ 10
+
+static int c_sock;
+static int s_sock;
+
+static void setup_udp(void)
+{
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	int res;
+
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, CLIENT_PORT,
+			    &c_sock, &c_addr);
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &s_sock, &s_addr);
+
+	res = bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+}
+
+static void teardown_udp(void)
+{
+	zassert_equal(close(c_sock), 0, "close failed");
+	zassert_equal(close(s_sock), 0, "close failed");
+}
+
+static void send_small(void)
+{
+	ssize_t len;
+
+	len = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+}
+
+static void recv_small(void)
+{
+	char buf[10];
+	ssize_t len;
+
+	len = recv(s_sock, BUF_AND_SIZE(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+}
+
+static void add_sock(int epfd, int fd, uint32_t events)
+{
+	struct epoll_event ev = {
+		.events = events,
+		.data.fd = fd,
+	};
+
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev), 0,
+		      "epoll_ctl failed");
+}
+
+void test_epoll_level(void)
+{
+	struct epoll_event events[2];
+	uint32_t tstamp;
+	int epfd;
+	int res;
+
+	memset(events, 0, sizeof(events));
+
+	setup_udp();
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	add_sock(epfd, s_sock, EPOLLIN);
+	add_sock(epfd, c_sock, EPOLLIN);
+
+	/* Same socket cannot be added twice */
+	res = epoll_ctl(epfd, EPOLL_CTL_ADD, s_sock, &events[0]);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EEXIST, "");
+
+	/* Nothing ready, timeout of 0 */
+	tstamp = k_uptime_get_32();
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_true(k_uptime_get_32() - tstamp <= FUZZ, "");
+	zassert_equal(res, 0, "");
+
+	/* Nothing ready, timeout of 30 */
+	tstamp = k_uptime_get_32();
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	tstamp = k_uptime_get_32() - tstamp;
+	zassert_true(tstamp >= 30U && tstamp <= 30 + FUZZ * 2, "tstamp %d",
+		     tstamp);
+	zassert_equal(res, 0, "");
+
+	send_small();
+
+	tstamp = k_uptime_get_32();
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_true(k_uptime_get_32() - tstamp <= FUZZ, "");
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+	zassert_equal(events[0].events, EPOLLIN, "");
+
+	/* Level triggered, reported again until the data is read */
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+
+	/* The epoll descriptor itself can be polled */
+	{
+		struct pollfd pfd = {
+			.fd = epfd,
+			.events = POLLIN,
+		};
+
+		res = poll(&pfd, 1, 0);
+		zassert_equal(res, 1, "");
+		zassert_equal(pfd.revents, POLLIN, "");
+	}
+
+	recv_small();
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	/* Removed socket is not reported */
+	res = epoll_ctl(epfd, EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, 0, "");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	send_small();
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_equal(res, 0, "");
+
+	recv_small();
+
+	zassert_equal(close(epfd), 0, "close failed");
+	teardown_udp();
+}
+
+void test_epoll_edge(void)
+{
+	struct epoll_event events[2];
+	int epfd;
+	int res;
+
+	setup_udp();
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	add_sock(epfd, s_sock, EPOLLIN | EPOLLET);
+
+	send_small();
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+
+	/* Data is still pending but there was no new arrival */
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	send_small();
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_equal(res, 1, "");
+
+	recv_small();
+	recv_small();
+
+	zassert_equal(close(epfd), 0, "close failed");
+	teardown_udp();
+}
+
+void test_epoll_oneshot(void)
+{
+	struct epoll_event events[2];
+	struct epoll_event ev;
+	int epfd;
+	int res;
+
+	setup_udp();
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	add_sock(epfd, s_sock, EPOLLIN | EPOLLONESHOT);
+
+	send_small();
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_equal(res, 1, "");
+
+	/* Disabled until rearmed */
+	send_small();
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_equal(res, 0, "");
+
+	ev.events = EPOLLIN | EPOLLONESHOT;
+	ev.data.fd = s_sock;
+	res = epoll_ctl(epfd, EPOLL_CTL_MOD, s_sock, &ev);
+	zassert_equal(res, 0, "");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+
+	recv_small();
+	recv_small();
+
+	zassert_equal(close(epfd), 0, "close failed");
+	teardown_udp();
+}
+
+void test_epoll_close(void)
+{
+	struct epoll_event events[2];
+	int epfd;
+	int res;
+
+	setup_udp();
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	add_sock(epfd, s_sock, EPOLLIN);
+	memset(events, 0, sizeof(events));
+
+	send_small();
+
+	/* Closing the socket removes it from the instance */
+	zassert_equal(close(s_sock), 0, "close failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	/* Only sockets can be watched */
+	res = epoll_ctl(epfd, EPOLL_CTL_ADD, epfd, &events[0]);
+	zassert_equal(res, -1, "");
+
+	zassert_equal(close(epfd), 0, "close failed");
+	zassert_equal(close(c_sock), 0, "close failed");
+}
+
+static K_THREAD_STACK_DEFINE(waiter_stack, 1024);
+static struct k_thread waiter_thread;
+static int waiter_res;
+static int waiter_errno;
+
+static void waiter(void *p1, void *p2, void *p3)
+{
+	struct epoll_event events[1];
+	int epfd = POINTER_TO_INT(p1);
+
+	waiter_res = epoll_wait(epfd, events, ARRAY_SIZE(events), -1);
+	waiter_errno = errno;
+}
+
+void test_epoll_close_wait(void)
+{
+	int epfd;
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	waiter_res = 0;
+	waiter_errno = 0;
+
+	k_thread_create(&waiter_thread, waiter_stack,
+			K_THREAD_STACK_SIZEOF(waiter_stack), waiter,
+			INT_TO_POINTER(epfd), NULL, NULL,
+			K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+	/* Let the waiter block */
+	k_msleep(50);
+
+	/* The waiter leaves before the instance is released */
+	zassert_equal(close(epfd), 0, "close failed");
+
+	zassert_equal(k_thread_join(&waiter_thread, K_MSEC(100)), 0,
+		      "waiter not woken up");
+	zassert_equal(waiter_res, -1, "");
+	zassert_equal(waiter_errno, EBADF, "");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(socket_epoll,
+			 ztest_unit_test(test_epoll_level),
+			 ztest_unit_test(test_epoll_edge),
+			 ztest_unit_test(test_epoll_oneshot),
+			 ztest_unit_test(test_epoll_close),
+			 ztest_unit_test(test_epoll_close_wait));
+
+	ztest_run_test_suite(socket_epoll);
+}
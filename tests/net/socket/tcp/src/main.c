@@ -1041,6 +1041,108 @@ void test_socket_permission(void)
 #endif /* CONFIG_USERSPACE */
 }
 
+#define REUSEPORT_LISTENERS 2
+#define REUSEPORT_MAX_FLOWS 16
+#define REUSEPORT_CLIENT_PORT 5000
+
+/* Connect from the given port and return the listener which got the
+ * connection.
+ */
+static int reuseport_connect(int *listeners, uint16_t port,
+			     struct sockaddr_in *s_saddr)
+{
+	struct pollfd fds[REUSEPORT_LISTENERS];
+	struct sockaddr_in c_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	int new_sock;
+	int c_sock;
+	int found = -1;
+	int i;
+
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, port,
+			    &c_sock, &c_saddr);
+	test_bind(c_sock, (struct sockaddr *)&c_saddr, sizeof(c_saddr));
+	test_connect(c_sock, (struct sockaddr *)s_saddr, sizeof(*s_saddr));
+
+	for (i = 0; i < REUSEPORT_LISTENERS; i++) {
+		fds[i].fd = listeners[i];
+		fds[i].events = POLLIN;
+	}
+
+	zassert_equal(poll(fds, REUSEPORT_LISTENERS, 1000), 1,
+		      "connection not queued on exactly one listener");
+
+	for (i = 0; i < REUSEPORT_LISTENERS; i++) {
+		if (fds[i].revents & POLLIN) {
+			found = i;
+		}
+	}
+
+	test_accept(listeners[found], &new_sock, &addr, &addrlen);
+
+	test_close(c_sock);
+	test_close(new_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+
+	return found;
+}
+
+void test_so_reuseport(void)
+{
+	int listeners[REUSEPORT_LISTENERS];
+	int first[REUSEPORT_MAX_FLOWS];
+	struct sockaddr_in s_saddr;
+	int optval = 1;
+	int flows = 0;
+	int seen = 0;
+	int rv;
+	int i;
+
+	for (i = 0; i < REUSEPORT_LISTENERS; i++) {
+		prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+				    SERVER_PORT, &listeners[i], &s_saddr);
+
+		rv = setsockopt(listeners[i], SOL_SOCKET, SO_REUSEPORT,
+				&optval, sizeof(optval));
+		zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+		test_bind(listeners[i], (struct sockaddr *)&s_saddr,
+			  sizeof(s_saddr));
+		test_listen(listeners[i]);
+	}
+
+	/* SYNs of different flows are spread over the listeners. The
+	 * selection depends on a random seed, so new flows are opened
+	 * until every listener got one.
+	 */
+	while (seen != BIT_MASK(REUSEPORT_LISTENERS)) {
+		zassert_true(flows < REUSEPORT_MAX_FLOWS,
+			     "%d flows all reached the same listener", flows);
+
+		first[flows] = reuseport_connect(listeners,
+						 REUSEPORT_CLIENT_PORT + flows,
+						 &s_saddr);
+		seen |= BIT(first[flows]);
+		flows++;
+	}
+
+	/* A flow opened again reaches the same listener */
+	for (i = 0; i < flows; i++) {
+		zassert_equal(reuseport_connect(listeners,
+						REUSEPORT_CLIENT_PORT + i,
+						&s_saddr),
+			      first[i], "flow %d moved to another listener", i);
+	}
+
+	for (i = 0; i < REUSEPORT_LISTENERS; i++) {
+		test_close(listeners[i]);
+	}
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
 void test_main(void)
 {
 #ifdef CONFIG_USERSPACE
@@ -1075,6 +1177,7 @@ void test_main(void)
 		ztest_unit_test(test_v6_so_rcvtimeo),
 		ztest_unit_test(test_v4_msg_waitall),
 		ztest_unit_test(test_v6_msg_waitall),
+		ztest_unit_test(test_so_reuseport),
 		ztest_user_unit_test(test_socket_permission)
 		);
 
@@ -20,10 +20,12 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #define SERVER_PORT 4242
 
 #define PSK_TAG 1
+#define PSK_TAG_WRONG 2
 
 #define MAX_CONNS 5
 
 #define TCP_TEARDOWN_TIMEOUT K_SECONDS(1)
+#define HANDSHAKE_POLL_TIMEOUT_MS 5000
 
 static const unsigned char psk[] = {
 	0x01, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
@@ -471,6 +473,303 @@ void test_v6_msg_trunc(void)
 		       (struct sockaddr *)&server_addr, sizeof(server_addr));
 }
 
+#if defined(CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE)
+/* Same identity as psk, so a full handshake with it fails the Finished
+ * check.
+ */
+static const unsigned char psk_wrong[] = {
+	0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08,
+	0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x01
+};
+
+static void test_psk_register(sec_tag_t tag, const unsigned char *key,
+			      size_t key_len)
+{
+	(void)tls_credential_delete(tag, TLS_CREDENTIAL_PSK);
+	(void)tls_credential_delete(tag, TLS_CREDENTIAL_PSK_ID);
+
+	zassert_equal(tls_credential_add(tag, TLS_CREDENTIAL_PSK,
+					 key, key_len),
+		      0, "Failed to register PSK");
+	zassert_equal(tls_credential_add(tag, TLS_CREDENTIAL_PSK_ID,
+					 psk_id, strlen(psk_id)),
+		      0, "Failed to register PSK ID");
+}
+
+static void test_set_sec_tag(int sock, sec_tag_t tag)
+{
+	sec_tag_t sec_tag_list[] = {
+		tag
+	};
+
+	zassert_equal(setsockopt(sock, SOL_TLS, TLS_SEC_TAG_LIST,
+				 sec_tag_list, sizeof(sec_tag_list)),
+		      0, "Failed to set security tag");
+}
+
+static void test_set_nonblock(int sock)
+{
+	int flags;
+
+	flags = fcntl(sock, F_GETFL, 0);
+	zassert_true(flags >= 0, "fcntl F_GETFL failed (%d)", errno);
+	zassert_equal(fcntl(sock, F_SETFL, flags | O_NONBLOCK), 0,
+		      "fcntl F_SETFL failed (%d)", errno);
+}
+
+static void test_async_server(uint16_t port, int *sock,
+			      struct sockaddr_in *addr)
+{
+	prepare_sock_tls_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, port,
+			    sock, addr, IPPROTO_TLS_1_2);
+
+	test_set_sec_tag(*sock, PSK_TAG);
+	test_set_nonblock(*sock);
+
+	test_bind(*sock, (struct sockaddr *)addr, sizeof(*addr));
+	test_listen(*sock);
+}
+
+static void test_async_client(int *sock)
+{
+	struct sockaddr_in addr;
+
+	prepare_sock_tls_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    sock, &addr, IPPROTO_TLS_1_2);
+
+	test_set_sec_tag(*sock, PSK_TAG);
+	test_set_nonblock(*sock);
+}
+
+static void test_async_connect(int sock, struct sockaddr_in *addr)
+{
+	zassert_equal(connect(sock, (struct sockaddr *)addr, sizeof(*addr)),
+		      -1, "connect did not return EINPROGRESS");
+	zassert_equal(errno, EINPROGRESS, "connect failed (%d)", errno);
+}
+
+static void test_async_accept(int sock, int *new_sock)
+{
+	struct pollfd pfd = {
+		.fd = sock,
+		.events = POLLIN,
+	};
+
+	zassert_equal(poll(&pfd, 1, HANDSHAKE_POLL_TIMEOUT_MS), 1,
+		      "no connection to accept");
+
+	*new_sock = accept(sock, NULL, NULL);
+	zassert_true(*new_sock >= 0, "accept failed (%d)", errno);
+}
+
+/* Wait for the end of the handshake, poll() reports it on POLLOUT. */
+static void test_async_wait(int sock, short revents)
+{
+	struct pollfd pfd = {
+		.fd = sock,
+		.events = POLLOUT,
+	};
+
+	zassert_equal(poll(&pfd, 1, HANDSHAKE_POLL_TIMEOUT_MS), 1,
+		      "handshake not finished");
+	zassert_true(pfd.revents & revents, "unexpected revents 0x%x",
+		     pfd.revents);
+}
+
+static void test_so_error(int sock, int expected)
+{
+	int optval;
+	socklen_t optlen = sizeof(optval);
+
+	zassert_equal(getsockopt(sock, SOL_SOCKET, SO_ERROR, &optval, &optlen),
+		      0, "getsockopt failed (%d)", errno);
+	zassert_equal(optval, expected, "unexpected SO_ERROR %d", optval);
+}
+
+static void test_async_data(int c_sock, int s_sock)
+{
+	uint8_t rx_buf[sizeof(TEST_STR_SMALL) - 1] = { 0 };
+	struct pollfd pfd = {
+		.fd = s_sock,
+		.events = POLLIN,
+	};
+
+	test_send(c_sock, TEST_STR_SMALL, sizeof(TEST_STR_SMALL) - 1, 0);
+
+	zassert_equal(poll(&pfd, 1, HANDSHAKE_POLL_TIMEOUT_MS), 1,
+		      "no data received");
+	zassert_equal(recv(s_sock, rx_buf, sizeof(rx_buf), 0), sizeof(rx_buf),
+		      "Invalid length received");
+	zassert_mem_equal(rx_buf, TEST_STR_SMALL, sizeof(rx_buf),
+			  "Invalid data received");
+}
+#endif /* CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE */
+
+void test_v4_async_handshake(void)
+{
+#if defined(CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE)
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in s_saddr;
+	int ret;
+
+	test_psk_register(PSK_TAG, psk, sizeof(psk));
+	test_async_server(SERVER_PORT, &s_sock, &s_saddr);
+	test_async_client(&c_sock);
+
+	test_async_connect(c_sock, &s_saddr);
+
+	/* The handshake work has not run yet */
+	ret = send(c_sock, TEST_STR_SMALL, sizeof(TEST_STR_SMALL) - 1, 0);
+	zassert_equal(ret, -1, "send succeeded during the handshake");
+	zassert_equal(errno, EAGAIN, "unexpected errno (%d)", errno);
+	test_so_error(c_sock, 0);
+
+	test_async_accept(s_sock, &new_sock);
+
+	test_async_wait(c_sock, POLLOUT);
+	test_async_wait(new_sock, POLLOUT);
+	test_so_error(c_sock, 0);
+	test_so_error(new_sock, 0);
+
+	test_async_data(c_sock, new_sock);
+
+	test_close(new_sock);
+	test_close(s_sock);
+	test_close(c_sock);
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+#else
+	ztest_test_skip();
+#endif /* CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE */
+}
+
+void test_v4_async_handshake_failure(void)
+{
+#if defined(CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE)
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in s_saddr;
+	int ret;
+
+	test_psk_register(PSK_TAG, psk, sizeof(psk));
+	test_psk_register(PSK_TAG_WRONG, psk_wrong, sizeof(psk_wrong));
+	test_async_server(SERVER_PORT + 1, &s_sock, &s_saddr);
+	test_set_sec_tag(s_sock, PSK_TAG_WRONG);
+	test_async_client(&c_sock);
+
+	test_async_connect(c_sock, &s_saddr);
+	test_async_accept(s_sock, &new_sock);
+
+	test_async_wait(c_sock, POLLERR);
+	test_async_wait(new_sock, POLLERR);
+	test_so_error(c_sock, ECONNABORTED);
+	test_so_error(new_sock, ECONNABORTED);
+
+	ret = send(c_sock, TEST_STR_SMALL, sizeof(TEST_STR_SMALL) - 1, 0);
+	zassert_equal(ret, -1, "send succeeded after a failed handshake");
+	zassert_equal(errno, ECONNABORTED, "unexpected errno (%d)", errno);
+
+	test_close(new_sock);
+	test_close(s_sock);
+	test_close(c_sock);
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+#else
+	ztest_test_skip();
+#endif /* CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE */
+}
+
+void test_v4_async_handshake_close(void)
+{
+#if defined(CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE)
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in s_saddr;
+	int ret;
+	int i;
+
+	test_psk_register(PSK_TAG, psk, sizeof(psk));
+	test_async_server(SERVER_PORT + 2, &s_sock, &s_saddr);
+
+	/* Every round takes two more TLS contexts, so a context which is
+	 * not released by close() makes socket() fail.
+	 */
+	for (i = 0; i < CONFIG_NET_SOCKETS_TLS_MAX_CONTEXTS; i++) {
+		test_async_client(&c_sock);
+		test_async_connect(c_sock, &s_saddr);
+
+		/* The client handshake is still queued, or waits for the
+		 * server hello if accept() had to wait. The server
+		 * handshake is queued.
+		 */
+		test_async_accept(s_sock, &new_sock);
+
+		ret = send(c_sock, TEST_STR_SMALL, sizeof(TEST_STR_SMALL) - 1,
+			   0);
+		zassert_equal(ret, -1, "send succeeded during the handshake");
+		zassert_equal(errno, EAGAIN, "unexpected errno (%d)", errno);
+
+		test_close(c_sock);
+		test_close(new_sock);
+	}
+
+	test_close(s_sock);
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+#else
+	ztest_test_skip();
+#endif /* CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE */
+}
+
+void test_v4_async_session_resumption(void)
+{
+#if defined(CONFIG_NET_SOCKETS_TLS_ASYNC_HANDSHAKE) && \
+	defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE) && \
+	defined(CONFIG_MBEDTLS_SSL_CACHE_C)
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in s_saddr;
+
+	test_psk_register(PSK_TAG, psk, sizeof(psk));
+	test_psk_register(PSK_TAG_WRONG, psk_wrong, sizeof(psk_wrong));
+	test_async_server(SERVER_PORT + 3, &s_sock, &s_saddr);
+
+	/* Full handshake, the client keeps the session */
+	test_async_client(&c_sock);
+	test_async_connect(c_sock, &s_saddr);
+	test_async_accept(s_sock, &new_sock);
+	test_async_wait(c_sock, POLLOUT);
+	test_async_wait(new_sock, POLLOUT);
+	test_async_data(c_sock, new_sock);
+	test_close(new_sock);
+	test_close(c_sock);
+
+	/* A full handshake fails with the server PSK changed, as in
+	 * test_v4_async_handshake_failure, only a resumed session
+	 * succeeds.
+	 */
+	test_set_sec_tag(s_sock, PSK_TAG_WRONG);
+
+	test_async_client(&c_sock);
+	test_async_connect(c_sock, &s_saddr);
+	test_async_accept(s_sock, &new_sock);
+	test_async_wait(c_sock, POLLOUT);
+	test_async_wait(new_sock, POLLOUT);
+	test_so_error(c_sock, 0);
+	test_so_error(new_sock, 0);
+	test_async_data(c_sock, new_sock);
+
+	test_close(new_sock);
+	test_close(s_sock);
+	test_close(c_sock);
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	if (IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE)) {
@@ -487,7 +786,11 @@ void test_main(void)
 		ztest_unit_test(test_v4_msg_waitall),
 		ztest_unit_test(test_v6_msg_waitall),
 		ztest_unit_test(test_v4_msg_trunc),
-		ztest_unit_test(test_v6_msg_trunc)
+		ztest_unit_test(test_v6_msg_trunc),
+		ztest_unit_test(test_v4_async_handshake),
+		ztest_unit_test(test_v4_async_handshake_failure),
+		ztest_unit_test(test_v4_async_handshake_close),
+		ztest_unit_test(test_v4_async_session_resumption)
 		);
 
 	ztest_run_test_suite(socket_tls);
@@ -1212,6 +1212,463 @@ void test_v6_msg_trunc(void)
 		       (struct sockaddr *)&server_addr, sizeof(server_addr));
 }
 
+static void test_recvmsg_ancillary(int sock_c, int sock_s,
+				   struct sockaddr *addr_s, socklen_t addrlen_s,
+				   int level, int pktinfo_opt, int tc_opt)
+{
+	uint8_t cmsgbuf[CMSG_SPACE(sizeof(struct in6_pktinfo)) +
+			CMSG_SPACE(sizeof(int))];
+	struct sockaddr_storage src;
+	struct cmsghdr *cmsg;
+	struct msghdr msg;
+	struct iovec io[2];
+	bool found_info = false;
+	bool found_tc = false;
+	char rx[8];
+	int optval = 1;
+	int rv;
+
+	rv = setsockopt(sock_s, level, pktinfo_opt, &optval, sizeof(optval));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+	rv = setsockopt(sock_s, level, tc_opt, &optval, sizeof(optval));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	rv = bind(sock_s, addr_s, addrlen_s);
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = sendto(sock_c, BUF_AND_SIZE(TEST_STR_SMALL), 0, addr_s,
+		    addrlen_s);
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	/* Scatter the datagram over two buffers */
+	memset(rx, 0, sizeof(rx));
+	io[0].iov_base = rx;
+	io[0].iov_len = 1;
+	io[1].iov_base = rx + 1;
+	io[1].iov_len = sizeof(rx) - 1;
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_name = &src;
+	msg.msg_namelen = sizeof(src);
+	msg.msg_iov = io;
+	msg.msg_iovlen = ARRAY_SIZE(io);
+	msg.msg_control = cmsgbuf;
+	msg.msg_controllen = sizeof(cmsgbuf);
+
+	rv = recvmsg(sock_s, &msg, 0);
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "recvmsg failed");
+	zassert_mem_equal(rx, BUF_AND_SIZE(TEST_STR_SMALL), "wrong data");
+	zassert_equal(msg.msg_flags, 0, "unexpected flags");
+	zassert_equal(msg.msg_namelen, addrlen_s, "unexpected addrlen");
+
+	for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL;
+	     cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+		zassert_equal(cmsg->cmsg_level, level, "wrong level");
+
+		if (cmsg->cmsg_type == IP_PKTINFO ||
+		    cmsg->cmsg_type == IPV6_PKTINFO) {
+			found_info = true;
+		} else if (cmsg->cmsg_type == IP_TOS ||
+			   cmsg->cmsg_type == IPV6_TCLASS) {
+			found_tc = true;
+		}
+	}
+
+	zassert_true(found_info, "no pktinfo");
+	zassert_true(found_tc, "no traffic class");
+
+	/* Ancillary data which does not fit is reported with MSG_CTRUNC */
+	rv = sendto(sock_c, BUF_AND_SIZE(TEST_STR_SMALL), 0, addr_s,
+		    addrlen_s);
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	msg.msg_controllen = CMSG_SPACE(sizeof(int)) - 1;
+	rv = recvmsg(sock_s, &msg, 0);
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "recvmsg failed");
+	zassert_true(msg.msg_flags & MSG_CTRUNC, "no MSG_CTRUNC");
+
+	rv = close(sock_c);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(sock_s);
+	zassert_equal(rv, 0, "close failed");
+}
+
+void test_v4_recvmsg_ancillary(void)
+{
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	test_recvmsg_ancillary(client_sock, server_sock,
+			       (struct sockaddr *)&server_addr,
+			       sizeof(server_addr),
+			       IPPROTO_IP, IP_PKTINFO, IP_RECVTOS);
+}
+
+void test_v6_recvmsg_ancillary(void)
+{
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in6 client_addr;
+	struct sockaddr_in6 server_addr;
+
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	test_recvmsg_ancillary(client_sock, server_sock,
+			       (struct sockaddr *)&server_addr,
+			       sizeof(server_addr),
+			       IPPROTO_IPV6, IPV6_RECVPKTINFO, IPV6_RECVTCLASS);
+}
+
+#define MMSG_COUNT 4
+
+void test_v6_sendmmsg_recvmmsg(void)
+{
+	static const char *const payload[MMSG_COUNT] = {
+		"one", "two", "three", "four"
+	};
+	struct mmsghdr msgs[MMSG_COUNT];
+	struct iovec io[MMSG_COUNT];
+	char rx[MMSG_COUNT][8];
+	struct sockaddr_in6 client_addr;
+	struct sockaddr_in6 server_addr;
+	int client_sock;
+	int server_sock;
+	int rv;
+	int i;
+
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	memset(msgs, 0, sizeof(msgs));
+	for (i = 0; i < MMSG_COUNT; i++) {
+		io[i].iov_base = (void *)payload[i];
+		io[i].iov_len = strlen(payload[i]);
+		msgs[i].msg_hdr.msg_name = &server_addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+		msgs[i].msg_hdr.msg_iov = &io[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = sendmmsg(client_sock, msgs, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", errno);
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, strlen(payload[i]),
+			      "wrong sent length");
+	}
+
+	/* Wait for the first one, collect the rest without blocking */
+	memset(msgs, 0, sizeof(msgs));
+	memset(rx, 0, sizeof(rx));
+	for (i = 0; i < MMSG_COUNT; i++) {
+		io[i].iov_base = rx[i];
+		io[i].iov_len = sizeof(rx[i]);
+		msgs[i].msg_hdr.msg_iov = &io[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = 0;
+	while (rv < MMSG_COUNT) {
+		int ret = recvmmsg(server_sock, msgs + rv, MMSG_COUNT - rv,
+				   MSG_WAITFORONE, NULL);
+
+		zassert_true(ret > 0, "recvmmsg failed (%d)", errno);
+		rv += ret;
+	}
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, strlen(payload[i]),
+			      "wrong received length");
+		zassert_mem_equal(rx[i], payload[i], strlen(payload[i]),
+				  "wrong data");
+	}
+
+	/* Nothing left */
+	rv = recvmmsg(server_sock, msgs, MMSG_COUNT, MSG_DONTWAIT, NULL);
+	zassert_equal(rv, -1, "recvmmsg should have failed");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+void test_so_rcvbuf(void)
+{
+	struct sockaddr_in6 client_addr;
+	struct sockaddr_in6 server_addr;
+	socklen_t optlen = sizeof(int);
+	int client_sock;
+	int server_sock;
+	int optval;
+	int rv;
+	int i;
+
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	/* Room for two datagrams */
+	optval = 2 * STRLEN(TEST_STR_SMALL);
+	rv = setsockopt(server_sock, SOL_SOCKET, SO_RCVBUF, &optval,
+			sizeof(optval));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	optval = 0;
+	rv = getsockopt(server_sock, SOL_SOCKET, SO_RCVBUF, &optval, &optlen);
+	zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(optval, 2 * STRLEN(TEST_STR_SMALL), "wrong rcvbuf");
+
+	optval = -1;
+	rv = setsockopt(server_sock, SOL_SOCKET, SO_RCVBUF, &optval,
+			sizeof(optval));
+	zassert_equal(rv, -1, "negative size accepted");
+	zassert_equal(errno, EINVAL, "incorrect errno value");
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	for (i = 0; i < 3; i++) {
+		rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+			    (struct sockaddr *)&server_addr,
+			    sizeof(server_addr));
+		zassert_equal(rv, STRLEN(TEST_STR_SMALL), "sendto failed");
+	}
+
+	k_msleep(10);
+
+	/* The third datagram did not fit */
+	for (i = 0; i < 2; i++) {
+		rv = recv(server_sock, rx_buf, sizeof(rx_buf), MSG_DONTWAIT);
+		zassert_equal(rv, STRLEN(TEST_STR_SMALL), "recv failed");
+	}
+
+	rv = recv(server_sock, rx_buf, sizeof(rx_buf), MSG_DONTWAIT);
+	zassert_equal(rv, -1, "datagram was not dropped");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	/* Reading made room again */
+	rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+		    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	rv = recv(server_sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "recv failed");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+#define REUSEPORT_CLIENTS 3
+
+void test_so_reuseport(void)
+{
+	int client_sock[REUSEPORT_CLIENTS];
+	struct sockaddr_in6 client_addr;
+	struct sockaddr_in6 server_addr;
+	int server_sock[2];
+	int first[REUSEPORT_CLIENTS];
+	int other_sock;
+	int optval = 1;
+	int total = 0;
+	int rv;
+	int i;
+	int j;
+
+	for (i = 0; i < ARRAY_SIZE(server_sock); i++) {
+		prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR,
+				    SERVER_PORT, &server_sock[i],
+				    &server_addr);
+
+		rv = setsockopt(server_sock[i], SOL_SOCKET, SO_REUSEPORT,
+				&optval, sizeof(optval));
+		zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+		rv = bind(server_sock[i], (struct sockaddr *)&server_addr,
+			  sizeof(server_addr));
+		zassert_equal(rv, 0, "bind %d failed (%d)", i, errno);
+	}
+
+	/* The option cannot change once bound */
+	rv = setsockopt(server_sock[0], SOL_SOCKET, SO_REUSEPORT, &optval,
+			sizeof(optval));
+	zassert_equal(rv, -1, "setsockopt after bind succeeded");
+
+	/* A socket without the option cannot join the group */
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &other_sock, &server_addr);
+	rv = bind(other_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, -1, "bind without SO_REUSEPORT succeeded");
+	rv = close(other_sock);
+	zassert_equal(rv, 0, "close failed");
+
+	for (i = 0; i < REUSEPORT_CLIENTS; i++) {
+		prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR,
+				    CLIENT_PORT + i, &client_sock[i],
+				    &client_addr);
+		rv = bind(client_sock[i], (struct sockaddr *)&client_addr,
+			  sizeof(client_addr));
+		zassert_equal(rv, 0, "client bind failed");
+	}
+
+	/* Every datagram reaches exactly one member and a flow always
+	 * reaches the same one.
+	 */
+	for (j = 0; j < 2; j++) {
+		for (i = 0; i < REUSEPORT_CLIENTS; i++) {
+			int found = -1;
+			int k;
+
+			rv = sendto(client_sock[i],
+				    BUF_AND_SIZE(TEST_STR_SMALL), 0,
+				    (struct sockaddr *)&server_addr,
+				    sizeof(server_addr));
+			zassert_equal(rv, STRLEN(TEST_STR_SMALL),
+				      "sendto failed");
+
+			k_msleep(10);
+
+			for (k = 0; k < ARRAY_SIZE(server_sock); k++) {
+				rv = recv(server_sock[k], rx_buf,
+					  sizeof(rx_buf), MSG_DONTWAIT);
+				if (rv < 0) {
+					continue;
+				}
+
+				zassert_equal(found, -1, "delivered twice");
+				found = k;
+				total++;
+			}
+
+			zassert_not_equal(found, -1, "not delivered");
+
+			if (j == 0) {
+				first[i] = found;
+			} else {
+				zassert_equal(first[i], found,
+					      "flow moved to another socket");
+			}
+		}
+	}
+
+	zassert_equal(total, 2 * REUSEPORT_CLIENTS, "datagrams lost");
+
+	for (i = 0; i < REUSEPORT_CLIENTS; i++) {
+		rv = close(client_sock[i]);
+		zassert_equal(rv, 0, "close failed");
+	}
+
+	for (i = 0; i < ARRAY_SIZE(server_sock); i++) {
+		rv = close(server_sock[i]);
+		zassert_equal(rv, 0, "close failed");
+	}
+}
+
+NET_BUF_POOL_DEFINE(zc_pool, 4, 128, 0, NULL);
+
+void test_v6_zerocopy(void)
+{
+	struct sockaddr_in6 client_addr;
+	struct sockaddr_in6 server_addr;
+	struct sockaddr_in6 src_addr;
+	socklen_t addrlen = sizeof(src_addr);
+	struct net_buf *tx;
+	struct net_buf *rx;
+	int client_sock;
+	int server_sock;
+	size_t off = 0;
+	int rv;
+
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, CLIENT_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+	rv = bind(client_sock, (struct sockaddr *)&client_addr,
+		  sizeof(client_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	/* Spread the payload over several buffers */
+	tx = net_buf_alloc(&zc_pool, K_NO_WAIT);
+	zassert_not_null(tx, "cannot allocate buffer");
+
+	while (off < STRLEN(TEST_STR2)) {
+		struct net_buf *frag = net_buf_frag_last(tx);
+		size_t len = MIN(net_buf_tailroom(frag),
+				 STRLEN(TEST_STR2) - off);
+
+		if (len == 0) {
+			frag = net_buf_alloc(&zc_pool, K_NO_WAIT);
+			zassert_not_null(frag, "cannot allocate buffer");
+			net_buf_frag_add(tx, frag);
+			continue;
+		}
+
+		net_buf_add_mem(frag, TEST_STR2 + off, len);
+		off += len;
+	}
+
+	rv = zsock_sendto_zc(client_sock, tx, 0,
+			     (struct sockaddr *)&server_addr,
+			     sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto_zc failed (%d)", errno);
+
+	/* The caller always drops its own reference */
+	net_buf_unref(tx);
+
+	rv = zsock_recvfrom_zc(server_sock, &rx, 0,
+			       (struct sockaddr *)&src_addr, &addrlen);
+	zassert_equal(rv, STRLEN(TEST_STR2), "recvfrom_zc failed (%d)", errno);
+	zassert_not_null(rx, "no buffer returned");
+	zassert_equal(net_buf_frags_len(rx), STRLEN(TEST_STR2),
+		      "invalid chain length");
+	zassert_equal(addrlen, sizeof(src_addr), "invalid addrlen");
+	zassert_equal(src_addr.sin6_port, client_addr.sin6_port,
+		      "invalid source port");
+
+	memset(rx_buf, 0, sizeof(rx_buf));
+	net_buf_linearize(rx_buf, sizeof(rx_buf), rx, 0, STRLEN(TEST_STR2));
+	zassert_mem_equal(rx_buf, TEST_STR2, STRLEN(TEST_STR2),
+			  "invalid payload");
+	net_buf_unref(rx);
+
+	/* Nothing else is queued */
+	rv = zsock_recvfrom_zc(server_sock, &rx, MSG_DONTWAIT, NULL, NULL);
+	zassert_equal(rv, -1, "recvfrom_zc should fail");
+	zassert_equal(errno, EAGAIN, "invalid errno (%d)", errno);
+	zassert_is_null(rx, "buffer returned on error");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 void test_main(void)
 {
 	k_thread_system_pool_assign(k_current_get());
@@ -1242,7 +1699,13 @@ void test_main(void)
 			 ztest_unit_test(test_v6_sendmsg_with_txtime),
 			 ztest_user_unit_test(test_v6_sendmsg_with_txtime),
 			 ztest_unit_test(test_v4_msg_trunc),
-			 ztest_unit_test(test_v6_msg_trunc)
+			 ztest_unit_test(test_v6_msg_trunc),
+			 ztest_unit_test(test_v4_recvmsg_ancillary),
+			 ztest_unit_test(test_v6_recvmsg_ancillary),
+			 ztest_unit_test(test_v6_sendmmsg_recvmmsg),
+			 ztest_unit_test(test_so_rcvbuf),
+			 ztest_unit_test(test_so_reuseport),
+			 ztest_unit_test(test_v6_zerocopy)
 		);
 
 	ztest_run_test_suite(socket_udp);
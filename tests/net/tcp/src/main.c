@@ -29,6 +29,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
 
 #include "ipv4.h"
 #include "ipv6.h"
+#include "net_private.h"
 #include "tcp.h"
 #include "tcp_private.h"
 #include "net_stats.h"
@@ -125,6 +126,8 @@ static void handle_syn_resend(void);
 static void handle_client_fin_wait_2_test(sa_family_t af, struct tcphdr *th);
 static void handle_client_closing_test(sa_family_t af, struct tcphdr *th);
 static void handle_server_recv_out_of_order(struct net_pkt *pkt);
+static void handle_server_options_test(struct net_pkt *pkt);
+static void handle_offload_test(struct net_pkt *pkt);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -213,6 +216,12 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+/* Segment size announced by the peer in the offload tests */
+#define OFFLOAD_MSS 80
+
+static uint8_t offload_options[4] = {
+	0x02, 0x04, 0x00, OFFLOAD_MSS /* Max segment */ };
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -222,12 +231,16 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct net_pkt *pkt;
+	const uint8_t *opts = tcp_options;
 	struct tcphdr *th;
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if ((test_case_no == 4U || test_case_no == 10U) && (flags & SYN)) {
 		opts_len = sizeof(tcp_options);
+	} else if (test_case_no == 11U && (flags & SYN)) {
+		opts = offload_options;
+		opts_len = sizeof(offload_options);
 	}
 
 	/* Allocate buffer */
@@ -262,14 +275,10 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
+	th->th_off = 5U + opts_len / 4U;
 
 	th->th_flags = flags;
-	th->th_win = NET_IPV6_MTU;
+	th->th_win = htons(NET_IPV6_MTU);
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
@@ -281,9 +290,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if (opts_len) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -420,6 +429,12 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case 9:
 		handle_server_recv_out_of_order(pkt);
 		break;
+	case 10:
+		handle_server_options_test(pkt);
+		break;
+	case 11:
+		handle_offload_test(pkt);
+		break;
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -1484,6 +1499,880 @@ static void test_server_timeout_out_of_order_data(void)
 	net_tcp_put(ooo_ctx);
 }
 
+static struct tcphdr reply_th;
+static uint8_t reply_opts[40];
+static size_t reply_opts_len;
+static struct net_context *accepted_ctx;
+
+static void handle_server_options_test(struct net_pkt *pkt)
+{
+	int ret;
+
+	ret = read_tcp_header(pkt, &reply_th);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	reply_opts_len = (reply_th.th_off - 5) * 4;
+
+	ret = net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			   net_pkt_ip_opts_len(pkt) + sizeof(struct tcphdr));
+	if (ret < 0) {
+		goto fail;
+	}
+
+	ret = net_pkt_read(pkt, reply_opts, reply_opts_len);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	test_sem_give();
+
+	return;
+
+fail:
+	zassert_true(false, "%s failed", __func__);
+}
+
+/* Find an option in the last segment sent by the stack */
+static const uint8_t *reply_option_find(uint8_t kind)
+{
+	size_t i = 0;
+
+	while (i < reply_opts_len && reply_opts[i] != NET_TCP_END_OPT) {
+		if (reply_opts[i] == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
+
+		if (i + 1 >= reply_opts_len || reply_opts[i + 1] < 2) {
+			break;
+		}
+
+		if (reply_opts[i] == kind) {
+			return &reply_opts[i];
+		}
+
+		i += reply_opts[i + 1];
+	}
+
+	return NULL;
+}
+
+static void check_reply_timestamp(void)
+{
+	const uint8_t *opt = reply_option_find(NET_TCP_TIMESTAMP_OPT);
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS)) {
+		zassert_is_null(opt, "Timestamps not negotiated");
+		return;
+	}
+
+	zassert_not_null(opt, "Timestamps missing");
+	zassert_equal(opt[1], NET_TCP_TIMESTAMP_SIZE, "Invalid length");
+	zassert_equal(sys_get_be32(&opt[6]), sys_get_be32(&tcp_options[8]),
+		      "Peer timestamp not echoed");
+}
+
+static void test_options_accept_cb(struct net_context *ctx,
+				   struct sockaddr *addr,
+				   socklen_t addrlen,
+				   int status,
+				   void *user_data)
+{
+	zassert_equal(status, 0, "failed to accept the conn");
+
+	ctx->recv_cb = test_tcp_recv_cb;
+	accepted_ctx = ctx;
+
+	test_sem_give();
+}
+
+/* Test case scenario IPv4
+ *   send SYN with MSS, SACK permitted, timestamps and window scale,
+ *   expect SYN ACK with the options that are enabled,
+ *   send ACK,
+ *   send out-of-order DATA,
+ *   expect ACK with a SACK block covering the DATA,
+ *   send RST.
+ */
+static void test_server_negotiated_options(void)
+{
+	const uint8_t *opt;
+	struct net_context *ctx;
+	struct net_pkt *pkt;
+	struct tcp *conn;
+	int ret;
+
+	k_sem_reset(&test_sem);
+	test_case_no = 10;
+	seq = ack = 0;
+	accepted_ctx = NULL;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&my_addr_s,
+			       sizeof(struct sockaddr_in));
+	zassert_equal(ret, 0, "Failed to bind net_context");
+
+	ret = net_context_listen(ctx, 1);
+	zassert_equal(ret, 0, "Failed to listen on net_context");
+
+	ret = net_context_accept(ctx, test_options_accept_cb, K_FOREVER, NULL);
+	zassert_equal(ret, 0, "Failed to set accept on net_context");
+
+	pkt = prepare_syn_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+	zassert_not_null(pkt, "Cannot create pkt");
+	ret = net_recv_data(iface, pkt);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+	test_verify_flags(&reply_th, SYN | ACK);
+
+	zassert_not_null(reply_option_find(NET_TCP_MSS_OPT), "MSS missing");
+
+	opt = reply_option_find(NET_TCP_WINDOW_SCALE_OPT);
+	zassert_equal(opt != NULL, IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE),
+		      "Window scale option mismatch");
+
+	opt = reply_option_find(NET_TCP_SACK_PERM_OPT);
+	zassert_equal(opt != NULL, IS_ENABLED(CONFIG_NET_TCP_SACK),
+		      "SACK permitted option mismatch");
+
+	check_reply_timestamp();
+
+	seq++;
+	ack = ntohl(reply_th.th_seq) + 1U;
+
+	pkt = prepare_ack_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+	zassert_not_null(pkt, "Cannot create pkt");
+	ret = net_recv_data(iface, pkt);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+	zassert_not_null(accepted_ctx, "Connection not accepted");
+
+	conn = accepted_ctx->tcp;
+	zassert_equal(conn->wscale_ok, IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE),
+		      "Window scaling not negotiated");
+	zassert_equal(conn->snd_wscale,
+		      IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) ?
+		      tcp_options[19] : 0, "Invalid send window scale");
+	zassert_equal(conn->ts_ok, IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS),
+		      "Timestamps not negotiated");
+	zassert_equal(conn->sack_ok, IS_ENABLED(CONFIG_NET_TCP_SACK),
+		      "SACK not negotiated");
+
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+	    CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT) {
+		/* Leave a 10 byte hole in front of the data */
+		seq += 10;
+		pkt = prepare_data_packet(AF_INET, htons(MY_PORT),
+					  htons(PEER_PORT), lorem_ipsum, 10);
+		zassert_not_null(pkt, "Cannot create pkt");
+		ret = net_recv_data(iface, pkt);
+		zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+		test_sem_take(K_MSEC(100), __LINE__);
+		test_verify_flags(&reply_th, ACK);
+		zassert_equal(ntohl(reply_th.th_ack), seq - 10,
+			      "Invalid ACK %u", ntohl(reply_th.th_ack));
+
+		opt = reply_option_find(NET_TCP_SACK_OPT);
+		zassert_not_null(opt, "SACK block missing");
+		zassert_equal(opt[1], 2 + NET_TCP_SACK_BLOCK_SIZE,
+			      "Invalid SACK length %d", opt[1]);
+		zassert_equal(sys_get_be32(&opt[2]), seq,
+			      "Invalid SACK block start");
+		zassert_equal(sys_get_be32(&opt[6]), seq + 10,
+			      "Invalid SACK block end");
+
+		check_reply_timestamp();
+
+		/* The block holding the most recent segment is reported
+		 * first, here it grows at the front.
+		 */
+		seq -= 5;
+		pkt = prepare_data_packet(AF_INET, htons(MY_PORT),
+					  htons(PEER_PORT), lorem_ipsum, 5);
+		zassert_not_null(pkt, "Cannot create pkt");
+		ret = net_recv_data(iface, pkt);
+		zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+		test_sem_take(K_MSEC(100), __LINE__);
+		opt = reply_option_find(NET_TCP_SACK_OPT);
+		zassert_not_null(opt, "SACK block missing");
+		zassert_equal(sys_get_be32(&opt[2]), seq,
+			      "Invalid SACK block start");
+		zassert_equal(sys_get_be32(&opt[6]), seq + 15,
+			      "Invalid SACK block end");
+
+		seq -= 5;
+	}
+
+	pkt = prepare_rst_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+	zassert_not_null(pkt, "Cannot create pkt");
+	ret = net_recv_data(iface, pkt);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+}
+
+/* Select the congestion control algorithm of a socket and read it back */
+static void test_congestion_control_option(void)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	struct net_context *ctx;
+	char name[16];
+	size_t len;
+	int ret;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context (%d)", ret);
+
+	len = sizeof(name);
+	ret = net_context_get_option(ctx, NET_OPT_TCP_CONGESTION, name, &len);
+	zassert_equal(ret, 0, "Cannot get algorithm (%d)", ret);
+	zassert_equal(len, strlen(tcp_cc_default()->name) + 1,
+		      "Invalid name length %zd", len);
+	zassert_true(!strcmp(name, tcp_cc_default()->name),
+		     "Invalid default algorithm %s", name);
+
+	ret = net_context_set_option(ctx, NET_OPT_TCP_CONGESTION, "reno",
+				     sizeof("reno"));
+	zassert_equal(ret, 0, "Cannot set algorithm (%d)", ret);
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CC_CUBIC)) {
+		ret = net_context_set_option(ctx, NET_OPT_TCP_CONGESTION,
+					     "cubic", strlen("cubic"));
+		zassert_equal(ret, 0, "Cannot set algorithm (%d)", ret);
+
+		len = sizeof(name);
+		ret = net_context_get_option(ctx, NET_OPT_TCP_CONGESTION,
+					     name, &len);
+		zassert_equal(ret, 0, "Cannot get algorithm (%d)", ret);
+		zassert_true(!strcmp(name, "cubic"), "Invalid algorithm %s",
+			     name);
+	}
+
+	ret = net_context_set_option(ctx, NET_OPT_TCP_CONGESTION, "vegas",
+				     sizeof("vegas"));
+	zassert_equal(ret, -ENOENT, "Unknown algorithm accepted (%d)", ret);
+
+	net_context_put(ctx);
+#else
+	ztest_test_skip();
+#endif
+}
+
+#define MAX_SENT_SEGS 16
+#define OFFLOAD_DATA_LEN (5 * OFFLOAD_MSS)
+
+/* A segment sent by the stack in the offload tests */
+struct sent_seg {
+	uint32_t seq;
+	uint32_t ack;
+	uint8_t flags;
+	uint16_t ip_id;
+	size_t len;
+	bool chksum_ok;
+	bool data_ok;
+};
+
+static struct sent_seg sent_segs[MAX_SENT_SEGS];
+static int sent_cnt;
+static uint32_t sent_data_seq;
+static K_SEM_DEFINE(sent_sem, 0, MAX_SENT_SEGS);
+
+static int offload_recv_calls;
+static size_t offload_recv_len;
+static bool offload_recv_ok;
+
+/* Record every segment as it leaves the interface, the data is compared
+ * with lorem_ipsum which starts at sent_data_seq.
+ */
+static void handle_offload_test(struct net_pkt *pkt)
+{
+	uint8_t data[OFFLOAD_MSS];
+	struct sent_seg *seg;
+	struct tcphdr th;
+	size_t hdr_len;
+	uint32_t pos;
+	int ret;
+
+	if (sent_cnt >= MAX_SENT_SEGS) {
+		goto fail;
+	}
+
+	ret = read_tcp_header(pkt, &th);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	seg = &sent_segs[sent_cnt];
+	seg->seq = ntohl(th.th_seq);
+	seg->ack = ntohl(th.th_ack);
+	seg->flags = th.th_flags;
+	seg->ip_id = 0U;
+
+	hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+		th.th_off * 4U;
+	seg->len = net_pkt_get_len(pkt) - hdr_len;
+	seg->chksum_ok = net_calc_chksum_tcp(pkt) == 0U;
+
+	if (net_pkt_family(pkt) == AF_INET) {
+		struct net_ipv4_hdr ip_hdr;
+
+		if (net_calc_chksum_ipv4(pkt) != 0U) {
+			seg->chksum_ok = false;
+		}
+
+		net_pkt_cursor_init(pkt);
+		ret = net_pkt_read(pkt, &ip_hdr, sizeof(ip_hdr));
+		if (ret < 0) {
+			goto fail;
+		}
+
+		seg->ip_id = (ip_hdr.id[0] << 8) | ip_hdr.id[1];
+	}
+
+	pos = seg->seq - sent_data_seq;
+	seg->data_ok = false;
+
+	if (seg->len <= sizeof(data) && pos + seg->len <= sizeof(lorem_ipsum)) {
+		net_pkt_cursor_init(pkt);
+
+		ret = net_pkt_skip(pkt, hdr_len);
+		if (ret < 0) {
+			goto fail;
+		}
+
+		ret = net_pkt_read(pkt, data, seg->len);
+		if (ret < 0) {
+			goto fail;
+		}
+
+		seg->data_ok = !memcmp(data, lorem_ipsum + pos, seg->len);
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	sent_cnt++;
+	k_sem_give(&sent_sem);
+
+	return;
+
+fail:
+	zassert_true(false, "%s failed", __func__);
+}
+
+static void offload_recv_cb(struct net_context *context,
+			    struct net_pkt *pkt,
+			    union net_ip_header *ip_hdr,
+			    union net_proto_header *proto_hdr,
+			    int status,
+			    void *user_data)
+{
+	uint8_t data[2 * OFFLOAD_MSS];
+	size_t len;
+
+	if (status || !pkt) {
+		return;
+	}
+
+	len = net_pkt_remaining_data(pkt);
+
+	if (len > sizeof(data) ||
+	    offload_recv_len + len > sizeof(lorem_ipsum) ||
+	    net_pkt_read(pkt, data, len) < 0 ||
+	    memcmp(data, lorem_ipsum + offload_recv_len, len)) {
+		offload_recv_ok = false;
+	}
+
+	offload_recv_calls++;
+	offload_recv_len += len;
+
+	net_pkt_unref(pkt);
+}
+
+/* Open a connection from the peer to an IPv4 listener. The peer announces
+ * an MSS of OFFLOAD_MSS and the stack sends to a non-local address, so
+ * large packets are split when they leave the interface.
+ */
+static struct net_context *offload_connect(struct net_context **listener)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	k_sem_reset(&test_sem);
+	k_sem_reset(&sent_sem);
+	test_case_no = 11;
+	seq = ack = 0;
+	sent_cnt = 0;
+	accepted_ctx = NULL;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, listener);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	ret = net_context_bind(*listener, (struct sockaddr *)&my_addr_s,
+			       sizeof(struct sockaddr_in));
+	zassert_equal(ret, 0, "Failed to bind net_context");
+
+	ret = net_context_listen(*listener, 1);
+	zassert_equal(ret, 0, "Failed to listen on net_context");
+
+	ret = net_context_accept(*listener, test_options_accept_cb, K_FOREVER,
+				 NULL);
+	zassert_equal(ret, 0, "Failed to set accept on net_context");
+
+	pkt = prepare_syn_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+	zassert_not_null(pkt, "Cannot create pkt");
+	ret = net_recv_data(iface, pkt);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	ret = k_sem_take(&sent_sem, K_MSEC(100));
+	zassert_equal(ret, 0, "SYN ACK not sent");
+	zassert_equal(sent_segs[0].flags, SYN | ACK, "Invalid flags 0x%02x",
+		      sent_segs[0].flags);
+
+	seq++;
+	ack = sent_segs[0].seq + 1U;
+
+	pkt = prepare_ack_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+	zassert_not_null(pkt, "Cannot create pkt");
+	ret = net_recv_data(iface, pkt);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+	zassert_not_null(accepted_ctx, "Connection not accepted");
+
+	accepted_ctx->recv_cb = offload_recv_cb;
+	offload_recv_calls = 0;
+	offload_recv_len = 0;
+	offload_recv_ok = true;
+
+	k_sem_reset(&sent_sem);
+	sent_cnt = 0;
+	sent_data_seq = ack;
+
+	return accepted_ctx;
+}
+
+static void offload_close(struct net_context *listener)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = prepare_rst_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+	zassert_not_null(pkt, "Cannot create pkt");
+	ret = net_recv_data(iface, pkt);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(listener);
+}
+
+/* Test case scenario IPv4
+ *   send SYN with a small MSS,
+ *   expect SYN ACK,
+ *   send ACK,
+ *   expect the data of one send call split into MSS sized segments with
+ *   consecutive sequence numbers and IPv4 ids, valid checksums and PSH
+ *   only on the last one,
+ *   send ACK for all of it,
+ *   send RST.
+ */
+static void test_server_gso(void)
+{
+#if defined(CONFIG_NET_TCP_GSO)
+	int segs = OFFLOAD_DATA_LEN / OFFLOAD_MSS;
+	struct net_context *listener;
+	struct net_context *ctx;
+	struct sent_seg *seg;
+	struct net_pkt *pkt;
+	int ret, i;
+
+	ctx = offload_connect(&listener);
+
+	ret = net_context_send(ctx, lorem_ipsum, OFFLOAD_DATA_LEN, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_true(ret >= 0, "Failed to send data to peer (%d)", ret);
+
+	for (i = 0; i < segs; i++) {
+		ret = k_sem_take(&sent_sem, K_MSEC(100));
+		zassert_equal(ret, 0, "Segment %d not sent", i);
+
+		seg = &sent_segs[i];
+		zassert_equal(seg->len, OFFLOAD_MSS, "Segment %d has %zd bytes",
+			      i, seg->len);
+		zassert_equal(seg->seq, sent_data_seq + i * OFFLOAD_MSS,
+			      "Segment %d has seq %u", i, seg->seq);
+		zassert_equal(seg->ack, seq, "Segment %d has ack %u", i,
+			      seg->ack);
+		zassert_equal(seg->ip_id, (uint16_t)(sent_segs[0].ip_id + i),
+			      "Segment %d has IPv4 id %u", i, seg->ip_id);
+		zassert_equal(seg->flags, i == segs - 1 ? PSH | ACK : ACK,
+			      "Segment %d has flags 0x%02x", i, seg->flags);
+		zassert_true(seg->chksum_ok, "Segment %d has an invalid checksum",
+			     i);
+		zassert_true(seg->data_ok, "Segment %d has invalid data", i);
+	}
+
+	/* Nothing more than the data */
+	k_msleep(10);
+	zassert_equal(sent_cnt, segs, "%d segments sent", sent_cnt);
+
+	ack = sent_data_seq + OFFLOAD_DATA_LEN;
+	pkt = prepare_ack_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+	zassert_not_null(pkt, "Cannot create pkt");
+	ret = net_recv_data(iface, pkt);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	k_msleep(50);
+	zassert_equal(((struct tcp *)ctx->tcp)->unacked_len, 0,
+		      "Data not acknowledged");
+
+	offload_close(listener);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/* Test case scenario IPv4
+ *   send SYN,
+ *   expect SYN ACK,
+ *   send ACK,
+ *   queue two in-order DATA segments without PSH at once,
+ *   expect a single ACK for both and the data passed up in one piece,
+ *   send RST.
+ */
+static void test_server_gro(void)
+{
+#if defined(CONFIG_NET_TCP_GRO)
+	struct net_pkt *pkts[2];
+	struct net_context *listener;
+	int ret[ARRAY_SIZE(pkts)];
+	int i;
+
+	(void)offload_connect(&listener);
+
+	for (i = 0; i < ARRAY_SIZE(pkts); i++) {
+		pkts[i] = tester_prepare_tcp_pkt(AF_INET, htons(MY_PORT),
+						 htons(PEER_PORT), ACK,
+						 lorem_ipsum + i * OFFLOAD_MSS,
+						 OFFLOAD_MSS);
+		zassert_not_null(pkts[i], "Cannot create pkt");
+		seq += OFFLOAD_MSS;
+	}
+
+	/* Both segments are in the receive queue before it is processed */
+	k_sched_lock();
+	for (i = 0; i < ARRAY_SIZE(pkts); i++) {
+		ret[i] = net_recv_data(iface, pkts[i]);
+	}
+	k_sched_unlock();
+
+	for (i = 0; i < ARRAY_SIZE(pkts); i++) {
+		zassert_equal(ret[i], 0, "recv data failed (%d)", ret[i]);
+	}
+
+	zassert_equal(k_sem_take(&sent_sem, K_MSEC(100)), 0,
+		      "Data not acknowledged");
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	zassert_equal(sent_cnt, 1, "%d ACKs sent", sent_cnt);
+	zassert_equal(sent_segs[0].flags, ACK, "Invalid flags 0x%02x",
+		      sent_segs[0].flags);
+	zassert_equal(sent_segs[0].ack, seq, "Invalid ACK %u",
+		      sent_segs[0].ack);
+
+	zassert_equal(offload_recv_calls, 1, "Data passed up in %d parts",
+		      offload_recv_calls);
+	zassert_equal(offload_recv_len, 2 * OFFLOAD_MSS,
+		      "%zd bytes received", offload_recv_len);
+	zassert_true(offload_recv_ok, "Invalid data received");
+
+	offload_close(listener);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/* Test case scenario IPv4
+ *   send SYN,
+ *   expect SYN ACK,
+ *   send ACK,
+ *   queue a DATA segment without PSH and a RST at once, so the connection
+ *   is closed while the data is held,
+ *   expect the data to be passed up before the connection is released.
+ */
+static void test_server_gro_close(void)
+{
+#if defined(CONFIG_NET_TCP_GRO)
+	struct net_context *listener;
+	struct net_context *ctx;
+	struct net_pkt *pkts[2];
+	int ret[ARRAY_SIZE(pkts)];
+	int i;
+
+	ctx = offload_connect(&listener);
+
+	pkts[0] = tester_prepare_tcp_pkt(AF_INET, htons(MY_PORT),
+					 htons(PEER_PORT), ACK, lorem_ipsum,
+					 OFFLOAD_MSS);
+	zassert_not_null(pkts[0], "Cannot create pkt");
+	seq += OFFLOAD_MSS;
+
+	pkts[1] = prepare_rst_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+	zassert_not_null(pkts[1], "Cannot create pkt");
+
+	k_sched_lock();
+	for (i = 0; i < ARRAY_SIZE(pkts); i++) {
+		ret[i] = net_recv_data(iface, pkts[i]);
+	}
+	k_sched_unlock();
+
+	for (i = 0; i < ARRAY_SIZE(pkts); i++) {
+		zassert_equal(ret[i], 0, "recv data failed (%d)", ret[i]);
+	}
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	zassert_equal(offload_recv_calls, 1, "Data passed up in %d parts",
+		      offload_recv_calls);
+	zassert_equal(offload_recv_len, OFFLOAD_MSS, "%zd bytes received",
+		      offload_recv_len);
+	zassert_true(offload_recv_ok, "Invalid data received");
+	zassert_is_null(ctx->tcp, "Connection not released");
+
+	offload_close(listener);
+#else
+	ztest_test_skip();
+#endif
+}
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+/* Open a connection using NewReno and queue len bytes of data for the
+ * peer, which announces an MSS of OFFLOAD_MSS.
+ */
+static struct tcp *cc_connect(struct net_context **listener, size_t len)
+{
+	struct net_context *ctx;
+	int ret;
+
+	ctx = offload_connect(listener);
+
+	ret = net_context_set_option(ctx, NET_OPT_TCP_CONGESTION, "reno",
+				     sizeof("reno"));
+	zassert_equal(ret, 0, "Cannot set algorithm (%d)", ret);
+
+	ret = net_context_send(ctx, lorem_ipsum, len, NULL, K_NO_WAIT, NULL);
+	zassert_true(ret >= 0, "Failed to send data to peer (%d)", ret);
+
+	return ctx->tcp;
+}
+
+/* Wait for the next cnt segments and check that no more follow */
+static void cc_expect_segs(int cnt, int line)
+{
+	int i;
+
+	for (i = 0; i < cnt; i++) {
+		zassert_equal(k_sem_take(&sent_sem, K_MSEC(100)), 0,
+			      "Segment %d not sent (line %d)", i, line);
+	}
+
+	zassert_equal(k_sem_take(&sent_sem, K_MSEC(20)), -EAGAIN,
+		      "Too many segments sent (line %d)", line);
+}
+
+/* Acknowledge the first acked bytes of the data */
+static void cc_peer_ack(uint32_t acked)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	ack = sent_data_seq + acked;
+
+	pkt = prepare_ack_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+	zassert_not_null(pkt, "Cannot create pkt");
+	ret = net_recv_data(iface, pkt);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+}
+
+static void cc_check_seg(int idx, uint32_t pos)
+{
+	zassert_equal(sent_segs[idx].seq, sent_data_seq + pos,
+		      "Segment %d has seq %u", idx, sent_segs[idx].seq);
+	zassert_equal(sent_segs[idx].len, OFFLOAD_MSS,
+		      "Segment %d has %zd bytes", idx, sent_segs[idx].len);
+	zassert_true(sent_segs[idx].data_ok, "Segment %d has invalid data",
+		     idx);
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
+/* Test case scenario IPv4
+ *   establish a connection with a small MSS,
+ *   send 12 segments worth of data,
+ *   expect the initial window of 4 segments,
+ *   ACK them one by one,
+ *   expect two new segments for every ACK as the congestion window grows
+ *   by one MSS per ACK in slow start.
+ */
+static void test_cc_slow_start(void)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	struct net_context *listener;
+	struct tcp *conn;
+	int i;
+
+	conn = cc_connect(&listener, 12 * OFFLOAD_MSS);
+
+	cc_expect_segs(4, __LINE__);
+	zassert_equal(conn->cwnd, 4 * OFFLOAD_MSS, "Invalid initial cwnd %u",
+		      conn->cwnd);
+	zassert_equal(conn->ssthresh, TCP_CC_CWND_MAX, "Invalid ssthresh %u",
+		      conn->ssthresh);
+
+	for (i = 1; i <= 4; i++) {
+		cc_peer_ack(i * OFFLOAD_MSS);
+		cc_expect_segs(2, __LINE__);
+
+		zassert_equal(conn->cwnd, (4 + i) * OFFLOAD_MSS,
+			      "Invalid cwnd %u after ACK %d", conn->cwnd, i);
+	}
+
+	zassert_equal(sent_cnt, 12, "%d segments sent", sent_cnt);
+
+	for (i = 0; i < sent_cnt; i++) {
+		cc_check_seg(i, i * OFFLOAD_MSS);
+	}
+
+	offload_close(listener);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/* Test case scenario IPv4
+ *   establish a connection with a small MSS,
+ *   send 8 segments worth of data,
+ *   expect the initial window of 4 segments,
+ *   send 3 duplicate ACKs for the first one,
+ *   expect the first segment to be resent after the third one only,
+ *   send one more duplicate ACK,
+ *   expect new data as the window is inflated,
+ *   ACK the data sent before the loss,
+ *   expect the recovery to end with half of the flight as window.
+ */
+static void test_cc_fast_retransmit(void)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	struct net_context *listener;
+	struct tcp *conn;
+	int i;
+
+	conn = cc_connect(&listener, 8 * OFFLOAD_MSS);
+
+	cc_expect_segs(4, __LINE__);
+
+	for (i = 1; i < TCP_CC_DUP_ACK_THRESHOLD; i++) {
+		cc_peer_ack(0);
+		cc_expect_segs(0, __LINE__);
+		zassert_false(conn->in_recovery, "Recovery after %d ACKs", i);
+	}
+
+	cc_peer_ack(0);
+	cc_expect_segs(1, __LINE__);
+	cc_check_seg(4, 0);
+
+	zassert_true(conn->in_recovery, "No fast recovery");
+	zassert_equal(conn->ssthresh, 2 * OFFLOAD_MSS, "Invalid ssthresh %u",
+		      conn->ssthresh);
+	zassert_equal(conn->cwnd, conn->ssthresh +
+		      TCP_CC_DUP_ACK_THRESHOLD * OFFLOAD_MSS,
+		      "Invalid cwnd %u", conn->cwnd);
+
+	/* Every further duplicate ACK inflates the window by one MSS */
+	cc_peer_ack(0);
+	cc_expect_segs(2, __LINE__);
+	cc_check_seg(5, 4 * OFFLOAD_MSS);
+	cc_check_seg(6, 5 * OFFLOAD_MSS);
+	zassert_equal(conn->cwnd, 6 * OFFLOAD_MSS, "Invalid cwnd %u",
+		      conn->cwnd);
+
+	/* The data in flight at the loss is acknowledged, the window is
+	 * deflated to ssthresh which the remaining flight fills up
+	 */
+	cc_peer_ack(4 * OFFLOAD_MSS);
+	cc_expect_segs(0, __LINE__);
+	zassert_false(conn->in_recovery, "Still in fast recovery");
+	zassert_equal(conn->cwnd, 2 * OFFLOAD_MSS, "Invalid cwnd %u",
+		      conn->cwnd);
+
+	offload_close(listener);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/* Test case scenario IPv4
+ *   establish a connection with a small MSS,
+ *   send 2 segments worth of data,
+ *   expect both segments and do not ACK them,
+ *   expect the first one resent after the RTO with a window of one MSS,
+ *   expect the next resend after twice the RTO.
+ */
+static void test_cc_rto_backoff(void)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	struct net_context *listener;
+	struct tcp *conn;
+	uint32_t rto;
+	int i, ret;
+
+	conn = cc_connect(&listener, 2 * OFFLOAD_MSS);
+
+	cc_expect_segs(2, __LINE__);
+
+	rto = conn->rto;
+	zassert_true(rto >= CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT,
+		     "Invalid RTO %u", rto);
+
+	for (i = 0; i < 2; i++) {
+		ret = k_sem_take(&sent_sem, K_MSEC(rto * 3 / 4));
+		zassert_equal(ret, -EAGAIN, "Resent before the RTO of %u ms",
+			      rto);
+
+		ret = k_sem_take(&sent_sem, K_MSEC(rto / 2));
+		zassert_equal(ret, 0, "Not resent after the RTO of %u ms",
+			      rto);
+		cc_check_seg(2 + i, 0);
+
+		rto *= 2;
+		zassert_equal(conn->rto, rto, "RTO %u not backed off",
+			      conn->rto);
+		zassert_equal(conn->cwnd, OFFLOAD_MSS, "Invalid cwnd %u",
+			      conn->cwnd);
+		zassert_equal(conn->ssthresh, 2 * OFFLOAD_MSS,
+			      "Invalid ssthresh %u", conn->ssthresh);
+	}
+
+	offload_close(listener);
+#else
+	ztest_test_skip();
+#endif
+}
+
 /** Test case main entry */
 void test_main(void)
 {
@@ -1499,7 +2388,15 @@ void test_main(void)
 			 ztest_unit_test(test_client_closing_ipv6),
 			 ztest_unit_test(test_client_invalid_rst),
 			 ztest_unit_test(test_server_recv_out_of_order_data),
-			 ztest_unit_test(test_server_timeout_out_of_order_data)
+			 ztest_unit_test(test_server_timeout_out_of_order_data),
+			 ztest_unit_test(test_congestion_control_option),
+			 ztest_unit_test(test_server_negotiated_options),
+			 ztest_unit_test(test_server_gso),
+			 ztest_unit_test(test_server_gro),
+			 ztest_unit_test(test_server_gro_close),
+			 ztest_unit_test(test_cc_slow_start),
+			 ztest_unit_test(test_cc_fast_retransmit),
+			 ztest_unit_test(test_cc_rto_backoff)
 			 );
 
 	ztest_run_test_suite(test_tcp_fn);
@@ -968,6 +968,192 @@ static void test_traffic_class_recv_data_mix_all_2(void)
 	zassert_false(test_failed, "Traffic class verification failed.");
 }
 
+#if NET_TC_FLOW_QUEUES > 1
+#define FLOW_COUNT 32
+
+struct flow_ipv6_udp {
+	struct net_ipv6_hdr ip;
+	struct net_udp_hdr udp;
+} __packed;
+
+struct flow_ipv6_frag {
+	struct net_ipv6_hdr ip;
+	struct net_ipv6_frag_hdr frag;
+	struct net_udp_hdr udp;
+} __packed;
+
+struct flow_ipv4_udp {
+	struct net_ipv4_hdr ip;
+	struct net_udp_hdr udp;
+} __packed;
+
+static const uint8_t flow_src4[] = { 192, 0, 2, 1 };
+static const uint8_t flow_dst4[] = { 198, 51, 100, 1 };
+
+static void flow_ipv6_hdr_init(struct net_ipv6_hdr *ip, uint8_t nexthdr)
+{
+	ip->vtc = 0x60;
+	ip->nexthdr = nexthdr;
+	ip->hop_limit = 64U;
+	net_ipv6_addr_copy_raw(ip->src, (uint8_t *)&my_addr1);
+	net_ipv6_addr_copy_raw(ip->dst, (uint8_t *)&dst_addr);
+}
+
+static void flow_ipv6_udp_init(struct flow_ipv6_udp *hdr, uint16_t src_port)
+{
+	memset(hdr, 0, sizeof(*hdr));
+	flow_ipv6_hdr_init(&hdr->ip, IPPROTO_UDP);
+	hdr->udp.src_port = htons(src_port);
+	hdr->udp.dst_port = htons(TEST_PORT);
+}
+
+/* Flow queue selected for a packet made of hdr, the Tx and Rx paths must
+ * agree on it.
+ */
+static int flow_queue_get(sa_family_t family, const void *hdr, size_t len,
+			  uint32_t hash)
+{
+	struct net_if *iface;
+	struct net_pkt *pkt;
+	int queue;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+
+	pkt = net_pkt_alloc_with_buffer(iface, len, family, IPPROTO_UDP,
+					K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+	zassert_equal(net_pkt_write(pkt, hdr, len), 0, "Cannot write pkt");
+	net_pkt_cursor_init(pkt);
+
+	net_pkt_set_flow_hash(pkt, hash);
+
+	queue = net_tc_flow_queue(pkt, false);
+	zassert_true(queue >= 0 && queue < NET_TC_FLOW_QUEUES,
+		     "Invalid flow queue %d", queue);
+	zassert_equal(net_tc_flow_queue(pkt, true), queue,
+		      "Tx and Rx flow queues differ");
+
+	net_pkt_unref(pkt);
+
+	return queue;
+}
+#endif /* NET_TC_FLOW_QUEUES > 1 */
+
+static void test_traffic_class_flow_same_queue(void)
+{
+#if NET_TC_FLOW_QUEUES > 1
+	struct flow_ipv6_udp hdr;
+	int i, queue;
+
+	for (i = 0; i < FLOW_COUNT; i++) {
+		flow_ipv6_udp_init(&hdr, 1000 + i);
+		queue = flow_queue_get(AF_INET6, &hdr, sizeof(hdr), 0U);
+
+		/* Only the addresses, protocol and ports matter */
+		hdr.ip.len = htons(sizeof(hdr.udp) + i);
+		hdr.udp.len = hdr.ip.len;
+		hdr.udp.chksum = htons(i);
+
+		zassert_equal(flow_queue_get(AF_INET6, &hdr, sizeof(hdr), 0U),
+			      queue, "Flow %d changed queue", i);
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
+static void test_traffic_class_flow_spread(void)
+{
+#if NET_TC_FLOW_QUEUES > 1
+	bool used[NET_TC_FLOW_QUEUES] = { false };
+	struct flow_ipv6_udp hdr;
+	int i;
+
+	for (i = 0; i < FLOW_COUNT; i++) {
+		flow_ipv6_udp_init(&hdr, 1000 + i);
+		used[flow_queue_get(AF_INET6, &hdr, sizeof(hdr), 0U)] = true;
+	}
+
+	for (i = 0; i < NET_TC_FLOW_QUEUES; i++) {
+		zassert_true(used[i], "No flow in queue %d", i);
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
+static void test_traffic_class_flow_fragments(void)
+{
+#if NET_TC_FLOW_QUEUES > 1
+	struct flow_ipv6_frag frag6;
+	struct flow_ipv4_udp frag4;
+	int queue;
+
+	/* The first fragment carries the ports, the next ones do not */
+	memset(&frag6, 0, sizeof(frag6));
+	flow_ipv6_hdr_init(&frag6.ip, NET_IPV6_NEXTHDR_FRAG);
+	frag6.frag.nexthdr = IPPROTO_UDP;
+	frag6.frag.offset = htons(0x0001);
+	frag6.frag.id = htonl(1234);
+	frag6.udp.src_port = htons(1000);
+	frag6.udp.dst_port = htons(TEST_PORT);
+
+	queue = flow_queue_get(AF_INET6, &frag6, sizeof(frag6), 0U);
+
+	frag6.frag.offset = htons(1280);
+	memset(&frag6.udp, 0xaa, sizeof(frag6.udp));
+
+	zassert_equal(flow_queue_get(AF_INET6, &frag6, sizeof(frag6), 0U),
+		      queue, "IPv6 fragments in different queues");
+
+	if (!IS_ENABLED(CONFIG_NET_IPV4)) {
+		return;
+	}
+
+	memset(&frag4, 0, sizeof(frag4));
+	frag4.ip.vhl = 0x45;
+	frag4.ip.ttl = 64U;
+	frag4.ip.proto = IPPROTO_UDP;
+	frag4.ip.id[1] = 1U;
+	frag4.ip.offset[0] = 0x20; /* More fragments */
+	memcpy(frag4.ip.src, flow_src4, sizeof(flow_src4));
+	memcpy(frag4.ip.dst, flow_dst4, sizeof(flow_dst4));
+	frag4.udp.src_port = htons(1000);
+	frag4.udp.dst_port = htons(TEST_PORT);
+
+	queue = flow_queue_get(AF_INET, &frag4, sizeof(frag4), 0U);
+
+	/* Last fragment, at offset 1480 */
+	frag4.ip.offset[0] = 0x00;
+	frag4.ip.offset[1] = 0xb9;
+	memset(&frag4.udp, 0xaa, sizeof(frag4.udp));
+
+	zassert_equal(flow_queue_get(AF_INET, &frag4, sizeof(frag4), 0U),
+		      queue, "IPv4 fragments in different queues");
+#else
+	ztest_test_skip();
+#endif
+}
+
+static void test_traffic_class_flow_hash(void)
+{
+#if NET_TC_FLOW_QUEUES > 1
+	struct flow_ipv6_udp hdr;
+	int i;
+
+	flow_ipv6_udp_init(&hdr, 1000);
+
+	/* A hash given by the driver replaces the one of the stack */
+	for (i = 0; i < NET_TC_FLOW_QUEUES; i++) {
+		zassert_equal(flow_queue_get(AF_INET6, &hdr, sizeof(hdr),
+					     NET_TC_FLOW_QUEUES + i),
+			      i, "Flow hash ignored");
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(net_traffic_class_test,
@@ -1006,7 +1192,13 @@ void test_main(void)
 			 ztest_unit_test(test_traffic_class_recv_data_mix),
 			 ztest_unit_test(test_traffic_class_recv_data_mix_all_1),
 			 ztest_unit_test(test_traffic_class_recv_data_mix_all_2),
-			 ztest_unit_test(test_traffic_class_cleanup_rx)
+			 ztest_unit_test(test_traffic_class_cleanup_rx),
+
+			 /* Packets of a flow stay in the same flow queue */
+			 ztest_unit_test(test_traffic_class_flow_same_queue),
+			 ztest_unit_test(test_traffic_class_flow_spread),
+			 ztest_unit_test(test_traffic_class_flow_fragments),
+			 ztest_unit_test(test_traffic_class_flow_hash)
 			 );
 
 	ztest_run_test_suite(net_traffic_class_test);
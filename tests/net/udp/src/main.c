@@ -433,7 +433,7 @@ void test_udp(void)
 	struct net_conn_handle *handlers[CONFIG_NET_MAX_CONN];
 	struct net_if *iface;
 	struct net_if_addr *ifaddr;
-	struct ud *ud;
+	struct ud *ud, *ud_wild;
 	int ret, i = 0;
 	bool st;
 
@@ -628,6 +628,30 @@ void test_udp(void)
 	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1234, 4242);
 	TEST_IPV4_FAIL(ud, &in4addr_peer, &in4addr_my, 1234, 4243);
 
+	/* An exact handler wins over a wildcard one for the same local
+	 * port, whichever of them was registered first.
+	 */
+	ud_wild = REGISTER(AF_INET6, &any_addr6, NULL, 0, 4250);
+	ud = REGISTER(AF_INET6, &peer_addr6, &my_addr6, 1234, 4250);
+	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 1234, 4250);
+	TEST_IPV6_OK(ud_wild, &in6addr_peer, &in6addr_my, 1235, 4250);
+	UNREGISTER(ud);
+	UNREGISTER(ud_wild);
+
+	ud = REGISTER(AF_INET6, &peer_addr6, &my_addr6, 1234, 4251);
+	ud_wild = REGISTER(AF_INET6, &any_addr6, NULL, 0, 4251);
+	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 1234, 4251);
+	TEST_IPV6_OK(ud_wild, &in6addr_peer, &in6addr_my, 1235, 4251);
+	UNREGISTER(ud_wild);
+	UNREGISTER(ud);
+
+	ud_wild = REGISTER(AF_INET, &any_addr4, NULL, 0, 4250);
+	ud = REGISTER(AF_INET, &peer_addr4, &my_addr4, 1234, 4250);
+	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1234, 4250);
+	TEST_IPV4_OK(ud_wild, &in4addr_peer, &in4addr_my, 1235, 4250);
+	UNREGISTER(ud);
+	UNREGISTER(ud_wild);
+
 	ud = REGISTER(AF_UNSPEC, NULL, NULL, 1234, 42423);
 	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1234, 42423);
 	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 1234, 42423);
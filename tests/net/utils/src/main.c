@@ -21,6 +21,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_UTILS_LOG_LEVEL);
 #include <sys/printk.h>
 #include <net/net_core.h>
 #include <net/net_ip.h>
+#include <net/net_pkt.h>
 #include <net/ethernet.h>
 #include <linker/sections.h>
 
@@ -848,11 +849,146 @@ void test_addr_parse(void)
 #endif
 }
 
+#define CHKSUM_PKT_LEN 300
+#define CHKSUM_UDP_OFF NET_IPV4H_LEN
+
+/* IPv4 header followed by a UDP datagram */
+static uint8_t chksum_data[CHKSUM_PKT_LEN];
+
+/* Fragment sizes, the first one must hold the IPv4 header */
+static const uint8_t chksum_splits[][6] = {
+	{ 128, 128, 44 },
+	{ 21, 1, 127, 127, 24 },
+	{ 27, 100, 1, 101, 71 },
+	{ 33, 126, 2, 3, 125, 11 },
+};
+
+static struct net_pkt *chksum_pkt(const uint8_t *split)
+{
+	struct net_pkt *pkt;
+	size_t off = 0;
+
+	pkt = net_pkt_alloc(K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	net_pkt_set_family(pkt, AF_INET);
+	net_pkt_set_ip_hdr_len(pkt, NET_IPV4H_LEN);
+
+	for (int i = 0; i < 6 && off < sizeof(chksum_data); i++) {
+		struct net_buf *frag;
+
+		frag = net_pkt_get_reserve_tx_data(K_NO_WAIT);
+		zassert_not_null(frag, "Cannot allocate frag");
+
+		net_buf_add_mem(frag, chksum_data + off, split[i]);
+		net_pkt_frag_add(pkt, frag);
+		off += split[i];
+	}
+
+	zassert_equal(off, sizeof(chksum_data), "Bad split");
+
+	return pkt;
+}
+
+/* Sum of big endian 16-bit words, one at a time */
+static uint32_t chksum_ref_sum(uint32_t sum, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		sum += (i & 1) ? data[i] : (data[i] << 8);
+	}
+
+	return sum;
+}
+
+static uint16_t chksum_ref(void)
+{
+	uint32_t sum;
+
+	/* Pseudo header: addresses, protocol and UDP length */
+	sum = chksum_ref_sum(IPPROTO_UDP + CHKSUM_PKT_LEN - CHKSUM_UDP_OFF,
+			     chksum_data + 12, 8);
+	sum = chksum_ref_sum(sum, chksum_data + CHKSUM_UDP_OFF,
+			     CHKSUM_PKT_LEN - CHKSUM_UDP_OFF);
+
+	while (sum > 0xffff) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return ~htons(sum == 0 ? 0xffff : sum);
+}
+
+static uint16_t chksum_calc(const uint8_t *split)
+{
+	struct net_pkt *pkt = chksum_pkt(split);
+	uint16_t chksum = net_calc_chksum(pkt, IPPROTO_UDP);
+
+	net_pkt_unref(pkt);
+
+	return chksum;
+}
+
+void test_chksum(void)
+{
+	uint32_t seed = 1;
+
+	for (int round = 0; round < 4; round++) {
+		for (int i = 0; i < sizeof(chksum_data); i++) {
+			seed = seed * 1103515245 + 12345;
+			chksum_data[i] = seed >> 16;
+		}
+
+		/* All ones payload, the sum wraps around many times */
+		if (round == 3) {
+			memset(chksum_data + CHKSUM_UDP_OFF, 0xff,
+			       sizeof(chksum_data) - CHKSUM_UDP_OFF);
+		}
+
+		for (int i = 0; i < ARRAY_SIZE(chksum_splits); i++) {
+			zassert_equal(chksum_calc(chksum_splits[i]),
+				      chksum_ref(),
+				      "Checksum mismatch, round %d split %d",
+				      round, i);
+		}
+	}
+}
+
+void test_chksum_update(void)
+{
+	uint8_t *chksum_field = chksum_data + CHKSUM_UDP_OFF + 6;
+	uint8_t new_addr[4] = { 192, 0, 2, 42 };
+	uint16_t chksum, old_val, new_val;
+
+	memset(chksum_field, 0, 2);
+	chksum = chksum_calc(chksum_splits[1]);
+	memcpy(chksum_field, &chksum, 2);
+	zassert_equal(chksum_calc(chksum_splits[1]), 0, "Invalid checksum");
+
+	/* Rewrite the destination port */
+	memcpy(&old_val, chksum_data + CHKSUM_UDP_OFF + 2, 2);
+	new_val = htons(4242);
+	memcpy(chksum_data + CHKSUM_UDP_OFF + 2, &new_val, 2);
+
+	chksum = net_chksum_update16(chksum, old_val, new_val);
+	memcpy(chksum_field, &chksum, 2);
+	zassert_equal(chksum_calc(chksum_splits[1]), 0,
+		      "Invalid checksum after port rewrite");
+
+	/* Rewrite the source address of the pseudo header */
+	chksum = net_chksum_update(chksum, chksum_data + 12, new_addr,
+				   sizeof(new_addr));
+	memcpy(chksum_data + 12, new_addr, sizeof(new_addr));
+	memcpy(chksum_field, &chksum, 2);
+	zassert_equal(chksum_calc(chksum_splits[2]), 0,
+		      "Invalid checksum after address rewrite");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_utils_fn,
 			 ztest_user_unit_test(test_net_addr),
-			 ztest_unit_test(test_addr_parse));
+			 ztest_unit_test(test_addr_parse),
+			 ztest_unit_test(test_chksum),
+			 ztest_unit_test(test_chksum_update));
 
 	ztest_run_test_suite(test_utils_fn);
 }
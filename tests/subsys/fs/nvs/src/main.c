@@ -707,6 +707,71 @@ void test_nvs_gc_corrupt_ate(void)
 	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
 }
 
+/*
+ * Test that the lookup cache resolves the latest entry of each ID directly
+ * after a remount and after garbage collection, and that IDs which were
+ * never written or were deleted are reported as missing.
+ */
+void test_nvs_lookup_cache(void)
+{
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	struct nvs_lookup_cache_stats stats;
+	int err;
+	ssize_t len;
+	uint16_t id, data_read;
+	uint32_t value;
+
+	fs.sector_count = 3;
+
+	err = nvs_mount(&fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+
+	/* Several generations of each ID, enough to trigger a gc */
+	for (value = 0; value < 64; value++) {
+		for (id = 1; id <= 8; id++) {
+			uint16_t data = id * 100 + value;
+
+			len = nvs_write(&fs, id, &data, sizeof(data));
+			zassert_true(len == sizeof(data) || len == 0,
+				     "nvs_write failed: %d", len);
+		}
+	}
+
+	err = nvs_delete(&fs, 8);
+	zassert_true(err == 0,  "nvs_delete call failure: %d", err);
+
+	err = nvs_mount(&fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+
+	for (id = 1; id <= 7; id++) {
+		len = nvs_read(&fs, id, &data_read, sizeof(data_read));
+		zassert_true(len == sizeof(data_read), "nvs_read failed: %d",
+			     len);
+		zassert_equal(data_read, id * 100 + 63,
+			      "wrong data read for id %u", id);
+	}
+
+	len = nvs_read(&fs, 8, &data_read, sizeof(data_read));
+	zassert_true(len == -ENOENT, "nvs_read shouldn't found the entry: %d",
+		     len);
+
+	len = nvs_read(&fs, 0x1000, &data_read, sizeof(data_read));
+	zassert_true(len == -ENOENT, "nvs_read shouldn't found the entry: %d",
+		     len);
+
+	err = nvs_lookup_cache_stats_get(&fs, &stats);
+	zassert_true(err == 0,  "nvs_lookup_cache_stats_get failure: %d", err);
+	zassert_equal(stats.lookups, 9, "unexpected lookup count %u",
+		      stats.lookups);
+
+	/* IDs sharing a cache position cost a walk, the rest must be hits */
+	zassert_true(stats.hits > 0 && stats.hits <= stats.lookups,
+		     "unexpected cache hit count %u", stats.hits);
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_nvs,
@@ -730,7 +795,9 @@ void test_main(void)
 			 ztest_unit_test_setup_teardown(
 				 test_nvs_gc_corrupt_close_ate, setup, teardown),
 			 ztest_unit_test_setup_teardown(
-				 test_nvs_gc_corrupt_ate, setup, teardown)
+				 test_nvs_gc_corrupt_ate, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_lookup_cache, setup, teardown)
 			);
 
 	ztest_run_test_suite(test_nvs);
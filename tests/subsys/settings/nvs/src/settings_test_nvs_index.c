@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <storage/flash_map.h>
+
+#include "settings_test.h"
+#include "settings/settings_nvs.h"
+
+/* Tests of the NVS backend on names stored by images built with and without
+ * CONFIG_SETTINGS_NVS_NAME_INDEX. The backend is initialized again to
+ * simulate a reboot, and names are written straight to NVS the way an
+ * image without the index stores them.
+ */
+
+#define INDEX_TEST_VALS 4
+
+static struct settings_nvs cf;
+static uint32_t index_vals[INDEX_TEST_VALS];
+static int index_found;
+
+static void index_backend_init(bool erase)
+{
+	const struct flash_area *fa;
+	struct flash_sector sector;
+	uint32_t sector_cnt = 1;
+	int rc;
+
+	rc = flash_area_open(FLASH_AREA_ID(storage), &fa);
+	zassert_equal(rc, 0, "can't open storage area");
+
+	rc = flash_area_get_sectors(FLASH_AREA_ID(storage), &sector_cnt,
+				    &sector);
+	zassert_true(rc == 0 || rc == -ENOMEM, "can't get sectors");
+
+	if (erase) {
+		rc = flash_area_erase(fa, 0, fa->fa_size);
+		zassert_equal(rc, 0, "can't erase storage area");
+	}
+
+	(void)memset(&cf, 0, sizeof(cf));
+	cf.cf_nvs.sector_size = sector.fs_size;
+	cf.cf_nvs.sector_count = MIN(fa->fa_size / sector.fs_size,
+				     CONFIG_SETTINGS_NVS_SECTOR_COUNT);
+	cf.cf_nvs.offset = fa->fa_off;
+	cf.flash_dev_name = fa->fa_dev_name;
+	flash_area_close(fa);
+
+	rc = settings_nvs_backend_init(&cf);
+	zassert_equal(rc, 0, "can't initialize backend");
+}
+
+/* store a setting the way an image built without the index does */
+static void index_raw_save(uint16_t name_id, const char *name, uint32_t val)
+{
+	ssize_t rc;
+
+	rc = nvs_write(&cf.cf_nvs, name_id + NVS_NAME_ID_OFFSET, &val,
+		       sizeof(val));
+	zassert_true(rc >= 0, "can't write value");
+	rc = nvs_write(&cf.cf_nvs, name_id, name, strlen(name));
+	zassert_true(rc >= 0, "can't write name");
+
+	if (name_id > cf.last_name_id) {
+		cf.last_name_id = name_id;
+		rc = nvs_write(&cf.cf_nvs, NVS_NAMECNT_ID, &cf.last_name_id,
+			       sizeof(uint16_t));
+		zassert_true(rc >= 0, "can't write name count");
+	}
+}
+
+static void index_save(const char *name, uint32_t val)
+{
+	int rc;
+
+	rc = cf.cf_store.cs_itf->csi_save(&cf.cf_store, name,
+					  (const char *)&val, sizeof(val));
+	zassert_equal(rc, 0, "can't save %s", name);
+}
+
+static void index_delete(const char *name)
+{
+	int rc;
+
+	rc = cf.cf_store.cs_itf->csi_save(&cf.cf_store, name, NULL, 0);
+	zassert_equal(rc, 0, "can't delete %s", name);
+}
+
+/* "idx/a" to "idx/d" are loaded into index_vals[0] to index_vals[3] */
+static int index_load_cb(const char *key, size_t len, settings_read_cb read_cb,
+			 void *cb_arg, void *param)
+{
+	int idx = key[0] - 'a';
+
+	ARG_UNUSED(param);
+
+	zassert_true(idx >= 0 && idx < INDEX_TEST_VALS && key[1] == '\0',
+		     "unexpected setting %s", key);
+	zassert_equal(len, sizeof(uint32_t), "unexpected length");
+	zassert_equal(read_cb(cb_arg, &index_vals[idx], sizeof(uint32_t)),
+		      sizeof(uint32_t), "can't read value");
+	index_found |= BIT(idx);
+
+	return 0;
+}
+
+static int index_load(void)
+{
+	struct settings_load_arg arg = {
+		.subtree = "idx",
+		.cb = index_load_cb,
+	};
+	int rc;
+
+	index_found = 0;
+	(void)memset(index_vals, 0, sizeof(index_vals));
+
+	rc = cf.cf_store.cs_itf->csi_load(&cf.cf_store, &arg);
+	zassert_equal(rc, 0, "can't load");
+
+	return index_found;
+}
+
+static void index_check(uint16_t first, uint16_t last)
+{
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	uint16_t index_last_name_id;
+	ssize_t rc;
+
+	for (uint16_t name_id = first; name_id <= last; name_id++) {
+		zassert_not_equal(cf.name_index[name_id - NVS_NAMECNT_ID - 1]
+				  .name_hash, 0, "name ID %x not indexed",
+				  name_id);
+	}
+
+	rc = nvs_read(&cf.cf_nvs, NVS_NAME_INDEX_CNT_ID, &index_last_name_id,
+		      sizeof(index_last_name_id));
+	zassert_equal(rc, sizeof(index_last_name_id), "no index name count");
+	zassert_equal(index_last_name_id, cf.last_name_id,
+		      "index name count out of date");
+#else
+	ARG_UNUSED(first);
+	ARG_UNUSED(last);
+#endif
+}
+
+/**
+ * @brief Test that settings stored without the name index are all found
+ * and updated in place once the index is created.
+ */
+void test_config_nvs_index_upgrade(void)
+{
+	index_backend_init(true);
+
+	index_raw_save(NVS_NAMECNT_ID + 1, "idx/a", 1);
+	index_raw_save(NVS_NAMECNT_ID + 2, "other/x", 100);
+	index_raw_save(NVS_NAMECNT_ID + 3, "idx/b", 2);
+
+	index_backend_init(false);
+	index_check(NVS_NAMECNT_ID + 1, NVS_NAMECNT_ID + 3);
+
+	zassert_equal(index_load(), BIT(0) | BIT(1), "settings lost");
+	zassert_equal(index_vals[0], 1, "wrong value");
+	zassert_equal(index_vals[1], 2, "wrong value");
+
+	/* An existing setting is overwritten, not stored again */
+	index_save("idx/a", 10);
+	index_save("idx/c", 3);
+	zassert_equal(cf.last_name_id, NVS_NAMECNT_ID + 4,
+		      "setting stored twice");
+	index_check(NVS_NAMECNT_ID + 1, NVS_NAMECNT_ID + 4);
+
+	index_backend_init(false);
+	zassert_equal(index_load(), BIT(0) | BIT(1) | BIT(2),
+		      "settings lost");
+	zassert_equal(index_vals[0], 10, "wrong value");
+	zassert_equal(index_vals[2], 3, "wrong value");
+}
+
+/**
+ * @brief Test that an index is rebuilt when an image built without it
+ * stored settings after it was created.
+ */
+void test_config_nvs_index_stale(void)
+{
+	index_backend_init(true);
+
+	index_save("idx/a", 1);
+	index_save("idx/b", 2);
+	index_check(NVS_NAMECNT_ID + 1, NVS_NAMECNT_ID + 2);
+
+	/* A new name ID is taken */
+	index_raw_save(NVS_NAMECNT_ID + 3, "idx/c", 3);
+
+	index_backend_init(false);
+	index_check(NVS_NAMECNT_ID + 1, NVS_NAMECNT_ID + 3);
+	zassert_equal(index_load(), BIT(0) | BIT(1) | BIT(2),
+		      "settings lost");
+
+	index_save("idx/c", 30);
+	zassert_equal(cf.last_name_id, NVS_NAMECNT_ID + 3,
+		      "setting stored twice");
+
+	/* A name ID freed with the index is used again */
+	index_delete("idx/a");
+	zassert_equal(index_load(), BIT(1) | BIT(2), "setting not deleted");
+	index_raw_save(NVS_NAMECNT_ID + 1, "idx/d", 4);
+
+	index_backend_init(false);
+	index_check(NVS_NAMECNT_ID + 1, NVS_NAMECNT_ID + 3);
+	zassert_equal(index_load(), BIT(1) | BIT(2) | BIT(3),
+		      "settings lost");
+	zassert_equal(index_vals[2], 30, "wrong value");
+	zassert_equal(index_vals[3], 4, "wrong value");
+
+	index_save("idx/d", 40);
+	zassert_equal(cf.last_name_id, NVS_NAMECNT_ID + 3,
+		      "setting stored twice");
+	index_load();
+	zassert_equal(index_vals[3], 40, "wrong value");
+}
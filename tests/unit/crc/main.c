@@ -50,6 +50,63 @@ void test_crc32_ieee(void)
 	zassert_equal(crc32_ieee(test3, sizeof(test3)), 0x20089AA4, NULL);
 }
 
+/* Bit at a time reference for the reflected CRC-32 polynomials, without
+ * any input or output inversion.
+ */
+static uint32_t crc32_bitwise(uint32_t poly, uint32_t crc,
+			      const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		crc ^= data[i];
+		for (int bit = 0; bit < 8; bit++) {
+			crc = (crc >> 1) ^ ((crc & 1) ? poly : 0);
+		}
+	}
+
+	return crc;
+}
+
+/* Compare whichever CRC-32 implementation is built against the bitwise
+ * reference for all alignments and lengths around the word and slice
+ * boundaries, in one go and split across several updates.
+ */
+void test_crc32_cross_check(void)
+{
+	static uint8_t buf[300];
+	uint32_t seed = 0x12345678;
+	uint32_t crc, ref;
+
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		seed = seed * 1103515245 + 12345;
+		buf[i] = seed >> 16;
+	}
+
+	for (size_t off = 0; off < 8; off++) {
+		for (size_t len = 0; len <= sizeof(buf) - off; len++) {
+			const uint8_t *data = buf + off;
+			size_t half = len / 2;
+
+			ref = ~crc32_bitwise(0xedb88320, ~0U, data, len);
+			zassert_equal(crc32_ieee(data, len), ref,
+				      "ieee off %zu len %zu", off, len);
+
+			crc = crc32_ieee_update(0, data, half);
+			crc = crc32_ieee_update(crc, data + half, len - half);
+			zassert_equal(crc, ref, "ieee split off %zu len %zu",
+				      off, len);
+
+			ref = ~crc32_bitwise(0x82f63b78, ~0U, data, len);
+			zassert_equal(crc32_c(0, data, len, true, true), ref,
+				      "c off %zu len %zu", off, len);
+
+			crc = crc32_c(0, data, half, true, false);
+			crc = crc32_c(crc, data + half, len - half, false, true);
+			zassert_equal(crc, ref, "c split off %zu len %zu",
+				      off, len);
+		}
+	}
+}
+
 void test_crc16(void)
 {
 	uint8_t test[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
@@ -266,6 +323,7 @@ void test_main(void)
 	ztest_test_suite(test_crc,
 			 ztest_unit_test(test_crc32c),
 			 ztest_unit_test(test_crc32_ieee),
+			 ztest_unit_test(test_crc32_cross_check),
 			 ztest_unit_test(test_crc16),
 			 ztest_unit_test(test_crc16_ansi),
 			 ztest_unit_test(test_crc16_ccitt),